@@ -0,0 +1,198 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "chrono/core/ChException.h"
+#include "chrono/core/ChLanczosEigenSolver.h"
+#include "chrono/core/ChLinearAlgebra.h"
+
+namespace chrono {
+
+static double Dot(const ChVectorDynamic<>& a, const ChVectorDynamic<>& b) {
+    int n = a.GetRows();
+    const double* pa = a.GetAddress();
+    const double* pb = b.GetAddress();
+    double sum = 0;
+#pragma omp parallel for reduction(+ : sum) schedule(static) if (n > 10000)
+    for (int i = 0; i < n; i++)
+        sum += pa[i] * pb[i];
+    return sum;
+}
+
+// y += a * x
+static void Axpy(double a, const ChVectorDynamic<>& x, ChVectorDynamic<>& y) {
+    int n = x.GetRows();
+    const double* px = x.GetAddress();
+    double* py = y.GetAddress();
+#pragma omp parallel for schedule(static) if (n > 10000)
+    for (int i = 0; i < n; i++)
+        py[i] += a * px[i];
+}
+
+int ChLanczosEigenSolver::Solve(int n,
+                                Operator solve_shifted,
+                                Operator multiply_M,
+                                double sigma,
+                                int nev,
+                                ChVectorDynamic<>& eigenvalues,
+                                ChMatrixDynamic<>& eigenvectors) {
+    nev = std::min(nev, n);
+    int max_size = m_max_subspace > 0 ? m_max_subspace : std::max(3 * nev, nev + 50);
+    max_size = std::max(std::min(max_size, n), nev);
+
+    // Lanczos vectors q_j (M-orthonormal) and their products by M.
+    std::vector<ChVectorDynamic<>> Q;
+    std::vector<ChVectorDynamic<>> MQ;
+    std::vector<double> alpha;
+    std::vector<double> beta;
+    Q.reserve(max_size + 1);
+    MQ.reserve(max_size + 1);
+
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    ChVectorDynamic<> w(n);
+    ChVectorDynamic<> Mw(n);
+
+    // Make w a new unit vector, M-orthogonal to the current Lanczos vectors. The random vector is first
+    // multiplied by the operator, to remove the components in the null space of M (infinite eigenvalues).
+    // Returns false if no such vector could be found.
+    auto restart = [&]() {
+        for (int attempt = 0; attempt < 3; attempt++) {
+            for (int i = 0; i < n; i++)
+                Mw(i) = uniform(generator);
+            solve_shifted(Mw, w);
+            for (int pass = 0; pass < 2; pass++) {
+                for (size_t k = 0; k < Q.size(); k++)
+                    Axpy(-Dot(w, MQ[k]), Q[k], w);
+            }
+            multiply_M(w, Mw);
+            double norm = std::sqrt(std::max(Dot(w, Mw), 0.0));
+            if (norm > 0) {
+                w.MatrScale(1 / norm);
+                Mw.MatrScale(1 / norm);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (!restart())
+        throw ChException("ChLanczosEigenSolver: the mass matrix is zero.");
+    Q.push_back(w);
+    MQ.push_back(Mw);
+
+    ChMatrixDynamic<> S;
+    ChMatrixDynamic<> theta;
+    std::vector<int> selected;
+    int num_converged = 0;
+    m_iterations = 0;
+
+    for (int j = 0; j < max_size; j++) {
+        m_iterations = j + 1;
+
+        // Three-term recurrence, w = Op(q_j) - alpha_j q_j - beta_(j-1) q_(j-1), with Op = (K - sigma M)^-1 M.
+        solve_shifted(MQ[j], w);
+        alpha.push_back(Dot(w, MQ[j]));
+        Axpy(-alpha[j], Q[j], w);
+        if (j > 0)
+            Axpy(-beta[j - 1], Q[j - 1], w);
+
+        // Full reorthogonalization (twice is enough).
+        for (int pass = 0; pass < 2; pass++) {
+            for (int k = 0; k <= j; k++)
+                Axpy(-Dot(w, MQ[k]), Q[k], w);
+        }
+        multiply_M(w, Mw);
+        double b = std::sqrt(std::max(Dot(w, Mw), 0.0));
+
+        // Invariant subspace found: continue with a new vector (and a zero coupling term).
+        bool invariant = (b <= 1e-12 * std::abs(alpha[j]));
+        bool last = (j + 1 == max_size);
+        if (invariant && !last) {
+            b = 0;
+            if (!restart())
+                last = true;
+        } else if (!last) {
+            w.MatrScale(1 / b);
+            Mw.MatrScale(1 / b);
+        }
+        beta.push_back(b);
+        if (!last) {
+            Q.push_back(w);
+            MQ.push_back(Mw);
+        }
+
+        // Check the convergence of the Ritz pairs every few iterations.
+        int m = j + 1;
+        if (m < nev || (!last && m % 5 != 0 && m != n))
+            continue;
+
+        ChMatrixDynamic<> T(m, m);
+        for (int i = 0; i < m; i++) {
+            T(i, i) = alpha[i];
+            if (i + 1 < m) {
+                T(i, i + 1) = beta[i];
+                T(i + 1, i) = beta[i];
+            }
+        }
+        ChLinearAlgebra::SymmetricEigen(T, S, theta);
+
+        // Eigenvalues closest to the shift correspond to the largest |theta| = 1 / |lambda - sigma|.
+        selected.resize(m);
+        for (int i = 0; i < m; i++)
+            selected[i] = i;
+        std::stable_sort(selected.begin(), selected.end(),
+                         [&](int a, int c) { return std::abs(theta(a)) > std::abs(theta(c)); });
+        selected.resize(nev);
+
+        num_converged = 0;
+        for (int i : selected) {
+            if (std::abs(b * S(m - 1, i)) <= m_tolerance * std::abs(theta(i)))
+                num_converged++;
+        }
+        if (num_converged == nev || last || m == n)
+            break;
+    }
+
+    // Ritz vectors, sorted by eigenvalue.
+    int m = (int)alpha.size();
+    std::vector<double> lambda(nev);
+    for (int k = 0; k < nev; k++)
+        lambda[k] = sigma + 1 / theta(selected[k]);
+    std::vector<int> order(nev);
+    for (int k = 0; k < nev; k++)
+        order[k] = k;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int c) { return lambda[a] < lambda[c]; });
+
+    eigenvalues.Reset(nev);
+    eigenvectors.Reset(n, nev);
+    for (int k = 0; k < nev; k++) {
+        int i = selected[order[k]];
+        eigenvalues(k) = lambda[order[k]];
+#pragma omp parallel for schedule(static) if (n > 10000)
+        for (int r = 0; r < n; r++) {
+            double sum = 0;
+            for (int l = 0; l < m; l++)
+                sum += S(l, i) * Q[l](r);
+            eigenvectors(r, k) = sum;
+        }
+    }
+
+    return num_converged;
+}
+
+}  // end namespace chrono
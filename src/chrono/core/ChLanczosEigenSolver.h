@@ -0,0 +1,68 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHLANCZOSEIGENSOLVER_H
+#define CHLANCZOSEIGENSOLVER_H
+
+#include <functional>
+
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChVectorDynamic.h"
+
+namespace chrono {
+
+/// Shift-invert Lanczos solver for the generalized symmetric eigenproblem K*x = lambda*M*x, with K
+/// symmetric and M symmetric positive semidefinite (e.g. stiffness and mass matrices).
+/// The matrices are accessed only through two operators provided by the caller: the product by M and
+/// the solution of (K - sigma*M)*y = x for a fixed shift sigma, typically with a sparse factorization
+/// (see ChSkylineMatrix). The eigenvalues closest to the shift converge first: with a shift below the
+/// lowest eigenvalue (e.g. sigma = 0 for a constrained structure), the solver returns the lowest modes.
+/// The Lanczos vectors are fully reorthogonalized, so the method is robust but needs to store all of
+/// them; the size of the subspace is bounded (see SetMaxSubspaceSize()).
+class ChApi ChLanczosEigenSolver {
+  public:
+    /// Linear operator y = Op(x).
+    typedef std::function<void(const ChVectorDynamic<>& x, ChVectorDynamic<>& y)> Operator;
+
+    ChLanczosEigenSolver() : m_tolerance(1e-8), m_max_subspace(0), m_iterations(0) {}
+
+    /// Set the relative tolerance on the residuals of the eigenpairs (default: 1e-8).
+    void SetTolerance(double tol) { m_tolerance = tol; }
+
+    /// Set the maximum number of Lanczos vectors (default: 0, i.e. max(3*nev, nev+50)).
+    void SetMaxSubspaceSize(int size) { m_max_subspace = size; }
+
+    /// Compute the 'nev' eigenpairs of the problem of size 'n' with eigenvalues closest to 'sigma'.
+    /// Eigenvalues are returned in ascending order, the corresponding eigenvectors (M-orthonormal) in the
+    /// columns of 'eigenvectors' (n x nev). Returns the number of eigenpairs which met the tolerance; if it
+    /// is less than nev, the remaining ones are only approximations.
+    int Solve(int n,                              ///< size of the problem
+              Operator solve_shifted,             ///< y = (K - sigma*M)^-1 * x
+              Operator multiply_M,                ///< y = M * x
+              double sigma,                       ///< shift
+              int nev,                            ///< number of requested eigenpairs
+              ChVectorDynamic<>& eigenvalues,     ///< output eigenvalues
+              ChMatrixDynamic<>& eigenvectors     ///< output eigenvectors, in columns
+              );
+
+    /// Number of Lanczos iterations performed in the last call to Solve().
+    int GetNumIterations() const { return m_iterations; }
+
+  private:
+    double m_tolerance;
+    int m_max_subspace;
+    int m_iterations;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -872,6 +872,88 @@ class ChLinearAlgebra {
         SVD(A, U, W, V, cond);
         return cond;
     }
+
+    /// Computes eigenvalues and eigenvectors of the symmetric matrix A, with the cyclic Jacobi method.
+    /// Eigenvalues are returned in d (a column vector) in ascending order, the corresponding eigenvectors
+    /// in the columns of V; both are resized if needed. A is not modified.
+    /// Returns the number of sweeps, or -1 if the method did not converge.
+    /// Meant for small matrices (up to a few hundred rows).
+    static int SymmetricEigen(const ChMatrix<>& A, ChMatrix<>& V, ChMatrix<>& d, int max_sweeps = 100) {
+        int n = A.GetRows();
+        ChMatrixDynamic<> B(n, n);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                B(i, j) = 0.5 * (A(i, j) + A(j, i));
+        V.Reset(n, n);
+        for (int i = 0; i < n; i++)
+            V(i, i) = 1;
+
+        int sweeps = -1;
+        for (int sweep = 0; sweep < max_sweeps; sweep++) {
+            double off = 0;
+            double diag = 0;
+            for (int i = 0; i < n; i++) {
+                diag += B(i, i) * B(i, i);
+                for (int j = i + 1; j < n; j++)
+                    off += B(i, j) * B(i, j);
+            }
+            if (off <= 1e-30 * diag || off == 0) {
+                sweeps = sweep;
+                break;
+            }
+            for (int p = 0; p < n - 1; p++) {
+                for (int q = p + 1; q < n; q++) {
+                    if (B(p, q) == 0)
+                        continue;
+                    // Rotation which zeroes B(p,q).
+                    double theta = (B(q, q) - B(p, p)) / (2 * B(p, q));
+                    double t = ch_sign(1.0, theta) / (fabs(theta) + sqrt(theta * theta + 1));
+                    double c = 1 / sqrt(t * t + 1);
+                    double s = t * c;
+                    for (int k = 0; k < n; k++) {
+                        double bkp = B(k, p);
+                        double bkq = B(k, q);
+                        B(k, p) = c * bkp - s * bkq;
+                        B(k, q) = s * bkp + c * bkq;
+                    }
+                    for (int k = 0; k < n; k++) {
+                        double bpk = B(p, k);
+                        double bqk = B(q, k);
+                        B(p, k) = c * bpk - s * bqk;
+                        B(q, k) = s * bpk + c * bqk;
+                    }
+                    for (int k = 0; k < n; k++) {
+                        double vkp = V(k, p);
+                        double vkq = V(k, q);
+                        V(k, p) = c * vkp - s * vkq;
+                        V(k, q) = s * vkp + c * vkq;
+                    }
+                }
+            }
+        }
+
+        // Sort eigenpairs by increasing eigenvalue (selection sort, swapping columns of V).
+        d.Reset(n, 1);
+        for (int i = 0; i < n; i++)
+            d(i) = B(i, i);
+        for (int i = 0; i < n - 1; i++) {
+            int imin = i;
+            for (int j = i + 1; j < n; j++)
+                if (d(j) < d(imin))
+                    imin = j;
+            if (imin != i) {
+                double tmp = d(i);
+                d(i) = d(imin);
+                d(imin) = tmp;
+                for (int k = 0; k < n; k++) {
+                    tmp = V(k, i);
+                    V(k, i) = V(k, imin);
+                    V(k, imin) = tmp;
+                }
+            }
+        }
+        return sweeps;
+    }
 };
 
 }  // end namespace chrono
@@ -60,6 +60,7 @@ void SetLogDefault() {
 ChLog::ChLog() {
     default_level = CHMESSAGE;
     current_level = CHMESSAGE;
+    max_level = CHSTATUS;
 }
 
 ChLog& ChLog::operator-(eChLogLevel mnewlev) {
@@ -14,6 +14,7 @@
 #ifndef CHLOG_H
 #define CHLOG_H
 
+#include <atomic>
 #include <cassert>
 
 #include "chrono/core/ChStream.h"
@@ -36,8 +37,9 @@ class ChApi ChLog : public ChStreamOutAscii {
     enum eChLogLevel { CHERROR = 0, CHWARNING, CHMESSAGE, CHSTATUS, CHQUIET };
 
   protected:
-    eChLogLevel current_level;
-    eChLogLevel default_level;
+    std::atomic<int> current_level;  ///< atomic, since loggers may be shared by several threads
+    std::atomic<int> default_level;
+    std::atomic<int> max_level;
 
     /// Creates the ChLog, and sets the level at MESSAGE
     ChLog();
@@ -50,16 +52,31 @@ class ChApi ChLog : public ChStreamOutAscii {
     virtual void Flush() { RestoreDefaultLevel(); };
 
     /// Sets the default level, to be used from now on.
-    void SetDefaultLevel(eChLogLevel mlev) { default_level = mlev; };
+    void SetDefaultLevel(eChLogLevel mlev) { default_level.store(mlev, std::memory_order_relaxed); };
 
     /// Sets the current level, to be used until new flushing.
-    void SetCurrentLevel(eChLogLevel mlev) { current_level = mlev; };
+    void SetCurrentLevel(eChLogLevel mlev) { current_level.store(mlev, std::memory_order_relaxed); };
 
     /// Gets the current level
-    eChLogLevel GetCurrentLevel() { return current_level; };
+    eChLogLevel GetCurrentLevel() { return (eChLogLevel)current_level.load(std::memory_order_relaxed); };
 
     /// Restore the default level.
-    void RestoreDefaultLevel() { current_level = default_level; };
+    void RestoreDefaultLevel() {
+        current_level.store(default_level.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    };
+
+    /// Sets the least severe level of messages that are output (default: CHSTATUS, i.e. all messages).
+    /// Messages written through the CH_LOG macro with a less severe level are discarded before
+    /// their arguments are evaluated and formatted.
+    void SetMaxLevel(eChLogLevel mlev) { max_level.store(mlev, std::memory_order_relaxed); }
+
+    /// Gets the least severe level of messages that are output.
+    eChLogLevel GetMaxLevel() const { return (eChLogLevel)max_level.load(std::memory_order_relaxed); }
+
+    /// Tells if messages with the given level are output.
+    bool IsEnabled(eChLogLevel mlev) const {
+        return mlev != CHQUIET && mlev <= max_level.load(std::memory_order_relaxed);
+    }
 
     /// Using the - operator is easy to set the status of the
     /// log, so in you code you can write, for example:
@@ -87,7 +104,7 @@ class ChApi ChLogConsole : public ChLog, public ChStreamOstreamWrapper {
 
     /// Redirect output stream to file wrapper.
     virtual void Output(const char* data, size_t n) {
-        if (current_level != CHQUIET)
+        if (GetCurrentLevel() != CHQUIET)
             ChStreamOstreamWrapper::Write(data, n);
     }
 
@@ -114,6 +131,17 @@ ChApi void SetLog(ChLog& new_logobject);
 /// Global function to set the default ChLogConsole output to std::output.
 ChApi void SetLogDefault();
 
+/// Write to the global log only if messages of the specified level are enabled (see ChLog::SetMaxLevel).
+/// The rest of the expression is not evaluated otherwise, so no time is spent formatting. The message is
+/// written with the specified level as current level, as with GetLog() - level. Example:
+///
+///   CH_LOG(ChLog::CHSTATUS) << "iteration " << it << "  residual " << res << "\n";
+///
+#define CH_LOG(level)                               \
+    if (!chrono::GetLog().IsEnabled(level)) {       \
+    } else                                          \
+        chrono::GetLog() - (level)
+
 }  // end namespace chrono
 
 #endif
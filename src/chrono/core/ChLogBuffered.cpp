@@ -0,0 +1,171 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+
+#include "chrono/core/ChLogBuffered.h"
+
+namespace chrono {
+
+static std::atomic<uint64_t> log_buffered_counter(0);
+
+ChLogBuffered::ChLogBuffered(std::ostream& stream, size_t ring_size, int flush_interval_ms)
+    : m_stream(&stream),
+      m_ring_size(std::max(ring_size, (size_t)256)),
+      m_interval(std::max(flush_interval_ms, 1)),
+      m_id(++log_buffered_counter),
+      m_stop(false),
+      m_wake(false),
+      m_num_blocked(0) {
+    m_thread = std::thread(&ChLogBuffered::Process, this);
+}
+
+ChLogBuffered::~ChLogBuffered() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_cv.notify_one();
+    }
+    m_thread.join();
+
+    // Output what is left, including incomplete lines.
+    Drain();
+    for (auto& ring : m_rings) {
+        if (!ring->pending.empty())
+            m_stream->write(ring->pending.data(), ring->pending.size());
+    }
+    m_stream->flush();
+}
+
+ChLogBuffered::Ring& ChLogBuffered::GetThreadRing() {
+    // Ring buffers of the calling thread, for each logger it wrote to.
+    static thread_local std::unordered_map<uint64_t, Ring*> thread_rings;
+
+    auto found = thread_rings.find(m_id);
+    if (found != thread_rings.end())
+        return *found->second;
+
+    std::lock_guard<std::mutex> lock(m_rings_mutex);
+    m_rings.emplace_back(new Ring(m_ring_size));
+    Ring* ring = m_rings.back().get();
+    thread_rings[m_id] = ring;
+    return *ring;
+}
+
+void ChLogBuffered::Push(Ring& ring, const char* data, size_t n) {
+    size_t size = ring.data.size();
+    while (n > 0) {
+        size_t head = ring.head.load(std::memory_order_relaxed);
+        size_t needed = std::min(n, size);
+        auto space_left = [&]() { return size - (head - ring.tail.load(std::memory_order_acquire)); };
+        if (space_left() < needed) {
+            // Not enough room for the whole text (a line is split only if longer than the ring).
+            // Wake up the flusher and wait until it drained the ring.
+            m_num_blocked.fetch_add(1, std::memory_order_relaxed);
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake = true;
+            m_cv.notify_one();
+            m_cv_space.wait(lock, [&]() { return space_left() >= needed || m_stop; });
+            if (space_left() < needed) {
+                // The background thread stopped.
+                lock.unlock();
+                Drain();
+            }
+        }
+        size_t space = space_left();
+        size_t chunk = std::min(n, space);
+        size_t pos = head % size;
+        size_t first = std::min(chunk, size - pos);
+        std::memcpy(&ring.data[pos], data, first);
+        std::memcpy(&ring.data[0], data + first, chunk - first);
+        ring.head.store(head + chunk, std::memory_order_release);
+        data += chunk;
+        n -= chunk;
+    }
+}
+
+void ChLogBuffered::Output(const char* data, size_t n) {
+    if (GetCurrentLevel() == CHQUIET)
+        return;
+
+    Ring& ring = GetThreadRing();
+    ring.pending.append(data, n);
+
+    // Publish only complete lines (unless the line is very long).
+    size_t eol = ring.pending.rfind('\n');
+    if (eol != std::string::npos) {
+        Push(ring, ring.pending.data(), eol + 1);
+        ring.pending.erase(0, eol + 1);
+    } else if (ring.pending.size() >= m_ring_size / 2) {
+        Push(ring, ring.pending.data(), ring.pending.size());
+        ring.pending.clear();
+    }
+}
+
+void ChLogBuffered::Drain() {
+    std::lock_guard<std::mutex> drain_lock(m_drain_mutex);
+
+    std::vector<Ring*> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_rings_mutex);
+        for (auto& ring : m_rings)
+            rings.push_back(ring.get());
+    }
+
+    for (auto ring : rings) {
+        size_t size = ring->data.size();
+        size_t head = ring->head.load(std::memory_order_acquire);
+        size_t tail = ring->tail.load(std::memory_order_relaxed);
+        while (tail < head) {
+            size_t pos = tail % size;
+            size_t chunk = std::min(head - tail, size - pos);
+            m_stream->write(&ring->data[pos], chunk);
+            tail += chunk;
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+    // Wake up the threads waiting for room in their ring buffer. The lock orders this notification after
+    // their check of the available space.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cv_space.notify_all();
+}
+
+void ChLogBuffered::Process() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop) {
+        m_cv.wait_for(lock, std::chrono::milliseconds(m_interval), [this]() { return m_stop || m_wake; });
+        m_wake = false;
+        lock.unlock();
+        Drain();
+        lock.lock();
+    }
+}
+
+void ChLogBuffered::Flush() {
+    Ring& ring = GetThreadRing();
+    if (!ring.pending.empty()) {
+        Push(ring, ring.pending.data(), ring.pending.size());
+        ring.pending.clear();
+    }
+    Drain();
+    {
+        std::lock_guard<std::mutex> drain_lock(m_drain_mutex);
+        m_stream->flush();
+    }
+    RestoreDefaultLevel();
+}
+
+}  // end namespace chrono
@@ -0,0 +1,103 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHLOGBUFFERED_H
+#define CHLOGBUFFERED_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChLog.h"
+
+namespace chrono {
+
+/// Logger for multithreaded runs.
+/// The text written by each thread is collected in a private line buffer and, one complete line
+/// at a time, copied into a lock-free ring buffer owned by that thread. A background thread drains
+/// all the ring buffers into the output stream, so that logging threads never wait for I/O nor
+/// for each other (a lock is taken only once per thread, at its first message, and a thread blocks
+/// only if its ring buffer is full, until the background thread drained it). Lines written by one
+/// thread keep their order; lines of different threads are interleaved at line boundaries.
+///
+/// Usage:
+///   ChLogBuffered mylog;
+///   SetLog(mylog);
+///   ...
+///   CH_LOG(ChLog::CHSTATUS) << "residual " << res << "\n";
+///   ...
+///   SetLogDefault();
+class ChApi ChLogBuffered : public ChLog {
+  public:
+    /// Create the logger and start the background thread.
+    ChLogBuffered(std::ostream& stream = std::cout,  ///< output stream
+                  size_t ring_size = 65536,          ///< size (in bytes) of the ring buffer of each thread
+                  int flush_interval_ms = 20         ///< period of the background flusher
+                  );
+
+    /// Output all pending text and stop the background thread.
+    /// No other thread may be writing to the log at this time.
+    virtual ~ChLogBuffered();
+
+    /// Output all the text published so far (including the incomplete line of the calling thread)
+    /// and wait until it is written to the output stream. Also restores the default level.
+    virtual void Flush() override;
+
+    /// Return the number of times a thread had to wait because its ring buffer was full.
+    uint64_t GetNumBlocked() const { return m_num_blocked.load(std::memory_order_relaxed); }
+
+  protected:
+    virtual void Output(const char* data, size_t n) override;
+
+  private:
+    /// Single-producer single-consumer ring buffer of one thread.
+    struct Ring {
+        Ring(size_t size) : data(size), head(0), tail(0) {}
+        std::vector<char> data;
+        std::atomic<size_t> head;  ///< total number of bytes written (by the owning thread)
+        std::atomic<size_t> tail;  ///< total number of bytes read (by the flusher)
+        std::string pending;       ///< incomplete line (accessed only by the owning thread)
+    };
+
+    Ring& GetThreadRing();
+    void Push(Ring& ring, const char* data, size_t n);
+    void Drain();
+    void Process();
+
+    std::ostream* m_stream;
+    size_t m_ring_size;
+    int m_interval;
+    uint64_t m_id;  ///< unique identifier of this logger (key of the thread-local ring buffers)
+
+    std::mutex m_rings_mutex;  ///< protects the list of ring buffers
+    std::vector<std::unique_ptr<Ring>> m_rings;
+
+    std::mutex m_drain_mutex;  ///< only one consumer at a time
+    std::mutex m_mutex;                  ///< protects m_stop and m_wake
+    std::condition_variable m_cv;        ///< wakes up the background thread
+    std::condition_variable m_cv_space;  ///< signaled after the ring buffers were drained
+    bool m_stop;
+    bool m_wake;  ///< a thread waits for room in its ring buffer
+    std::thread m_thread;
+
+    std::atomic<uint64_t> m_num_blocked;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,62 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHMAPPEDFILE_H
+#define CHMAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+
+/// Read-only memory mapping of a file.
+/// The content of the file is accessed through a pointer to the mapped memory; the operating
+/// system pages in only the parts of the file which are actually touched.
+class ChApi ChMappedFile {
+  public:
+    ChMappedFile();
+
+    /// Create the object and map the specified file (check IsOpen() for success).
+    explicit ChMappedFile(const std::string& filename);
+
+    ~ChMappedFile();
+
+    /// Map the specified file, unmapping any previously mapped one.
+    /// Return false if the file cannot be opened or mapped.
+    bool Open(const std::string& filename);
+
+    /// Unmap the file.
+    void Close();
+
+    /// Return true if a file is currently mapped.
+    bool IsOpen() const { return m_data != nullptr; }
+
+    /// Return a pointer to the beginning of the mapped file.
+    const char* GetData() const { return m_data; }
+
+    /// Return the size (in bytes) of the mapped file.
+    size_t GetSize() const { return m_size; }
+
+  private:
+    ChMappedFile(const ChMappedFile&) = delete;
+    ChMappedFile& operator=(const ChMappedFile&) = delete;
+
+    const char* m_data;
+    size_t m_size;
+    void* m_handle;  ///< file mapping handle (Windows only)
+};
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,209 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/core/ChSkylineMatrix.h"
+
+namespace chrono {
+
+void ChSkylineMatrix::Reset(const std::vector<int>& first_column) {
+    int n = (int)first_column.size();
+    m_first_column = first_column;
+    m_row_start.resize(n + 1);
+    m_row_start[0] = 0;
+    for (int i = 0; i < n; i++)
+        m_row_start[i + 1] = m_row_start[i] + (i - first_column[i] + 1);
+    m_values.assign(m_row_start[n], 0.0);
+    m_factorized = false;
+    m_num_negative = 0;
+}
+
+double ChSkylineMatrix::GetElement(int row, int col) const {
+    if (col > row)
+        std::swap(row, col);
+    if (col < m_first_column[row])
+        return 0;
+    return m_values[m_row_start[row] + col - m_first_column[row]];
+}
+
+void ChSkylineMatrix::Multiply(const ChMatrix<>& x, ChMatrix<>& y) const {
+    int n = GetRows();
+    y.Reset(n, 1);
+    for (int i = 0; i < n; i++) {
+        const double* row = &m_values[m_row_start[i]] - m_first_column[i];
+        double sum = 0;
+        for (int j = m_first_column[i]; j < i; j++) {
+            sum += row[j] * x(j);
+            y(j) += row[j] * x(i);
+        }
+        y(i) += sum + row[i] * x(i);
+    }
+}
+
+bool ChSkylineMatrix::Factorize() {
+    int n = GetRows();
+    m_num_negative = 0;
+    for (int i = 0; i < n; i++) {
+        int fi = m_first_column[i];
+        double* row_i = &m_values[m_row_start[i]] - fi;
+        double diagonal = std::abs(row_i[i]);
+
+        // Off-diagonal entries, first scaled by the pivots: g(i,j) = a(i,j) - sum_k g(i,k) * l(j,k).
+        for (int j = fi; j < i; j++) {
+            int fj = m_first_column[j];
+            const double* row_j = &m_values[m_row_start[j]] - fj;
+            double sum = row_i[j];
+            for (int k = std::max(fi, fj); k < j; k++)
+                sum -= row_i[k] * row_j[k];
+            row_i[j] = sum;
+        }
+
+        // Then l(i,j) = g(i,j) / d(j), and d(i) = a(i,i) - sum_j l(i,j) * g(i,j).
+        double d = row_i[i];
+        for (int j = fi; j < i; j++) {
+            double l = row_i[j] / m_values[m_row_start[j + 1] - 1];
+            d -= l * row_i[j];
+            row_i[j] = l;
+        }
+        if (std::abs(d) <= 1e-14 * diagonal || d == 0) {
+            m_factorized = false;
+            return false;
+        }
+        if (d < 0)
+            m_num_negative++;
+        row_i[i] = d;
+    }
+    m_factorized = true;
+    return true;
+}
+
+void ChSkylineMatrix::Solve(ChMatrix<>& b) const {
+    int n = GetRows();
+    int nc = b.GetColumns();
+
+    // The columns are independent right hand sides.
+#pragma omp parallel for schedule(dynamic) if (nc > 1)
+    for (int c = 0; c < nc; c++) {
+        // L * y = b
+        for (int i = 0; i < n; i++) {
+            const double* row = &m_values[m_row_start[i]] - m_first_column[i];
+            double sum = b(i, c);
+            for (int j = m_first_column[i]; j < i; j++)
+                sum -= row[j] * b(j, c);
+            b(i, c) = sum;
+        }
+        // D * z = y
+        for (int i = 0; i < n; i++)
+            b(i, c) /= m_values[m_row_start[i + 1] - 1];
+        // L' * x = z
+        for (int i = n - 1; i >= 0; i--) {
+            const double* row = &m_values[m_row_start[i]] - m_first_column[i];
+            double bi = b(i, c);
+            if (bi != 0)
+                for (int j = m_first_column[i]; j < i; j++)
+                    b(j, c) -= row[j] * bi;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Reverse Cuthill-McKee ordering
+// -----------------------------------------------------------------------------
+
+// Breadth-first traversal of the component of 'start' in the node graph, visiting the neighbors of each node
+// by increasing degree. Visited nodes are appended to 'order' and marked with 'stamp'; returns the number of
+// levels and sets 'last' to the node of minimum degree in the last level.
+static int TraverseLevels(const std::vector<std::vector<int>>& adjacency,
+                          int start,
+                          int stamp,
+                          std::vector<int>& mark,
+                          std::vector<int>& order,
+                          int& last) {
+    size_t first = order.size();
+    order.push_back(start);
+    mark[start] = stamp;
+    int levels = 0;
+    size_t level_begin = first;
+    std::vector<int> neighbors;
+    while (level_begin < order.size()) {
+        size_t level_end = order.size();
+        last = order[level_begin];
+        for (size_t i = level_begin; i < level_end; i++) {
+            int node = order[i];
+            if (adjacency[node].size() < adjacency[last].size())
+                last = node;
+            neighbors.clear();
+            for (int other : adjacency[node]) {
+                if (mark[other] != stamp) {
+                    mark[other] = stamp;
+                    neighbors.push_back(other);
+                }
+            }
+            std::stable_sort(neighbors.begin(), neighbors.end(),
+                             [&](int a, int b) { return adjacency[a].size() < adjacency[b].size(); });
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+        level_begin = level_end;
+        levels++;
+    }
+    return levels;
+}
+
+std::vector<int> ChSkylineMatrix::ReverseCuthillMcKee(const std::vector<std::vector<int>>& adjacency) {
+    int n = (int)adjacency.size();
+    std::vector<int> order;
+    std::vector<int> scratch;
+    std::vector<int> mark(n, -1);
+    std::vector<bool> done(n, false);
+    order.reserve(n);
+
+    // Start each connected component from its node of lowest degree...
+    std::vector<int> seeds(n);
+    for (int i = 0; i < n; i++)
+        seeds[i] = i;
+    std::stable_sort(seeds.begin(), seeds.end(),
+                     [&](int a, int b) { return adjacency[a].size() < adjacency[b].size(); });
+
+    int stamp = 0;
+    for (int seed : seeds) {
+        if (done[seed])
+            continue;
+
+        // ...moved to a pseudo-peripheral node, i.e. an end of a long path through the component.
+        int start = seed;
+        int last;
+        scratch.clear();
+        int levels = TraverseLevels(adjacency, start, stamp++, mark, scratch, last);
+        for (int iter = 0; iter < 8; iter++) {
+            scratch.clear();
+            int candidate;
+            int candidate_levels = TraverseLevels(adjacency, last, stamp++, mark, scratch, candidate);
+            if (candidate_levels <= levels)
+                break;
+            start = last;
+            levels = candidate_levels;
+            last = candidate;
+        }
+
+        size_t first = order.size();
+        TraverseLevels(adjacency, start, stamp++, mark, order, last);
+        for (size_t i = first; i < order.size(); i++)
+            done[order[i]] = true;
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+}  // end namespace chrono
@@ -0,0 +1,81 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSKYLINEMATRIX_H
+#define CHSKYLINEMATRIX_H
+
+#include <vector>
+
+#include "chrono/core/ChMatrixDynamic.h"
+
+namespace chrono {
+
+/// Symmetric sparse matrix in skyline (variable band) storage, with an in-place LDL' factorization.
+/// Each row i of the lower triangle is stored contiguously, from its first nonzero column to the
+/// diagonal; since the factorization does not create fill-in outside this profile, it is a simple and
+/// robust direct solver for finite element matrices, provided the unknowns are numbered so as to keep
+/// the profile small (see ReverseCuthillMcKee()). No pivoting is performed: the matrix should be
+/// positive definite, or at least have a well-conditioned LDL' factorization in the given order.
+class ChApi ChSkylineMatrix {
+  public:
+    ChSkylineMatrix() : m_factorized(false), m_num_negative(0) {}
+
+    /// Set the profile of the matrix, given the column of the first nonzero entry in each row of the
+    /// lower triangle (first_column[i] <= i). All entries are set to zero.
+    void Reset(const std::vector<int>& first_column);
+
+    /// Number of rows (and columns).
+    int GetRows() const { return (int)m_first_column.size(); }
+
+    /// Number of stored entries.
+    size_t GetProfileSize() const { return m_values.size(); }
+
+    /// Add a value to the entry (row, col). Since the matrix is symmetric, only entries of the lower triangle
+    /// should be added (entries with col > row are ignored). The entry must be inside the profile.
+    void AddElement(int row, int col, double value) {
+        if (col <= row)
+            m_values[m_row_start[row] + col - m_first_column[row]] += value;
+    }
+
+    /// Get the entry (row, col), or the corresponding factor after Factorize().
+    double GetElement(int row, int col) const;
+
+    /// Compute the product y = A * x (x and y are column vectors). Not available after Factorize().
+    void Multiply(const ChMatrix<>& x, ChMatrix<>& y) const;
+
+    /// Compute the LDL' factorization of the matrix, in place.
+    /// Return false if a pivot is zero (relative to the magnitude of the corresponding diagonal entry).
+    bool Factorize();
+
+    /// Number of negative pivots of the last factorization, which is also the number of negative eigenvalues
+    /// of the matrix (Sylvester's law of inertia).
+    int GetNumNegativePivots() const { return m_num_negative; }
+
+    /// Solve A * x = b in place, for all the columns of b, using the factorization.
+    void Solve(ChMatrix<>& b) const;
+
+    /// Compute a reverse Cuthill-McKee ordering of an undirected graph, given the adjacency list of each
+    /// vertex. Returns the old index of each vertex in the new order. This ordering keeps the bandwidth
+    /// and the profile of sparse matrices small.
+    static std::vector<int> ReverseCuthillMcKee(const std::vector<std::vector<int>>& adjacency);
+
+  private:
+    std::vector<int> m_first_column;
+    std::vector<size_t> m_row_start;
+    std::vector<double> m_values;
+    bool m_factorized;
+    int m_num_negative;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -121,6 +121,8 @@ public:
         /// - It recomputes the jacobian(s) K,R,M in case of stiff load 
         /// Q and jacobians assumed evaluated at the current state.
         /// Jacobian structures are automatically allocated if needed.
+        /// Note: in a ChLoadContainer with parallel update enabled, this (and KRMmatricesLoad) is called
+        /// concurrently for different loads, so it must not modify data shared with other loads.
     virtual void Update(){
             // current state speed & position
         ChState      mstate_x(this->LoadGet_ndof_x(),0); 
@@ -154,6 +156,12 @@ public:
         ///   R += forces * c
     virtual void LoadIntLoadResidual_F(ChVectorDynamic<>& R, const double c) =0;
 
+        /// Get the generalized load Q computed by the last Update() and, for each of its entries, the row
+        /// of the global vector R where LoadIntLoadResidual_F() adds it (-1 if not added). This allows a
+        /// ChLoadContainer to add the loads to R in parallel. Loads that do not store their generalized
+        /// forces in a single vector return null, as by default, and are added with LoadIntLoadResidual_F().
+    virtual const ChVectorDynamic<>* LoadGetResidualRows(std::vector<int>& rows) { return nullptr; }
+
         /// Tell to a system descriptor that there are item(s) of type
         /// ChKblock in this object (for further passing it to a solver)
         /// Basically does nothing, but inherited classes must specialize this.
@@ -273,6 +281,16 @@ public:
         }
     };
 
+    virtual const ChVectorDynamic<>* LoadGetResidualRows(std::vector<int>& rows) override {
+        rows.clear();
+        for (int i =0; i< this->loader.GetLoadable()->GetSubBlocks(); ++i) {
+            unsigned int moffset = this->loader.GetLoadable()->GetSubBlockOffset(i);
+            for (unsigned int row =0; row< this->loader.GetLoadable()->GetSubBlockSize(i); ++row)
+                rows.push_back(row + moffset);
+        }
+        return &this->loader.Q;
+    }
+
         /// Default: load is stiff if the loader is stiff. Override if needed.
     virtual bool IsStiff() {
         return loader.IsStiff();
@@ -389,6 +407,16 @@ public:
         }
     };
 
+    virtual const ChVectorDynamic<>* LoadGetResidualRows(std::vector<int>& rows) override {
+        rows.clear();
+        for (int i =0; i< this->loadable->GetSubBlocks(); ++i) {
+            unsigned int moffset = this->loadable->GetSubBlockOffset(i);
+            for (unsigned int row =0; row< this->loadable->GetSubBlockSize(i); ++row)
+                rows.push_back(row + moffset);
+        }
+        return &this->load_Q;
+    }
+
         /// Return true if stiff load. 
         /// MUST BE LOAD BY CHILDREN CLASSES!!!
     virtual bool IsStiff() = 0;
@@ -567,6 +595,20 @@ public:
        //GetLog() << " debug: R=" << R << "\n";
     };
 
+    virtual const ChVectorDynamic<>* LoadGetResidualRows(std::vector<int>& rows) override {
+        rows.clear();
+        for (int k= 0; k<loadables.size(); ++k) {
+            std::vector<ChVariables*> kvars;
+            loadables[k]->LoadableGetVariables(kvars);
+            for (int i =0; i< loadables[k]->GetSubBlocks(); ++i) {
+                unsigned int mblockoffset = loadables[k]->GetSubBlockOffset(i);
+                for (unsigned int row =0; row< loadables[k]->GetSubBlockSize(i); ++row)
+                    rows.push_back(kvars[i]->IsActive() ? (int)(row + mblockoffset) : -1);
+            }
+        }
+        return &this->load_Q;
+    }
+
         /// Return true if stiff load. 
         /// MUST BE LOAD BY CHILDREN CLASSES!!!
     virtual bool IsStiff() = 0;
@@ -12,6 +12,8 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/physics/ChLoadContainer.h"
 
 namespace chrono {
@@ -21,6 +23,8 @@ CH_FACTORY_REGISTER(ChLoadContainer)
 
 ChLoadContainer::ChLoadContainer(const ChLoadContainer& other) : ChPhysicsItem(other) {
     loadlist = other.loadlist;
+    residual_tables_valid = false;
+    parallel = other.parallel;
 }
 
 void ChLoadContainer::Add(std::shared_ptr<ChLoadBase> newload) {
@@ -30,10 +34,26 @@ void ChLoadContainer::Add(std::shared_ptr<ChLoadBase> newload) {
     //assert(std::find<std::vector<std::shared_ptr<ChLoadBase>>::iterator>(loadlist.begin(), loadlist.end(), newload)
     ///== loadlist.end());
     loadlist.push_back(newload);
+    residual_tables_valid = false;
+}
+
+void ChLoadContainer::ClearLoads() {
+    loadlist.clear();
+
+    // The tables refer to the removed loads.
+    residual_tables_valid = false;
+    residual_Q.clear();
+    residual_load_rows.clear();
+    residual_rows.clear();
+    residual_row_start.clear();
+    residual_contributions.clear();
+    residual_other_loads.clear();
 }
 
 void ChLoadContainer::Update(double mytime, bool update_assets) {
-    for (size_t i = 0; i < loadlist.size(); ++i) {
+    // Each load computes its own generalized forces and jacobians.
+#pragma omp parallel for schedule(dynamic, 4) if (parallel)
+    for (int i = 0; i < (int)loadlist.size(); ++i) {
         loadlist[i]->Update();
     }
     // Overloading of base class:
@@ -44,9 +64,90 @@ void ChLoadContainer::IntLoadResidual_F(const unsigned int off,  // offset in R
                                         ChVectorDynamic<>& R,    // result: the R residual, R += c*F
                                         const double c           // a scaling factor
                                         ) {
-    for (size_t i = 0; i < loadlist.size(); ++i) {
-        loadlist[i]->LoadIntLoadResidual_F(R, c);
+    if (!residual_tables_valid)
+        SetupResidual();
+
+    // Each row sums its contributions in the order of the loads, so that rows can be processed in parallel
+    // without races and the result does not depend on the number of threads.
+#pragma omp parallel for schedule(static)
+    for (int ir = 0; ir < (int)residual_rows.size(); ir++) {
+        double& Ri = R(residual_rows[ir]);
+        for (int ic = residual_row_start[ir]; ic < residual_row_start[ir + 1]; ic++) {
+            const ResidualContribution& contribution = residual_contributions[ic];
+            Ri += (*residual_Q[contribution.load])(contribution.entry) * c;
+        }
+    }
+
+    for (auto load : residual_other_loads) {
+        load->LoadIntLoadResidual_F(R, c);
+    }
+}
+
+void ChLoadContainer::SetupResidual() {
+    // The rows change only if the offsets of the loaded items change, which is not the case at most calls to
+    // Setup(): query them in parallel, and rebuild the tables only if needed.
+    int nloads = (int)loadlist.size();
+    std::vector<const ChVectorDynamic<>*> Q(nloads);
+    std::vector<std::vector<int> > rows(nloads);
+    bool resized = nloads != (int)residual_load_rows.size();
+    int changed = 0;
+#pragma omp parallel for schedule(dynamic, 16) reduction(+ : changed) if (parallel)
+    for (int i = 0; i < nloads; ++i) {
+        Q[i] = loadlist[i]->LoadGetResidualRows(rows[i]);
+        if (Q[i] && Q[i]->GetRows() != (int)rows[i].size())
+            Q[i] = nullptr;
+        if (resized || Q[i] != residual_Q[i] || rows[i] != residual_load_rows[i])
+            changed++;
+    }
+    residual_tables_valid = true;
+    if (!changed)
+        return;
+
+    residual_Q.swap(Q);
+    residual_load_rows.swap(rows);
+    residual_other_loads.clear();
+    int nrows = 0;
+    for (int i = 0; i < nloads; ++i) {
+        if (!residual_Q[i]) {
+            residual_other_loads.push_back(loadlist[i].get());
+            continue;
+        }
+        for (int row : residual_load_rows[i])
+            nrows = std::max(nrows, row + 1);
+    }
+
+    // Counting sort of the contributions by row; within a row, the contributions are in the order of the loads.
+    std::vector<int> count(nrows + 1, 0);
+    for (int i = 0; i < nloads; ++i) {
+        if (residual_Q[i]) {
+            for (int row : residual_load_rows[i])
+                if (row >= 0)
+                    count[row + 1]++;
+        }
+    }
+    for (int row = 0; row < nrows; row++)
+        count[row + 1] += count[row];
+    residual_contributions.resize(count[nrows]);
+    std::vector<int> next(count.begin(), count.end() - 1);
+    for (int i = 0; i < nloads; ++i) {
+        if (residual_Q[i]) {
+            for (int entry = 0; entry < (int)residual_load_rows[i].size(); entry++) {
+                int row = residual_load_rows[i][entry];
+                if (row >= 0)
+                    residual_contributions[next[row]++] = {i, entry};
+            }
+        }
     }
+
+    residual_rows.clear();
+    residual_row_start.clear();
+    for (int row = 0; row < nrows; row++) {
+        if (count[row + 1] > count[row]) {
+            residual_rows.push_back(row);
+            residual_row_start.push_back(count[row]);
+        }
+    }
+    residual_row_start.push_back(count[nrows]);
 }
 
 void ChLoadContainer::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
@@ -56,7 +157,9 @@ void ChLoadContainer::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChLoadContainer::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
-    for (size_t i = 0; i < loadlist.size(); ++i) {
+    // Each load fills its own ChKblock.
+#pragma omp parallel for schedule(dynamic, 4) if (parallel)
+    for (int i = 0; i < (int)loadlist.size(); ++i) {
         loadlist[i]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
     }
 }
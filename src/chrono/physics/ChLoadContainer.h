@@ -23,14 +23,37 @@ namespace chrono {
 /// A container of ChLoad objects. This container can be added to a ChSystem.
 /// One usually create one or more ChLoad objects acting on a ChLoadable items (ex. FEA elements),
 /// add them to this container, then  the container is added to a ChSystem.
+/// Loads which expose their generalized forces (see ChLoadBase::LoadGetResidualRows) are added to the residual
+/// in parallel; the result does not depend on the number of threads. The loads can also be updated in parallel,
+/// if they are thread-safe (see SetParallel).
 
 class ChApi ChLoadContainer : public ChPhysicsItem {
 
   private:
     std::vector<std::shared_ptr<ChLoadBase> > loadlist;
 
+    /// Contribution of one load to one row of the residual.
+    struct ResidualContribution {
+        int load;   ///< index in the list of loads
+        int entry;  ///< entry in the generalized forces of the load
+    };
+
+    // Tables for the parallel evaluation of the residual (see IntLoadResidual_F).
+    std::vector<const ChVectorDynamic<>*> residual_Q;         ///< generalized forces of each load, or null
+    std::vector<std::vector<int> > residual_load_rows;        ///< rows of the residual for each load
+    std::vector<int> residual_rows;                           ///< rows of the residual with contributions
+    std::vector<int> residual_row_start;                      ///< first contribution to each row (CSR layout)
+    std::vector<ResidualContribution> residual_contributions;  ///< contributions, grouped by row
+    std::vector<ChLoadBase*> residual_other_loads;            ///< loads added with LoadIntLoadResidual_F
+    bool residual_tables_valid;
+
+    bool parallel;  ///< update the loads and load their KRM matrices in parallel
+
+    /// Query the rows of the residual of all loads, and rebuild the tables if they changed.
+    void SetupResidual();
+
   public:
-    ChLoadContainer() {}
+    ChLoadContainer() : residual_tables_valid(false), parallel(false) {}
     ChLoadContainer(const ChLoadContainer& other);
     ~ChLoadContainer() {}
 
@@ -40,10 +63,29 @@ class ChApi ChLoadContainer : public ChPhysicsItem {
     /// Add a load to the container list of loads
     void Add(std::shared_ptr<ChLoadBase> newload);
 
+    /// Remove all loads from the container.
+    void ClearLoads();
+
     /// Direct access to the load vector, for iterating etc.
+    /// If loads are added or removed through it, call Setup() afterwards, so that the residual of removed
+    /// loads is not added anymore (Add() and ClearLoads() do it).
     std::vector<std::shared_ptr<ChLoadBase> >& GetLoadList() { return loadlist; }
 
-    virtual void Setup() override {}
+    /// Access to the load vector, for iterating etc.
+    const std::vector<std::shared_ptr<ChLoadBase> >& GetLoadList() const { return loadlist; }
+
+    /// Enable or disable the parallel update of the loads (default: false).
+    /// If enabled, ChLoadBase::Update() and ChLoadBase::KRMmatricesLoad() are called concurrently for different
+    /// loads, so they must be thread-safe: two loads must not write to shared data (e.g. a common loader, or
+    /// the state of a loaded item perturbed to compute jacobians numerically).
+    void SetParallel(bool val) { parallel = val; }
+
+    /// Return true if the loads are updated in parallel.
+    bool IsParallel() const { return parallel; }
+
+    /// Invalidate the tables used to add the loads to the residual.
+    /// Classes which override this function must call it.
+    virtual void Setup() override { residual_tables_valid = false; }
 
     virtual void Update(double mytime, bool update_assets = true) override;
 
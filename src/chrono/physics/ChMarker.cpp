@@ -318,6 +318,7 @@ void ChMarker::ArchiveOUT(ChArchiveOut& marchive) {
     marchive << CHNVP(motion_Z);
     marchive << CHNVP(motion_ang);
     marchive << CHNVP(motion_axis);
+    marchive << CHNVP(rest_coord);
 }
 
 /// Method to allow de serialization of transient data from archives.
@@ -338,6 +339,12 @@ void ChMarker::ArchiveIN(ChArchiveIn& marchive) {
     marchive >> CHNVP(motion_Z);
     marchive >> CHNVP(motion_ang);
     marchive >> CHNVP(motion_axis);
+    if (version >= 1)
+        marchive >> CHNVP(rest_coord);
+
+    last_time = ChTime;
+    last_rel_coord = coord;
+    last_rel_coord_dt = coord_dt;
 }
 
 }  // end namespace chrono
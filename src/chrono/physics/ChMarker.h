@@ -235,7 +235,7 @@ class ChApi ChMarker : public ChObj, public ChFrameMoving<double> {
     virtual void ArchiveIN(ChArchiveIn& marchive) override;
 };
 
-CH_CLASS_VERSION(ChMarker,0)
+CH_CLASS_VERSION(ChMarker,1)
 
 
 }  // end namespace chrono
@@ -0,0 +1,195 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "chrono/core/ChException.h"
+#include "chrono/physics/ChProbeReduction.h"
+
+namespace chrono {
+
+// -----------------------------------------------------------------------------
+// ChProbeStatistics
+// -----------------------------------------------------------------------------
+
+void ChProbeStatistics::Process(double time, double value) {
+    if (value < m_min) {
+        m_min = value;
+        m_time_min = time;
+    }
+    if (value > m_max) {
+        m_max = value;
+        m_time_max = time;
+    }
+    m_count++;
+    double delta = value - m_mean;
+    m_mean += delta / m_count;
+    m_m2 += delta * (value - m_mean);
+    m_sum_sq += value * value;
+}
+
+void ChProbeStatistics::Reset() {
+    m_count = 0;
+    m_min = std::numeric_limits<double>::max();
+    m_max = -std::numeric_limits<double>::max();
+    m_time_min = 0;
+    m_time_max = 0;
+    m_mean = 0;
+    m_m2 = 0;
+    m_sum_sq = 0;
+}
+
+double ChProbeStatistics::GetRMS() const {
+    return m_count > 0 ? std::sqrt(m_sum_sq / m_count) : 0;
+}
+
+double ChProbeStatistics::GetVariance() const {
+    return m_count > 1 ? m_m2 / (m_count - 1) : 0;
+}
+
+double ChProbeStatistics::GetStdDev() const {
+    return std::sqrt(GetVariance());
+}
+
+// -----------------------------------------------------------------------------
+// ChProbeDecimator
+// -----------------------------------------------------------------------------
+
+ChProbeDecimator::ChProbeDecimator(size_t max_points, unsigned int decimation)
+    : m_max_points(std::max(max_points, (size_t)2)), m_initial_decimation(std::max(decimation, 1u)) {
+    Reset();
+}
+
+ChProbeDecimator::ChProbeDecimator(std::function<double()> signal, size_t max_points, unsigned int decimation)
+    : ChProbeSignal(signal),
+      m_max_points(std::max(max_points, (size_t)2)),
+      m_initial_decimation(std::max(decimation, 1u)) {
+    Reset();
+}
+
+void ChProbeDecimator::Process(double time, double value) {
+    if (m_counter++ % m_decimation != 0)
+        return;
+
+    if (m_times.size() == m_max_points) {
+        // Keep the samples at even positions; these are also the ones the doubled decimation keeps.
+        size_t n = (m_times.size() + 1) / 2;
+        for (size_t i = 1; i < n; ++i) {
+            m_times[i] = m_times[2 * i];
+            m_values[i] = m_values[2 * i];
+        }
+        m_times.resize(n);
+        m_values.resize(n);
+        m_decimation *= 2;
+        // The current sample is at an odd position of the previous sequence.
+        if ((m_counter - 1) % m_decimation != 0)
+            return;
+    }
+
+    m_times.push_back(time);
+    m_values.push_back(value);
+}
+
+void ChProbeDecimator::Reset() {
+    m_decimation = m_initial_decimation;
+    m_counter = 0;
+    m_times.clear();
+    m_values.clear();
+    m_times.reserve(m_max_points);
+    m_values.reserve(m_max_points);
+}
+
+double ChProbeDecimator::GetValue(double time) const {
+    if (m_times.empty())
+        return 0;
+    if (time <= m_times.front())
+        return m_values.front();
+    if (time >= m_times.back())
+        return m_values.back();
+    size_t i = std::upper_bound(m_times.begin(), m_times.end(), time) - m_times.begin();
+    double t0 = m_times[i - 1];
+    double t1 = m_times[i];
+    double w = (t1 > t0) ? (time - t0) / (t1 - t0) : 0;
+    return (1 - w) * m_values[i - 1] + w * m_values[i];
+}
+
+// -----------------------------------------------------------------------------
+// ChProbeHistogram
+// -----------------------------------------------------------------------------
+
+// Check the range of a histogram (also rejects NaN bounds).
+static void CheckHistogramRange(double min, double max) {
+    if (!(max > min) || !std::isfinite(max - min))
+        throw ChException("ChProbeHistogram: invalid range, max must be greater than min");
+}
+
+ChProbeHistogram::ChProbeHistogram(double min, double max, int num_bins)
+    : m_min(min), m_width((max - min) / std::max(num_bins, 1)), m_counts(std::max(num_bins, 1)) {
+    CheckHistogramRange(min, max);
+    Reset();
+}
+
+ChProbeHistogram::ChProbeHistogram(std::function<double()> signal, double min, double max, int num_bins)
+    : ChProbeSignal(signal), m_min(min), m_width((max - min) / std::max(num_bins, 1)), m_counts(std::max(num_bins, 1)) {
+    CheckHistogramRange(min, max);
+    Reset();
+}
+
+void ChProbeHistogram::Process(double time, double value) {
+    double x = (value - m_min) / m_width;
+    if (std::isnan(x))
+        m_nan++;
+    else if (x < 0)
+        m_underflow++;
+    else if (x >= m_counts.size())
+        m_overflow++;
+    else
+        m_counts[(size_t)x]++;
+}
+
+void ChProbeHistogram::Reset() {
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    m_underflow = 0;
+    m_overflow = 0;
+    m_nan = 0;
+}
+
+// -----------------------------------------------------------------------------
+// ChProbeCircularBuffer
+// -----------------------------------------------------------------------------
+
+ChProbeCircularBuffer::ChProbeCircularBuffer(size_t capacity)
+    : m_times(std::max(capacity, (size_t)1)), m_values(std::max(capacity, (size_t)1)) {
+    Reset();
+}
+
+ChProbeCircularBuffer::ChProbeCircularBuffer(std::function<double()> signal, size_t capacity)
+    : ChProbeSignal(signal), m_times(std::max(capacity, (size_t)1)), m_values(std::max(capacity, (size_t)1)) {
+    Reset();
+}
+
+void ChProbeCircularBuffer::Process(double time, double value) {
+    m_times[m_head] = time;
+    m_values[m_head] = value;
+    m_head = (m_head + 1) % m_times.size();
+    if (m_size < m_times.size())
+        m_size++;
+}
+
+void ChProbeCircularBuffer::Reset() {
+    m_head = 0;
+    m_size = 0;
+}
+
+}  // end namespace chrono
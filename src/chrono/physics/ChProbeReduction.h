@@ -0,0 +1,188 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHPROBEREDUCTION_H
+#define CHPROBEREDUCTION_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "chrono/physics/ChProbe.h"
+
+namespace chrono {
+
+/// Base class for probes which reduce a scalar signal on the fly.
+/// The signal is a function evaluated at each call to Record(), i.e. at the end of each time step
+/// when the probe is added to a system with ChSystem::AddProbe(). All derived probes have a constant
+/// cost per step and store their data in contiguous arrays of bounded size, so that they can be
+/// kept alive over arbitrarily long simulations.
+///
+/// Example:
+///   auto probe = std::make_shared<ChProbeStatistics>([&]() { return body->GetPos_dt().Length(); });
+///   system.AddProbe(probe);
+class ChApi ChProbeSignal : public ChProbe {
+  public:
+    ChProbeSignal() {}
+    ChProbeSignal(std::function<double()> signal) : m_signal(signal) {}
+
+    /// Set the function providing the recorded value.
+    void SetSignal(std::function<double()> signal) { m_signal = signal; }
+
+    /// Evaluate the signal and process its value.
+    virtual void Record(double mtime) override {
+        if (m_signal)
+            Process(mtime, m_signal());
+    }
+
+    /// Process a value of the signal, at the given time.
+    /// May be called directly, to feed values not provided by a signal function.
+    virtual void Process(double time, double value) = 0;
+
+  protected:
+    std::function<double()> m_signal;
+};
+
+/// Probe computing running statistics of a signal: minimum, maximum (with the times at which they
+/// occurred), mean, root mean square and variance. Mean and variance are updated with Welford's
+/// algorithm, which is numerically stable over very long runs.
+class ChApi ChProbeStatistics : public ChProbeSignal {
+  public:
+    ChProbeStatistics() { Reset(); }
+    ChProbeStatistics(std::function<double()> signal) : ChProbeSignal(signal) { Reset(); }
+
+    virtual ChProbeStatistics* Clone() const override { return new ChProbeStatistics(*this); }
+
+    virtual void Process(double time, double value) override;
+    virtual void Reset() override;
+
+    uint64_t GetCount() const { return m_count; }
+    double GetMin() const { return m_min; }
+    double GetMax() const { return m_max; }
+    double GetTimeMin() const { return m_time_min; }
+    double GetTimeMax() const { return m_time_max; }
+    double GetMean() const { return m_mean; }
+    double GetRMS() const;
+    double GetVariance() const;
+    double GetStdDev() const;
+
+  private:
+    uint64_t m_count;
+    double m_min;
+    double m_max;
+    double m_time_min;
+    double m_time_max;
+    double m_mean;
+    double m_m2;       ///< sum of squared deviations from the mean
+    double m_sum_sq;   ///< sum of squared values
+};
+
+/// Probe recording a decimated history of a signal, with bounded memory.
+/// One sample out of every N is stored. When the storage is full, every other stored sample is
+/// discarded and N is doubled, so that the recorded history always spans the whole simulation with
+/// at most the given number of points (amortized constant cost per step). Samples are kept in
+/// contiguous arrays sorted by time, so that interpolation uses a binary search.
+class ChApi ChProbeDecimator : public ChProbeSignal {
+  public:
+    ChProbeDecimator(size_t max_points = 4096, unsigned int decimation = 1);
+    ChProbeDecimator(std::function<double()> signal, size_t max_points = 4096, unsigned int decimation = 1);
+
+    virtual ChProbeDecimator* Clone() const override { return new ChProbeDecimator(*this); }
+
+    virtual void Process(double time, double value) override;
+    virtual void Reset() override;
+
+    /// Number of stored samples.
+    size_t GetNumPoints() const { return m_times.size(); }
+
+    /// Current decimation factor (one stored sample out of this many).
+    unsigned int GetDecimation() const { return m_decimation; }
+
+    const std::vector<double>& GetTimes() const { return m_times; }
+    const std::vector<double>& GetValues() const { return m_values; }
+
+    /// Return the value at the given time, interpolating linearly between stored samples
+    /// (clamped at the ends of the recorded interval). Returns 0 if no samples are stored.
+    double GetValue(double time) const;
+
+  private:
+    size_t m_max_points;
+    unsigned int m_initial_decimation;
+    unsigned int m_decimation;
+    uint64_t m_counter;
+    std::vector<double> m_times;
+    std::vector<double> m_values;
+};
+
+/// Probe accumulating a histogram of the values of a signal, over uniform bins in a given range.
+/// Values outside the range, and NaN values, are counted separately.
+/// The constructors throw a ChException if max is not greater than min.
+class ChApi ChProbeHistogram : public ChProbeSignal {
+  public:
+    ChProbeHistogram(double min, double max, int num_bins);
+    ChProbeHistogram(std::function<double()> signal, double min, double max, int num_bins);
+
+    virtual ChProbeHistogram* Clone() const override { return new ChProbeHistogram(*this); }
+
+    virtual void Process(double time, double value) override;
+    virtual void Reset() override;
+
+    int GetNumBins() const { return (int)m_counts.size(); }
+    double GetBinWidth() const { return m_width; }
+    double GetBinCenter(int bin) const { return m_min + (bin + 0.5) * m_width; }
+    const std::vector<uint64_t>& GetCounts() const { return m_counts; }
+    uint64_t GetUnderflow() const { return m_underflow; }
+    uint64_t GetOverflow() const { return m_overflow; }
+    uint64_t GetNumNaN() const { return m_nan; }
+
+  private:
+    double m_min;
+    double m_width;
+    std::vector<uint64_t> m_counts;
+    uint64_t m_underflow;
+    uint64_t m_overflow;
+    uint64_t m_nan;
+};
+
+/// Probe keeping the most recent values of a signal in a fixed-size circular buffer.
+class ChApi ChProbeCircularBuffer : public ChProbeSignal {
+  public:
+    ChProbeCircularBuffer(size_t capacity);
+    ChProbeCircularBuffer(std::function<double()> signal, size_t capacity);
+
+    virtual ChProbeCircularBuffer* Clone() const override { return new ChProbeCircularBuffer(*this); }
+
+    virtual void Process(double time, double value) override;
+    virtual void Reset() override;
+
+    /// Number of stored samples (at most the capacity).
+    size_t GetNumPoints() const { return m_size; }
+    size_t GetCapacity() const { return m_times.size(); }
+
+    /// Time of the i-th stored sample, from the oldest (i = 0) to the most recent.
+    double GetTime(size_t i) const { return m_times[Index(i)]; }
+
+    /// Value of the i-th stored sample, from the oldest (i = 0) to the most recent.
+    double GetValue(size_t i) const { return m_values[Index(i)]; }
+
+  private:
+    size_t Index(size_t i) const { return (m_head + m_times.size() - m_size + i) % m_times.size(); }
+
+    std::vector<double> m_times;
+    std::vector<double> m_values;
+    size_t m_head;  ///< position of the next sample
+    size_t m_size;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -29,7 +29,9 @@
 #include "chrono/solver/ChSolverSORmultithread.h"
 #include "chrono/solver/ChSolverSymmSOR.h"
 #include "chrono/timestepper/ChStaticAnalysis.h"
+#include "chrono/core/ChLanczosEigenSolver.h"
 #include "chrono/core/ChLinkedListMatrix.h"
+#include "chrono/core/ChSkylineMatrix.h"
 #include "chrono/utils/ChProfiler.h"
 
 using namespace chrono::collision;
@@ -546,7 +548,7 @@ void ChSystem::Reference_LM_byID() {
             std::shared_ptr<ChMarker> shm1 = SearchMarker(malink->GetMarkID1());
             std::shared_ptr<ChMarker> shm2 = SearchMarker(malink->GetMarkID2());
             ChMarker* mm1 = shm1.get();
-            ChMarker* mm2 = shm1.get();
+            ChMarker* mm2 = shm2.get();
             malink->SetUpMarkers(mm1, mm2);
             if (mm1 && mm2) {
                 Lpointer->SetValid(true);
@@ -1479,6 +1481,258 @@ void ChSystem::GetConstraintJacobianMatrix(ChSparseMatrix* Cq) {
     this->GetSystemDescriptor()->ConvertToMatrixForm(Cq, nullptr, nullptr, nullptr, nullptr, nullptr, false, false);
 }
 
+// Sparse matrix in CSR format.
+struct ModalCSR {
+    std::vector<int> ia;
+    std::vector<int> ja;
+    std::vector<double> a;
+};
+
+// Sparse matrix which collects the entries loaded by the system descriptor row by row, then converts them
+// to CSR. Entries are always summed: the descriptor sets each mass and jacobian entry once, before adding
+// the stiffness blocks, so this is equivalent and much faster than a map-based matrix for large systems.
+class ModalAssemblyMatrix : public ChSparseMatrix {
+  public:
+    virtual void SetElement(int insrow, int inscol, double insval, bool overwrite = true) override {
+        if (insval != 0)
+            m_rows[insrow].push_back(std::make_pair(inscol, insval));
+    }
+    virtual double GetElement(int row, int col) const override {
+        double value = 0;
+        for (auto& entry : m_rows[row])
+            if (entry.first == col)
+                value += entry.second;
+        return value;
+    }
+    virtual void Reset(int nrows, int ncols, int nonzeros = 0) override {
+        m_num_rows = nrows;
+        m_num_cols = ncols;
+        m_rows.assign(nrows, std::vector<std::pair<int, double>>());
+    }
+    virtual bool Resize(int nrows, int ncols, int nonzeros = 0) override {
+        Reset(nrows, ncols);
+        return true;
+    }
+
+    // Sort the entries of each row, sum the duplicates and move them to 'csr'.
+    void ConvertToCSR(ModalCSR& csr) {
+#pragma omp parallel for schedule(dynamic, 256)
+        for (int r = 0; r < m_num_rows; r++) {
+            auto& row = m_rows[r];
+            std::sort(row.begin(), row.end(),
+                      [](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.first < b.first; });
+            size_t last = 0;
+            for (size_t k = 1; k < row.size(); k++) {
+                if (row[k].first == row[last].first)
+                    row[last].second += row[k].second;
+                else
+                    row[++last] = row[k];
+            }
+            if (!row.empty())
+                row.resize(last + 1);
+        }
+        csr.ia.resize(m_num_rows + 1);
+        csr.ia[0] = 0;
+        for (int r = 0; r < m_num_rows; r++)
+            csr.ia[r + 1] = csr.ia[r] + (int)m_rows[r].size();
+        csr.ja.resize(csr.ia[m_num_rows]);
+        csr.a.resize(csr.ia[m_num_rows]);
+        for (int r = 0; r < m_num_rows; r++) {
+            for (size_t k = 0; k < m_rows[r].size(); k++) {
+                csr.ja[csr.ia[r] + k] = m_rows[r][k].first;
+                csr.a[csr.ia[r] + k] = m_rows[r][k].second;
+            }
+            std::vector<std::pair<int, double>>().swap(m_rows[r]);
+        }
+    }
+
+  private:
+    std::vector<std::vector<std::pair<int, double>>> m_rows;
+};
+
+// Build the KKT matrix [K - shift*M, Cq'; Cq, -reg*I] in skyline form. The unknowns are numbered by reverse
+// Cuthill-McKee, then each constraint is moved after all the variables it acts on, so that the factorization
+// without pivoting meets nonzero pivots for the constraint rows.
+static void BuildModalKKT(const ModalCSR& K,
+                          const ModalCSR& M,
+                          const ModalCSR& Cq,
+                          int n,
+                          int m,
+                          double shift,
+                          double reg,
+                          std::vector<int>& position,
+                          ChSkylineMatrix& A) {
+    std::vector<std::vector<int>> adjacency(n + m);
+    for (int i = 0; i < n; i++) {
+        for (int k = K.ia[i]; k < K.ia[i + 1]; k++)
+            if (K.ja[k] != i)
+                adjacency[i].push_back(K.ja[k]);
+        for (int k = M.ia[i]; k < M.ia[i + 1]; k++)
+            if (M.ja[k] != i)
+                adjacency[i].push_back(M.ja[k]);
+    }
+    for (int c = 0; c < m; c++) {
+        for (int k = Cq.ia[c]; k < Cq.ia[c + 1]; k++) {
+            adjacency[n + c].push_back(Cq.ja[k]);
+            adjacency[Cq.ja[k]].push_back(n + c);
+        }
+    }
+    for (auto& neighbors : adjacency) {
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+    std::vector<int> order = ChSkylineMatrix::ReverseCuthillMcKee(adjacency);
+
+    std::vector<int> rank(n + m);
+    for (int i = 0; i < n + m; i++)
+        rank[order[i]] = i;
+    std::vector<long long> key(n + m);
+    for (int i = 0; i < n; i++)
+        key[i] = 2 * (long long)rank[i];
+    for (int c = 0; c < m; c++) {
+        long long last = -1;
+        for (int k = Cq.ia[c]; k < Cq.ia[c + 1]; k++)
+            last = std::max(last, (long long)rank[Cq.ja[k]]);
+        key[n + c] = (last < 0) ? 2 * (long long)(n + m) : 2 * last + 1;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return key[a] < key[b]; });
+    position.resize(n + m);
+    for (int i = 0; i < n + m; i++)
+        position[order[i]] = i;
+
+    // Profile, then values (lower triangle only).
+    std::vector<int> first_column(n + m);
+    for (int i = 0; i < n + m; i++)
+        first_column[position[i]] = position[i];
+    auto extend = [&](int row, int col) {
+        int r = std::max(position[row], position[col]);
+        int c = std::min(position[row], position[col]);
+        first_column[r] = std::min(first_column[r], c);
+    };
+    for (int i = 0; i < n; i++) {
+        for (int k = K.ia[i]; k < K.ia[i + 1]; k++)
+            extend(i, K.ja[k]);
+        for (int k = M.ia[i]; k < M.ia[i + 1]; k++)
+            extend(i, M.ja[k]);
+    }
+    for (int c = 0; c < m; c++)
+        for (int k = Cq.ia[c]; k < Cq.ia[c + 1]; k++)
+            extend(n + c, Cq.ja[k]);
+    A.Reset(first_column);
+
+    for (int i = 0; i < n; i++) {
+        for (int k = K.ia[i]; k < K.ia[i + 1]; k++)
+            if (position[K.ja[k]] <= position[i])
+                A.AddElement(position[i], position[K.ja[k]], K.a[k]);
+        for (int k = M.ia[i]; k < M.ia[i + 1]; k++)
+            if (position[M.ja[k]] <= position[i])
+                A.AddElement(position[i], position[M.ja[k]], -shift * M.a[k]);
+    }
+    for (int c = 0; c < m; c++) {
+        for (int k = Cq.ia[c]; k < Cq.ia[c + 1]; k++) {
+            int r = std::max(position[n + c], position[Cq.ja[k]]);
+            int col = std::min(position[n + c], position[Cq.ja[k]]);
+            A.AddElement(r, col, Cq.a[k]);
+        }
+        A.AddElement(position[n + c], position[n + c], -reg);
+    }
+}
+
+int ChSystem::ComputeModes(int num_modes,
+                           ChVectorDynamic<>& eigenvalues,
+                           ChMatrixDynamic<>& modes,
+                           double shift,
+                           double tolerance) {
+    // Assemble the matrices at the current configuration.
+    Setup();
+    Update();
+    DescriptorPrepareInject(*descriptor);
+    ConstraintsLoadJacobians();
+
+    ModalAssemblyMatrix mK;
+    ModalAssemblyMatrix mM;
+    ModalAssemblyMatrix mCq;
+    double mass_factor = descriptor->GetMassFactor();
+    KRMmatricesLoad(1.0, 0, 0);
+    descriptor->SetMassFactor(0.0);
+    descriptor->ConvertToMatrixForm(nullptr, &mK, nullptr, nullptr, nullptr, nullptr, true, false);
+    KRMmatricesLoad(0, 0, 1.0);
+    descriptor->SetMassFactor(1.0);
+    descriptor->ConvertToMatrixForm(&mCq, &mM, nullptr, nullptr, nullptr, nullptr, true, false);
+
+    // Do not leave the mass matrices in the KRM blocks for the next solver call: clear them, and restore the
+    // mass factor of the descriptor.
+    KRMmatricesLoad(0, 0, 0);
+    descriptor->SetMassFactor(mass_factor);
+
+    int n = mK.GetNumRows();
+    int m = mCq.GetNumRows();
+    if (n == 0)
+        throw ChException("ChSystem::ComputeModes: the system has no degrees of freedom.");
+    ModalCSR K, M, Cq;
+    mK.ConvertToCSR(K);
+    mM.ConvertToCSR(M);
+    mCq.ConvertToCSR(Cq);
+
+    // Scale of the problem, for the automatic shift and the regularization of the constraints.
+    double diag_K = 0;
+    double diag_M = 0;
+    for (int i = 0; i < n; i++) {
+        for (int k = K.ia[i]; k < K.ia[i + 1]; k++)
+            if (K.ja[k] == i)
+                diag_K = std::max(diag_K, std::abs(K.a[k]));
+        for (int k = M.ia[i]; k < M.ia[i + 1]; k++)
+            if (M.ja[k] == i)
+                diag_M = std::max(diag_M, std::abs(M.a[k]));
+    }
+    if (diag_M == 0)
+        throw ChException("ChSystem::ComputeModes: the mass matrix is zero.");
+
+    // Factorization of the shifted KKT matrix; if K is singular (free rigid motions) and no shift was
+    // given, retry with a small negative shift.
+    std::vector<int> position;
+    ChSkylineMatrix A;
+    bool factorized = false;
+    for (int attempt = 0; attempt < 2 && !factorized; attempt++) {
+        if (attempt == 1) {
+            if (shift != 0)
+                break;
+            shift = -1e-6 * std::max(diag_K, diag_M) / diag_M;
+        }
+        double scale = std::max(diag_K, std::abs(shift) * diag_M);
+        BuildModalKKT(K, M, Cq, n, m, shift, 1e-10 / scale, position, A);
+        factorized = A.Factorize();
+    }
+    if (!factorized)
+        throw ChException("ChSystem::ComputeModes: singular matrix, check the shift and the constraints.");
+
+    ChLanczosEigenSolver eigen_solver;
+    eigen_solver.SetTolerance(tolerance);
+    ChVectorDynamic<> rhs(n + m);
+    int converged = eigen_solver.Solve(
+        n,
+        [&](const ChVectorDynamic<>& x, ChVectorDynamic<>& y) {
+            rhs.FillElem(0);
+            for (int i = 0; i < n; i++)
+                rhs(position[i]) = x(i);
+            A.Solve(rhs);
+            for (int i = 0; i < n; i++)
+                y(i) = rhs(position[i]);
+        },
+        [&](const ChVectorDynamic<>& x, ChVectorDynamic<>& y) {
+#pragma omp parallel for schedule(static) if (n > 10000)
+            for (int i = 0; i < n; i++) {
+                double sum = 0;
+                for (int k = M.ia[i]; k < M.ia[i + 1]; k++)
+                    sum += M.a[k] * x(M.ja[k]);
+                y(i) = sum;
+            }
+        },
+        shift, num_modes, eigenvalues, modes);
+
+    return converged;
+}
+
 void ChSystem::DumpSystemMatrices(bool save_M, bool save_K, bool save_R, bool save_Cq, const char* path) {
     char filename[300];
     const char* numformat = "%.12g";
@@ -2020,6 +2274,7 @@ void ChSystem::ArchiveIN(ChArchiveIn& marchive) {
     // stream in all member data:
 
     marchive >> CHNVP(contact_container);
+    contact_container->SetSystem(this);
 
     marchive >> CHNVP(G_acc);
     marchive >> CHNVP(end_time);
@@ -2045,10 +2300,27 @@ void ChSystem::ArchiveIN(ChArchiveIn& marchive) {
     marchive >> CHNVP(max_penetration_recovery_speed);
     marchive >> CHNVP(parallel_thread_number);
 
+    // The items read above added their collision models to the current collision system: move them to the
+    // collision system read from the archive, which replaces it.
+    for (auto& body : bodylist)
+        body->RemoveCollisionModelsFromSystem();
+    for (auto& item : otherphysicslist)
+        item->RemoveCollisionModelsFromSystem();
+
     marchive >> CHNVP(collision_system);  // ChCollisionSystem should implement class factory for abstract create
 
+    for (auto& body : bodylist)
+        body->AddCollisionModelsToSystem();
+    for (auto& item : otherphysicslist)
+        item->AddCollisionModelsToSystem();
+
     marchive >> CHNVP(timestepper);  // ChTimestepper should implement class factory for abstract create
-    timestepper->SetIntegrable(this);
+    // ChTimestepperIIorder::SetIntegrable does not override the base one, and it must be called to
+    // bind the timestepper state vectors to this system.
+    if (auto timestepperII = std::dynamic_pointer_cast<ChTimestepperIIorder>(timestepper))
+        timestepperII->SetIntegrable(this);
+    else
+        timestepper->SetIntegrable(this);
 
     //***TODO*** complete...
 
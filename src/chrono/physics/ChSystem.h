@@ -713,6 +713,26 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// sparse matrix -which is used only for the purpose of this function.
     void GetConstraintJacobianMatrix(ChSparseMatrix* Cq);  ///< fill this system damping matrix
 
+    /// Compute the lowest undamped vibration modes of the system, linearized about the current configuration,
+    /// by solving K*x = lambda*M*x subject to the bilateral constraints Cq*x = 0 (contacts are ignored).
+    /// The eigenvalues closest to 'shift' are found with the shift-invert Lanczos method, using a sparse
+    /// (skyline) factorization of the KKT matrix [K - shift*M, Cq'; Cq, 0], so systems with 10^5 unknowns can
+    /// be analyzed if their matrices have a moderate profile (e.g. beams, shells, wire wheels).
+    /// Eigenvalues are returned in ascending order (the frequency of a mode is sqrt(lambda)/(2*pi)); the modes,
+    /// normalized with respect to M, are returned in the columns of 'modes', with rows ordered as the speed
+    /// state vector of the active items. The shift must not be an eigenvalue: for systems with rigid body
+    /// motions, K is singular and a small negative shift is needed; by default (shift = 0) it is chosen
+    /// automatically in this case.
+    /// The KRM blocks of the items are cleared on return, and the mass factor of the system descriptor is
+    /// left unchanged. Returns the number of modes which converged to the requested tolerance.
+    /// Throws a ChException if the factorization fails, e.g. with redundant constraints.
+    int ComputeModes(int num_modes,                    ///< number of requested modes
+                     ChVectorDynamic<>& eigenvalues,   ///< output eigenvalues, omega^2
+                     ChMatrixDynamic<>& modes,         ///< output modes, in columns
+                     double shift = 0,                 ///< shift of the eigenvalues
+                     double tolerance = 1e-8           ///< relative tolerance on the eigenpairs
+                     );
+
     // ---- KINEMATICS
 
     /// Advances the kinematic simulation for a single step, of
@@ -304,7 +304,11 @@ private:
         template <class Tc=TClass>
         typename enable_if< !std::is_default_constructible<Tc>::value, void >::type
         _constructor(ChArchiveIn& marchive, const char* classname) {
-            throw (ChExceptionArchive( "Cannot call CallConstructor() for an object without default constructor.")); 
+            // abstract classes are never default constructible: use the class factory, if possible
+            if (ChClassFactory::IsClassRegistered(std::string(classname)))
+                ChClassFactory::create(std::string(classname), pt2Object);
+            else
+                throw (ChExceptionArchive( "Cannot call CallConstructor() for an object without default constructor.")); 
         }
 
         private:
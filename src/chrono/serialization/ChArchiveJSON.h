@@ -20,11 +20,20 @@
 #include "chrono_thirdparty/rapidjson/prettywriter.h"
 #include "chrono_thirdparty/rapidjson/filereadstream.h"
 #include "chrono_thirdparty/rapidjson/filewritestream.h"
+#include "chrono_thirdparty/rapidjson/reader.h"
+#include "chrono_thirdparty/rapidjson/writer.h"
+#include "chrono_thirdparty/rapidjson/error/en.h"
 
+#include <cstdint>
+#include <cstdio>
+#include <climits>
+#include <cstring>
+#include <memory>
 #include <stack>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 namespace chrono {
 
@@ -290,6 +299,164 @@ class  ChArchiveOutJSON : public ChArchiveOut {
 
 
 
+///
+/// This is a class for serializing to compact JSON files, in streaming mode.
+/// Unlike ChArchiveOutJSON, no indentation is written and the output is generated
+/// with the rapidjson Writer directly into a buffered file stream, so it is much
+/// faster for large systems. Files can be read with both ChArchiveInJSON and
+/// ChArchiveInJSONStream.
+///
+
+class  ChArchiveOutJSONStream : public ChArchiveOut {
+  public:
+      typedef rapidjson::Writer<rapidjson::FileWriteStream,
+                                rapidjson::UTF8<>,
+                                rapidjson::UTF8<>,
+                                rapidjson::CrtAllocator,
+                                rapidjson::kWriteNanAndInfFlag>
+          WriterType;
+
+      ChArchiveOutJSONStream(const std::string& filename, size_t buffer_size = 65536) : buffer(buffer_size) {
+          file = std::fopen(filename.c_str(), "wb");
+          if (!file)
+              throw (ChExceptionArchive("Cannot open file " + filename + " for writing"));
+          fstream.reset(new rapidjson::FileWriteStream(file, buffer.data(), buffer.size()));
+          writer.reset(new WriterType(*fstream));
+
+          writer->StartObject();
+          is_array.push(false);
+      };
+
+      virtual ~ChArchiveOutJSONStream() {
+          is_array.pop();
+          writer->EndObject();
+          fstream->Flush();
+          std::fclose(file);
+      };
+
+      virtual void out     (ChNameValue<bool> bVal) {
+            key(bVal.name());
+            writer->Bool(bVal.value());
+      }
+      virtual void out     (ChNameValue<int> bVal) {
+            key(bVal.name());
+            writer->Int(bVal.value());
+      }
+      virtual void out     (ChNameValue<double> bVal) {
+            key(bVal.name());
+            writer->Double(bVal.value());
+      }
+      virtual void out     (ChNameValue<float> bVal){
+            key(bVal.name());
+            writer->Double((double)bVal.value());
+      }
+      virtual void out     (ChNameValue<char> bVal){
+            key(bVal.name());
+            writer->Int((int)bVal.value());
+      }
+      virtual void out     (ChNameValue<unsigned int> bVal){
+            key(bVal.name());
+            writer->Uint(bVal.value());
+      }
+      virtual void out     (ChNameValue<const char*> bVal){
+            key(bVal.name());
+            writer->String(bVal.value());
+      }
+      virtual void out     (ChNameValue<std::string> bVal){
+            key(bVal.name());
+            writer->String(bVal.value().c_str(), (rapidjson::SizeType)bVal.value().size());
+      }
+      virtual void out     (ChNameValue<unsigned long> bVal){
+            key(bVal.name());
+            writer->Uint64((uint64_t)bVal.value());
+      }
+      virtual void out     (ChNameValue<unsigned long long> bVal){
+            key(bVal.name());
+            writer->Uint64((uint64_t)bVal.value());
+      }
+      virtual void out     (ChNameValue<ChEnumMapperBase> bVal) {
+            key(bVal.name());
+            std::string mstr = bVal.value().GetValueAsString();
+            writer->String(mstr.c_str(), (rapidjson::SizeType)mstr.size());
+      }
+
+      virtual void out_array_pre (const char* name, size_t msize, const char* classname) {
+            key(name);
+            writer->StartArray();
+            is_array.push(true);
+      }
+      virtual void out_array_between (size_t msize, const char* classname) {
+      }
+      virtual void out_array_end (size_t msize,const char* classname) {
+            is_array.pop();
+            writer->EndArray();
+      }
+
+        // for custom c++ objects:
+      virtual void out     (ChNameValue<ChFunctorArchiveOut> bVal, const char* classname, bool tracked, size_t obj_ID) {
+            key(bVal.name());
+            writer->StartObject();
+            is_array.push(false);
+
+            if (tracked) {
+                writer->Key("_object_ID");
+                writer->Uint64(obj_ID);
+            }
+
+            bVal.value().CallArchiveOut(*this);
+
+            is_array.pop();
+            writer->EndObject();
+      }
+
+      virtual void out_ref          (ChNameValue<ChFunctorArchiveOut> bVal,  bool already_inserted, size_t obj_ID, size_t ext_ID, const char* classname)  {
+          key(bVal.name());
+          writer->StartObject();
+          is_array.push(false);
+
+          if (strlen(classname) > 0) {
+              writer->Key("_type");
+              writer->String(classname);
+          }
+
+          if (!already_inserted) {
+              writer->Key("_object_ID");
+              writer->Uint64(obj_ID);
+
+              // New Object, we have to full serialize it
+              bVal.value().CallArchiveOutConstructor(*this);
+              bVal.value().CallArchiveOut(*this);
+          } else {
+              if (obj_ID || bVal.value().IsNull()) {
+                  writer->Key("_reference_ID");
+                  writer->Uint64(obj_ID);
+              }
+              if (ext_ID) {
+                  writer->Key("_external_ID");
+                  writer->Uint64(ext_ID);
+              }
+          }
+
+          is_array.pop();
+          writer->EndObject();
+      }
+
+  protected:
+      void key(const char* name) {
+          if (is_array.top() == false)
+              writer->Key(name);
+      }
+
+      std::FILE* file;
+      std::vector<char> buffer;
+      std::unique_ptr<rapidjson::FileWriteStream> fstream;
+      std::unique_ptr<WriterType> writer;
+      std::stack<bool> is_array;
+};
+
+
+
+
 ///
 /// This is a class for deserializing from JSON archives
 ///
@@ -520,6 +687,374 @@ class  ChArchiveInJSON : public ChArchiveIn {
       bool tolerate_missing_tokens;   
 };
 
+///
+/// This is a class for deserializing from JSON archives, in streaming mode.
+/// The file is parsed with the rapidjson SAX Reader from a buffered file stream
+/// into a flat list of tokens (no rapidjson Document is built). Members are
+/// searched starting after the last one read, so files with the same member order
+/// as the deserializing code (e.g. written by ChArchiveOutJSONStream) are read in
+/// linear time. Numbers are parsed in full precision, so doubles written by
+/// ChArchiveOutJSONStream are read back exactly.
+///
+
+class  ChArchiveInJSONStream : public ChArchiveIn {
+  public:
+
+      ChArchiveInJSONStream(const std::string& filename, size_t buffer_size = 65536) {
+            std::FILE* file = std::fopen(filename.c_str(), "rb");
+            if (!file)
+                throw (ChExceptionArchive("Cannot open file " + filename + " for reading"));
+
+            std::vector<char> buffer(buffer_size);
+            rapidjson::FileReadStream fstream(file, buffer.data(), buffer.size());
+            TokenBuilder builder(tokens, strings);
+            rapidjson::Reader reader;
+            rapidjson::ParseResult ok =
+                reader.Parse<rapidjson::kParseNanAndInfFlag | rapidjson::kParseFullPrecisionFlag>(fstream, builder);
+            std::fclose(file);
+
+            if (!ok)
+                throw (ChExceptionArchive("the file has bad JSON syntax, " +
+                                          std::string(rapidjson::GetParseError_En(ok.Code())) + " (offset " +
+                                          std::to_string(ok.Offset()) + ")"));
+            if (tokens.empty() || tokens[0].type != Token::OBJECT)
+                throw (ChExceptionArchive("the file is not a valid JSON document"));
+
+            Level root = {0, 1, false};
+            levels.push(root);
+
+            tolerate_missing_tokens = false;
+      }
+
+      virtual ~ChArchiveInJSONStream() {};
+
+      virtual void in     (ChNameValue<bool> bVal) {
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (mval->type != Token::FALSE_VALUE && mval->type != Token::TRUE_VALUE) {throw (ChExceptionArchive( "Invalid true/false flag after '"+std::string(bVal.name())+"'"));}
+            bVal.value() = (mval->type == Token::TRUE_VALUE);
+      }
+      virtual void in     (ChNameValue<int> bVal) {
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (!IsInt(*mval)) {throw (ChExceptionArchive( "Invalid integer number after '"+std::string(bVal.name())+"'"));}
+            bVal.value() = (int)mval->i;
+      }
+      virtual void in     (ChNameValue<double> bVal) {
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (!IsNumber(*mval)) {throw (ChExceptionArchive( "Invalid number after '"+std::string(bVal.name())+"'"));}
+            bVal.value() = GetDouble(*mval);
+      }
+      virtual void in     (ChNameValue<float> bVal){
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (!IsNumber(*mval)) {throw (ChExceptionArchive( "Invalid number after '"+std::string(bVal.name())+"'"));}
+            bVal.value() = (float)GetDouble(*mval);
+      }
+      virtual void in     (ChNameValue<char> bVal){
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (!IsInt(*mval)) {throw (ChExceptionArchive( "Invalid char code after '"+std::string(bVal.name())+"'"));}
+            bVal.value() = (char)mval->i;
+      }
+      virtual void in     (ChNameValue<unsigned int> bVal){
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (mval->type != Token::UINT || mval->u > UINT_MAX) {throw (ChExceptionArchive( "Invalid unsigned integer number after '"+std::string(bVal.name())+"'"));}
+            bVal.value() = (unsigned int)mval->u;
+      }
+      virtual void in     (ChNameValue<std::string> bVal){
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (mval->type != Token::STRING) {throw (ChExceptionArchive( "Invalid string after '"+std::string(bVal.name())+"'"));}
+            bVal.value().assign(&strings[mval->str], mval->len);
+      }
+      virtual void in     (ChNameValue<unsigned long> bVal){
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (mval->type != Token::UINT) {throw (ChExceptionArchive( "Invalid unsigned long number after '"+std::string(bVal.name())+"'"));}
+            bVal.value() = (unsigned long)mval->u;
+      }
+      virtual void in     (ChNameValue<unsigned long long> bVal){
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (mval->type != Token::UINT) {throw (ChExceptionArchive( "Invalid unsigned long long number after '"+std::string(bVal.name())+"'"));}
+            bVal.value() = mval->u;
+      }
+      virtual void in     (ChNameValue<ChEnumMapperBase> bVal) {
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (mval->type != Token::STRING) {throw (ChExceptionArchive( "Invalid string after '"+std::string(bVal.name())+"'"));}
+            std::string mstr(&strings[mval->str], mval->len);
+            if (!bVal.value().SetValueAsString(mstr)) {throw (ChExceptionArchive( "Not recognized enum type '"+mstr+"'"));}
+      }
+
+         // for wrapping arrays and lists
+      virtual void in_array_pre (const char* name, size_t& msize) {
+            const Token* mval = GetValueFromNameOrArray(name);
+            if (!mval) {msize = 0; Level empty = {npos, 0, true}; levels.push(empty); return;}
+            if (mval->type != Token::ARRAY) {throw (ChExceptionArchive( "Invalid array [...] after '"+std::string(name)+"'"));}
+            msize = mval->size;
+            PushLevel(Index(mval), true);
+      }
+      virtual void in_array_between (const char* name) {
+          Level& lev = levels.top();
+          if (lev.cursor < tokens[lev.container].end)
+              lev.cursor = Next(lev.cursor);
+      }
+      virtual void in_array_end (const char* name) {
+          levels.pop();
+      }
+
+        //  for custom c++ objects:
+      virtual void in     (ChNameValue<ChFunctorArchiveIn> bVal) {
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return;
+            if (mval->type != Token::OBJECT) {throw (ChExceptionArchive( "Invalid object {...} after '"+std::string(bVal.name())+"'"));}
+
+            if (bVal.flags() & NVP_TRACK_OBJECT){
+              bool already_stored; size_t obj_ID;
+              PutPointer(bVal.value().GetRawPtr(), already_stored, obj_ID);
+            }
+
+            PushLevel(Index(mval), false);
+            bVal.value().CallArchiveIn(*this);
+            levels.pop();
+      }
+
+        // for objects to construct, return non-null ptr if new object, return null ptr if just reused obj
+      virtual void* in_ref          (ChNameValue<ChFunctorArchiveIn> bVal)
+      {
+            void* new_ptr = nullptr;
+
+            const Token* mval = GetValueFromNameOrArray(bVal.name());
+            if (!mval) return nullptr;
+            if (mval->type != Token::OBJECT) {throw (ChExceptionArchive( "Invalid object {...} after '"+std::string(bVal.name())+"'"));}
+            PushLevel(Index(mval), false);
+
+            std::string cls_name = "";
+            if (bVal.value().IsPolymorphic()) {
+                if (const Token* mtype = FindMember(levels.top(), "_type")) {
+                    if (mtype->type != Token::STRING) {throw (ChExceptionArchive( "Invalid string after '"+std::string(bVal.name())+"'"));}
+                    cls_name.assign(&strings[mtype->str], mtype->len);
+                }
+            }
+            bool is_reference = false;
+            size_t ref_ID = 0;
+            if (const Token* mref = FindMember(levels.top(), "_reference_ID")) {
+                if (mref->type != Token::UINT) {throw (ChExceptionArchive( "Invalid number after '"+std::string(bVal.name())+"'"));}
+                ref_ID = (size_t)mref->u;
+                is_reference = true;
+            }
+            size_t ext_ID = 0;
+            if (const Token* mext = FindMember(levels.top(), "_external_ID")) {
+                if (mext->type != Token::UINT) {throw (ChExceptionArchive( "Invalid number after '"+std::string(bVal.name())+"'"));}
+                ext_ID = (size_t)mext->u;
+                is_reference = true;
+            }
+
+            if (!is_reference) {
+                // 2) Dynamically create
+                // call new(), or deserialize constructor params+call new():
+                bVal.value().CallArchiveInConstructor(*this, cls_name.c_str());
+
+                if (bVal.value().GetRawPtr()) {
+                    bool already_stored; size_t obj_ID;
+                    PutPointer(bVal.value().GetRawPtr(), already_stored, obj_ID);
+                    // 3) Deserialize
+                    bVal.value().CallArchiveIn(*this);
+                } else {
+                    throw(ChExceptionArchive("Archive cannot create object " + std::string(bVal.name()) +"\n"));
+                }
+                new_ptr = bVal.value().GetRawPtr();
+            }
+            else {
+                if (this->internal_id_ptr.find(ref_ID) == this->internal_id_ptr.end()) {
+                    throw (ChExceptionArchive( "In object '" + std::string(bVal.name()) +"' the _reference_ID " + std::to_string((int)ref_ID) +" is not a valid number." ));
+                }
+                bVal.value().SetRawPtr(internal_id_ptr[ref_ID]);
+
+                if (ext_ID) {
+                    if (this->external_id_ptr.find(ext_ID) == this->external_id_ptr.end()) {
+                        throw (ChExceptionArchive( "In object '" + std::string(bVal.name()) +"' the _external_ID " + std::to_string((int)ext_ID) +" is not valid." ));
+                    }
+                    bVal.value().SetRawPtr(external_id_ptr[ext_ID]);
+                }
+            }
+            levels.pop();
+
+            return new_ptr;
+      }
+
+
+        /// By default, if a token is missing (respect to those required by << deserialization in c++)
+        /// an exception is thrown. This function can deactivate the exception throwing, so
+        /// the default c++ variables values are left, if no token is found.
+      void SetTolerateMissingTokens(bool mtol) { tolerate_missing_tokens = mtol;}
+
+  protected:
+      /// A JSON value. Objects and arrays are followed by the tokens of their children.
+      struct Token {
+          enum Type : uint8_t { NULL_VALUE, FALSE_VALUE, TRUE_VALUE, INT, UINT, DOUBLE, STRING, OBJECT, ARRAY };
+          Type type;
+          uint32_t key;   ///< offset of the member name in the string pool (npos in arrays)
+          uint32_t str;   ///< offset of the string in the string pool
+          uint32_t len;   ///< length of the string
+          uint32_t end;   ///< for objects and arrays, index past the last token of the children
+          uint32_t size;  ///< for objects and arrays, number of children
+          union {
+              int64_t i;  ///< INT (negative integers)
+              uint64_t u; ///< UINT (non-negative integers)
+              double d;   ///< DOUBLE
+          };
+      };
+
+      /// Current object or array.
+      struct Level {
+          uint32_t container;  ///< index of the object or array token
+          uint32_t cursor;     ///< index of the next child to read
+          bool is_array;
+      };
+
+      static const uint32_t npos = 0xFFFFFFFF;
+
+      /// SAX handler appending tokens to the flat list.
+      struct TokenBuilder : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, TokenBuilder> {
+          TokenBuilder(std::vector<Token>& mtokens, std::vector<char>& mstrings)
+              : tokens(mtokens), strings(mstrings), key(npos) {}
+
+          Token& Add(Token::Type type) {
+              Token t;
+              t.type = type;
+              t.key = key;
+              t.str = t.len = 0;
+              t.end = t.size = 0;
+              t.u = 0;
+              key = npos;
+              tokens.push_back(t);
+              return tokens.back();
+          }
+          uint32_t Store(const char* str, rapidjson::SizeType length) {
+              uint32_t offset = (uint32_t)strings.size();
+              strings.insert(strings.end(), str, str + length);
+              strings.push_back('\0');
+              return offset;
+          }
+
+          bool Null() { Add(Token::NULL_VALUE); return true; }
+          bool Bool(bool b) { Add(b ? Token::TRUE_VALUE : Token::FALSE_VALUE); return true; }
+          bool Int(int v) { return Int64(v); }
+          bool Uint(unsigned v) { return Uint64(v); }
+          bool Int64(int64_t v) {
+              if (v >= 0)
+                  return Uint64((uint64_t)v);
+              Add(Token::INT).i = v;
+              return true;
+          }
+          bool Uint64(uint64_t v) { Add(Token::UINT).u = v; return true; }
+          bool Double(double v) { Add(Token::DOUBLE).d = v; return true; }
+          bool String(const char* str, rapidjson::SizeType length, bool copy) {
+              uint32_t offset = Store(str, length);
+              Token& t = Add(Token::STRING);
+              t.str = offset;
+              t.len = length;
+              return true;
+          }
+          bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+              key = Store(str, length);
+              return true;
+          }
+          bool StartObject() { return Start(Token::OBJECT); }
+          bool EndObject(rapidjson::SizeType count) { return End(count); }
+          bool StartArray() { return Start(Token::ARRAY); }
+          bool EndArray(rapidjson::SizeType count) { return End(count); }
+
+          bool Start(Token::Type type) {
+              Add(type);
+              open.push_back((uint32_t)tokens.size() - 1);
+              return true;
+          }
+          bool End(rapidjson::SizeType count) {
+              Token& t = tokens[open.back()];
+              t.end = (uint32_t)tokens.size();
+              t.size = count;
+              open.pop_back();
+              return true;
+          }
+
+          std::vector<Token>& tokens;
+          std::vector<char>& strings;
+          std::vector<uint32_t> open;
+          uint32_t key;
+      };
+
+      uint32_t Index(const Token* t) const { return (uint32_t)(t - tokens.data()); }
+
+      /// Index of the token following the given one and all its children.
+      uint32_t Next(uint32_t i) const {
+          const Token& t = tokens[i];
+          return (t.type == Token::OBJECT || t.type == Token::ARRAY) ? t.end : i + 1;
+      }
+
+      void PushLevel(uint32_t container, bool is_array) {
+          Level lev = {container, container + 1, is_array};
+          levels.push(lev);
+      }
+
+      /// Find a member of the current object, without moving the cursor.
+      const Token* FindMember(const Level& lev, const char* mname) const {
+          uint32_t end = tokens[lev.container].end;
+          for (uint32_t i = lev.container + 1; i < end; i = Next(i)) {
+              if (std::strcmp(&strings[tokens[i].key], mname) == 0)
+                  return &tokens[i];
+          }
+          return nullptr;
+      }
+
+      const Token* GetValueFromNameOrArray(const char* mname) {
+          Level& lev = levels.top();
+          uint32_t end = lev.container == npos ? 0 : tokens[lev.container].end;
+          if (lev.is_array) {
+              if (lev.cursor >= end) {throw (ChExceptionArchive( "Cannot retrieve from ID num in non-array object."));}
+              return &tokens[lev.cursor];
+          }
+          // Search forward from the cursor first (members are usually read in order), then wrap around.
+          for (uint32_t i = lev.cursor; i < end; i = Next(i)) {
+              if (std::strcmp(&strings[tokens[i].key], mname) == 0) {
+                  lev.cursor = Next(i);
+                  return &tokens[i];
+              }
+          }
+          for (uint32_t i = lev.container + 1; i < lev.cursor && i < end; i = Next(i)) {
+              if (std::strcmp(&strings[tokens[i].key], mname) == 0) {
+                  lev.cursor = Next(i);
+                  return &tokens[i];
+              }
+          }
+          token_notfound(mname);
+          return nullptr;
+      }
+
+      static bool IsNumber(const Token& t) { return t.type == Token::INT || t.type == Token::UINT || t.type == Token::DOUBLE; }
+      static bool IsInt(const Token& t) {
+          return (t.type == Token::INT && t.i >= INT_MIN) || (t.type == Token::UINT && t.u <= (uint64_t)INT_MAX);
+      }
+      static double GetDouble(const Token& t) {
+          return t.type == Token::INT ? (double)t.i : (t.type == Token::UINT ? (double)t.u : t.d);
+      }
+
+      void token_notfound(const char* mname) {
+          if (!tolerate_missing_tokens)
+            throw (ChExceptionArchive( "Cannot find '"+std::string(mname)+"'"));
+      }
+
+      std::vector<Token> tokens;
+      std::vector<char> strings;
+      std::stack<Level> levels;
+      bool tolerate_missing_tokens;
+};
+
 }  // end namespace chrono
 
 #endif
@@ -63,7 +63,7 @@ double ChSolverMINRES::Solve(ChSystemDescriptor& sysd  ///< system description w
     int nc = sysd.CountActiveConstraints();
 
     if (verbose)
-        GetLog() << "nc = " << nc << "\n";
+        CH_LOG(ChLog::CHSTATUS) << "nc = " << nc << "\n";
     ChMatrixDynamic<> ml(nc, 1);
     ChMatrixDynamic<> mb(nc, 1);
     ChMatrixDynamic<> mr(nc, 1);
@@ -118,7 +118,7 @@ double ChSolverMINRES::Solve(ChSystemDescriptor& sysd  ///< system description w
 
     while (true) {
         if (verbose)
-            GetLog() << "\n";
+            CH_LOG(ChLog::CHSTATUS) << "\n";
 
         //
         // A)  The MINRES loop. Operates only on set defined by en_l
@@ -140,7 +140,7 @@ double ChSolverMINRES::Solve(ChSystemDescriptor& sysd  ///< system description w
 
         while (true) {
             if (verbose)
-                GetLog() << "K";
+                CH_LOG(ChLog::CHSTATUS) << "K";
             // sysd.ShurComplementProduct(Nr, &mr,&en_l); // Nr  =  N * r  (no, recompute only when mr changes, see
             // later)
             double rNr = mr.MatrDot(mr, Nr);  // rNr = r' * N * r
@@ -203,7 +203,7 @@ double ChSolverMINRES::Solve(ChSystemDescriptor& sysd  ///< system description w
 
             if (norm_corr > this->feas_tolerance * norm_jump) {
                 if (verbose)
-                    GetLog() << " " << (norm_corr / norm_jump);
+                    CH_LOG(ChLog::CHSTATUS) << " " << (norm_corr / norm_jump);
                 break;
             }
 
@@ -244,7 +244,7 @@ double ChSolverMINRES::Solve(ChSystemDescriptor& sysd  ///< system description w
             break;
 
         if (verbose)
-            GetLog() << "\n";
+            CH_LOG(ChLog::CHSTATUS) << "\n";
 
         //
         // B)  The FIXED POINT, it also will find active sets. Operates on entire set
@@ -252,7 +252,7 @@ double ChSolverMINRES::Solve(ChSystemDescriptor& sysd  ///< system description w
 
         for (int iter_fixedp = 0; iter_fixedp < this->max_fixedpoint_steps; iter_fixedp++) {
             if (verbose)
-                GetLog() << "p";
+                CH_LOG(ChLog::CHSTATUS) << "p";
 
             // Compute residual  as  r = N*l - b_shur
             sysd.ShurComplementProduct(mr, &ml, 0);  // 1)  r = N*l ...
@@ -304,7 +304,7 @@ double ChSolverMINRES::Solve(ChSystemDescriptor& sysd  ///< system description w
             break;
 
         if (verbose)
-            GetLog() << "\n";
+            CH_LOG(ChLog::CHSTATUS) << "\n";
         //
         // C)  The ACTIVE SET detection
         //
@@ -312,18 +312,18 @@ double ChSolverMINRES::Solve(ChSystemDescriptor& sysd  ///< system description w
         for (int row = 0; row < nc; row++) {
             if (ml(row) == 0) {
                 if (verbose)
-                    GetLog() << "0";
+                    CH_LOG(ChLog::CHSTATUS) << "0";
                 en_l[row] = false;
             } else {
                 if (verbose)
-                    GetLog() << "1";
+                    CH_LOG(ChLog::CHSTATUS) << "1";
                 en_l[row] = true;
             }
         }
     }
 
     if (verbose)
-        GetLog() << "-----\n";
+        CH_LOG(ChLog::CHSTATUS) << "-----\n";
 
     // Resulting DUAL variables:
     // store ml temporary vector into ChConstraint 'l_i' multipliers
@@ -365,8 +365,8 @@ double ChSolverMINRES::Solve_SupportingStiffness(
     int nx = nv + nc;  // total scalar unknowns, in x vector for full KKT system Z*x-d=0
 
     if (verbose)
-        GetLog() << "\n----- MINRES -supporting stiffness-, n.vars nx=" << nx << "  max.iters=" << max_iterations
-                 << "\n";
+        CH_LOG(ChLog::CHSTATUS) << "\n----- MINRES -supporting stiffness-, n.vars nx=" << nx
+                                << "  max.iters=" << max_iterations << "\n";
 
     ChMatrixDynamic<> x(nx, 1);
     ChMatrixDynamic<> d(nx, 1);
@@ -452,7 +452,7 @@ double ChSolverMINRES::Solve_SupportingStiffness(
         double r_proj_resid = r.NormTwo();
         if (r_proj_resid < ChMax(rel_tol_d, abs_tol)) {
             if (verbose)
-                GetLog() << "P(r)-converged! iter=" << iter << " |P(r)|=" << r_proj_resid << "\n";
+                CH_LOG(ChLog::CHSTATUS) << "P(r)-converged! iter=" << iter << " |P(r)|=" << r_proj_resid << "\n";
             break;
         }
 
@@ -517,7 +517,7 @@ double ChSolverMINRES::Solve_SupportingStiffness(
     sysd.FromVectorToUnknowns(x);
 
     if (verbose)
-        GetLog() << "MINRES residual: " << r.NormTwo() << " ---\n";
+        CH_LOG(ChLog::CHSTATUS) << "MINRES residual: " << r.NormTwo() << " ---\n";
 
     return maxviolation;
 }
@@ -95,7 +95,7 @@ void ChTimestepperHHT::Advance(const double dt) {
             h = new_h;
             num_successful_steps = 0;
             if (verbose)
-                GetLog() << " +++HHT increase stepsize to " << h << "\n";
+                CH_LOG(ChLog::CHSTATUS) << " +++HHT increase stepsize to " << h << "\n";
         }
     } else {
         h = ChMin(h, dt);
@@ -121,7 +121,7 @@ void ChTimestepperHHT::Advance(const double dt) {
 
         for (it = 0; it < maxiters; it++) {
             if (verbose && modified_Newton && call_setup)
-                GetLog() << " HHT call Setup.\n";
+                CH_LOG(ChLog::CHSTATUS) << " HHT call Setup.\n";
 
             // Solve linear system and increment state
             Increment(mintegrable, scaling_factor);
@@ -153,8 +153,8 @@ void ChTimestepperHHT::Advance(const double dt) {
                 num_successful_steps = 0;
 
             if (verbose) {
-                GetLog() << " HHT NR converged (" << num_successful_steps << ").";
-                GetLog() << "  T = " << T + h << "  h = " << h << "\n";
+                CH_LOG(ChLog::CHSTATUS) << " HHT NR converged (" << num_successful_steps << ").";
+                CH_LOG(ChLog::CHSTATUS) << "  T = " << T + h << "  h = " << h << "\n";
             }
 
             // if needed, adjust stepsize to reach exactly tfinal
@@ -177,7 +177,7 @@ void ChTimestepperHHT::Advance(const double dt) {
 
             // re-attempt step with updated matrix
             if (verbose) {
-                GetLog() << " HHT re-attempt step with updated matrix.\n";
+                CH_LOG(ChLog::CHSTATUS) << " HHT re-attempt step with updated matrix.\n";
             }
 
             call_setup = true;
@@ -191,8 +191,8 @@ void ChTimestepperHHT::Advance(const double dt) {
 
             // accept solution as is and complete step
             if (verbose) {
-                GetLog() << " HHT NR terminated.";
-                GetLog() << "  T = " << T + h << "  h = " << h << "\n";
+                CH_LOG(ChLog::CHSTATUS) << " HHT NR terminated.";
+                CH_LOG(ChLog::CHSTATUS) << "  T = " << T + h << "  h = " << h << "\n";
             }
 
             T += h;
@@ -211,12 +211,12 @@ void ChTimestepperHHT::Advance(const double dt) {
             h *= step_decrease_factor;
 
             if (verbose)
-                GetLog() << " ---HHT reduce stepsize to " << h << "\n";
+                CH_LOG(ChLog::CHSTATUS) << " ---HHT reduce stepsize to " << h << "\n";
 
             // bail out if stepsize reaches minimum allowable
             if (h < h_min) {
                 if (verbose)
-                    GetLog() << " HHT at minimum stepsize. Exiting...\n";
+                    CH_LOG(ChLog::CHSTATUS) << " HHT at minimum stepsize. Exiting...\n";
                 throw ChException("HHT: Reached minimum allowable step size.");
             }
 
@@ -369,9 +369,9 @@ bool ChTimestepperHHT::CheckConvergence(double scaling_factor) {
             double Dl_nrm = Dl.NormWRMS(ewtL);
 
             if (verbose) {
-                GetLog() << " HHT iteration=" << numiters << "  |R|=" << R_nrm << "  |Qc|=" << Qc_nrm
-                         << "  |Da|=" << Da_nrm << "  |Dl|=" << Dl_nrm << "  N = " << R.GetLength()
-                         << "  M = " << Qc.GetLength() << "\n";
+                CH_LOG(ChLog::CHSTATUS) << " HHT iteration=" << numiters << "  |R|=" << R_nrm << "  |Qc|=" << Qc_nrm
+                                        << "  |Da|=" << Da_nrm << "  |Dl|=" << Dl_nrm << "  N = " << R.GetLength()
+                                        << "  M = " << Qc.GetLength() << "\n";
             }
 
             if ((R_nrm < abstolS && Qc_nrm < abstolL) || (Da_nrm < 1 && Dl_nrm < 1))
@@ -391,7 +391,8 @@ bool ChTimestepperHHT::CheckConvergence(double scaling_factor) {
             Dl_nrm /= scaling_factor;
 
             if (verbose) {
-                GetLog() << " HHT iteration=" << numiters << "  |Dx|=" << Dx_nrm << "  |Dl|=" << Dl_nrm << "\n";
+                CH_LOG(ChLog::CHSTATUS) << " HHT iteration=" << numiters << "  |Dx|=" << Dx_nrm << "  |Dl|=" << Dl_nrm
+                                        << "\n";
             }
 
             if (Dx_nrm < 1 && Dl_nrm < 1)
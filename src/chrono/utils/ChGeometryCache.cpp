@@ -0,0 +1,269 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#if defined(_WIN32) || defined(__WIN32__)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "chrono/collision/ChCConvexDecomposition.h"
+#include "chrono/core/ChException.h"
+#include "chrono/core/ChMappedFile.h"
+#include "chrono/utils/ChGeometryCache.h"
+
+namespace chrono {
+namespace utils {
+
+// Header at the beginning of each entry file.
+struct ChGeometryCacheHeader {
+    char magic[4];   // "CHGC"
+    uint32_t version;
+    uint64_t key;
+    uint64_t size;   // payload size (in bytes)
+};
+
+static const uint32_t GEOMETRY_CACHE_VERSION = 1;
+
+// Identifier of the current process.
+static unsigned long GetProcessId() {
+#if defined(_WIN32) || defined(__WIN32__)
+    return static_cast<unsigned long>(_getpid());
+#else
+    return static_cast<unsigned long>(getpid());
+#endif
+}
+
+// Arrays of vectors are stored as they are laid out in memory.
+static_assert(sizeof(ChVector<double>) == 3 * sizeof(double), "unexpected ChVector layout");
+static_assert(sizeof(ChVector<float>) == 3 * sizeof(float), "unexpected ChVector layout");
+static_assert(sizeof(ChVector<int>) == 3 * sizeof(int), "unexpected ChVector layout");
+
+// Kinds of entries (part of the key).
+enum { ENTRY_WAVEFRONT_MESH = 1, ENTRY_CONVEX_HACDv2 = 2 };
+
+// -----------------------------------------------------------------------------
+
+ChGeometryCache::ChGeometryCache(const std::string& directory) : m_dir(directory), m_hits(0), m_misses(0) {}
+
+uint64_t ChGeometryCache::Hash(const void* data, size_t size, uint64_t hash) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t ChGeometryCache::HashFile(const std::string& filename) {
+    std::ifstream test(filename);
+    if (!test.good())
+        throw ChException("ChGeometryCache: cannot read file " + filename);
+    test.close();
+
+    // Note: an empty file cannot be mapped.
+    ChMappedFile file(filename);
+    if (!file.IsOpen())
+        return Hash(nullptr, 0);
+    return Hash(file.GetData(), file.GetSize());
+}
+
+std::string ChGeometryCache::GetEntryFilename(uint64_t key) const {
+    char name[32];
+    sprintf(name, "%016llx.chgc", (unsigned long long)key);
+    return m_dir + "/" + name;
+}
+
+bool ChGeometryCache::Read(uint64_t key, std::vector<char>& data) {
+    ChMappedFile file(GetEntryFilename(key));
+    if (!file.IsOpen() || file.GetSize() < sizeof(ChGeometryCacheHeader))
+        return false;
+
+    ChGeometryCacheHeader header;
+    std::memcpy(&header, file.GetData(), sizeof(header));
+    if (std::strncmp(header.magic, "CHGC", 4) != 0 || header.version != GEOMETRY_CACHE_VERSION ||
+        header.key != key || header.size != file.GetSize() - sizeof(header))
+        return false;
+
+    data.assign(file.GetData() + sizeof(header), file.GetData() + file.GetSize());
+    return true;
+}
+
+bool ChGeometryCache::Write(uint64_t key, const void* data, size_t size) {
+    ChGeometryCacheHeader header;
+    std::memcpy(header.magic, "CHGC", 4);
+    header.version = GEOMETRY_CACHE_VERSION;
+    header.key = key;
+    header.size = size;
+
+    // Write to a file name unique to this process and thread, then move it in place. The random suffix guards
+    // against collisions of the thread id hashes and against other processes sharing the cache directory.
+    std::string filename = GetEntryFilename(key);
+    std::random_device random;
+    std::ostringstream tmpname;
+    tmpname << filename << ".tmp" << GetProcessId() << "_" << std::hash<std::thread::id>()(std::this_thread::get_id())
+            << "_" << std::hex << random() << random();
+
+    {
+        std::ofstream file(tmpname.str(), std::ios::binary);
+        if (!file.good())
+            return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(data), size);
+        if (!file.good()) {
+            file.close();
+            std::remove(tmpname.str().c_str());
+            return false;
+        }
+    }
+
+    // On Windows, rename fails if the destination exists (e.g. written meanwhile by another run). Keep the
+    // existing entry then: removing it first would expose readers to a missing (or half-replaced) entry.
+    if (std::rename(tmpname.str().c_str(), filename.c_str()) != 0) {
+        std::remove(tmpname.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+void ChGeometryCache::Remove(uint64_t key) {
+    std::remove(GetEntryFilename(key).c_str());
+}
+
+// -----------------------------------------------------------------------------
+
+uint64_t ChGeometryCache::GetWavefrontMeshKey(const std::string& filename, bool load_normals, bool load_uv) {
+    uint64_t params[] = {ENTRY_WAVEFRONT_MESH, load_normals, load_uv};
+    return Hash(params, sizeof(params), HashFile(filename));
+}
+
+uint64_t ChGeometryCache::GetConvexDecompositionKey(const std::string& filename,
+                                                    unsigned int max_hull_count,
+                                                    unsigned int max_hull_merge,
+                                                    unsigned int max_hull_vertices,
+                                                    float concavity,
+                                                    float small_cluster_threshold,
+                                                    float fuse_tolerance) {
+    uint64_t params[] = {ENTRY_CONVEX_HACDv2, max_hull_count, max_hull_merge, max_hull_vertices};
+    float fparams[] = {concavity, small_cluster_threshold, fuse_tolerance};
+    return Hash(fparams, sizeof(fparams), Hash(params, sizeof(params), HashFile(filename)));
+}
+
+std::shared_ptr<geometry::ChTriangleMeshConnected> ChGeometryCache::LoadWavefrontMesh(const std::string& filename,
+                                                                                       bool load_normals,
+                                                                                       bool load_uv) {
+    uint64_t key = GetWavefrontMeshKey(filename, load_normals, load_uv);
+    auto mesh = std::make_shared<geometry::ChTriangleMeshConnected>();
+
+    std::vector<char> payload;
+    if (Read(key, payload)) {
+        const char* cursor = payload.data();
+        const char* end = cursor + payload.size();
+        if (GetArray(cursor, end, mesh->m_vertices) && GetArray(cursor, end, mesh->m_normals) &&
+            GetArray(cursor, end, mesh->m_UV) && GetArray(cursor, end, mesh->m_colors) &&
+            GetArray(cursor, end, mesh->m_face_v_indices) && GetArray(cursor, end, mesh->m_face_n_indices) &&
+            GetArray(cursor, end, mesh->m_face_uv_indices) && GetArray(cursor, end, mesh->m_face_col_indices)) {
+            mesh->m_filename = filename;
+            ++m_hits;
+            return mesh;
+        }
+    }
+
+    ++m_misses;
+    mesh->LoadWavefrontMesh(filename, load_normals, load_uv);
+
+    payload.clear();
+    PutArray(payload, mesh->m_vertices);
+    PutArray(payload, mesh->m_normals);
+    PutArray(payload, mesh->m_UV);
+    PutArray(payload, mesh->m_colors);
+    PutArray(payload, mesh->m_face_v_indices);
+    PutArray(payload, mesh->m_face_n_indices);
+    PutArray(payload, mesh->m_face_uv_indices);
+    PutArray(payload, mesh->m_face_col_indices);
+    Write(key, payload.data(), payload.size());
+
+    return mesh;
+}
+
+void ChGeometryCache::LoadConvexDecomposition(const std::string& filename,
+                                              std::vector<std::vector<ChVector<>>>& hulls,
+                                              unsigned int max_hull_count,
+                                              unsigned int max_hull_merge,
+                                              unsigned int max_hull_vertices,
+                                              float concavity,
+                                              float small_cluster_threshold,
+                                              float fuse_tolerance) {
+    uint64_t key = GetConvexDecompositionKey(filename, max_hull_count, max_hull_merge, max_hull_vertices, concavity,
+                                             small_cluster_threshold, fuse_tolerance);
+
+    hulls.clear();
+
+    std::vector<char> payload;
+    if (Read(key, payload)) {
+        const char* cursor = payload.data();
+        const char* end = cursor + payload.size();
+        uint64_t num_hulls = 0;
+        bool ok = payload.size() >= sizeof(uint64_t);
+        if (ok) {
+            std::memcpy(&num_hulls, cursor, sizeof(uint64_t));
+            cursor += sizeof(uint64_t);
+            ok = num_hulls <= payload.size() / sizeof(uint64_t);
+        }
+        if (ok) {
+            hulls.resize((size_t)num_hulls);
+            for (auto& hull : hulls) {
+                if (!GetArray(cursor, end, hull)) {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+        if (ok) {
+            ++m_hits;
+            return;
+        }
+        hulls.clear();
+    }
+
+    ++m_misses;
+    auto mesh = LoadWavefrontMesh(filename, false, false);
+
+    collision::ChConvexDecompositionHACDv2 decomposition;
+    decomposition.Reset();
+    decomposition.AddTriangleMesh(*mesh);
+    decomposition.SetParameters(max_hull_count, max_hull_merge, max_hull_vertices, concavity, small_cluster_threshold,
+                                fuse_tolerance);
+    decomposition.ComputeConvexDecomposition();
+
+    hulls.resize(decomposition.GetHullCount());
+    for (unsigned int i = 0; i < hulls.size(); ++i)
+        decomposition.GetConvexHullResult(i, hulls[i]);
+
+    payload.clear();
+    uint64_t num_hulls = hulls.size();
+    payload.resize(sizeof(uint64_t));
+    std::memcpy(payload.data(), &num_hulls, sizeof(uint64_t));
+    for (auto& hull : hulls)
+        PutArray(payload, hull);
+    Write(key, payload.data(), payload.size());
+}
+
+}  // end namespace utils
+}  // end namespace chrono
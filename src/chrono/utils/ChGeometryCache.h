@@ -0,0 +1,152 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Content-hashed on-disk cache of processed geometry (triangle meshes loaded
+// from Wavefront OBJ files, convex decompositions), so that repeated runs can
+// skip parsing and decomposition.
+//
+// =============================================================================
+
+#ifndef CH_GEOMETRY_CACHE_H
+#define CH_GEOMETRY_CACHE_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "chrono/core/ChVector.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+
+namespace chrono {
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Content-hashed cache of processed geometry.
+/// Each entry is stored in its own binary file in the cache directory, named after a 64-bit FNV-1a
+/// hash of the source file content and of the processing parameters; editing a source file or
+/// changing a parameter therefore simply results in a new entry. Entries are read through a
+/// memory mapping and their arrays copied directly into the output containers. Entries are written
+/// to a temporary file which is then renamed, so concurrent runs sharing a cache directory never
+/// see partially written entries.
+///
+/// Usage:
+///   ChGeometryCache cache("geometry_cache");
+///   auto mesh = cache.LoadWavefrontMesh(GetChronoDataFile("mymesh.obj"), false, false);
+///   std::vector<std::vector<ChVector<>>> hulls;
+///   cache.LoadConvexDecomposition(GetChronoDataFile("mymesh.obj"), hulls);
+class ChApi ChGeometryCache {
+  public:
+    /// Create a cache using the specified directory, which must exist.
+    ChGeometryCache(const std::string& directory);
+
+    /// Load a triangle mesh from a Wavefront OBJ file, using the cached copy if available.
+    /// Throws a ChException if the OBJ file cannot be read.
+    std::shared_ptr<geometry::ChTriangleMeshConnected> LoadWavefrontMesh(const std::string& filename,
+                                                                         bool load_normals = true,
+                                                                         bool load_uv = false);
+
+    /// Load the mesh in the given OBJ file and compute its convex decomposition with the HACDv2
+    /// algorithm (see collision::ChConvexDecompositionHACDv2::SetParameters), using the cached
+    /// hulls if available. Each hull is returned as the list of its vertices.
+    void LoadConvexDecomposition(const std::string& filename,
+                                 std::vector<std::vector<ChVector<>>>& hulls,
+                                 unsigned int max_hull_count = 1024,
+                                 unsigned int max_hull_merge = 256,
+                                 unsigned int max_hull_vertices = 64,
+                                 float concavity = 0.01f,
+                                 float small_cluster_threshold = 0.0f,
+                                 float fuse_tolerance = 1e-6f);
+
+    /// Return the key of the entry used by LoadWavefrontMesh() for the given file and options.
+    static uint64_t GetWavefrontMeshKey(const std::string& filename, bool load_normals, bool load_uv);
+
+    /// Return the key of the entry used by LoadConvexDecomposition() for the given file and parameters.
+    static uint64_t GetConvexDecompositionKey(const std::string& filename,
+                                              unsigned int max_hull_count,
+                                              unsigned int max_hull_merge,
+                                              unsigned int max_hull_vertices,
+                                              float concavity,
+                                              float small_cluster_threshold,
+                                              float fuse_tolerance);
+
+    /// Read a generic entry. Return false if no valid entry with the given key exists.
+    bool Read(uint64_t key, std::vector<char>& data);
+
+    /// Store a generic entry, replacing any existing entry with the same key.
+    /// Return false if the entry could not be written. Where an existing file cannot be replaced atomically
+    /// (Windows), the existing entry is kept and false is returned; concurrent writers (threads or processes)
+    /// never expose a partially written entry.
+    bool Write(uint64_t key, const void* data, size_t size);
+
+    /// Remove the entry with the given key, if any.
+    void Remove(uint64_t key);
+
+    /// Number of entries found in the cache so far.
+    int GetNumHits() const { return m_hits; }
+
+    /// Number of entries which had to be computed so far.
+    int GetNumMisses() const { return m_misses; }
+
+    /// Append the content of a vector to an entry payload, preceded by its number of elements.
+    template <typename T>
+    static void PutArray(std::vector<char>& payload, const std::vector<T>& v) {
+        uint64_t n = v.size();
+        size_t pos = payload.size();
+        payload.resize(pos + sizeof(uint64_t) + n * sizeof(T));
+        std::memcpy(&payload[pos], &n, sizeof(uint64_t));
+        if (n)
+            std::memcpy(&payload[pos + sizeof(uint64_t)], v.data(), n * sizeof(T));
+    }
+
+    /// Extract a vector written by PutArray() from an entry payload, advancing the cursor.
+    /// Return false if the payload is too short.
+    template <typename T>
+    static bool GetArray(const char*& cursor, const char* end, std::vector<T>& v) {
+        uint64_t n;
+        if ((size_t)(end - cursor) < sizeof(uint64_t))
+            return false;
+        std::memcpy(&n, cursor, sizeof(uint64_t));
+        cursor += sizeof(uint64_t);
+        if ((uint64_t)(end - cursor) / sizeof(T) < n)
+            return false;
+        v.resize((size_t)n);
+        if (n)
+            std::memcpy(v.data(), cursor, (size_t)n * sizeof(T));
+        cursor += n * sizeof(T);
+        return true;
+    }
+
+    /// Accumulate the 64-bit FNV-1a hash of a block of memory.
+    static uint64_t Hash(const void* data, size_t size, uint64_t hash = 14695981039346656037ULL);
+
+    /// Compute the 64-bit FNV-1a hash of the content of a file (read through a memory mapping).
+    /// Throws a ChException if the file cannot be read.
+    static uint64_t HashFile(const std::string& filename);
+
+  private:
+    std::string GetEntryFilename(uint64_t key) const;
+
+    std::string m_dir;
+    int m_hits;
+    int m_misses;
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,253 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "chrono/core/ChException.h"
+#include "chrono/utils/ChOutputPipeline.h"
+#include "chrono/utils/ChUtilsInputOutput.h"
+
+namespace chrono {
+namespace utils {
+
+// -----------------------------------------------------------------------------
+// ChOutputTaskBodies
+// -----------------------------------------------------------------------------
+
+ChOutputTaskBodies::ChOutputTaskBodies(const std::string& prefix,
+                                       bool active_only,
+                                       bool dump_vel,
+                                       const std::string& delim)
+    : m_prefix(prefix), m_active_only(active_only), m_dump_vel(dump_vel), m_delim(delim) {}
+
+void ChOutputTaskBodies::Capture(ChSystem& system, ChOutputFrame& frame) {
+    size_t stride = m_dump_vel ? 13 : 7;
+    auto& bodies = *system.Get_bodylist();
+
+    frame.reals.resize(bodies.size() * stride);
+    size_t n = 0;
+    for (auto& body : bodies) {
+        if (m_active_only && !body->IsActive())
+            continue;
+        double* data = &frame.reals[n * stride];
+        const ChVector<>& pos = body->GetPos();
+        const ChQuaternion<>& rot = body->GetRot();
+        data[0] = pos.x();
+        data[1] = pos.y();
+        data[2] = pos.z();
+        data[3] = rot.e0();
+        data[4] = rot.e1();
+        data[5] = rot.e2();
+        data[6] = rot.e3();
+        if (m_dump_vel) {
+            const ChVector<>& vel = body->GetPos_dt();
+            const ChVector<>& wvel = body->GetWvel_loc();
+            data[7] = vel.x();
+            data[8] = vel.y();
+            data[9] = vel.z();
+            data[10] = wvel.x();
+            data[11] = wvel.y();
+            data[12] = wvel.z();
+        }
+        ++n;
+    }
+    frame.reals.resize(n * stride);
+}
+
+void ChOutputTaskBodies::Write(const ChOutputFrame& frame) {
+    size_t stride = m_dump_vel ? 13 : 7;
+    CSV_writer csv(m_delim);
+    for (size_t i = 0; i < frame.reals.size(); i += stride) {
+        for (size_t j = 0; j < stride; ++j)
+            csv << frame.reals[i + j];
+        csv << std::endl;
+    }
+
+    char suffix[16];
+    sprintf(suffix, "_%05u.csv", frame.frame);
+    csv.write_to_file(m_prefix + suffix);
+}
+
+// -----------------------------------------------------------------------------
+// ChOutputPipeline
+// -----------------------------------------------------------------------------
+
+ChOutputPipeline::ChOutputPipeline(int num_threads, size_t max_queued_frames, eChQueuePolicy policy)
+    : m_max_queued(std::max(max_queued_frames, (size_t)1)),
+      m_policy(policy),
+      m_output_step(0),
+      m_next_output_time(0),
+      m_num_busy(0),
+      m_stop(false),
+      m_num_enqueued(0),
+      m_num_submitted(0),
+      m_num_dropped(0),
+      m_num_blocked(0),
+      m_blocked_time(0),
+      m_capture_time(0),
+      m_max_queue_length(0) {
+    for (int i = 0; i < std::max(num_threads, 1); ++i)
+        m_threads.push_back(std::thread(&ChOutputPipeline::Process, this));
+}
+
+ChOutputPipeline::~ChOutputPipeline() {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv_space.wait(lock, [this]() { return m_queue.empty() && m_num_busy == 0; });
+        m_stop = true;
+    }
+    m_cv_work.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+void ChOutputPipeline::AddTask(std::shared_ptr<ChOutputTask> task) {
+    if (m_num_submitted > 0)
+        throw ChException("ChOutputPipeline: tasks must be added before the first frame is submitted.");
+    Task entry;
+    entry.task = task;
+    entry.next_frame = 0;
+    m_tasks.push_back(entry);
+}
+
+bool ChOutputPipeline::Update(ChSystem& system) {
+    if (m_num_submitted > 0 && system.GetChTime() < m_next_output_time)
+        return false;
+    // Tolerate round-off in the accumulated simulation time.
+    m_next_output_time = system.GetChTime() + m_output_step * (1 - 1e-6);
+    Submit(system);
+    return true;
+}
+
+bool ChOutputPipeline::Submit(ChSystem& system) {
+    CheckError();
+
+    Snapshot snapshot;
+    ++m_num_submitted;
+
+    // Wait for room in the queue (or give up) and recycle buffers.
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_queue.size() >= m_max_queued) {
+            if (m_policy == DROP) {
+                ++m_num_dropped;
+                return false;
+            }
+            ++m_num_blocked;
+            auto start = std::chrono::steady_clock::now();
+            m_cv_space.wait(lock, [this]() { return m_queue.size() < m_max_queued; });
+            m_blocked_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        for (size_t i = 0; i < m_tasks.size(); ++i) {
+            if (!m_pool.empty()) {
+                snapshot.buffers.push_back(std::move(m_pool.back()));
+                m_pool.pop_back();
+            } else {
+                snapshot.buffers.emplace_back(new ChOutputFrame);
+            }
+        }
+    }
+
+    // Capture the data for all tasks (only the simulation thread accesses the system).
+    auto start = std::chrono::steady_clock::now();
+    snapshot.frame = m_num_enqueued++;
+    for (size_t i = 0; i < m_tasks.size(); ++i) {
+        ChOutputFrame& buffer = *snapshot.buffers[i];
+        buffer.frame = snapshot.frame;
+        buffer.time = system.GetChTime();
+        m_tasks[i].task->Capture(system, buffer);
+    }
+    m_capture_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(snapshot));
+        m_max_queue_length = std::max(m_max_queue_length, m_queue.size());
+    }
+    m_cv_work.notify_one();
+
+    return true;
+}
+
+void ChOutputPipeline::Flush() {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv_space.wait(lock, [this]() { return m_queue.empty() && m_num_busy == 0; });
+    }
+    CheckError();
+}
+
+void ChOutputPipeline::CheckError() {
+    std::string error;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        error.swap(m_error);
+    }
+    if (!error.empty())
+        throw ChException("ChOutputPipeline: " + error);
+}
+
+void ChOutputPipeline::Process() {
+    while (true) {
+        Snapshot snapshot;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv_work.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty())
+                return;
+            snapshot = std::move(m_queue.front());
+            m_queue.pop_front();
+            ++m_num_busy;
+        }
+        m_cv_space.notify_all();
+
+        for (size_t i = 0; i < m_tasks.size(); ++i) {
+            Task& task = m_tasks[i];
+            bool ordered = task.task->IsOrdered();
+
+            // Frames are dequeued in order, so the frame this one waits for is already being written.
+            if (ordered) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv_order.wait(lock, [&]() { return task.next_frame == snapshot.frame; });
+            }
+
+            try {
+                task.task->Write(*snapshot.buffers[i]);
+            } catch (const std::exception& e) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_error.empty())
+                    m_error = e.what();
+            }
+
+            if (ordered) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    task.next_frame++;
+                }
+                m_cv_order.notify_all();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& buffer : snapshot.buffers)
+                m_pool.push_back(std::move(buffer));
+            --m_num_busy;
+        }
+        m_cv_space.notify_all();
+    }
+}
+
+}  // end namespace utils
+}  // end namespace chrono
@@ -0,0 +1,206 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Asynchronous output pipeline: snapshots of the system state are captured on
+// the simulation thread into pooled buffers and processed (formatted, written
+// to disk) by writer threads.
+//
+// =============================================================================
+
+#ifndef CH_OUTPUT_PIPELINE_H
+#define CH_OUTPUT_PIPELINE_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Snapshot buffer of one output task for one frame.
+/// Buffers are pooled by the pipeline and reused: tasks should fill the containers with assign/resize
+/// (not by creating new ones) so that their capacity is retained and steady-state captures do not
+/// allocate memory.
+struct ChOutputFrame {
+    unsigned int frame;         ///< frame number (set by the pipeline)
+    double time;                ///< simulation time (set by the pipeline)
+    std::vector<double> reals;  ///< real data captured by the task
+    std::vector<int> ints;      ///< integer data captured by the task
+    std::vector<char> bytes;    ///< raw data captured by the task
+};
+
+/// Base class for tasks of an output pipeline.
+/// Capture() runs on the simulation thread and should only copy the needed data; Write() runs on a
+/// writer thread and does the expensive part (formatting, compression, I/O). Write() must not access
+/// the system, which is being advanced concurrently.
+class ChApi ChOutputTask {
+  public:
+    virtual ~ChOutputTask() {}
+
+    /// Copy the data to be output from the system into the frame buffer (simulation thread).
+    virtual void Capture(ChSystem& system, ChOutputFrame& frame) = 0;
+
+    /// Output the captured data (writer thread).
+    virtual void Write(const ChOutputFrame& frame) = 0;
+
+    /// Return true if frames must be written one at a time, in order (e.g. when appending to a
+    /// single file). Otherwise, different frames may be written concurrently by different threads.
+    virtual bool IsOrdered() const { return true; }
+};
+
+/// Output task writing, at each frame, a CSV file with the position, orientation and (optionally)
+/// linear and angular velocity of all bodies (same format as utils::WriteBodies).
+/// Files are named <prefix>_NNNNN.csv after the frame number.
+class ChApi ChOutputTaskBodies : public ChOutputTask {
+  public:
+    ChOutputTaskBodies(const std::string& prefix,
+                       bool active_only = false,
+                       bool dump_vel = false,
+                       const std::string& delim = ",");
+
+    virtual void Capture(ChSystem& system, ChOutputFrame& frame) override;
+    virtual void Write(const ChOutputFrame& frame) override;
+    virtual bool IsOrdered() const override { return false; }
+
+  private:
+    std::string m_prefix;
+    bool m_active_only;
+    bool m_dump_vel;
+    std::string m_delim;
+};
+
+/// Asynchronous output pipeline.
+/// At each call to Submit(), every task captures a snapshot of the system into a pooled buffer; the
+/// snapshot is then appended to a bounded queue which is drained by one or more writer threads.
+/// When the queue is full, Submit() either waits for a free slot or drops the frame, depending on
+/// the selected policy; statistics on this back-pressure are available, to tune the number of
+/// writer threads and the queue length.
+///
+/// Usage:
+///   ChOutputPipeline output(2);
+///   output.AddTask(std::make_shared<ChOutputTaskBodies>("out/bodies"));
+///   output.SetOutputStep(0.01);
+///   while (...) {
+///       system.DoStepDynamics(step);
+///       output.Update(system);
+///   }
+///   output.Flush();
+class ChApi ChOutputPipeline {
+  public:
+    /// Behavior of Submit() when the queue is full.
+    enum eChQueuePolicy {
+        BLOCK,  ///< wait until a frame is written
+        DROP    ///< skip the frame
+    };
+
+    ChOutputPipeline(int num_threads = 1,             ///< number of writer threads
+                     size_t max_queued_frames = 8,    ///< max. number of frames waiting to be written
+                     eChQueuePolicy policy = BLOCK    ///< behavior when the queue is full
+                     );
+
+    /// Write all pending frames and stop the writer threads.
+    ~ChOutputPipeline();
+
+    /// Add an output task. Tasks must be added before the first frame is submitted.
+    void AddTask(std::shared_ptr<ChOutputTask> task);
+
+    /// Set the interval between output frames used by Update() (default: 0, output at each call).
+    void SetOutputStep(double step) { m_output_step = step; }
+
+    /// Submit a frame if at least one output step elapsed since the last submitted frame.
+    /// Return true if a frame was submitted.
+    bool Update(ChSystem& system);
+
+    /// Capture a snapshot of the system for all tasks and enqueue it.
+    /// Return false if the frame was dropped because the queue was full (DROP policy).
+    /// If a writer thread failed, the corresponding exception is rethrown here.
+    bool Submit(ChSystem& system);
+
+    /// Block until all enqueued frames were written.
+    /// If a writer thread failed, the corresponding exception is rethrown here.
+    void Flush();
+
+    /// Number of frames submitted (including the dropped ones).
+    unsigned int GetNumSubmitted() const { return m_num_submitted; }
+
+    /// Number of frames dropped because the queue was full (DROP policy).
+    unsigned int GetNumDropped() const { return m_num_dropped; }
+
+    /// Number of times Submit() had to wait for a free slot (BLOCK policy).
+    unsigned int GetNumBlocked() const { return m_num_blocked; }
+
+    /// Cumulative time (in seconds) spent by Submit() waiting for a free slot.
+    double GetBlockedTime() const { return m_blocked_time; }
+
+    /// Cumulative time (in seconds) spent capturing snapshots on the simulation thread.
+    double GetCaptureTime() const { return m_capture_time; }
+
+    /// Largest number of frames observed in the queue.
+    size_t GetMaxQueueLength() const { return m_max_queue_length; }
+
+  private:
+    /// Snapshot of one frame, for all tasks.
+    struct Snapshot {
+        unsigned int frame;
+        std::vector<std::unique_ptr<ChOutputFrame>> buffers;
+    };
+
+    /// Per-task state.
+    struct Task {
+        std::shared_ptr<ChOutputTask> task;
+        unsigned int next_frame;  ///< next frame to be written (ordered tasks)
+    };
+
+    void Process();
+    void CheckError();
+
+    std::vector<Task> m_tasks;
+    size_t m_max_queued;
+    eChQueuePolicy m_policy;
+    double m_output_step;
+    double m_next_output_time;
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_cv_work;   ///< signaled when a frame is enqueued or the pipeline is stopped
+    std::condition_variable m_cv_space;  ///< signaled when a frame was written
+    std::condition_variable m_cv_order;  ///< signaled when an ordered task advanced to its next frame
+    std::deque<Snapshot> m_queue;
+    std::vector<std::unique_ptr<ChOutputFrame>> m_pool;
+    int m_num_busy;
+    bool m_stop;
+    std::string m_error;
+
+    unsigned int m_num_enqueued;
+    unsigned int m_num_submitted;
+    unsigned int m_num_dropped;
+    unsigned int m_num_blocked;
+    double m_blocked_time;
+    double m_capture_time;
+    size_t m_max_queue_length;
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,457 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Binary, columnar output of simulation trajectories.
+//
+// =============================================================================
+
+#include <chrono>
+#include <cstring>
+
+#include "chrono/core/ChException.h"
+#include "chrono/utils/ChSimulationOutput.h"
+
+namespace chrono {
+namespace utils {
+
+// Round up to a multiple of 8 bytes.
+static size_t Align8(size_t n) {
+    return (n + 7) & ~static_cast<size_t>(7);
+}
+
+// -----------------------------------------------------------------------------
+// ChSimulationOutputLayout
+// -----------------------------------------------------------------------------
+
+ChSimulationOutputLayout::ChSimulationOutputLayout(unsigned int blocks, const ChSimulationOutputFrameHeader& header) {
+    size_t nb = header.num_bodies;
+    size_t ni = header.num_items;
+    size_t nc = header.num_contacts;
+
+    size_t off = 0;
+    auto column = [&off](size_t bytes) {
+        size_t start = off;
+        off += Align8(bytes);
+        return start;
+    };
+
+    body_ids = column(nb * sizeof(int32_t));
+
+    for (int i = 0; i < 3; i++)
+        body_pos[i] = (blocks & OUTPUT_BODY_POSITIONS) ? column(nb * sizeof(double)) : npos;
+    for (int i = 0; i < 4; i++)
+        body_rot[i] = (blocks & OUTPUT_BODY_ROTATIONS) ? column(nb * sizeof(double)) : npos;
+    for (int i = 0; i < 3; i++)
+        body_lin_vel[i] = (blocks & OUTPUT_BODY_VELOCITIES) ? column(nb * sizeof(double)) : npos;
+    for (int i = 0; i < 3; i++)
+        body_ang_vel[i] = (blocks & OUTPUT_BODY_VELOCITIES) ? column(nb * sizeof(double)) : npos;
+
+    if (blocks & OUTPUT_ITEM_STATES) {
+        item_ids = column(ni * sizeof(int32_t));
+        item_nx = column(ni * sizeof(uint32_t));
+        item_nv = column(ni * sizeof(uint32_t));
+        item_x = column(header.num_item_x * sizeof(double));
+        item_v = column(header.num_item_v * sizeof(double));
+    } else {
+        item_ids = item_nx = item_nv = item_x = item_v = npos;
+    }
+
+    if (blocks & OUTPUT_CONTACT_FORCES) {
+        contact_bodyA = column(nc * sizeof(int32_t));
+        contact_bodyB = column(nc * sizeof(int32_t));
+        for (int i = 0; i < 3; i++)
+            contact_pos[i] = column(nc * sizeof(double));
+        for (int i = 0; i < 3; i++)
+            contact_normal[i] = column(nc * sizeof(double));
+        for (int i = 0; i < 3; i++)
+            contact_force[i] = column(nc * sizeof(double));
+    } else {
+        contact_bodyA = contact_bodyB = npos;
+        for (int i = 0; i < 3; i++)
+            contact_pos[i] = contact_normal[i] = contact_force[i] = npos;
+    }
+
+    size = off;
+}
+
+// -----------------------------------------------------------------------------
+// ChSimulationOutputCodec
+// -----------------------------------------------------------------------------
+
+void ChSimulationOutputCodec::DecompressPrefix(const char* src,
+                                               size_t src_size,
+                                               char* dst,
+                                               size_t dst_size,
+                                               size_t raw_size) {
+    std::vector<char> buffer(raw_size);
+    Decompress(src, src_size, buffer.data(), raw_size);
+    std::memcpy(dst, buffer.data(), dst_size);
+}
+
+// -----------------------------------------------------------------------------
+// Contact reporter used to capture contact data in a snapshot.
+// -----------------------------------------------------------------------------
+
+class OutputContactCollector : public ChContactContainer::ReportContactCallback {
+  public:
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        bodyA.push_back(GetId(contactobjA));
+        bodyB.push_back(GetId(contactobjB));
+        pos.push_back(pA);
+        normal.push_back(plane_coord.Get_A_Xaxis());
+        force.push_back(plane_coord.Matr_x_Vect(react_forces));
+        return true;
+    }
+
+    std::vector<int32_t> bodyA;
+    std::vector<int32_t> bodyB;
+    std::vector<ChVector<>> pos;
+    std::vector<ChVector<>> normal;
+    std::vector<ChVector<>> force;
+
+  private:
+    static int32_t GetId(ChContactable* obj) {
+        if (auto body = dynamic_cast<ChBody*>(obj))
+            return body->GetIdentifier();
+        return -1;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// ChSimulationOutputWriter
+// -----------------------------------------------------------------------------
+
+ChSimulationOutputWriter::ChSimulationOutputWriter(const std::string& filename,
+                                                   unsigned int blocks,
+                                                   size_t max_queued_frames)
+    : m_filename(filename),
+      m_blocks(blocks & OUTPUT_ALL),
+      m_max_queued(max_queued_frames > 0 ? max_queued_frames : 1),
+      m_num_frames(0),
+      m_blocked_time(0),
+      m_busy(false),
+      m_closing(false),
+      m_closed(false),
+      m_failed(false),
+      m_bytes_written(0) {
+    m_file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file.good())
+        throw ChException("Cannot open simulation output file " + filename);
+
+    ChSimulationOutputFileHeader header;
+    std::memcpy(header.magic, "CHSIMOUT", 8);
+    header.version = CH_OUTPUT_FORMAT_VERSION;
+    header.blocks = m_blocks;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    m_thread = std::thread(&ChSimulationOutputWriter::Process, this);
+}
+
+ChSimulationOutputWriter::~ChSimulationOutputWriter() {
+    try {
+        Close();
+    } catch (const ChException&) {
+    }
+}
+
+void ChSimulationOutputWriter::SetCodec(std::shared_ptr<ChSimulationOutputCodec> codec) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_codec = codec;
+}
+
+bool ChSimulationOutputWriter::HasFailed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failed;
+}
+
+uint64_t ChSimulationOutputWriter::GetNumBytesWritten() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytes_written;
+}
+
+void ChSimulationOutputWriter::WriteFrame(ChSystem* system) {
+    Frame frame;
+
+    // Recycle a payload buffer, waiting for room in the queue if necessary.
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_closing)
+            return;
+        if (m_failed)
+            throw ChException("Error writing simulation output file " + m_filename);
+        if (m_queue.size() >= m_max_queued) {
+            auto start = std::chrono::steady_clock::now();
+            m_cv_space.wait(lock, [this]() { return m_queue.size() < m_max_queued; });
+            m_blocked_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        if (!m_pool.empty()) {
+            frame.payload.swap(m_pool.back());
+            m_pool.pop_back();
+        }
+    }
+
+    frame.header.frame = m_num_frames++;
+    Capture(system, frame);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(frame));
+    }
+    m_cv_work.notify_one();
+}
+
+void ChSimulationOutputWriter::Capture(ChSystem* system, Frame& frame) {
+    auto& bodies = *system->Get_bodylist();
+
+    ChSimulationOutputFrameHeader& hdr = frame.header;
+    hdr.magic = CH_OUTPUT_FRAME_MAGIC;
+    hdr.codec = 0;
+    hdr.time = system->GetChTime();
+    hdr.num_bodies = static_cast<uint32_t>(bodies.size());
+    hdr.num_items = 0;
+    hdr.num_item_x = 0;
+    hdr.num_item_v = 0;
+    hdr.num_contacts = 0;
+    hdr.reserved = 0;
+
+    // Physics items (other than bodies and links) which carry state, e.g. FEA meshes.
+    std::vector<ChPhysicsItem*> items;
+    if (m_blocks & OUTPUT_ITEM_STATES) {
+        for (auto& item : *system->Get_otherphysicslist()) {
+            if (item->GetDOF() > 0) {
+                items.push_back(item.get());
+                hdr.num_item_x += item->GetDOF();
+                hdr.num_item_v += item->GetDOF_w();
+            }
+        }
+        hdr.num_items = static_cast<uint32_t>(items.size());
+    }
+
+    OutputContactCollector contacts;
+    if (m_blocks & OUTPUT_CONTACT_FORCES) {
+        system->GetContactContainer()->ReportAllContacts(&contacts);
+        hdr.num_contacts = static_cast<uint32_t>(contacts.pos.size());
+    }
+
+    ChSimulationOutputLayout layout(m_blocks, hdr);
+    frame.payload.resize(layout.size);
+    char* data = frame.payload.data();
+    std::memset(data, 0, layout.size);
+
+    auto column_d = [data](size_t offset) { return reinterpret_cast<double*>(data + offset); };
+    auto column_i = [data](size_t offset) { return reinterpret_cast<int32_t*>(data + offset); };
+    auto column_u = [data](size_t offset) { return reinterpret_cast<uint32_t*>(data + offset); };
+
+    int32_t* ids = column_i(layout.body_ids);
+    for (size_t i = 0; i < bodies.size(); i++)
+        ids[i] = bodies[i]->GetIdentifier();
+
+    if (m_blocks & OUTPUT_BODY_POSITIONS) {
+        double* c[3] = {column_d(layout.body_pos[0]), column_d(layout.body_pos[1]), column_d(layout.body_pos[2])};
+        for (size_t i = 0; i < bodies.size(); i++) {
+            const ChVector<>& p = bodies[i]->GetPos();
+            c[0][i] = p.x();
+            c[1][i] = p.y();
+            c[2][i] = p.z();
+        }
+    }
+
+    if (m_blocks & OUTPUT_BODY_ROTATIONS) {
+        double* c[4] = {column_d(layout.body_rot[0]), column_d(layout.body_rot[1]), column_d(layout.body_rot[2]),
+                        column_d(layout.body_rot[3])};
+        for (size_t i = 0; i < bodies.size(); i++) {
+            const ChQuaternion<>& q = bodies[i]->GetRot();
+            c[0][i] = q.e0();
+            c[1][i] = q.e1();
+            c[2][i] = q.e2();
+            c[3][i] = q.e3();
+        }
+    }
+
+    if (m_blocks & OUTPUT_BODY_VELOCITIES) {
+        double* v[3] = {column_d(layout.body_lin_vel[0]), column_d(layout.body_lin_vel[1]),
+                        column_d(layout.body_lin_vel[2])};
+        double* w[3] = {column_d(layout.body_ang_vel[0]), column_d(layout.body_ang_vel[1]),
+                        column_d(layout.body_ang_vel[2])};
+        for (size_t i = 0; i < bodies.size(); i++) {
+            const ChVector<>& lin = bodies[i]->GetPos_dt();
+            ChVector<> ang = bodies[i]->GetWvel_par();
+            v[0][i] = lin.x();
+            v[1][i] = lin.y();
+            v[2][i] = lin.z();
+            w[0][i] = ang.x();
+            w[1][i] = ang.y();
+            w[2][i] = ang.z();
+        }
+    }
+
+    if (m_blocks & OUTPUT_ITEM_STATES) {
+        int32_t* item_ids = column_i(layout.item_ids);
+        uint32_t* item_nx = column_u(layout.item_nx);
+        uint32_t* item_nv = column_u(layout.item_nv);
+        double* x = column_d(layout.item_x);
+        double* v = column_d(layout.item_v);
+        for (size_t i = 0; i < items.size(); i++) {
+            int nx = items[i]->GetDOF();
+            int nv = items[i]->GetDOF_w();
+            if (m_x.GetRows() != nx)
+                m_x.Reset(nx, nullptr);
+            if (m_v.GetRows() != nv)
+                m_v.Reset(nv, nullptr);
+            double T;
+            items[i]->IntStateGather(0, m_x, 0, m_v, T);
+            std::memcpy(x, m_x.GetAddress(), nx * sizeof(double));
+            std::memcpy(v, m_v.GetAddress(), nv * sizeof(double));
+            x += nx;
+            v += nv;
+            item_ids[i] = items[i]->GetIdentifier();
+            item_nx[i] = nx;
+            item_nv[i] = nv;
+        }
+    }
+
+    if (m_blocks & OUTPUT_CONTACT_FORCES) {
+        std::memcpy(data + layout.contact_bodyA, contacts.bodyA.data(), hdr.num_contacts * sizeof(int32_t));
+        std::memcpy(data + layout.contact_bodyB, contacts.bodyB.data(), hdr.num_contacts * sizeof(int32_t));
+        for (int k = 0; k < 3; k++) {
+            double* p = column_d(layout.contact_pos[k]);
+            double* n = column_d(layout.contact_normal[k]);
+            double* f = column_d(layout.contact_force[k]);
+            for (uint32_t i = 0; i < hdr.num_contacts; i++) {
+                p[i] = contacts.pos[i][k];
+                n[i] = contacts.normal[i][k];
+                f[i] = contacts.force[i][k];
+            }
+        }
+    }
+
+    hdr.raw_size = layout.size;
+    hdr.stored_size = layout.size;
+}
+
+void ChSimulationOutputWriter::Process() {
+    while (true) {
+        Frame frame;
+        std::shared_ptr<ChSimulationOutputCodec> codec;
+        bool last;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv_work.wait(lock, [this]() { return !m_queue.empty() || m_closing; });
+            if (m_queue.empty())
+                break;
+            frame = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_busy = true;
+            codec = m_codec;
+            last = m_queue.empty();
+        }
+
+        // Only the writer thread sets the failure flag, so it can be read here without locking.
+        // After a failure, frames are discarded so that no frame follows a partially written one.
+        bool written = false;
+        if (!m_failed) {
+            const char* payload = frame.payload.data();
+            if (codec) {
+                codec->Compress(frame.payload.data(), frame.payload.size(), m_compressed);
+                frame.header.codec = codec->GetId();
+                frame.header.stored_size = m_compressed.size();
+                payload = m_compressed.data();
+            }
+
+            uint64_t offset = static_cast<uint64_t>(m_file.tellp());
+            m_file.write(reinterpret_cast<const char*>(&frame.header), sizeof(frame.header));
+            m_file.write(payload, frame.header.stored_size);
+
+            // Pad to keep all frame headers 8-byte aligned
+            static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+            size_t padding = Align8(frame.header.stored_size) - frame.header.stored_size;
+            m_file.write(zeros, padding);
+
+            // Flush when the queue is drained, so that write errors are detected by the next Flush().
+            if (last)
+                m_file.flush();
+
+            written = m_file.good();
+            if (written)
+                m_offsets.push_back(offset);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (written)
+                m_bytes_written += frame.header.stored_size;
+            else
+                m_failed = true;
+            m_pool.push_back(std::move(frame.payload));
+            m_busy = false;
+        }
+        m_cv_space.notify_all();
+    }
+}
+
+void ChSimulationOutputWriter::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv_space.wait(lock, [this]() { return m_queue.empty() && !m_busy; });
+    if (m_failed)
+        throw ChException("Error writing simulation output file " + m_filename);
+}
+
+void ChSimulationOutputWriter::Close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed)
+            return;
+        m_closed = true;
+        m_closing = true;
+    }
+    m_cv_work.notify_all();
+    if (m_thread.joinable())
+        m_thread.join();
+
+    // Do not write an index which would refer to frames which were not (completely) written.
+    if (m_failed) {
+        m_file.close();
+        throw ChException("Error writing simulation output file " + m_filename);
+    }
+
+    // Append the frame index and the trailer.
+    ChSimulationOutputIndexHeader index;
+    index.magic = CH_OUTPUT_INDEX_MAGIC;
+    index.reserved = 0;
+    index.num_frames = m_offsets.size();
+
+    ChSimulationOutputTrailer trailer;
+    trailer.index_offset = static_cast<uint64_t>(m_file.tellp());
+    std::memcpy(trailer.magic, "CHSOINDX", 8);
+
+    m_file.write(reinterpret_cast<const char*>(&index), sizeof(index));
+    m_file.write(reinterpret_cast<const char*>(m_offsets.data()), m_offsets.size() * sizeof(uint64_t));
+    m_file.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer));
+    m_file.close();
+    if (m_file.fail()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_failed = true;
+        }
+        throw ChException("Error writing the index of simulation output file " + m_filename);
+    }
+}
+
+}  // end namespace utils
+}  // end namespace chrono
@@ -0,0 +1,257 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Binary, columnar output of simulation trajectories.
+//
+// File layout (native endianness, all blocks 8-byte aligned):
+//
+//   ChSimulationOutputFileHeader
+//   frame 0:  ChSimulationOutputFrameHeader + payload
+//   frame 1:  ChSimulationOutputFrameHeader + payload
+//   ...
+//   index:    ChSimulationOutputIndexHeader + uint64 offset of each frame
+//   trailer:  ChSimulationOutputTrailer
+//
+// Each frame payload is a sequence of columns (structure of arrays), in the
+// order and with the offsets given by ChSimulationOutputLayout:
+//   - body identifiers                        int32  [num_bodies]
+//   - body positions           x, y, z        double [num_bodies] each
+//   - body rotations           e0, e1, e2, e3 double [num_bodies] each
+//   - body velocities          vx, vy, vz     double [num_bodies] each
+//     (absolute)               wx, wy, wz     double [num_bodies] each
+//   - physics items with state (e.g. FEA meshes):
+//       identifiers, sizes of x and v        int32/uint32 [num_items] each
+//       concatenated position-level states   double [num_item_x]
+//       concatenated velocity-level states   double [num_item_v]
+//   - contacts:
+//       identifiers of bodies A and B        int32  [num_contacts] each (-1 if not a body)
+//       contact point on A   x, y, z         double [num_contacts] each
+//       contact normal       x, y, z         double [num_contacts] each
+//       contact force        x, y, z         double [num_contacts] each (absolute frame)
+// Only the columns enabled in the file header are present. A payload can be
+// stored compressed, in which case the frame header records the codec id.
+//
+// =============================================================================
+
+#ifndef CH_SIMULATION_OUTPUT_H
+#define CH_SIMULATION_OUTPUT_H
+
+#include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Flags selecting the data blocks stored in each frame of a simulation output file.
+enum ChSimulationOutputBlocks {
+    OUTPUT_BODY_POSITIONS = 1 << 0,   ///< body reference frame positions
+    OUTPUT_BODY_ROTATIONS = 1 << 1,   ///< body reference frame rotations (quaternions)
+    OUTPUT_BODY_VELOCITIES = 1 << 2,  ///< body linear and angular velocities (absolute frame)
+    OUTPUT_ITEM_STATES = 1 << 3,      ///< full state of other physics items with DOFs (e.g. FEA meshes)
+    OUTPUT_CONTACT_FORCES = 1 << 4,   ///< contact points, normals and forces
+    OUTPUT_ALL = 0x1F
+};
+
+/// Version of the simulation output file format.
+const uint32_t CH_OUTPUT_FORMAT_VERSION = 1;
+
+/// Marker at the beginning of each frame header ("FRAM").
+const uint32_t CH_OUTPUT_FRAME_MAGIC = 0x4D415246;
+
+/// Marker at the beginning of the frame index ("INDX").
+const uint32_t CH_OUTPUT_INDEX_MAGIC = 0x58444E49;
+
+/// Header at the beginning of a simulation output file.
+struct ChSimulationOutputFileHeader {
+    char magic[8];     ///< "CHSIMOUT"
+    uint32_t version;  ///< file format version
+    uint32_t blocks;   ///< mask of ChSimulationOutputBlocks stored in each frame
+};
+
+/// Header preceding the payload of each frame.
+struct ChSimulationOutputFrameHeader {
+    uint32_t magic;          ///< frame marker ("FRAM")
+    uint32_t codec;          ///< id of the codec used for the payload (0: uncompressed)
+    uint64_t frame;          ///< frame number
+    double time;             ///< simulation time
+    uint32_t num_bodies;     ///< number of bodies
+    uint32_t num_items;      ///< number of physics items with state
+    uint32_t num_item_x;     ///< total size of the position-level item states
+    uint32_t num_item_v;     ///< total size of the velocity-level item states
+    uint32_t num_contacts;   ///< number of contacts
+    uint32_t reserved;       ///< unused (padding)
+    uint64_t raw_size;       ///< size of the uncompressed payload
+    uint64_t stored_size;    ///< size of the payload as stored in the file
+};
+
+/// Header of the frame index written at the end of a simulation output file.
+struct ChSimulationOutputIndexHeader {
+    uint32_t magic;       ///< index marker ("INDX")
+    uint32_t reserved;    ///< unused (padding)
+    uint64_t num_frames;  ///< number of frame offsets that follow
+};
+
+/// Trailer at the very end of a (properly closed) simulation output file.
+struct ChSimulationOutputTrailer {
+    uint64_t index_offset;  ///< file offset of the ChSimulationOutputIndexHeader
+    char magic[8];          ///< "CHSOINDX"
+};
+
+/// Byte offsets of the columns of a frame payload.
+/// Offsets of columns not present in the frame are set to ChSimulationOutputLayout::npos.
+struct ChApi ChSimulationOutputLayout {
+    static const size_t npos = static_cast<size_t>(-1);
+
+    ChSimulationOutputLayout(unsigned int blocks, const ChSimulationOutputFrameHeader& header);
+
+    size_t body_ids;
+    size_t body_pos[3];
+    size_t body_rot[4];
+    size_t body_lin_vel[3];
+    size_t body_ang_vel[3];
+    size_t item_ids;
+    size_t item_nx;
+    size_t item_nv;
+    size_t item_x;
+    size_t item_v;
+    size_t contact_bodyA;
+    size_t contact_bodyB;
+    size_t contact_pos[3];
+    size_t contact_normal[3];
+    size_t contact_force[3];
+    size_t size;  ///< total payload size
+};
+
+/// Base class for a codec used to compress frame payloads.
+/// Chrono does not bundle compression libraries; a user can wrap LZ4, zstd, etc. in a class
+/// derived from this one and register it with both the writer and the reader.
+class ChApi ChSimulationOutputCodec {
+  public:
+    virtual ~ChSimulationOutputCodec() {}
+
+    /// Return the codec identifier stored in frame headers (must be different from 0).
+    virtual uint32_t GetId() const = 0;
+
+    /// Compress the given buffer, replacing the content of 'dst'.
+    virtual void Compress(const char* src, size_t src_size, std::vector<char>& dst) = 0;
+
+    /// Decompress the given buffer into 'dst', which has room for exactly 'dst_size' bytes.
+    virtual void Decompress(const char* src, size_t src_size, char* dst, size_t dst_size) = 0;
+
+    /// Decompress only the first 'dst_size' bytes of a payload with uncompressed size 'raw_size'.
+    /// The default implementation decompresses the whole payload into a temporary buffer; codecs which
+    /// support streaming decompression should override it to stop early.
+    virtual void DecompressPrefix(const char* src, size_t src_size, char* dst, size_t dst_size, size_t raw_size);
+};
+
+/// Streaming writer of simulation output files.
+/// Each call to WriteFrame() copies the requested state of the system into a pooled buffer (on the
+/// calling thread) and hands it to a background thread which compresses and writes it to disk, so
+/// that the simulation can proceed with the next step while the previous snapshot is serialized.
+class ChApi ChSimulationOutputWriter {
+  public:
+    ChSimulationOutputWriter(const std::string& filename,      ///< name of the output file
+                             unsigned int blocks = OUTPUT_ALL,  ///< mask of ChSimulationOutputBlocks
+                             size_t max_queued_frames = 4       ///< max. number of frames waiting to be written
+                             );
+
+    /// Flush all pending frames and close the file.
+    /// Write errors cannot be reported here; call Close() explicitly to check for them.
+    ~ChSimulationOutputWriter();
+
+    /// Set the codec used to compress frame payloads (default: none).
+    void SetCodec(std::shared_ptr<ChSimulationOutputCodec> codec);
+
+    /// Capture a snapshot of the given system and enqueue it for writing.
+    /// If the queue is full, this call blocks until the writer thread catches up.
+    /// Throws a ChException if writing a previous frame failed (e.g. disk full).
+    void WriteFrame(ChSystem* system);
+
+    /// Block until all enqueued frames were written.
+    /// Throws a ChException if writing any frame failed.
+    void Flush();
+
+    /// Flush all pending frames, write the frame index and close the file.
+    /// Throws a ChException if writing any frame, or the index, failed. In that case no index is written, and
+    /// the frames written before the failure can still be read (by walking the frame headers).
+    void Close();
+
+    /// Return true if writing to the file failed.
+    bool HasFailed() const;
+
+    /// Return the number of frames enqueued so far.
+    uint64_t GetNumFrames() const { return m_num_frames; }
+
+    /// Return the number of payload bytes written so far (after compression).
+    uint64_t GetNumBytesWritten() const;
+
+    /// Return the cumulative time (in seconds) the simulation thread was blocked on a full queue.
+    double GetBlockedTime() const { return m_blocked_time; }
+
+  private:
+    struct Frame {
+        ChSimulationOutputFrameHeader header;
+        std::vector<char> payload;
+    };
+
+    void Capture(ChSystem* system, Frame& frame);
+    void Process();
+
+    std::ofstream m_file;
+    std::string m_filename;
+    unsigned int m_blocks;
+    size_t m_max_queued;
+    std::shared_ptr<ChSimulationOutputCodec> m_codec;
+
+    uint64_t m_num_frames;
+    double m_blocked_time;
+
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv_work;   ///< signaled when a frame is enqueued or the writer is closed
+    std::condition_variable m_cv_space;  ///< signaled when a frame was written
+    std::deque<Frame> m_queue;
+    std::vector<std::vector<char>> m_pool;
+    bool m_busy;
+    bool m_closing;
+    bool m_closed;
+    bool m_failed;  ///< set by the writer thread when a write fails; no more frames are written afterwards
+
+    // Written (and read) only by the writer thread, until Close()
+    std::vector<uint64_t> m_offsets;
+    std::vector<char> m_compressed;
+    uint64_t m_bytes_written;
+
+    // Scratch data used when capturing a snapshot (simulation thread only)
+    ChState m_x;
+    ChStateDelta m_v;
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
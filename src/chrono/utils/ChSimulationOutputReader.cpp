@@ -0,0 +1,289 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Random-access reader of simulation output files.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cstring>
+
+#include "chrono/core/ChException.h"
+#include "chrono/utils/ChSimulationOutputReader.h"
+
+namespace chrono {
+namespace utils {
+
+// -----------------------------------------------------------------------------
+// Frame view
+// -----------------------------------------------------------------------------
+
+ChSimulationOutputReader::Frame::Frame(unsigned int blocks,
+                                       const ChSimulationOutputFrameHeader* header,
+                                       const char* payload)
+    : m_header(header), m_data(payload), m_layout(blocks, *header) {}
+
+ChVector<> ChSimulationOutputReader::Frame::GetBodyPos(size_t i) const {
+    return ChVector<>(GetBodyPos(0)[i], GetBodyPos(1)[i], GetBodyPos(2)[i]);
+}
+
+ChQuaternion<> ChSimulationOutputReader::Frame::GetBodyRot(size_t i) const {
+    return ChQuaternion<>(GetBodyRot(0)[i], GetBodyRot(1)[i], GetBodyRot(2)[i], GetBodyRot(3)[i]);
+}
+
+ChVector<> ChSimulationOutputReader::Frame::GetBodyLinVel(size_t i) const {
+    return ChVector<>(GetBodyLinVel(0)[i], GetBodyLinVel(1)[i], GetBodyLinVel(2)[i]);
+}
+
+ChVector<> ChSimulationOutputReader::Frame::GetBodyAngVel(size_t i) const {
+    return ChVector<>(GetBodyAngVel(0)[i], GetBodyAngVel(1)[i], GetBodyAngVel(2)[i]);
+}
+
+// -----------------------------------------------------------------------------
+// Body history view
+// -----------------------------------------------------------------------------
+
+const double* ChSimulationOutputReader::BodyHistory::Value(size_t i, size_t offset) const {
+    return reinterpret_cast<const double*>(m_reader->GetPayload(m_samples[i].frame) + offset) + m_samples[i].slot;
+}
+
+double ChSimulationOutputReader::BodyHistory::GetTime(size_t i) const {
+    return m_reader->GetTime(m_samples[i].frame);
+}
+
+ChVector<> ChSimulationOutputReader::BodyHistory::GetPos(size_t i) const {
+    ChSimulationOutputLayout layout(m_reader->m_blocks, *m_reader->m_frames[m_samples[i].frame]);
+    if (layout.body_pos[0] == ChSimulationOutputLayout::npos)
+        return VNULL;
+    return ChVector<>(*Value(i, layout.body_pos[0]), *Value(i, layout.body_pos[1]), *Value(i, layout.body_pos[2]));
+}
+
+ChQuaternion<> ChSimulationOutputReader::BodyHistory::GetRot(size_t i) const {
+    ChSimulationOutputLayout layout(m_reader->m_blocks, *m_reader->m_frames[m_samples[i].frame]);
+    if (layout.body_rot[0] == ChSimulationOutputLayout::npos)
+        return QUNIT;
+    return ChQuaternion<>(*Value(i, layout.body_rot[0]), *Value(i, layout.body_rot[1]),
+                          *Value(i, layout.body_rot[2]), *Value(i, layout.body_rot[3]));
+}
+
+ChVector<> ChSimulationOutputReader::BodyHistory::GetLinVel(size_t i) const {
+    ChSimulationOutputLayout layout(m_reader->m_blocks, *m_reader->m_frames[m_samples[i].frame]);
+    if (layout.body_lin_vel[0] == ChSimulationOutputLayout::npos)
+        return VNULL;
+    return ChVector<>(*Value(i, layout.body_lin_vel[0]), *Value(i, layout.body_lin_vel[1]),
+                      *Value(i, layout.body_lin_vel[2]));
+}
+
+ChVector<> ChSimulationOutputReader::BodyHistory::GetAngVel(size_t i) const {
+    ChSimulationOutputLayout layout(m_reader->m_blocks, *m_reader->m_frames[m_samples[i].frame]);
+    if (layout.body_ang_vel[0] == ChSimulationOutputLayout::npos)
+        return VNULL;
+    return ChVector<>(*Value(i, layout.body_ang_vel[0]), *Value(i, layout.body_ang_vel[1]),
+                      *Value(i, layout.body_ang_vel[2]));
+}
+
+// -----------------------------------------------------------------------------
+// ChSimulationOutputReader
+// -----------------------------------------------------------------------------
+
+// Check that a frame header at the given offset, and its payload, lie within the file and are consistent.
+static bool ValidFrame(const char* data, size_t size, uint64_t offset, unsigned int blocks) {
+    if (offset < sizeof(ChSimulationOutputFileHeader) || offset % 8 != 0 ||
+        size < sizeof(ChSimulationOutputFrameHeader) || offset > size - sizeof(ChSimulationOutputFrameHeader))
+        return false;
+    auto frame = reinterpret_cast<const ChSimulationOutputFrameHeader*>(data + offset);
+    if (frame->magic != CH_OUTPUT_FRAME_MAGIC)
+        return false;
+    if (frame->stored_size > size - offset - sizeof(ChSimulationOutputFrameHeader))
+        return false;
+    if (frame->codec == 0 && frame->stored_size != frame->raw_size)
+        return false;
+    // The writer stores the exact size of the layout: this also bounds the buffer allocated to decompress it.
+    return ChSimulationOutputLayout(blocks, *frame).size == frame->raw_size;
+}
+
+ChSimulationOutputReader::ChSimulationOutputReader(const std::string& filename)
+    : m_cache_size(16), m_body_index_built(false) {
+    if (!m_file.Open(filename))
+        throw ChException("Cannot open simulation output file " + filename);
+
+    if (m_file.GetSize() < sizeof(ChSimulationOutputFileHeader))
+        throw ChException("Invalid simulation output file " + filename);
+
+    auto header = reinterpret_cast<const ChSimulationOutputFileHeader*>(m_file.GetData());
+    if (std::memcmp(header->magic, "CHSIMOUT", 8) != 0)
+        throw ChException("Invalid simulation output file " + filename);
+    if (header->version > CH_OUTPUT_FORMAT_VERSION)
+        throw ChException("Unsupported version of simulation output file " + filename);
+
+    m_blocks = header->blocks;
+
+    BuildFrameIndex();
+}
+
+void ChSimulationOutputReader::BuildFrameIndex() {
+    const char* data = m_file.GetData();
+    size_t size = m_file.GetSize();
+
+    // Use the index at the end of the file, if present and consistent.
+    const size_t min_size =
+        sizeof(ChSimulationOutputFileHeader) + sizeof(ChSimulationOutputIndexHeader) + sizeof(ChSimulationOutputTrailer);
+    if (size >= min_size) {
+        auto trailer = reinterpret_cast<const ChSimulationOutputTrailer*>(data + size - sizeof(ChSimulationOutputTrailer));
+        size_t index_end = size - sizeof(ChSimulationOutputTrailer);
+        if (std::memcmp(trailer->magic, "CHSOINDX", 8) == 0 && trailer->index_offset % 8 == 0 &&
+            trailer->index_offset >= sizeof(ChSimulationOutputFileHeader) &&
+            trailer->index_offset <= index_end - sizeof(ChSimulationOutputIndexHeader)) {
+            auto index = reinterpret_cast<const ChSimulationOutputIndexHeader*>(data + trailer->index_offset);
+            auto offsets = reinterpret_cast<const uint64_t*>(index + 1);
+            size_t max_frames = (index_end - trailer->index_offset - sizeof(ChSimulationOutputIndexHeader)) / 8;
+            if (index->magic == CH_OUTPUT_INDEX_MAGIC && index->num_frames <= max_frames) {
+                bool valid = true;
+                m_frames.reserve(index->num_frames);
+                for (uint64_t i = 0; i < index->num_frames && valid; i++) {
+                    valid = offsets[i] < trailer->index_offset && ValidFrame(data, size, offsets[i], m_blocks);
+                    if (valid)
+                        m_frames.push_back(reinterpret_cast<const ChSimulationOutputFrameHeader*>(data + offsets[i]));
+                }
+                if (valid)
+                    return;
+                m_frames.clear();
+            }
+        }
+    }
+
+    // Otherwise (e.g. the writer did not close the file, or the index is corrupt), walk the frame headers.
+    size_t offset = sizeof(ChSimulationOutputFileHeader);
+    while (ValidFrame(data, size, offset, m_blocks)) {
+        auto frame = reinterpret_cast<const ChSimulationOutputFrameHeader*>(data + offset);
+        m_frames.push_back(frame);
+        offset += sizeof(*frame) + static_cast<size_t>((frame->stored_size + 7) & ~static_cast<uint64_t>(7));
+    }
+}
+
+void ChSimulationOutputReader::AddCodec(std::shared_ptr<ChSimulationOutputCodec> codec) {
+    m_codecs[codec->GetId()] = codec;
+}
+
+void ChSimulationOutputReader::SetCacheSize(size_t num_frames) {
+    m_cache_size = std::max(num_frames, static_cast<size_t>(1));
+    EvictFrames(m_cache_size);
+}
+
+void ChSimulationOutputReader::EvictFrames(size_t max_frames) {
+    while (m_cache.size() > max_frames) {
+        auto entry = m_cache.find(m_lru.back());
+        m_spare.push_back(std::move(entry->second.data));
+        m_cache.erase(entry);
+        m_lru.pop_back();
+    }
+}
+
+ChSimulationOutputCodec* ChSimulationOutputReader::GetCodec(const ChSimulationOutputFrameHeader* header) {
+    auto codec = m_codecs.find(header->codec);
+    if (codec == m_codecs.end())
+        throw ChException("No codec registered for compressed simulation output frame");
+    return codec->second.get();
+}
+
+const char* ChSimulationOutputReader::GetPayload(size_t frame) {
+    const ChSimulationOutputFrameHeader* header = m_frames[frame];
+    const char* stored = reinterpret_cast<const char*>(header + 1);
+
+    if (header->codec == 0)
+        return stored;
+
+    auto cached = m_cache.find(frame);
+    if (cached != m_cache.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, cached->second.lru);
+        return cached->second.data.data();
+    }
+
+    ChSimulationOutputCodec* codec = GetCodec(header);
+
+    // Make room for the new frame, reusing the buffer of an evicted one.
+    EvictFrames(m_cache_size - 1);
+    CacheEntry entry;
+    if (!m_spare.empty()) {
+        entry.data = std::move(m_spare.back());
+        m_spare.pop_back();
+    }
+    entry.data.resize(header->raw_size);  // checked against the frame layout (see ValidFrame)
+    codec->Decompress(stored, header->stored_size, entry.data.data(), entry.data.size());
+
+    m_lru.push_front(frame);
+    entry.lru = m_lru.begin();
+    return m_cache.emplace(frame, std::move(entry)).first->second.data.data();
+}
+
+ChSimulationOutputReader::Frame ChSimulationOutputReader::GetFrame(size_t frame) {
+    return Frame(m_blocks, m_frames[frame], GetPayload(frame));
+}
+
+void ChSimulationOutputReader::BuildBodyIndex() {
+    if (m_body_index_built)
+        return;
+
+    // Only the identifier column (at the beginning of the payload) of each frame is touched. Compressed
+    // frames which are not cached are partially decompressed into a scratch buffer, and not cached.
+    for (size_t i = 0; i < m_frames.size(); i++) {
+        const ChSimulationOutputFrameHeader* header = m_frames[i];
+        ChSimulationOutputLayout layout(m_blocks, *header);
+        size_t ids_size = header->num_bodies * sizeof(int32_t);
+
+        const char* payload;
+        auto cached = m_cache.find(i);
+        if (header->codec == 0) {
+            payload = reinterpret_cast<const char*>(header + 1);
+        } else if (cached != m_cache.end()) {
+            payload = cached->second.data.data();
+        } else {
+            m_scratch.resize(layout.body_ids + ids_size);
+            GetCodec(header)->DecompressPrefix(reinterpret_cast<const char*>(header + 1), header->stored_size,
+                                               m_scratch.data(), m_scratch.size(), header->raw_size);
+            payload = m_scratch.data();
+        }
+
+        auto ids = reinterpret_cast<const int32_t*>(payload + layout.body_ids);
+        for (uint32_t j = 0; j < header->num_bodies; j++) {
+            BodyHistory::Sample sample = {static_cast<uint32_t>(i), j};
+            m_body_index[ids[j]].push_back(sample);
+        }
+    }
+
+    m_body_index_built = true;
+}
+
+std::vector<int> ChSimulationOutputReader::GetBodyIdentifiers() {
+    BuildBodyIndex();
+
+    std::vector<int> ids;
+    ids.reserve(m_body_index.size());
+    for (auto& entry : m_body_index)
+        ids.push_back(entry.first);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+ChSimulationOutputReader::BodyHistory ChSimulationOutputReader::GetBodyHistory(int identifier) {
+    BuildBodyIndex();
+
+    BodyHistory history;
+    history.m_reader = this;
+    auto entry = m_body_index.find(identifier);
+    if (entry != m_body_index.end())
+        history.m_samples = entry->second;
+    return history;
+}
+
+}  // end namespace utils
+}  // end namespace chrono
@@ -0,0 +1,193 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Random-access reader of simulation output files written with
+// ChSimulationOutputWriter.
+//
+// The file is memory-mapped and accessed through light-weight views that point
+// directly into the mapped memory, so that extracting e.g. the history of a
+// single body touches only the bytes actually needed.
+//
+// =============================================================================
+
+#ifndef CH_SIMULATION_OUTPUT_READER_H
+#define CH_SIMULATION_OUTPUT_READER_H
+
+#include <list>
+#include <unordered_map>
+
+#include "chrono/core/ChMappedFile.h"
+#include "chrono/core/ChQuaternion.h"
+#include "chrono/core/ChVector.h"
+#include "chrono/utils/ChSimulationOutput.h"
+
+namespace chrono {
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Reader of simulation output files.
+/// Frames are located through the index written at the end of the file (or, for files which were
+/// not properly closed, by scanning the frame headers); every frame is validated against the file size
+/// before it is used. An index of body identifiers is built on first use. Uncompressed payloads are never
+/// copied; compressed payloads are decompressed on access and kept in a cache of the most recently used
+/// frames (see SetCacheSize).
+class ChApi ChSimulationOutputReader {
+  public:
+    /// View of the data stored in one frame.
+    /// Column accessors return nullptr if the corresponding block is not stored in the file.
+    class ChApi Frame {
+      public:
+        Frame(unsigned int blocks, const ChSimulationOutputFrameHeader* header, const char* payload);
+
+        uint64_t GetFrameNumber() const { return m_header->frame; }
+        double GetTime() const { return m_header->time; }
+
+        size_t GetNumBodies() const { return m_header->num_bodies; }
+        const int32_t* GetBodyIdentifiers() const { return Column<int32_t>(m_layout.body_ids); }
+        const double* GetBodyPos(int axis) const { return Column<double>(m_layout.body_pos[axis]); }
+        const double* GetBodyRot(int component) const { return Column<double>(m_layout.body_rot[component]); }
+        const double* GetBodyLinVel(int axis) const { return Column<double>(m_layout.body_lin_vel[axis]); }
+        const double* GetBodyAngVel(int axis) const { return Column<double>(m_layout.body_ang_vel[axis]); }
+
+        ChVector<> GetBodyPos(size_t i) const;
+        ChQuaternion<> GetBodyRot(size_t i) const;
+        ChVector<> GetBodyLinVel(size_t i) const;
+        ChVector<> GetBodyAngVel(size_t i) const;
+
+        size_t GetNumItems() const { return m_header->num_items; }
+        const int32_t* GetItemIdentifiers() const { return Column<int32_t>(m_layout.item_ids); }
+        const uint32_t* GetItemNumX() const { return Column<uint32_t>(m_layout.item_nx); }
+        const uint32_t* GetItemNumV() const { return Column<uint32_t>(m_layout.item_nv); }
+        /// Concatenated position-level states of all items (in the order of GetItemIdentifiers).
+        const double* GetItemX() const { return Column<double>(m_layout.item_x); }
+        /// Concatenated velocity-level states of all items (in the order of GetItemIdentifiers).
+        const double* GetItemV() const { return Column<double>(m_layout.item_v); }
+
+        size_t GetNumContacts() const { return m_header->num_contacts; }
+        const int32_t* GetContactBodyA() const { return Column<int32_t>(m_layout.contact_bodyA); }
+        const int32_t* GetContactBodyB() const { return Column<int32_t>(m_layout.contact_bodyB); }
+        const double* GetContactPos(int axis) const { return Column<double>(m_layout.contact_pos[axis]); }
+        const double* GetContactNormal(int axis) const { return Column<double>(m_layout.contact_normal[axis]); }
+        const double* GetContactForce(int axis) const { return Column<double>(m_layout.contact_force[axis]); }
+
+      private:
+        template <typename T>
+        const T* Column(size_t offset) const {
+            return offset == ChSimulationOutputLayout::npos ? nullptr : reinterpret_cast<const T*>(m_data + offset);
+        }
+
+        const ChSimulationOutputFrameHeader* m_header;
+        const char* m_data;
+        ChSimulationOutputLayout m_layout;
+    };
+
+    /// View of the history of a single body over all frames in which it is present.
+    class ChApi BodyHistory {
+      public:
+        /// Return the number of frames in which the body is present.
+        size_t GetNumSamples() const { return m_samples.size(); }
+
+        /// Return the index of the frame corresponding to the i-th sample.
+        size_t GetFrameIndex(size_t i) const { return m_samples[i].frame; }
+
+        double GetTime(size_t i) const;
+        ChVector<> GetPos(size_t i) const;
+        ChQuaternion<> GetRot(size_t i) const;
+        ChVector<> GetLinVel(size_t i) const;
+        ChVector<> GetAngVel(size_t i) const;
+
+      private:
+        struct Sample {
+            uint32_t frame;  ///< frame index
+            uint32_t slot;   ///< position of the body in the frame columns
+        };
+
+        const double* Value(size_t i, size_t offset) const;
+
+        ChSimulationOutputReader* m_reader;
+        std::vector<Sample> m_samples;
+
+        friend class ChSimulationOutputReader;
+    };
+
+    /// Map the specified simulation output file and build the frame index.
+    /// Throws a ChException if the file cannot be opened or is not a valid output file.
+    ChSimulationOutputReader(const std::string& filename);
+
+    ~ChSimulationOutputReader() {}
+
+    /// Register a codec for decompressing frame payloads.
+    void AddCodec(std::shared_ptr<ChSimulationOutputCodec> codec);
+
+    /// Set the maximum number of decompressed frames kept in memory (default: 16, minimum: 1).
+    /// Column pointers obtained from views of compressed frames remain valid only until this many other
+    /// frames were decompressed.
+    void SetCacheSize(size_t num_frames);
+
+    /// Return the number of decompressed frames currently kept in memory.
+    size_t GetNumCachedFrames() const { return m_cache.size(); }
+
+    /// Return the mask of ChSimulationOutputBlocks stored in the file.
+    unsigned int GetBlocks() const { return m_blocks; }
+
+    /// Return the number of frames in the file.
+    size_t GetNumFrames() const { return m_frames.size(); }
+
+    /// Return the simulation time of the specified frame (reads only the frame header).
+    double GetTime(size_t frame) const { return m_frames[frame]->time; }
+
+    /// Return a view of the specified frame.
+    Frame GetFrame(size_t frame);
+
+    /// Return the identifiers of all bodies present in at least one frame (sorted).
+    std::vector<int> GetBodyIdentifiers();
+
+    /// Return a view of the history of the body with specified identifier.
+    /// The returned view is empty if no such body exists.
+    BodyHistory GetBodyHistory(int identifier);
+
+  private:
+    /// Decompressed payload of a frame, with its position in the LRU list.
+    struct CacheEntry {
+        std::vector<char> data;
+        std::list<size_t>::iterator lru;
+    };
+
+    const char* GetPayload(size_t frame);
+    ChSimulationOutputCodec* GetCodec(const ChSimulationOutputFrameHeader* header);
+    void EvictFrames(size_t max_frames);
+    void BuildFrameIndex();
+    void BuildBodyIndex();
+
+    ChMappedFile m_file;
+    unsigned int m_blocks;
+    std::vector<const ChSimulationOutputFrameHeader*> m_frames;
+    std::unordered_map<uint32_t, std::shared_ptr<ChSimulationOutputCodec>> m_codecs;
+
+    size_t m_cache_size;                             ///< max. number of cached decompressed frames
+    std::unordered_map<size_t, CacheEntry> m_cache;  ///< decompressed payloads, by frame index
+    std::list<size_t> m_lru;                         ///< cached frames, most recently used first
+    std::vector<std::vector<char>> m_spare;          ///< buffers of evicted frames, for reuse
+    std::vector<char> m_scratch;                     ///< buffer for partial decompression
+
+    bool m_body_index_built;
+    std::unordered_map<int, std::vector<BodyHistory::Sample>> m_body_index;
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
@@ -14,8 +14,13 @@
 //
 // =============================================================================
 
+#include <memory>
+#include <typeinfo>
+
 #include "chrono/assets/ChColorAsset.h"
+#include "chrono/core/ChClassFactory.h"
 #include "chrono/geometry/ChLineBezier.h"
+#include "chrono/serialization/ChArchiveBinary.h"
 #include "chrono/utils/ChUtilsInputOutput.h"
 
 namespace chrono {
@@ -297,6 +302,178 @@ void ReadCheckpoint(ChSystem* system, const std::string& filename) {
     }
 }
 
+// -----------------------------------------------------------------------------
+// WriteCheckpointBinary
+//
+// Write a binary checkpoint of the complete system: a versioned header, the
+// archived object graph, and the state, acceleration and reaction vectors.
+// -----------------------------------------------------------------------------
+static const char* kCheckpointTag = "Chrono binary checkpoint";
+static const int kCheckpointVersion = 1;
+
+// Check that all the items of an assembly can be recreated from the archive. Objects of classes unknown to the
+// class factory are archived without their class name, and read back as objects of the declared type of their
+// list: this is acceptable for bodies (restored as ChBody, with all their data), but not for other items.
+static void CheckCheckpointItems(ChAssembly& assembly) {
+    auto check = [](ChPhysicsItem* item) {
+        try {
+            ChClassFactory::GetClassTagName(typeid(*item));
+        } catch (ChException&) {
+            throw ChException(std::string("Cannot write a binary checkpoint of an item of class ") +
+                              typeid(*item).name() + ", which does not support serialization");
+        }
+    };
+    for (auto& link : *assembly.Get_linklist())
+        check(link.get());
+    for (auto& item : *assembly.Get_otherphysicslist()) {
+        check(item.get());
+        if (auto sub_assembly = std::dynamic_pointer_cast<ChAssembly>(item))
+            CheckCheckpointItems(*sub_assembly);
+    }
+}
+
+void WriteCheckpointBinary(ChSystem* system, const std::string& filename) {
+    // Check the items before creating the file.
+    CheckCheckpointItems(*system);
+
+    ChStreamOutBinaryFile mfile(filename.c_str());
+    ChArchiveOutBinary marchive(mfile);
+
+    std::string tag(kCheckpointTag);
+    int version = kCheckpointVersion;
+    int method = static_cast<int>(system->GetContactMethod());
+    marchive << CHNVP(tag);
+    marchive << CHNVP(version);
+    marchive << CHNVP(method);
+
+    // Object graph (bodies, links, other physics items, solver and timestepper settings)
+    marchive << CHNVP(*system, "system");
+
+    // Full state, so that items which do not archive all their state variables
+    // (and the timestepper, which gathers accelerations at the next step) see
+    // exactly the same data after a restart.
+    system->Setup();
+    ChState x(system->GetNcoords_x(), system);
+    ChStateDelta v(system->GetNcoords_v(), system);
+    ChStateDelta a(system->GetNcoords_a(), system);
+    ChVectorDynamic<> L_all(system->GetNconstr());
+    double T;
+    system->StateGather(x, v, T);
+    system->StateGatherAcceleration(a);
+    system->StateGatherReactions(L_all);
+
+    // Reactions of the links and other items only: the contacts are not archived (they are found again by the
+    // collision detection at the next step), and their reactions come last.
+    ChVectorDynamic<> L(system->GetNconstr() - system->GetContactContainer()->GetDOC());
+    L.PasteClippedMatrix(L_all, 0, 0, L.GetRows(), 1, 0, 0);
+
+    marchive << CHNVP(T);
+    marchive << CHNVP(x);
+    marchive << CHNVP(v);
+    marchive << CHNVP(a);
+    marchive << CHNVP(L);
+}
+
+// -----------------------------------------------------------------------------
+// ReadCheckpointBinary
+//
+// Rebuild the system from a binary checkpoint.
+// -----------------------------------------------------------------------------
+
+// Read the object graph and the state vectors of a checkpoint into the given system, and check their sizes.
+static void ReadCheckpointData(ChSystem* system,
+                               const std::string& filename,
+                               double& T,
+                               ChState& x,
+                               ChStateDelta& v,
+                               ChStateDelta& a,
+                               ChVectorDynamic<>& L) {
+    ChStreamInBinaryFile mfile(filename.c_str());
+    ChArchiveInBinary marchive(mfile);
+
+    std::string tag;
+    int version;
+    int method;
+    marchive >> CHNVP(tag);
+    if (tag != kCheckpointTag)
+        throw ChException("Not a Chrono binary checkpoint: " + filename);
+    marchive >> CHNVP(version);
+    if (version > kCheckpointVersion)
+        throw ChException("Unsupported binary checkpoint version in " + filename);
+    marchive >> CHNVP(method);
+    if (method != static_cast<int>(system->GetContactMethod()))
+        throw ChException("Binary checkpoint " + filename + " was written for a different contact method");
+
+    // Object graph (also calls Setup() on the system)
+    marchive >> CHNVP(*system, "system");
+
+    marchive >> CHNVP(T);
+    marchive >> CHNVP(x);
+    marchive >> CHNVP(v);
+    marchive >> CHNVP(a);
+    marchive >> CHNVP(L);
+
+    system->Setup();
+    if (x.GetRows() != system->GetNcoords_x() || v.GetRows() != system->GetNcoords_v() ||
+        a.GetRows() != system->GetNcoords_a() ||
+        L.GetRows() != system->GetNconstr() - system->GetContactContainer()->GetDOC())
+        throw ChException("Inconsistent state size in binary checkpoint " + filename);
+}
+
+// Scatter the saved state into the items of an assembly, except bodies.
+// Bodies archive their complete state (position, velocity and acceleration of their frame), and get it back
+// exactly from the archive, while scattering a state vector into them is lossy (body velocities are converted
+// to quaternion derivatives): they are not scattered. All the other items get their state from the saved
+// vectors, whatever they archive. Inactive bodies and links have no state in the vectors, and keep the archived
+// one.
+static void ScatterCheckpointState(ChAssembly& assembly,
+                                   double T,
+                                   const ChState& x,
+                                   const ChStateDelta& v,
+                                   const ChStateDelta& a) {
+    for (auto& link : *assembly.Get_linklist()) {
+        if (link->IsActive()) {
+            link->IntStateScatter(link->GetOffset_x(), x, link->GetOffset_w(), v, T);
+            link->IntStateScatterAcceleration(link->GetOffset_w(), a);
+        }
+    }
+    for (auto& item : *assembly.Get_otherphysicslist()) {
+        if (auto sub_assembly = std::dynamic_pointer_cast<ChAssembly>(item)) {
+            ScatterCheckpointState(*sub_assembly, T, x, v, a);
+            continue;
+        }
+        item->IntStateScatter(item->GetOffset_x(), x, item->GetOffset_w(), v, T);
+        item->IntStateScatterAcceleration(item->GetOffset_w(), a);
+    }
+}
+
+void ReadCheckpointBinary(ChSystem* system, const std::string& filename) {
+    double T;
+    ChState x(system);
+    ChStateDelta v(system);
+    ChStateDelta a(system);
+    ChVectorDynamic<> L;
+
+    // Reading the object graph replaces all the items of the system. Read the checkpoint into a temporary
+    // system of the same class first, so that the system is left untouched if the checkpoint is not valid.
+    {
+        ChSystem* check_system = nullptr;
+        ChClassFactory::create(ChClassFactory::GetClassTagName(typeid(*system)), &check_system);
+        std::unique_ptr<ChSystem> check(check_system);
+        ReadCheckpointData(check.get(), filename, T, x, v, a, L);
+    }
+
+    ReadCheckpointData(system, filename, T, x, v, a, L);
+
+    ScatterCheckpointState(*system, T, x, v, a);
+
+    system->SetChTime(T);
+    system->Update();
+
+    // The contact container is empty after the restore, so the reactions cover all the constraints.
+    system->StateScatterReactions(L);
+}
+
 // -----------------------------------------------------------------------------
 // WriteShapesPovray
 //
@@ -25,6 +25,10 @@
 //      contact geometry.
 //    - only a subset of contact shapes are currently supported
 //
+// WriteCheckpointBinary and ReadCheckpointBinary
+//  these functions write and read, respectively, a binary checkpoint of the
+//  complete system, using the ChArchive serialization machinery.
+//
 // WriteShapesPovray
 //  this function writes a CSV file appropriate for processing with a POV-Ray
 //  script.
@@ -136,6 +140,38 @@ bool WriteCheckpoint(ChSystem* system, const std::string& filename);
 ChApi
 void ReadCheckpoint(ChSystem* system, const std::string& filename);
 
+// Write a binary checkpoint of the complete system.
+// The object graph of the system (bodies, links, other physics items such as
+// shafts, solver and timestepper settings) is serialized with a
+// ChArchiveOutBinary, followed by the full state vectors, accelerations and
+// constraint reactions, so that a restart reproduces the original run.
+// Throws a ChException, before creating the file, if a link or another physics
+// item cannot be recreated from the archive because its class is not
+// registered in the class factory (e.g. FEA meshes, ChMesh, which do not
+// support serialization). Bodies of unregistered classes derived from ChBody
+// (e.g. ChBodyEasyBox) are restored as ChBody objects, with all their data.
+// Contacts are not saved: they are found again by the collision detection at
+// the first step after the restart, but their cached reactions (kept in the
+// persistent contact manifolds of the collision system, and used as warm start
+// by the NSC solver when enabled) start from zero. Therefore a restart of a
+// system with contacts reproduces the original run only as far as the solver
+// result does not depend on its initial guess.
+ChApi
+void WriteCheckpointBinary(ChSystem* system, const std::string& filename);
+
+// Restore a binary checkpoint written with WriteCheckpointBinary into the
+// specified system (which must use the same contact method as the saved one).
+// All items currently in the system are replaced. Throws a ChException if the
+// file is not a valid checkpoint or was written by a newer format version; in
+// this case the system is left unchanged (the checkpoint is first read into a
+// temporary system of the same class, which must be registered in the class
+// factory, as ChSystemNSC and ChSystemSMC are).
+// Bodies get their state back exactly from the archive; all the other items
+// get the saved state vectors, so that items which do not archive all their
+// state variables are restored too.
+ChApi
+void ReadCheckpointBinary(ChSystem* system, const std::string& filename);
+
 // Write CSV output file for PovRay.
 // Each line contains information about one visualization asset shape, as
 // follows:
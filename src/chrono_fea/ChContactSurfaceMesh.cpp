@@ -863,34 +863,105 @@ unsigned int ChContactSurfaceMesh::GetNumVertices() const {
     return (unsigned int)(count + count_rot);
 }
 
+unsigned int ChContactSurfaceMesh::GetNumActiveTriangles() const {
+    return (unsigned int)std::count(in_system.begin(), in_system.end(), 1);
+}
+
 void ChContactSurfaceMesh::SurfaceSyncCollisionModels() {
-    for (unsigned int j = 0; j < vfaces.size(); j++) {
-        this->vfaces[j]->GetCollisionModel()->SyncPosition();
+    size_t nfaces = vfaces.size() + vfaces_rot.size();
+    in_system.resize(nfaces, 0);
+    ChSystem* msys = mmesh ? mmesh->GetSystem() : nullptr;
+
+    if (!added_to_system || !msys) {
+        for (size_t j = 0; j < nfaces; j++)
+            GetFaceCollisionModel(j)->SyncPosition();
+        return;
+    }
+
+    // Without active set, all triangles are in the collision system (re-add the dormant ones, if any).
+    if (!active_set) {
+        for (size_t j = 0; j < nfaces; j++) {
+            collision::ChCollisionModel* model = GetFaceCollisionModel(j);
+            model->SyncPosition();
+            if (!in_system[j]) {
+                msys->GetCollisionSystem()->Add(model);
+                in_system[j] = 1;
+            }
+        }
+        return;
+    }
+
+    // Bounding boxes of the partners, enlarged by the margin.
+    std::vector<ChVector<> > partner_min(active_set_partners.size());
+    std::vector<ChVector<> > partner_max(active_set_partners.size());
+    ChVector<> margin(active_set_margin);
+    for (size_t ip = 0; ip < active_set_partners.size(); ip++) {
+        active_set_partners[ip]->GetAABB(partner_min[ip], partner_max[ip]);
+        partner_min[ip] -= margin;
+        partner_max[ip] += margin;
     }
-    for (unsigned int j = 0; j < vfaces_rot.size(); j++) {
-        this->vfaces_rot[j]->GetCollisionModel()->SyncPosition();
+
+    // Find the triangles near a partner. The bounding boxes of the triangles follow their nodes, so they
+    // are up to date without syncing the collision models. Triangles which are already active are kept
+    // until they are farther than twice the margin, to avoid adding and removing them at each step.
+    std::vector<char> near(nfaces);
+#pragma omp parallel for schedule(static)
+    for (int j = 0; j < (int)nfaces; j++) {
+        ChVector<> face_min;
+        ChVector<> face_max;
+        GetFaceCollisionModel(j)->GetAABB(face_min, face_max);
+        if (in_system[j]) {
+            face_min -= margin;
+            face_max += margin;
+        }
+        char is_near = 0;
+        for (size_t ip = 0; ip < partner_min.size() && !is_near; ip++) {
+            is_near = face_min.x() <= partner_max[ip].x() && face_max.x() >= partner_min[ip].x() &&
+                      face_min.y() <= partner_max[ip].y() && face_max.y() >= partner_min[ip].y() &&
+                      face_min.z() <= partner_max[ip].z() && face_max.z() >= partner_min[ip].z();
+        }
+        near[j] = is_near;
+    }
+
+    for (size_t j = 0; j < nfaces; j++) {
+        collision::ChCollisionModel* model = GetFaceCollisionModel(j);
+        if (near[j]) {
+            model->SyncPosition();
+            if (!in_system[j]) {
+                msys->GetCollisionSystem()->Add(model);
+                in_system[j] = 1;
+            }
+        } else if (in_system[j]) {
+            msys->GetCollisionSystem()->Remove(model);
+            in_system[j] = 0;
+        }
     }
 }
 
 void ChContactSurfaceMesh::SurfaceAddCollisionModelsToSystem(ChSystem* msys) {
     assert(msys);
-    SurfaceSyncCollisionModels();
-    for (unsigned int j = 0; j < vfaces.size(); j++) {
-        msys->GetCollisionSystem()->Add(this->vfaces[j]->GetCollisionModel());
-    }
-    for (unsigned int j = 0; j < vfaces_rot.size(); j++) {
-        msys->GetCollisionSystem()->Add(this->vfaces_rot[j]->GetCollisionModel());
+    size_t nfaces = vfaces.size() + vfaces_rot.size();
+    in_system.assign(nfaces, 0);
+    for (size_t j = 0; j < nfaces; j++) {
+        collision::ChCollisionModel* model = GetFaceCollisionModel(j);
+        model->SyncPosition();
+        if (!active_set) {
+            msys->GetCollisionSystem()->Add(model);
+            in_system[j] = 1;
+        }
     }
+    // With active set, the triangles near the partners are added at the next sync.
+    added_to_system = true;
 }
 
 void ChContactSurfaceMesh::SurfaceRemoveCollisionModelsFromSystem(ChSystem* msys) {
     assert(msys);
-    for (unsigned int j = 0; j < vfaces.size(); j++) {
-        msys->GetCollisionSystem()->Remove(this->vfaces[j]->GetCollisionModel());
-    }
-    for (unsigned int j = 0; j < vfaces_rot.size(); j++) {
-        msys->GetCollisionSystem()->Remove(this->vfaces_rot[j]->GetCollisionModel());
+    for (size_t j = 0; j < in_system.size(); j++) {
+        if (in_system[j])
+            msys->GetCollisionSystem()->Remove(GetFaceCollisionModel(j));
     }
+    in_system.assign(in_system.size(), 0);
+    added_to_system = false;
 }
 
 }  // end namespace fea
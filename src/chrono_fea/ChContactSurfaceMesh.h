@@ -675,7 +675,8 @@ class ChApiFea ChContactTriangleXYZROT : public ChContactable_3vars<6, 6, 6>, pu
 class ChApiFea ChContactSurfaceMesh : public ChContactSurface {
 
   public:
-    ChContactSurfaceMesh(ChMesh* parentmesh = 0) : ChContactSurface(parentmesh) {}
+    ChContactSurfaceMesh(ChMesh* parentmesh = 0)
+        : ChContactSurface(parentmesh), active_set(false), active_set_margin(0.01), added_to_system(false) {}
 
     virtual ~ChContactSurfaceMesh() {}
 
@@ -718,15 +719,49 @@ class ChApiFea ChContactSurfaceMesh : public ChContactSurface {
     /// Get the number of vertices.
     unsigned int GetNumVertices() const;
 
+    /// Enable the active-set management of the collision shapes (default: disabled).
+    /// When enabled, only the triangles whose bounding box is within 'margin' of the bounding box of one of the
+    /// proximity partners (see AddActiveSetPartner) are kept in the collision system and synchronized at each
+    /// step; the others stay dormant. This is useful when only a small part of the surface can touch other
+    /// objects, e.g. a tire rolling on the ground. The margin must cover the motion of the surface in one step.
+    void SetActiveSet(bool enable, double margin = 0.01) {
+        active_set = enable;
+        active_set_margin = margin;
+    }
+    /// Tell if the active-set management of the collision shapes is enabled.
+    bool GetActiveSet() const { return active_set; }
+
+    /// Add the collision model of a potential contact partner (e.g. the ground), used by the active set.
+    void AddActiveSetPartner(std::shared_ptr<collision::ChCollisionModel> model) {
+        active_set_partners.push_back(model);
+    }
+    /// Remove all the potential contact partners of the active set.
+    void ClearActiveSetPartners() { active_set_partners.clear(); }
+
+    /// Get the number of triangles whose collision models are currently in the collision system.
+    unsigned int GetNumActiveTriangles() const;
+
     // Functions to interface this with ChPhysicsItem container
     virtual void SurfaceSyncCollisionModels();
     virtual void SurfaceAddCollisionModelsToSystem(ChSystem* msys);
     virtual void SurfaceRemoveCollisionModelsFromSystem(ChSystem* msys);
 
   private:
+    /// Collision model of the i-th triangle, counting vfaces first, then vfaces_rot.
+    collision::ChCollisionModel* GetFaceCollisionModel(size_t i) {
+        return i < vfaces.size() ? vfaces[i]->GetCollisionModel()
+                                 : vfaces_rot[i - vfaces.size()]->GetCollisionModel();
+    }
+
     std::vector<std::shared_ptr<ChContactTriangleXYZ> > vfaces;  //  faces that collide
     std::vector<std::shared_ptr<ChContactTriangleXYZROT> >
         vfaces_rot;  //  faces that collide (for nodes with rotation too)
+
+    bool active_set;
+    double active_set_margin;
+    std::vector<std::shared_ptr<collision::ChCollisionModel> > active_set_partners;
+    std::vector<char> in_system;  ///< for each triangle, true if its collision model is in the collision system
+    bool added_to_system;         ///< true if the surface was added to the collision system
 };
 
 }  // end namespace fea
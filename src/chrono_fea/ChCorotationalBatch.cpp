@@ -0,0 +1,188 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono_fea/ChCorotationalBatch.h"
+#include "chrono_fea/ChPolarDecomposition.h"
+
+namespace chrono {
+namespace fea {
+
+const int ChCorotationalBatch::WIDTH;
+
+// In the loops below, X[k][l] is the entry k (row-major) of the 3x3 matrix of lane l.
+
+void ChCorotationalBatch::PolarRotations(int n, const ChMatrix33<>* const* F, ChMatrix33<>* const* R) {
+    const int max_iterations = 20;
+    // On the squared Frobenius norm of the update: since the convergence is quadratic, the error after an
+    // update smaller than 1e-8 is at the level of the roundoff.
+    const double tolerance = 1e-16;
+
+    for (int start = 0; start < n; start += WIDTH) {
+        int count = std::min(WIDTH, n - start);
+
+        // Gather the matrices; unused lanes are set to the identity.
+        double X[9][WIDTH];
+        for (int l = 0; l < WIDTH; l++) {
+            const double* f = l < count ? F[start + l]->GetAddress() : nullptr;
+            for (int k = 0; k < 9; k++)
+                X[k][l] = f ? f[k] : (k % 4 == 0 ? 1.0 : 0.0);
+        }
+
+        // Sign of the determinant, and lanes which are too close to singular for the iteration.
+        double sign[WIDTH];
+        bool singular[WIDTH];
+        for (int l = 0; l < WIDTH; l++) {
+            double det = X[0][l] * (X[4][l] * X[8][l] - X[5][l] * X[7][l]) +
+                         X[1][l] * (X[5][l] * X[6][l] - X[3][l] * X[8][l]) +
+                         X[2][l] * (X[3][l] * X[7][l] - X[4][l] * X[6][l]);
+            double norm2 = 0;
+            for (int k = 0; k < 9; k++)
+                norm2 += X[k][l] * X[k][l];
+            sign[l] = det < 0 ? -1.0 : 1.0;
+            singular[l] = std::abs(det) <= 1e-12 * norm2 * std::sqrt(norm2);
+        }
+        for (int l = 0; l < WIDTH; l++)
+            if (singular[l])
+                for (int k = 0; k < 9; k++)
+                    X[k][l] = (k % 4 == 0 ? 1.0 : 0.0);
+
+        for (int iter = 0; iter < max_iterations; iter++) {
+            // Cofactor matrix C = det(X) * X^-T, and squared norms of X and C.
+            double C[9][WIDTH];
+            double det[WIDTH];
+            double normX[WIDTH];
+            double normC[WIDTH];
+            for (int l = 0; l < WIDTH; l++) {
+                C[0][l] = X[4][l] * X[8][l] - X[5][l] * X[7][l];
+                C[1][l] = X[5][l] * X[6][l] - X[3][l] * X[8][l];
+                C[2][l] = X[3][l] * X[7][l] - X[4][l] * X[6][l];
+                C[3][l] = X[2][l] * X[7][l] - X[1][l] * X[8][l];
+                C[4][l] = X[0][l] * X[8][l] - X[2][l] * X[6][l];
+                C[5][l] = X[1][l] * X[6][l] - X[0][l] * X[7][l];
+                C[6][l] = X[1][l] * X[5][l] - X[2][l] * X[4][l];
+                C[7][l] = X[2][l] * X[3][l] - X[0][l] * X[5][l];
+                C[8][l] = X[0][l] * X[4][l] - X[1][l] * X[3][l];
+                det[l] = X[0][l] * C[0][l] + X[1][l] * C[1][l] + X[2][l] * C[2][l];
+                normX[l] = 0;
+                normC[l] = 0;
+            }
+            for (int k = 0; k < 9; k++)
+                for (int l = 0; l < WIDTH; l++) {
+                    normX[l] += X[k][l] * X[k][l];
+                    normC[l] += C[k][l] * C[k][l];
+                }
+
+            // Scaling g = sqrt(|X^-1| / |X|), in the Frobenius norm, and X <- (g*X + C/(g*det))/2.
+            double a[WIDTH];
+            double b[WIDTH];
+            for (int l = 0; l < WIDTH; l++) {
+                double g = std::sqrt(std::sqrt(normC[l] / normX[l]) / std::abs(det[l]));
+                a[l] = 0.5 * g;
+                b[l] = 0.5 / (g * det[l]);
+            }
+            double change[WIDTH] = {0};
+            for (int k = 0; k < 9; k++)
+                for (int l = 0; l < WIDTH; l++) {
+                    double x = a[l] * X[k][l] + b[l] * C[k][l];
+                    change[l] += (x - X[k][l]) * (x - X[k][l]);
+                    X[k][l] = x;
+                }
+
+            double max_change = 0;
+            for (int l = 0; l < WIDTH; l++)
+                max_change = std::max(max_change, change[l]);
+            if (max_change < tolerance)
+                break;
+        }
+
+        // Scatter the rotations.
+        for (int l = 0; l < count; l++) {
+            if (singular[l]) {
+                ChMatrix33<> S;
+                double det = ChPolarDecomposition<>::Compute(*F[start + l], *R[start + l], S, 1E-6);
+                if (det < 0)
+                    R[start + l]->MatrScale(-1.0);
+                continue;
+            }
+            double* r = R[start + l]->GetAddress();
+            for (int k = 0; k < 9; k++)
+                r[k] = sign[l] * X[k][l];
+        }
+    }
+}
+
+void ChCorotationalBatch::RotateStiffness(int n,
+                                          int nnodes,
+                                          const ChMatrix<>* const* K,
+                                          const ChMatrix33<>* const* A,
+                                          const double* scale,
+                                          ChMatrix<>* const* H) {
+    int ndofs = 3 * nnodes;
+
+    for (int start = 0; start < n; start += WIDTH) {
+        int count = std::min(WIDTH, n - start);
+
+        // Gather the rotations, with the scaling folded into the left factor; unused lanes repeat lane 0.
+        double Ra[9][WIDTH];
+        double Rb[9][WIDTH];
+        const double* k_lane[WIDTH];
+        double* h_lane[WIDTH];
+        for (int l = 0; l < WIDTH; l++) {
+            int e = start + std::min(l, count - 1);
+            const double* a = A[e]->GetAddress();
+            for (int k = 0; k < 9; k++) {
+                Ra[k][l] = scale[e] * a[k];
+                Rb[k][l] = a[k];
+            }
+            k_lane[l] = K[e]->GetAddress();
+            h_lane[l] = H[e]->GetAddress();
+        }
+
+        // H_ij = s * A * K_ij * A', for the blocks of the lower triangle; H_ji = H_ij'.
+        for (int bi = 0; bi < nnodes; bi++) {
+            for (int bj = 0; bj <= bi; bj++) {
+                double Kb[9][WIDTH];
+                for (int l = 0; l < WIDTH; l++)
+                    for (int r = 0; r < 3; r++)
+                        for (int c = 0; c < 3; c++)
+                            Kb[3 * r + c][l] = k_lane[l][(3 * bi + r) * ndofs + 3 * bj + c];
+
+                double T[9][WIDTH];
+                for (int r = 0; r < 3; r++)
+                    for (int c = 0; c < 3; c++)
+                        for (int l = 0; l < WIDTH; l++)
+                            T[3 * r + c][l] = Ra[3 * r][l] * Kb[c][l] + Ra[3 * r + 1][l] * Kb[3 + c][l] +
+                                              Ra[3 * r + 2][l] * Kb[6 + c][l];
+
+                double Hb[9][WIDTH];
+                for (int r = 0; r < 3; r++)
+                    for (int c = 0; c < 3; c++)
+                        for (int l = 0; l < WIDTH; l++)
+                            Hb[3 * r + c][l] = T[3 * r][l] * Rb[3 * c][l] + T[3 * r + 1][l] * Rb[3 * c + 1][l] +
+                                               T[3 * r + 2][l] * Rb[3 * c + 2][l];
+
+                for (int l = 0; l < count; l++)
+                    for (int r = 0; r < 3; r++)
+                        for (int c = 0; c < 3; c++) {
+                            h_lane[l][(3 * bi + r) * ndofs + 3 * bj + c] = Hb[3 * r + c][l];
+                            h_lane[l][(3 * bj + c) * ndofs + 3 * bi + r] = Hb[3 * r + c][l];
+                        }
+            }
+        }
+    }
+}
+
+}  // end namespace fea
+}  // end namespace chrono
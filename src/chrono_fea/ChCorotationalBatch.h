@@ -0,0 +1,62 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHCOROTATIONALBATCH_H
+#define CHCOROTATIONALBATCH_H
+
+#include "chrono/core/ChMatrix.h"
+#include "chrono/core/ChMatrix33.h"
+#include "chrono_fea/ChApiFEA.h"
+
+namespace chrono {
+namespace fea {
+
+/// @addtogroup fea_math
+/// @{
+
+/// Batched kernels for linear corotational elements (see ChElementTetra_4, ChElementHexa_8).
+/// Elements are processed WIDTH at a time: the data of a batch is stored as structure of arrays, with one
+/// lane per element, and all lanes execute the same branch-free arithmetic, so that the inner loops
+/// are vectorized by the compiler (SSE/AVX registers hold several lanes).
+class ChApiFea ChCorotationalBatch {
+  public:
+    /// Number of elements processed together.
+    static const int WIDTH = 4;
+
+    /// Compute the rotation factors of the polar decompositions F = R * S of 'n' 3x3 matrices, as in the
+    /// corotational elements: if det(F) < 0, R is the rotation factor of -F, so that R is always a proper
+    /// rotation. The polar factors are computed with the scaled Newton iteration X <- (g*X + X^-T/g)/2
+    /// (N.J. Higham, 1986), which converges quadratically; matrices that are (almost) singular fall back
+    /// to ChPolarDecomposition.
+    static void PolarRotations(int n,                         ///< number of matrices
+                               const ChMatrix33<>* const* F,  ///< matrices to decompose
+                               ChMatrix33<>* const* R         ///< resulting rotations
+                               );
+
+    /// Rotate the local stiffness matrices of 'n' elements with 'nnodes' xyz nodes each:
+    /// H = scale * C * K * C', with C the block-diagonal matrix of the 3x3 rotation A of the element.
+    /// K must be symmetric: only its lower blocks are used, and H is set as a symmetric matrix.
+    static void RotateStiffness(int n,                         ///< number of elements
+                                int nnodes,                    ///< nodes per element
+                                const ChMatrix<>* const* K,    ///< local stiffness matrices (3*nnodes square)
+                                const ChMatrix33<>* const* A,  ///< rotations of the elements
+                                const double* scale,           ///< scaling factors of the elements
+                                ChMatrix<>* const* H           ///< resulting global matrices (3*nnodes square)
+                                );
+};
+
+/// @} fea_math
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
@@ -297,14 +297,12 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
         ChMatrixNM<double, 906, 1> TempIntegratedResult;
         ChMatrixNM<double, 24, 1> Finternal;
         // Enhanced Assumed Strain (EAS)
-        ChMatrixNM<double, 6, 6> T0;
         ChMatrixNM<double, 9, 1> HE;
         ChMatrixNM<double, 9, 24> GDEPSP;
         ChMatrixNM<double, 9, 9> KALPHA;
         ChMatrixNM<double, 24, 24> KTE;
         ChMatrixNM<double, 9, 9> KALPHA1;
         ChMatrixNM<double, 9, 1> ResidHE;
-        double detJ0C;
         ChMatrixNM<double, 9, 1> alpha_eas;
         ChMatrixNM<double, 9, 1> renewed_alpha_eas;
         ChMatrixNM<double, 9, 1> previous_alpha;
@@ -315,7 +313,7 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
         int count = 0;
         int fail = 1;
         // Loop to obtain convergence in EAS internal parameters alpha
-        // This loops call ChQuadrature::Integrate3D on MyAnalyticalForce,
+        // This loop integrates MyAnalyticalForce,
         // which calculates the Jacobian at every iteration of each time step
         int iteralpha = 0;  //  Counts number of iterations
         while (fail == 1) {
@@ -328,27 +326,11 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
             GDEPSP.Reset();     // Jacobian of EAS forces w.r.t. coordinates
             KALPHA.Reset();     // Jacobian of EAS forces w.r.t. EAS internal parameters
 
-            // Enhanced Assumed Strain (EAS)
-            T0.Reset();
-            detJ0C = 0.0;
-            T0DetJElementCenterForEAS(m_d0, T0, detJ0C);
-
             //== F_internal ==//
-            MyForceAnalytical myformula = !m_isMooney
-                                              ? MyForceAnalytical(&d, &m_d0, this, &T0, &detJ0C, &alpha_eas, &E, &v)
-                                              : MyForceAnalytical(&d, &m_d0, this, &T0, &detJ0C, &alpha_eas);
-
-            ChQuadrature::Integrate3D<ChMatrixNM<double, 906, 1> >(
-                TempIntegratedResult,  // result of integration will go there
-                myformula,             // formula to integrate
-                -1,                    // start of x
-                1,                     // end of x
-                -1,                    // start of y
-                1,                     // end of y
-                -1,                    // start of z
-                1,                     // end of z
-                2                      // order of integration
-                );
+            // The integrand is summed over the precomputed Gauss points (see ComputeGaussPoints)
+            MyForceAnalytical myformula = !m_isMooney ? MyForceAnalytical(&d, this, &alpha_eas, &E, &v)
+                                                      : MyForceAnalytical(&d, this, &alpha_eas);
+            myformula.Integrate(TempIntegratedResult);
             //	///===============================================================//
             //	///===TempIntegratedResult(0:23,1) -> InternalForce(24x1)=========//
             //	///===TempIntegratedResult(24:28,1) -> HE(5x1)           =========//
@@ -558,18 +540,12 @@ void ChElementBrick::ComputeStiffnessMatrix() {
     }
 }
 // -----------------------------------------------------------------------------
-void ChElementBrick::MyForceAnalytical::Evaluate(ChMatrixNM<double, 906, 1>& result,
-                                                 const double x,
-                                                 const double y,
-                                                 const double z) {
-    element->ShapeFunctionsDerivativeX(Nx, x, y, z);
-    element->ShapeFunctionsDerivativeY(Ny, x, y, z);
-    element->ShapeFunctionsDerivativeZ(Nz, x, y, z);
-
-    element->Basis_M(M, x, y, z);  // EAS
-
+void ChElementBrick::MyForceAnalytical::Integrate(ChMatrixNM<double, 906, 1>& result) {
+    // Quantities which do not depend on the Gauss point
+    d_d.MatrMultiplyT(*d, *d);
     if (!element->m_isMooney) {  // m_isMooney == false means use linear material
         double DD = (*E) * (1.0 - (*v)) / ((1.0 + (*v)) * (1.0 - 2.0 * (*v)));
+        E_eps.Reset();
         E_eps.FillDiag(1.0);
         E_eps(0, 1) = (*v) / (1.0 - (*v));
         E_eps(0, 3) = (*v) / (1.0 - (*v));
@@ -582,169 +558,37 @@ void ChElementBrick::MyForceAnalytical::Evaluate(ChMatrixNM<double, 906, 1>& res
         E_eps(5, 5) = (1.0 - 2.0 * (*v)) / (2.0 * (1.0 - (*v)));
         E_eps *= DD;
     }
-    //		// Sd=[Nd1*eye(3) Nd2*eye(3) Nd3*eye(3) Nd4*eye(3)]
-    ChMatrix33<> Sxi;
-    Sxi.FillDiag(Nx(0));
-    Sx.PasteMatrix(Sxi, 0, 0);
-    Sxi.FillDiag(Nx(1));
-    Sx.PasteMatrix(Sxi, 0, 3);
-    Sxi.FillDiag(Nx(2));
-    Sx.PasteMatrix(Sxi, 0, 6);
-    Sxi.FillDiag(Nx(3));
-    Sx.PasteMatrix(Sxi, 0, 9);
-    Sxi.FillDiag(Nx(4));
-    Sx.PasteMatrix(Sxi, 0, 12);
-    Sxi.FillDiag(Nx(5));
-    Sx.PasteMatrix(Sxi, 0, 15);
-    Sxi.FillDiag(Nx(6));
-    Sx.PasteMatrix(Sxi, 0, 18);
-    Sxi.FillDiag(Nx(7));
-    Sx.PasteMatrix(Sxi, 0, 21);
-
-    ChMatrix33<> Syi;
-    Syi.FillDiag(Ny(0));
-    Sy.PasteMatrix(Syi, 0, 0);
-    Syi.FillDiag(Ny(1));
-    Sy.PasteMatrix(Syi, 0, 3);
-    Syi.FillDiag(Ny(2));
-    Sy.PasteMatrix(Syi, 0, 6);
-    Syi.FillDiag(Ny(3));
-    Sy.PasteMatrix(Syi, 0, 9);
-    Syi.FillDiag(Ny(4));
-    Sy.PasteMatrix(Syi, 0, 12);
-    Syi.FillDiag(Ny(5));
-    Sy.PasteMatrix(Syi, 0, 15);
-    Syi.FillDiag(Ny(6));
-    Sy.PasteMatrix(Syi, 0, 18);
-    Syi.FillDiag(Ny(7));
-    Sy.PasteMatrix(Syi, 0, 21);
-
-    ChMatrix33<> Szi;
-    Szi.FillDiag(Nz(0));
-    Sz.PasteMatrix(Szi, 0, 0);
-    Szi.FillDiag(Nz(1));
-    Sz.PasteMatrix(Szi, 0, 3);
-    Szi.FillDiag(Nz(2));
-    Sz.PasteMatrix(Szi, 0, 6);
-    Szi.FillDiag(Nz(3));
-    Sz.PasteMatrix(Szi, 0, 9);
-    Szi.FillDiag(Nz(4));
-    Sz.PasteMatrix(Szi, 0, 12);
-    Szi.FillDiag(Nz(5));
-    Sz.PasteMatrix(Szi, 0, 15);
-    Szi.FillDiag(Nz(6));
-    Sz.PasteMatrix(Szi, 0, 18);
-    Szi.FillDiag(Nz(7));
-    Sz.PasteMatrix(Szi, 0, 21);
-
-    // EAS and Initial Shape
-    ChMatrixNM<double, 3, 3> rd0;
-    ChMatrixNM<double, 3, 3> temp33;
-    ChMatrixNM<double, 1, 3> temp13;
-
-    temp13.Reset();
-    temp13 = (Nx * (*d0));
-    temp13.MatrTranspose();
-    rd0.PasteClippedMatrix(temp13, 0, 0, 3, 1, 0, 0);
-    temp13.MatrTranspose();
-
-    temp13 = (Ny * (*d0));
-    temp13.MatrTranspose();
-    rd0.PasteClippedMatrix(temp13, 0, 0, 3, 1, 0, 1);
-    temp13.MatrTranspose();
-
-    temp13 = (Nz * (*d0));
-    temp13.MatrTranspose();
-    rd0.PasteClippedMatrix(temp13, 0, 0, 3, 1, 0, 2);
-    detJ0 = rd0.Det();
-
-    // Transformation : Orthogonal transformation (A and J)
-
-    ChVector<double> G1;
-    ChVector<double> G2;
-    ChVector<double> G3;
-    ChVector<double> G1xG2;
-    double G1dotG1;
-    G1[0] = rd0(0, 0);
-    G2[0] = rd0(0, 1);
-    G3[0] = rd0(0, 2);
-    G1[1] = rd0(1, 0);
-    G2[1] = rd0(1, 1);
-    G3[1] = rd0(1, 2);
-    G1[2] = rd0(2, 0);
-    G2[2] = rd0(2, 1);
-    G3[2] = rd0(2, 2);
-    G1xG2.Cross(G1, G2);
-    G1dotG1 = Vdot(G1, G1);
 
-    // Tangent Frame
-    ChVector<double> A1;
-    ChVector<double> A2;
-    ChVector<double> A3;
-    A1 = G1 / sqrt(G1[0] * G1[0] + G1[1] * G1[1] + G1[2] * G1[2]);
-    A3 = G1xG2 / sqrt(G1xG2[0] * G1xG2[0] + G1xG2[1] * G1xG2[1] + G1xG2[2] * G1xG2[2]);
-    A2.Cross(A3, A1);
+    result.Reset();
+    ChMatrixNM<double, 906, 1> val;
+    for (size_t ig = 0; ig < element->m_GaussPoints.size(); ig++) {
+        Evaluate(val, element->m_GaussPoints[ig]);
+        result += val;
+    }
+}
 
-    // Direction for orthotropic material
-    double theta = 0.0;
-    ChVector<double> AA1;
-    ChVector<double> AA2;
-    ChVector<double> AA3;
-    AA1 = A1 * cos(theta) + A2 * sin(theta);
-    AA2 = -A1 * sin(theta) + A2 * cos(theta);
-    AA3 = A3;
-
-    // Beta
-    ChMatrixNM<double, 3, 3> j0;
-    ChVector<double> j01;
-    ChVector<double> j02;
-    ChVector<double> j03;
-    ChMatrixNM<double, 9, 1> beta;
-    double temp;
-    j0 = rd0;
-    j0.MatrInverse();
-    j01[0] = j0(0, 0);
-    j02[0] = j0(1, 0);
-    j03[0] = j0(2, 0);
-    j01[1] = j0(0, 1);
-    j02[1] = j0(1, 1);
-    j03[1] = j0(2, 1);
-    j01[2] = j0(0, 2);
-    j02[2] = j0(1, 2);
-    j03[2] = j0(2, 2);
-    temp = Vdot(AA1, j01);
-    beta(0, 0) = temp;
-    temp = Vdot(AA2, j01);
-    beta(1, 0) = temp;
-    temp = Vdot(AA3, j01);
-    beta(2, 0) = temp;
-    temp = Vdot(AA1, j02);
-    beta(3, 0) = temp;
-    temp = Vdot(AA2, j02);
-    beta(4, 0) = temp;
-    temp = Vdot(AA3, j02);
-    beta(5, 0) = temp;
-    temp = Vdot(AA1, j03);
-    beta(6, 0) = temp;
-    temp = Vdot(AA2, j03);
-    beta(7, 0) = temp;
-    temp = Vdot(AA3, j03);
-    beta(8, 0) = temp;
+void ChElementBrick::MyForceAnalytical::Evaluate(ChMatrixNM<double, 906, 1>& result, const GaussPoint& gp) {
+    // Shape functions and quantities depending only on the initial configuration (precomputed)
+    const ChMatrixNM<double, 1, 8>& Nx = gp.Nx;
+    const ChMatrixNM<double, 1, 8>& Ny = gp.Ny;
+    const ChMatrixNM<double, 1, 8>& Nz = gp.Nz;
+    const ChMatrixNM<double, 3, 24>& Sx = gp.Sx;
+    const ChMatrixNM<double, 3, 24>& Sy = gp.Sy;
+    const ChMatrixNM<double, 3, 24>& Sz = gp.Sz;
+    const ChMatrixNM<double, 8, 1>& d0d0Nx = gp.d0d0Nx;
+    const ChMatrixNM<double, 8, 1>& d0d0Ny = gp.d0d0Ny;
+    const ChMatrixNM<double, 8, 1>& d0d0Nz = gp.d0d0Nz;
+    const ChMatrixNM<double, 3, 3>& j0 = gp.j0;
+    const ChMatrixNM<double, 9, 1>& beta = gp.beta;
+    const ChMatrixNM<double, 6, 9>& G = gp.G;
 
     // Enhanced Assumed Strain
-    G = (*T0) * M * ((*detJ0C) / (detJ0));
     strain_EAS = G * (*alpha_eas);
 
-    d_d.MatrMultiplyT(*d, *d);
     ddNx.MatrMultiplyT(d_d, Nx);
     ddNy.MatrMultiplyT(d_d, Ny);
     ddNz.MatrMultiplyT(d_d, Nz);
 
-    d0_d0.MatrMultiplyT(*d0, *d0);
-    d0d0Nx.MatrMultiplyT(d0_d0, Nx);
-    d0d0Ny.MatrMultiplyT(d0_d0, Ny);
-    d0d0Nz.MatrMultiplyT(d0_d0, Nz);
-
     // Strain component
 
     ChMatrixNM<double, 6, 1> strain_til;
@@ -999,9 +843,9 @@ void ChElementBrick::MyForceAnalytical::Evaluate(ChMatrixNM<double, 906, 1>& res
         // Add internal forces to Fint and HE1 for Mooney-Rivlin
         temp56.MatrMultiply(GT, E_eps);
         Fint.MatrTMultiply(strainD, TEMP5);
-        Fint *= detJ0 * (element->GetLengthX() / 2.0) * (element->GetLengthY() / 2.0) * (element->GetLengthZ() / 2.0);
+        Fint *= gp.weight;
         HE1.MatrMultiply(GT, TEMP5);
-        HE1 *= detJ0 * (element->GetLengthX() / 2.0) * (element->GetLengthY() / 2.0) * (element->GetLengthZ() / 2.0);
+        HE1 *= gp.weight;
         Sigm(0, 0) = TEMP5(0, 0);
         Sigm(1, 1) = TEMP5(0, 0);
         Sigm(2, 2) = TEMP5(0, 0);
@@ -1068,10 +912,10 @@ void ChElementBrick::MyForceAnalytical::Evaluate(ChMatrixNM<double, 906, 1>& res
         tempC.MatrTMultiply(strainD, E_eps);
         // Add generalized internal force
         Fint.MatrMultiply(tempC, strain);
-        Fint *= detJ0 * (element->GetLengthX() / 2.0) * (element->GetLengthY() / 2.0) * (element->GetLengthZ() / 2.0);
+        Fint *= gp.weight;
         // Add EAS internal force (vector of 9 components for each element)
         HE1.MatrMultiply(temp56, strain);
-        HE1 *= detJ0 * (element->GetLengthX() / 2.0) * (element->GetLengthY() / 2.0) * (element->GetLengthZ() / 2.0);
+        HE1 *= gp.weight;
     }  // end of   if(isMooney==1)
 
     // Internal force (linear isotropic or Mooney-Rivlin) Jacobian calculation
@@ -1081,13 +925,13 @@ void ChElementBrick::MyForceAnalytical::Evaluate(ChMatrixNM<double, 906, 1>& res
     temp249.MatrTMultiply(Gd, Sigm);
     JAC11 = temp246 * strainD + temp249 * Gd;
     // Final expression for the Jacobian
-    JAC11 *= detJ0 * (element->GetLengthX() / 2.0) * (element->GetLengthY() / 2.0) * (element->GetLengthZ() / 2.0);
+    JAC11 *= gp.weight;
     // Jacobian of EAS forces w.r.t. element coordinates
     GDEPSP.MatrMultiply(temp56, strainD);
-    GDEPSP *= detJ0 * (element->GetLengthX() / 2.0) * (element->GetLengthY() / 2.0) * (element->GetLengthZ() / 2.0);
+    GDEPSP *= gp.weight;
     // Jacobian of EAS forces (w.r.t. EAS internal parameters)
     KALPHA.MatrMultiply(temp56, G);
-    KALPHA *= detJ0 * (element->GetLengthX() / 2.0) * (element->GetLengthY() / 2.0) * (element->GetLengthZ() / 2.0);
+    KALPHA *= gp.weight;
 
     ChMatrixNM<double, 216, 1> GDEPSPVec;
     ChMatrixNM<double, 81, 1> KALPHAVec;
@@ -1699,6 +1543,8 @@ void ChElementBrick::ComputeMassMatrix() {
 // -----------------------------------------------------------------------------
 
 void ChElementBrick::SetupInitial(ChSystem* system) {
+    // Precompute the Gauss point data used in the internal force calculation
+    ComputeGaussPoints();
     // Compute gravitational forces
     ComputeGravityForce(system->Get_G_acc());
     // Compute mass matrix
@@ -1880,6 +1726,104 @@ void ChElementBrick::T0DetJElementCenterForEAS(ChMatrixNM<double, 8, 3>& d0,
     T0(4, 5) = beta(3) * beta(8) + beta(6) * beta(5);
     T0(5, 5) = beta(4) * beta(8) + beta(5) * beta(7);
 }
+// -----------------------------------------------------------------------------
+
+// Precompute the quantities at the 2x2x2 Gauss points which only depend on the initial configuration.
+// The quadrature weight, the scaling due to the change of integration intervals and the determinant
+// detJ0 are folded into 'weight'.
+void ChElementBrick::ComputeGaussPoints() {
+    const std::vector<double>& roots = ChQuadrature::GetStaticTables()->Lroots[1];
+    const std::vector<double>& weights = ChQuadrature::GetStaticTables()->Weight[1];
+
+    // EAS transformation matrix and determinant at the element center
+    ChMatrixNM<double, 6, 6> T0;
+    double detJ0C;
+    T0DetJElementCenterForEAS(m_d0, T0, detJ0C);
+
+    ChMatrixNM<double, 8, 8> d0_d0;
+    d0_d0.MatrMultiplyT(m_d0, m_d0);
+
+    m_GaussPoints.clear();
+    m_GaussPoints.reserve(8);
+
+    for (int ix = 0; ix < 2; ix++) {
+        for (int iy = 0; iy < 2; iy++) {
+            for (int iz = 0; iz < 2; iz++) {
+                double x = roots[ix];
+                double y = roots[iy];
+                double z = roots[iz];
+
+                GaussPoint gp;
+                ShapeFunctionsDerivativeX(gp.Nx, x, y, z);
+                ShapeFunctionsDerivativeY(gp.Ny, x, y, z);
+                ShapeFunctionsDerivativeZ(gp.Nz, x, y, z);
+
+                // Sd=[Nd1*eye(3) Nd2*eye(3) Nd3*eye(3) Nd4*eye(3)]
+                gp.Sx.Reset();
+                gp.Sy.Reset();
+                gp.Sz.Reset();
+                for (int i = 0; i < 8; i++) {
+                    for (int j = 0; j < 3; j++) {
+                        gp.Sx(j, 3 * i + j) = gp.Nx(i);
+                        gp.Sy(j, 3 * i + j) = gp.Ny(i);
+                        gp.Sz(j, 3 * i + j) = gp.Nz(i);
+                    }
+                }
+
+                gp.d0d0Nx.MatrMultiplyT(d0_d0, gp.Nx);
+                gp.d0d0Ny.MatrMultiplyT(d0_d0, gp.Ny);
+                gp.d0d0Nz.MatrMultiplyT(d0_d0, gp.Nz);
+
+                // Initial position vector gradient (columns G1, G2, G3)
+                ChMatrixNM<double, 1, 3> Nx_d0 = gp.Nx * m_d0;
+                ChMatrixNM<double, 1, 3> Ny_d0 = gp.Ny * m_d0;
+                ChMatrixNM<double, 1, 3> Nz_d0 = gp.Nz * m_d0;
+                ChMatrixNM<double, 3, 3> rd0;
+                for (int i = 0; i < 3; i++) {
+                    rd0(i, 0) = Nx_d0(0, i);
+                    rd0(i, 1) = Ny_d0(0, i);
+                    rd0(i, 2) = Nz_d0(0, i);
+                }
+                double detJ0 = rd0.Det();
+
+                // Tangent frame (the material directions coincide with it)
+                ChVector<double> G1(rd0(0, 0), rd0(1, 0), rd0(2, 0));
+                ChVector<double> G2(rd0(0, 1), rd0(1, 1), rd0(2, 1));
+                ChVector<double> A3 = Vcross(G1, G2).GetNormalized();
+                ChVector<double> A1 = G1.GetNormalized();
+                ChVector<double> A2 = Vcross(A3, A1);
+
+                // Coefficients of contravariant transformation
+                gp.j0 = rd0;
+                gp.j0.MatrInverse();
+                ChVector<double> j01(gp.j0(0, 0), gp.j0(0, 1), gp.j0(0, 2));
+                ChVector<double> j02(gp.j0(1, 0), gp.j0(1, 1), gp.j0(1, 2));
+                ChVector<double> j03(gp.j0(2, 0), gp.j0(2, 1), gp.j0(2, 2));
+                gp.beta(0) = Vdot(A1, j01);
+                gp.beta(1) = Vdot(A2, j01);
+                gp.beta(2) = Vdot(A3, j01);
+                gp.beta(3) = Vdot(A1, j02);
+                gp.beta(4) = Vdot(A2, j02);
+                gp.beta(5) = Vdot(A3, j02);
+                gp.beta(6) = Vdot(A1, j03);
+                gp.beta(7) = Vdot(A2, j03);
+                gp.beta(8) = Vdot(A3, j03);
+
+                // Enhanced Assumed Strain
+                ChMatrixNM<double, 6, 9> M;
+                Basis_M(M, x, y, z);
+                gp.G.MatrMultiply(T0, M);
+                gp.G.MatrScale(detJ0C / detJ0);
+
+                gp.weight = weights[ix] * weights[iy] * weights[iz] * detJ0 * (GetLengthX() / 2.0) *
+                            (GetLengthY() / 2.0) * (GetLengthZ() / 2.0);
+
+                m_GaussPoints.push_back(gp);
+            }
+        }
+    }
+}
+
 // -----------------------------------------------------------------------------
 void ChElementBrick::Basis_M(ChMatrixNM<double, 6, 9>& M, double x, double y, double z) {
     M.Reset();
@@ -63,51 +63,59 @@ class ChApiFea ChElementBrick : public ChElementGeneric, public ChLoadableUVW {
                               const double z) override;
     };
 
-    /// Internal force, EAS stiffness, and analytical jacobian are calculated
-    class MyForceAnalytical : public ChIntegrable3D<ChMatrixNM<double, 906, 1> > {
+    /// Data at a Gauss point, depending only on the initial configuration.
+    /// Precomputed at setup, so that the internal forces and their Jacobian do not re-evaluate the
+    /// shape functions and the initial geometry at each call.
+    struct GaussPoint {
+        ChMatrixNM<double, 1, 8> Nx;       ///< Dense shape function vector, X derivative
+        ChMatrixNM<double, 1, 8> Ny;       ///< Dense shape function vector, Y derivative
+        ChMatrixNM<double, 1, 8> Nz;       ///< Dense shape function vector, Z derivative
+        ChMatrixNM<double, 3, 24> Sx;      ///< Sparse shape function matrix, X derivative
+        ChMatrixNM<double, 3, 24> Sy;      ///< Sparse shape function matrix, Y derivative
+        ChMatrixNM<double, 3, 24> Sz;      ///< Sparse shape function matrix, Z derivative
+        ChMatrixNM<double, 8, 1> d0d0Nx;   ///< d0*d0'*Nx' matrix
+        ChMatrixNM<double, 8, 1> d0d0Ny;   ///< d0*d0'*Ny' matrix
+        ChMatrixNM<double, 8, 1> d0d0Nz;   ///< d0*d0'*Nz' matrix
+        ChMatrixNM<double, 3, 3> j0;       ///< Inverse of the initial position vector gradient matrix
+        ChMatrixNM<double, 9, 1> beta;     ///< Coefficients of the contravariant transformation
+        ChMatrixNM<double, 6, 9> G;        ///< Matrix G interpolates the internal parameters of EAS
+        double weight;                     ///< Quadrature weight, times detJ0 and the integration scaling
+    };
+
+    /// Internal force, EAS stiffness, and analytical jacobian are calculated,
+    /// integrating over the precomputed Gauss points.
+    class MyForceAnalytical {
       public:
         MyForceAnalytical();
         /// Constructor 1
         MyForceAnalytical(ChMatrixNM<double, 8, 3>* d_,
-                          ChMatrixNM<double, 8, 3>* m_d0_,
                           ChElementBrick* element_,
-                          ChMatrixNM<double, 6, 6>* T0_,
-                          double* detJ0C_,
                           ChMatrixNM<double, 9, 1>* alpha_eas_) {
             d = d_;
-            d0 = m_d0_;
             element = element_;
-            T0 = T0_;
-            detJ0C = detJ0C_;
             alpha_eas = alpha_eas_;
         }
         /// Constructor 2
         MyForceAnalytical(ChMatrixNM<double, 8, 3>* d_,
-                          ChMatrixNM<double, 8, 3>* m_d0_,
                           ChElementBrick* element_,
-                          ChMatrixNM<double, 6, 6>* T0_,
-                          double* detJ0C_,
                           ChMatrixNM<double, 9, 1>* alpha_eas_,
                           double* E_,
                           double* v_) {
             d = d_;
-            d0 = m_d0_;
             element = element_;
-            T0 = T0_;
-            detJ0C = detJ0C_;
             alpha_eas = alpha_eas_;
             E = E_;
             v = v_;
         }
         ~MyForceAnalytical() {}
 
+        /// Sum the weighted integrand over the Gauss points of the element.
+        void Integrate(ChMatrixNM<double, 906, 1>& result);
+
       private:
         ChElementBrick* element;
         ChMatrixNM<double, 8, 3>* d;          ///< Pointer to a matrix containing the element coordinates
-        ChMatrixNM<double, 8, 3>* d0;         ///< Pointer to a matrix containing the element initial coordinates
-        ChMatrixNM<double, 6, 6>* T0;         ///< Pointer to transformation matrix for Enhanced Assumed Strain (EAS)
         ChMatrixNM<double, 9, 1>* alpha_eas;  ///< Pointer to the 9 internal parameters for EAS
-        double* detJ0C;                       ///< Pointer to determinant of the initial Jacobian at the element center
         double* E;                            ///< Pointer to Young modulus
         double* v;                            ///< Pointer to Poisson ratio
 
@@ -119,12 +127,6 @@ class ChApiFea ChElementBrick : public ChElementGeneric, public ChLoadableUVW {
         ChMatrixNM<double, 24, 6> temp246;  ///< Temporary matrix for Jacobian (JAC11) calculation
         ChMatrixNM<double, 24, 9> temp249;  ///< Temporary matrix for Jacobian (JAC11) calculation
         ChMatrixNM<double, 6, 6> E_eps;     ///< Matrix of elastic coefficients (features orthotropy)
-        ChMatrixNM<double, 3, 24> Sx;       ///< Sparse shape function matrix, X derivative
-        ChMatrixNM<double, 3, 24> Sy;       ///< Sparse shape function matrix, Y derivative
-        ChMatrixNM<double, 3, 24> Sz;       ///< Sparse shape function matrix, Z derivative
-        ChMatrixNM<double, 1, 8> Nx;        ///< Dense shape function vector, X derivative
-        ChMatrixNM<double, 1, 8> Ny;        ///< Dense shape function vector, Y derivative
-        ChMatrixNM<double, 1, 8> Nz;        ///< Dense shape function vector, Z derivative
         ChMatrixNM<double, 6, 24> strainD;  ///< Derivative of the strains w.r.t. the coordinates. Includes orthotropy
         ChMatrixNM<double, 6, 1> strain;    ///< Vector of strains
         ChMatrixNM<double, 8, 8> d_d;       ///< d*d' matrix, where d contains current coordinates in matrix form
@@ -135,22 +137,12 @@ class ChApiFea ChElementBrick : public ChElementGeneric, public ChLoadableUVW {
         ChMatrixNM<double, 1, 24> tempB;    ///< Contains temporary strain derivatives
         ChMatrixNM<double, 24, 6> tempC;    ///< Used to calculate the internal forces Fint
         ChMatrixNM<double, 1, 1> tempA1;    ///< Contains temporary strains
-        ChMatrixNM<double, 8, 8> d0_d0;     ///< d0*d0' matrix, where d0 contains initial coordinates in matrix form
-        ChMatrixNM<double, 8, 1> d0d0Nx;    ///< d0_d0*Nx' matrix
-        ChMatrixNM<double, 8, 1> d0d0Ny;    ///< d0_d0*Ny' matrix
-        ChMatrixNM<double, 8, 1> d0d0Nz;    ///< d0_d0*Nz' matrix
-        double detJ0;                       ///< Determinant of the initial position vector gradient matrix
         // EAS
-        ChMatrixNM<double, 6, 9> M;           ///< Shape function matrix for Enhanced Assumed Strain
-        ChMatrixNM<double, 6, 9> G;           ///< Matrix G interpolates the internal parameters of EAS
         ChMatrixNM<double, 9, 6> GT;          ///< Tranpose of matrix GT
         ChMatrixNM<double, 6, 1> strain_EAS;  ///< Enhanced assumed strain vector
 
-        /// Evaluate (strainD'*strain)  at a point
-        virtual void Evaluate(ChMatrixNM<double, 906, 1>& result,
-                              const double x,
-                              const double y,
-                              const double z) override;
+        /// Evaluate (strainD'*strain) at a Gauss point
+        void Evaluate(ChMatrixNM<double, 906, 1>& result, const GaussPoint& gp);
     };
 
     class MyForceNum : public ChIntegrable3D<ChMatrixNM<double, 330, 1> > {
@@ -474,6 +466,7 @@ class ChApiFea ChElementBrick : public ChElementGeneric, public ChLoadableUVW {
     ChMatrixNM<double, 24, 24> m_stock_KTE;      ///< Analytical Jacobian
     ChMatrixNM<double, 8, 3> m_d0;               ///< Initial Coordinate per element
     ChMatrixNM<double, 24, 1> m_GravForce;       ///< Gravity Force
+    std::vector<GaussPoint> m_GaussPoints;       ///< Precomputed Gauss point data
     JacobianType m_flag_HE;
     bool m_gravity_on;  ///< Flag indicating whether or not gravity is included
     bool m_isMooney;    ///< Flag indicating whether the material is Mooney Rivlin
@@ -516,6 +509,8 @@ class ChApiFea ChElementBrick : public ChElementGeneric, public ChLoadableUVW {
     /// in the Fi vector.
     virtual void ComputeInternalForces(ChMatrixDynamic<>& Fi) override;
 
+    /// Precompute the Gauss point data used in the internal force calculation.
+    void ComputeGaussPoints();
     // [EAS] matrix T0 (inverse and transposed) and detJ0 at center are used for Enhanced Assumed Strains alpha
     void T0DetJElementCenterForEAS(ChMatrixNM<double, 8, 3>& d0, ChMatrixNM<double, 6, 6>& T0, double& detJ0C);
     // [EAS] Basis function of M for Enhanced Assumed Strain
@@ -0,0 +1,244 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/core/ChLinearAlgebra.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono_fea/ChElementCraigBampton.h"
+
+namespace chrono {
+namespace fea {
+
+ChElementCraigBampton::ChElementCraigBampton()
+    : frame_pos(VNULL), frame_rot(1), rayleigh_beta(0), automatic_gravity(false), system(nullptr) {}
+
+void ChElementCraigBampton::SetNodes(const std::vector<std::shared_ptr<ChNodeFEAxyz>>& boundary,
+                                     std::shared_ptr<ChNodeFEAmodal> modal) {
+    boundary_nodes = boundary;
+    modal_node = modal;
+
+    std::vector<ChVariables*> mvars;
+    for (auto& node : boundary_nodes)
+        mvars.push_back(&node->Variables());
+    mvars.push_back(&modal_node->Variables());
+    Kmatr.SetVariables(mvars);
+
+    // Reference configuration, from the centroid of the boundary nodes.
+    ChVector<> centroid(VNULL);
+    for (auto& node : boundary_nodes)
+        centroid += node->GetX0();
+    if (!boundary_nodes.empty())
+        centroid *= 1.0 / boundary_nodes.size();
+    boundary_ref.resize(boundary_nodes.size());
+    for (size_t i = 0; i < boundary_nodes.size(); i++)
+        boundary_ref[i] = boundary_nodes[i]->GetX0() - centroid;
+    interior_ref.clear();
+    frame_pos = centroid;
+    frame_rot.Set33Identity();
+}
+
+void ChElementCraigBampton::SetReducedMatrices(const ChMatrixDynamic<>& K, const ChMatrixDynamic<>& M) {
+    int n = GetNdofs();
+    if (K.GetRows() != n || K.GetColumns() != n || M.GetRows() != n || M.GetColumns() != n)
+        throw ChException("ChElementCraigBampton: wrong size of the reduced matrices.");
+    Kred = K;
+    Mred = M;
+    int nb = 3 * (int)boundary_nodes.size();
+    for (int i = nb; i < n; i++)
+        for (int j = nb; j < n; j++)
+            Mred(i, j) = 0;
+}
+
+void ChElementCraigBampton::SetInteriorNodes(const std::vector<std::shared_ptr<ChNodeFEAxyz>>& interior,
+                                             const ChMatrixDynamic<>& mPsi,
+                                             const ChMatrixDynamic<>& mPhi) {
+    interior_nodes = interior;
+    Psi = mPsi;
+    Phi = mPhi;
+
+    ChVector<> centroid(VNULL);
+    for (size_t i = 0; i < boundary_nodes.size(); i++)
+        centroid += boundary_nodes[i]->GetX0() - boundary_ref[i];
+    if (!boundary_nodes.empty())
+        centroid *= 1.0 / boundary_nodes.size();
+    interior_ref.resize(interior_nodes.size());
+    for (size_t i = 0; i < interior_nodes.size(); i++)
+        interior_ref[i] = interior_nodes[i]->GetX0() - centroid;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChElementCraigBampton::SetupInitial(ChSystem* msystem) {
+    system = msystem;
+    Update();
+}
+
+void ChElementCraigBampton::Update() {
+    int nb = (int)boundary_nodes.size();
+    if (nb == 0)
+        return;
+
+    ChVector<> centroid(VNULL);
+    for (auto& node : boundary_nodes)
+        centroid += node->GetPos();
+    centroid *= 1.0 / nb;
+    frame_pos = centroid;
+    if (nb < 3)
+        return;
+
+    // Best-fit rotation of the boundary nodes, as the unit quaternion which maximizes sum_i p_i' * R * q_i,
+    // i.e. the eigenvector of the largest eigenvalue of a 4x4 symmetric matrix (B.K.P. Horn, 1987).
+    double S[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+    for (int i = 0; i < nb; i++) {
+        ChVector<> p = boundary_ref[i];
+        ChVector<> q = boundary_nodes[i]->GetPos() - centroid;
+        for (int a = 0; a < 3; a++)
+            for (int b = 0; b < 3; b++)
+                S[a][b] += p[a] * q[b];
+    }
+    ChMatrixNM<double, 4, 4> N;
+    N(0, 0) = S[0][0] + S[1][1] + S[2][2];
+    N(1, 1) = S[0][0] - S[1][1] - S[2][2];
+    N(2, 2) = -S[0][0] + S[1][1] - S[2][2];
+    N(3, 3) = -S[0][0] - S[1][1] + S[2][2];
+    N(0, 1) = N(1, 0) = S[1][2] - S[2][1];
+    N(0, 2) = N(2, 0) = S[2][0] - S[0][2];
+    N(0, 3) = N(3, 0) = S[0][1] - S[1][0];
+    N(1, 2) = N(2, 1) = S[0][1] + S[1][0];
+    N(1, 3) = N(3, 1) = S[2][0] + S[0][2];
+    N(2, 3) = N(3, 2) = S[1][2] + S[2][1];
+    ChMatrixDynamic<> V;
+    ChMatrixDynamic<> d;
+    ChLinearAlgebra::SymmetricEigen(N, V, d);
+    ChQuaternion<> rot(V(0, 3), V(1, 3), V(2, 3), V(3, 3));
+    rot.Normalize();
+    frame_rot.Set_A_quaternion(rot);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChElementCraigBampton::GetStateBlock(ChMatrixDynamic<>& mD) {
+    mD.Reset(GetNdofs(), 1);
+    for (size_t i = 0; i < boundary_nodes.size(); i++)
+        mD.PasteVector(boundary_nodes[i]->GetPos(), 3 * (int)i, 0);
+    mD.PasteMatrix(modal_node->GetModalCoordinates(), 3 * (int)boundary_nodes.size(), 0);
+}
+
+void ChElementCraigBampton::RotateRows(ChMatrix<>& A) const {
+    int nc = A.GetColumns();
+    for (int ib = 0; ib < (int)boundary_nodes.size(); ib++) {
+        int r = 3 * ib;
+        for (int c = 0; c < nc; c++) {
+            ChVector<> v = frame_rot * ChVector<>(A(r, c), A(r + 1, c), A(r + 2, c));
+            A(r, c) = v.x();
+            A(r + 1, c) = v.y();
+            A(r + 2, c) = v.z();
+        }
+    }
+}
+
+void ChElementCraigBampton::RotateColumns(ChMatrix<>& A) const {
+    int nr = A.GetRows();
+    for (int ib = 0; ib < (int)boundary_nodes.size(); ib++) {
+        int c = 3 * ib;
+        for (int r = 0; r < nr; r++) {
+            ChVector<> v = frame_rot * ChVector<>(A(r, c), A(r, c + 1), A(r, c + 2));
+            A(r, c) = v.x();
+            A(r, c + 1) = v.y();
+            A(r, c + 2) = v.z();
+        }
+    }
+}
+
+void ChElementCraigBampton::ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor, double Mfactor) {
+    int n = GetNdofs();
+    assert((H.GetRows() == n) && (H.GetColumns() == n));
+
+    // H = Tr * ((Kfactor + Rfactor * beta) * K + Mfactor * M) * Tr', with Tr the block-diagonal rotation.
+    double kfactor = Kfactor + Rfactor * rayleigh_beta;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            H(i, j) = kfactor * Kred(i, j) + Mfactor * Mred(i, j);
+    RotateRows(H);
+    RotateColumns(H);
+}
+
+void ChElementCraigBampton::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
+    int n = GetNdofs();
+    int nb = (int)boundary_nodes.size();
+    assert((Fi.GetRows() == n) && (Fi.GetColumns() == 1));
+
+    // Displacements and speeds in the floating frame.
+    ChVector<> mean_speed(VNULL);
+    for (auto& node : boundary_nodes)
+        mean_speed += node->GetPos_dt();
+    if (nb)
+        mean_speed *= 1.0 / nb;
+    ChVectorDynamic<> displ(n);
+    ChVectorDynamic<> speed(n);
+    for (int i = 0; i < nb; i++) {
+        displ.PasteVector(frame_rot.MatrT_x_Vect(boundary_nodes[i]->GetPos() - frame_pos) - boundary_ref[i], 3 * i,
+                          0);
+        speed.PasteVector(frame_rot.MatrT_x_Vect(boundary_nodes[i]->GetPos_dt() - mean_speed), 3 * i, 0);
+    }
+    displ.PasteMatrix(modal_node->GetModalCoordinates(), 3 * nb, 0);
+    speed.PasteMatrix(modal_node->GetModalSpeeds(), 3 * nb, 0);
+    if (rayleigh_beta)
+        displ.MatrInc(speed * rayleigh_beta);
+
+    // Elastic and damping forces: -Tr * K * (u + beta * u_dt).
+    Fi.MatrMultiply(Kred, displ);
+    Fi.MatrNeg();
+
+    // Gravity: M * [g; ...; g; 0], since a uniform translation of the boundary nodes translates the whole body.
+    if (automatic_gravity && system) {
+        ChVector<> g = frame_rot.MatrT_x_Vect(system->Get_G_acc());
+        for (int i = 0; i < n; i++) {
+            double sum = 0;
+            for (int j = 0; j < nb; j++)
+                sum += Mred(i, 3 * j) * g.x() + Mred(i, 3 * j + 1) * g.y() + Mred(i, 3 * j + 2) * g.z();
+            Fi(i) += sum;
+        }
+    }
+
+    RotateRows(Fi);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChElementCraigBampton::UpdateInteriorNodes() {
+    int nb = (int)boundary_nodes.size();
+    int nm = modal_node->GetNumModes();
+    ChVectorDynamic<> displ(3 * nb);
+    for (int i = 0; i < nb; i++)
+        displ.PasteVector(frame_rot.MatrT_x_Vect(boundary_nodes[i]->GetPos() - frame_pos) - boundary_ref[i], 3 * i,
+                          0);
+    const ChVectorDynamic<>& q = modal_node->GetModalCoordinates();
+
+#pragma omp parallel for schedule(static)
+    for (int in = 0; in < (int)interior_nodes.size(); in++) {
+        double u[3];
+        for (int k = 0; k < 3; k++) {
+            int r = 3 * in + k;
+            double sum = 0;
+            for (int j = 0; j < 3 * nb; j++)
+                sum += Psi(r, j) * displ(j);
+            for (int j = 0; j < nm; j++)
+                sum += Phi(r, j) * q(j);
+            u[k] = sum;
+        }
+        ChVector<> local = interior_ref[in] + ChVector<>(u[0], u[1], u[2]);
+        interior_nodes[in]->SetPos(frame_pos + frame_rot * local);
+    }
+}
+
+}  // end namespace fea
+}  // end namespace chrono
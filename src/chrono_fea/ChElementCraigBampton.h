@@ -0,0 +1,144 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHELEMENTCRAIGBAMPTON_H
+#define CHELEMENTCRAIGBAMPTON_H
+
+#include "chrono_fea/ChElementGeneric.h"
+#include "chrono_fea/ChNodeFEAmodal.h"
+#include "chrono_fea/ChNodeFEAxyz.h"
+
+namespace chrono {
+namespace fea {
+
+/// @addtogroup fea_elements
+/// @{
+
+/// Reduced-order flexible body (superelement) obtained with the Craig-Bampton method from a mesh of
+/// xyz nodes (see ChModalReduction). The degrees of freedom are the positions of the boundary nodes,
+/// which can be connected to the rest of the system, and the amplitudes of a few fixed-interface modes,
+/// stored in a ChNodeFEAmodal.
+/// The element is corotational: the reduced stiffness and mass matrices are expressed in a floating frame
+/// which follows the best-fit rigid motion of the boundary nodes, so the body can undergo large rigid
+/// motions with small deformations. At least three non-collinear boundary nodes are needed for the frame
+/// to rotate. Gyroscopic and centrifugal terms of the deformation are neglected.
+class ChApiFea ChElementCraigBampton : public ChElementGeneric {
+  public:
+    ChElementCraigBampton();
+    ~ChElementCraigBampton() {}
+
+    virtual int GetNnodes() override { return (int)boundary_nodes.size() + 1; }
+    virtual int GetNdofs() override { return 3 * (int)boundary_nodes.size() + modal_node->GetNumModes(); }
+    virtual int GetNodeNdofs(int n) override {
+        return n < (int)boundary_nodes.size() ? 3 : modal_node->GetNumModes();
+    }
+
+    virtual std::shared_ptr<ChNodeFEAbase> GetNodeN(int n) override {
+        if (n < (int)boundary_nodes.size())
+            return boundary_nodes[n];
+        return modal_node;
+    }
+
+    /// Set the boundary nodes and the node of the modal coordinates. The reference positions (GetX0()) of the
+    /// boundary nodes define the undeformed configuration.
+    void SetNodes(const std::vector<std::shared_ptr<ChNodeFEAxyz>>& boundary,
+                  std::shared_ptr<ChNodeFEAmodal> modal);
+
+    /// Set the reduced stiffness and mass matrices, ordered as the boundary displacements (x,y,z of each
+    /// node) followed by the modal coordinates. The block of the modal mass must be the identity, and it is
+    /// not used (the modal node already has an identity mass).
+    void SetReducedMatrices(const ChMatrixDynamic<>& K, const ChMatrixDynamic<>& M);
+
+    /// Get the reduced stiffness matrix, in the floating frame.
+    const ChMatrixDynamic<>& GetReducedStiffness() const { return Kred; }
+    /// Get the reduced mass matrix, in the floating frame (without the identity modal block).
+    const ChMatrixDynamic<>& GetReducedMass() const { return Mred; }
+
+    /// Set the nodes of the original mesh which were condensed, with the matrices that give their
+    /// displacements from the boundary displacements (Psi, static modes) and from the modal coordinates
+    /// (Phi, fixed-interface modes). These are used only to recover the deformed shape of the full mesh,
+    /// see UpdateInteriorNodes().
+    void SetInteriorNodes(const std::vector<std::shared_ptr<ChNodeFEAxyz>>& interior,
+                          const ChMatrixDynamic<>& Psi,
+                          const ChMatrixDynamic<>& Phi);
+
+    /// Get the condensed nodes of the original mesh.
+    const std::vector<std::shared_ptr<ChNodeFEAxyz>>& GetInteriorNodes() const { return interior_nodes; }
+
+    /// Set the positions of the condensed nodes from the current state of the element, for postprocessing.
+    void UpdateInteriorNodes();
+
+    /// Set the stiffness-proportional Rayleigh damping coefficient (default: 0).
+    void SetRayleighDampingK(double beta) { rayleigh_beta = beta; }
+    double GetRayleighDampingK() const { return rayleigh_beta; }
+
+    /// Enable the gravity load, computed from the reduced mass matrix and the gravity of the system
+    /// (default: false).
+    void SetAutomaticGravity(bool gravity) { automatic_gravity = gravity; }
+    bool GetAutomaticGravity() const { return automatic_gravity; }
+
+    /// Get the rotation of the floating frame, from the reference configuration to the current one.
+    const ChMatrix33<>& GetFrameRotation() const { return frame_rot; }
+    /// Get the origin of the floating frame (the centroid of the boundary nodes).
+    const ChVector<>& GetFramePosition() const { return frame_pos; }
+
+    //
+    // FEA functions
+    //
+
+    /// Fills the D vector with the positions of the boundary nodes followed by the modal coordinates.
+    virtual void GetStateBlock(ChMatrixDynamic<>& mD) override;
+
+    /// Sets H as the global stiffness matrix K, scaled by Kfactor, plus the damping matrix scaled by Rfactor
+    /// and the mass matrix scaled by Mfactor, all rotated from the floating frame.
+    virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H,
+                                          double Kfactor,
+                                          double Rfactor = 0,
+                                          double Mfactor = 0) override;
+
+    /// Computes the internal forces (elastic, damping and gravity) in the Fi vector.
+    virtual void ComputeInternalForces(ChMatrixDynamic<>& Fi) override;
+
+    /// Store the system, for the gravity load, and initialize the floating frame.
+    virtual void SetupInitial(ChSystem* system) override;
+
+    /// Update the floating frame.
+    virtual void Update() override;
+
+  private:
+    // Multiply the rows (or the columns) of A by the rotation of the floating frame (the 3x3 blocks of the
+    // boundary nodes are rotated, the modal rows are unchanged).
+    void RotateRows(ChMatrix<>& A) const;
+    void RotateColumns(ChMatrix<>& A) const;
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> boundary_nodes;
+    std::shared_ptr<ChNodeFEAmodal> modal_node;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> interior_nodes;
+    ChMatrixDynamic<> Kred;                  ///< reduced stiffness matrix
+    ChMatrixDynamic<> Mred;                  ///< reduced mass matrix, without the modal block
+    ChMatrixDynamic<> Psi;                   ///< static modes of the interior nodes
+    ChMatrixDynamic<> Phi;                   ///< fixed-interface modes of the interior nodes
+    std::vector<ChVector<>> boundary_ref;    ///< reference positions of the boundary nodes, from their centroid
+    std::vector<ChVector<>> interior_ref;    ///< reference positions of the interior nodes, from the same centroid
+    ChVector<> frame_pos;
+    ChMatrix33<> frame_rot;
+    double rayleigh_beta;
+    bool automatic_gravity;
+    ChSystem* system;
+};
+
+/// @} fea_elements
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
@@ -12,6 +12,9 @@
 // Authors: Andrea Favali
 // =============================================================================
 
+#include <algorithm>
+
+#include "chrono_fea/ChCorotationalBatch.h"
 #include "chrono_fea/ChElementHexa_8.h"
 
 namespace chrono {
@@ -26,5 +29,30 @@ ChElementHexa_8::ChElementHexa_8() {
 
 ChElementHexa_8::~ChElementHexa_8() {}
 
+void ChElementHexa_8::KRMmatricesLoadBatch(ChElementHexa_8* const* elements,
+                                           int n,
+                                           double Kfactor,
+                                           double Rfactor,
+                                           double Mfactor) {
+    const int width = ChCorotationalBatch::WIDTH;
+    const ChMatrix<>* pK[width];
+    const ChMatrix33<>* pA[width];
+    ChMatrix<>* pH[width];
+    double scale[width];
+    for (int start = 0; start < n; start += width) {
+        int count = std::min(width, n - start);
+        for (int l = 0; l < count; l++) {
+            ChElementHexa_8* element = elements[start + l];
+            pK[l] = &element->StiffnessMatrix;
+            pA[l] = &element->A;
+            pH[l] = element->Kmatr.Get_K();
+            scale[l] = Kfactor + Rfactor * element->Material->Get_RayleighDampingK();
+        }
+        ChCorotationalBatch::RotateStiffness(count, 8, pK, pA, scale, pH);
+        for (int l = 0; l < count; l++)
+            elements[start + l]->AddLumpedMass(*pH[l], Rfactor, Mfactor);
+    }
+}
+
 }  // end namespace fea
 }  // end namespace chrono
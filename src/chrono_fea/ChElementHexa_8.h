@@ -384,16 +384,17 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
         H.PasteMatrix(CKCt, 0, 0);
 
         // For M mass matrix:
-        if (Mfactor) {
-            double lumped_node_mass = (this->Volume * this->Material->Get_density()) / 8.0;
-            for (int id = 0; id < GetNdofs(); id++) {
-                double amfactor = Mfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingM();
-                H(id, id) += amfactor * lumped_node_mass;
-            }
-        }
-        //***TO DO*** better per-node lumping, or 12x12 consistent mass matrix.
+        AddLumpedMass(H, Rfactor, Mfactor);
     }
 
+    /// Same as calling KRMmatricesLoad() on 'n' elements, with the stiffness matrices rotated in batches
+    /// (see ChCorotationalBatch).
+    static void KRMmatricesLoadBatch(ChElementHexa_8* const* elements,
+                                     int n,
+                                     double Kfactor,
+                                     double Rfactor,
+                                     double Mfactor);
+
     /// Computes the internal forces (ex. the actual position of
     /// nodes is not in relaxed reference position) and set values
     /// in the Fi vector.
@@ -551,6 +552,18 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
 
     /// This is needed so that it can be accessed by ChLoaderVolumeGravity
     virtual double GetDensity() override { return this->Material->Get_density(); }
+
+  protected:
+    /// Add the lumped mass matrix, scaled by Mfactor, and the mass-proportional damping, scaled by Rfactor.
+    void AddLumpedMass(ChMatrix<>& H, double Rfactor, double Mfactor) {
+        if (Mfactor) {
+            double lumped_node_mass = (this->Volume * this->Material->Get_density()) / 8.0;
+            double amfactor = Mfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingM();
+            for (int id = 0; id < 24; id++)
+                H(id, id) += amfactor * lumped_node_mass;
+        }
+        //***TO DO*** better per-node lumping, or 24x24 consistent mass matrix.
+    }
 };
 
 /// @} fea_elements
@@ -110,6 +110,9 @@ void ChElementShellANCF::SetupInitial(ChSystem* system) {
     // Cache the scaling factor (due to change of integration intervals)
     m_GaussScaling = (m_lenX * m_lenY * m_thickness) / 8;
 
+    // Precompute the Gauss point data used in the internal force and Jacobian calculations
+    ComputeGaussPoints();
+
     // Compute mass matrix and gravitational forces (constant)
     ComputeMassMatrix();
     ComputeGravityForce(system->Get_G_acc());
@@ -293,7 +296,9 @@ void ChElementShellANCF::ComputeGravityForce(const ChVector<>& g_acc) {
 // shear locking. This implementation also features a composite material implementation
 // that allows for selecting a number of layers over the element thickness; each of which
 // has an independent, user-selected fiber angle (direction for orthotropic constitutive behavior)
-class MyForce : public ChIntegrable3D<ChMatrixNM<double, 54, 1> > {
+// The integrand is evaluated at the precomputed Gauss points of the layer and already includes
+// the quadrature weights.
+class MyForce {
   public:
     MyForce(ChElementShellANCF* element,         // Containing element
             size_t kl,                           // Current layer index
@@ -302,110 +307,41 @@ class MyForce : public ChIntegrable3D<ChMatrixNM<double, 54, 1> > {
         : m_element(element), m_kl(kl), m_alpha_eas(alpha_eas) {}
     ~MyForce() {}
 
+    /// Integrate over the layer, summing the weighted integrand over its Gauss points.
+    void Integrate(ChMatrixNM<double, 54, 1>& result);
+
   private:
     ChElementShellANCF* m_element;
     size_t m_kl;
     ChMatrixNM<double, 5, 1>* m_alpha_eas;
 
-    /// Evaluate (strainD'*strain)  at point x, include ANS and EAS.
-    virtual void Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const double y, const double z) override;
+    /// Evaluate (strainD'*strain) at the given Gauss point, include ANS and EAS.
+    void Evaluate(ChMatrixNM<double, 54, 1>& result, const ChElementShellANCF::GaussPoint& gp);
 };
 
-void MyForce::Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const double y, const double z) {
-    // Element shape function
-    ChMatrixNM<double, 1, 8> N;
-    m_element->ShapeFunctions(N, x, y, z);
-
-    // Determinant of position vector gradient matrix: Initial configuration
-    ChMatrixNM<double, 1, 8> Nx;
-    ChMatrixNM<double, 1, 8> Ny;
-    ChMatrixNM<double, 1, 8> Nz;
-    ChMatrixNM<double, 1, 3> Nx_d0;
-    ChMatrixNM<double, 1, 3> Ny_d0;
-    ChMatrixNM<double, 1, 3> Nz_d0;
-    double detJ0 = m_element->Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
-
-    // ANS shape function
-    ChMatrixNM<double, 1, 4> S_ANS;  // Shape function vector for Assumed Natural Strain
-    ChMatrixNM<double, 6, 5> M;      // Shape function vector for Enhanced Assumed Strain
-    m_element->ShapeFunctionANSbilinearShell(S_ANS, x, y);
-    m_element->Basis_M(M, x, y, z);
-
-    // Transformation : Orthogonal transformation (A and J)
-    ChVector<double> G1xG2;  // Cross product of first and second column of
-    double G1dotG1;          // Dot product of first column of position vector gradient
-
-    G1xG2.x() = Nx_d0[0][1] * Ny_d0[0][2] - Nx_d0[0][2] * Ny_d0[0][1];
-    G1xG2.y() = Nx_d0[0][2] * Ny_d0[0][0] - Nx_d0[0][0] * Ny_d0[0][2];
-    G1xG2.z() = Nx_d0[0][0] * Ny_d0[0][1] - Nx_d0[0][1] * Ny_d0[0][0];
-    G1dotG1 = Nx_d0[0][0] * Nx_d0[0][0] + Nx_d0[0][1] * Nx_d0[0][1] + Nx_d0[0][2] * Nx_d0[0][2];
-
-    // Tangent Frame
-    ChVector<double> A1;
-    ChVector<double> A2;
-    ChVector<double> A3;
-    A1.x() = Nx_d0[0][0];
-    A1.y() = Nx_d0[0][1];
-    A1.z() = Nx_d0[0][2];
-    A1 = A1 / sqrt(G1dotG1);
-    A3 = G1xG2.GetNormalized();
-    A2.Cross(A3, A1);
-
-    // Direction for orthotropic material
-    double theta = m_element->GetLayer(m_kl).Get_theta();  // Fiber angle
-    ChVector<double> AA1;
-    ChVector<double> AA2;
-    ChVector<double> AA3;
-    AA1 = A1 * cos(theta) + A2 * sin(theta);
-    AA2 = -A1 * sin(theta) + A2 * cos(theta);
-    AA3 = A3;
-
-    /// Beta
-    ChMatrixNM<double, 3, 3> j0;
-    ChVector<double> j01;
-    ChVector<double> j02;
-    ChVector<double> j03;
-    ChMatrixNM<double, 9, 1> beta;
-    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
-    j0(0, 0) = Ny_d0[0][1] * Nz_d0[0][2] - Nz_d0[0][1] * Ny_d0[0][2];
-    j0(0, 1) = Ny_d0[0][2] * Nz_d0[0][0] - Ny_d0[0][0] * Nz_d0[0][2];
-    j0(0, 2) = Ny_d0[0][0] * Nz_d0[0][1] - Nz_d0[0][0] * Ny_d0[0][1];
-    j0(1, 0) = Nz_d0[0][1] * Nx_d0[0][2] - Nx_d0[0][1] * Nz_d0[0][2];
-    j0(1, 1) = Nz_d0[0][2] * Nx_d0[0][0] - Nx_d0[0][2] * Nz_d0[0][0];
-    j0(1, 2) = Nz_d0[0][0] * Nx_d0[0][1] - Nz_d0[0][1] * Nx_d0[0][0];
-    j0(2, 0) = Nx_d0[0][1] * Ny_d0[0][2] - Ny_d0[0][1] * Nx_d0[0][2];
-    j0(2, 1) = Ny_d0[0][0] * Nx_d0[0][2] - Nx_d0[0][0] * Ny_d0[0][2];
-    j0(2, 2) = Nx_d0[0][0] * Ny_d0[0][1] - Ny_d0[0][0] * Nx_d0[0][1];
-    j0.MatrDivScale(detJ0);
-
-    j01[0] = j0(0, 0);
-    j02[0] = j0(1, 0);
-    j03[0] = j0(2, 0);
-    j01[1] = j0(0, 1);
-    j02[1] = j0(1, 1);
-    j03[1] = j0(2, 1);
-    j01[2] = j0(0, 2);
-    j02[2] = j0(1, 2);
-    j03[2] = j0(2, 2);
-
-    // Coefficients of contravariant transformation
-    beta(0, 0) = Vdot(AA1, j01);
-    beta(1, 0) = Vdot(AA2, j01);
-    beta(2, 0) = Vdot(AA3, j01);
-    beta(3, 0) = Vdot(AA1, j02);
-    beta(4, 0) = Vdot(AA2, j02);
-    beta(5, 0) = Vdot(AA3, j02);
-    beta(6, 0) = Vdot(AA1, j03);
-    beta(7, 0) = Vdot(AA2, j03);
-    beta(8, 0) = Vdot(AA3, j03);
+void MyForce::Integrate(ChMatrixNM<double, 54, 1>& result) {
+    result.Reset();
+    ChMatrixNM<double, 54, 1> val;
+    for (size_t ig = 8 * m_kl; ig < 8 * (m_kl + 1); ig++) {
+        Evaluate(val, m_element->m_GaussPoints[ig]);
+        result += val;
+    }
+}
 
-    // Transformation matrix, function of fiber angle
-    const ChMatrixNM<double, 6, 6>& T0 = m_element->GetLayer(m_kl).Get_T0();
-    // Determinant of the initial position vector gradient at the element center
-    double detJ0C = m_element->GetLayer(m_kl).Get_detJ0C();
+void MyForce::Evaluate(ChMatrixNM<double, 54, 1>& result, const ChElementShellANCF::GaussPoint& gp) {
+    // Shape functions and quantities depending only on the initial configuration (precomputed)
+    const ChMatrixNM<double, 1, 8>& N = gp.N;
+    const ChMatrixNM<double, 1, 8>& Nx = gp.Nx;
+    const ChMatrixNM<double, 1, 8>& Ny = gp.Ny;
+    const ChMatrixNM<double, 1, 8>& Nz = gp.Nz;
+    const ChMatrixNM<double, 1, 4>& S_ANS = gp.S_ANS;
+    const ChMatrixNM<double, 3, 3>& j0 = gp.j0;
+    const ChMatrixNM<double, 9, 1>& beta = gp.beta;
+    const ChMatrixNM<double, 6, 5>& G = gp.G;
+    const ChMatrixNM<double, 8, 1>& d0d0Nx = gp.d0d0Nx;
+    const ChMatrixNM<double, 8, 1>& d0d0Ny = gp.d0d0Ny;
+    const ChMatrixNM<double, 8, 1>& d0d0Nz = gp.d0d0Nz;
 
-    // Enhanced Assumed Strain
-    ChMatrixNM<double, 6, 5> G = T0 * M * (detJ0C / detJ0);
     ChMatrixNM<double, 6, 1> strain_EAS = G * (*m_alpha_eas);
 
     ChMatrixNM<double, 8, 1> ddNx;
@@ -415,13 +351,6 @@ void MyForce::Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const
     ddNy.MatrMultiplyT(m_element->m_ddT, Ny);
     ddNz.MatrMultiplyT(m_element->m_ddT, Nz);
 
-    ChMatrixNM<double, 8, 1> d0d0Nx;
-    ChMatrixNM<double, 8, 1> d0d0Ny;
-    ChMatrixNM<double, 8, 1> d0d0Nz;
-    d0d0Nx.MatrMultiplyT(m_element->m_d0d0T, Nx);
-    d0d0Ny.MatrMultiplyT(m_element->m_d0d0T, Ny);
-    d0d0Nz.MatrMultiplyT(m_element->m_d0d0T, Nz);
-
     // Strain component
     ChMatrixNM<double, 6, 1> strain_til;
     strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - (Nx * d0d0Nx)(0, 0));
@@ -572,13 +501,13 @@ void MyForce::Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const
     // Internal force calculation
     ChMatrixNM<double, 24, 6> tempC;
     tempC.MatrTMultiply(strainD, E_eps);
-    ChMatrixNM<double, 24, 1> Fint = (tempC * strain) * (detJ0 * m_element->m_GaussScaling);
+    ChMatrixNM<double, 24, 1> Fint = (tempC * strain) * gp.weight;
 
     // EAS terms
     ChMatrixNM<double, 5, 6> temp56;
     temp56.MatrTMultiply(G, E_eps);
-    ChMatrixNM<double, 5, 1> HE = (temp56 * strain) * (detJ0 * m_element->m_GaussScaling);  // EAS residual
-    ChMatrixNM<double, 5, 5> KALPHA = (temp56 * G) * (detJ0 * m_element->m_GaussScaling);   // EAS Jacobian
+    ChMatrixNM<double, 5, 1> HE = (temp56 * strain) * gp.weight;  // EAS residual
+    ChMatrixNM<double, 5, 5> KALPHA = (temp56 * G) * gp.weight;   // EAS Jacobian
 
     /// Total result vector
     result.PasteClippedMatrix(Fint, 0, 0, 24, 1, 0, 0);
@@ -608,13 +537,7 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
         for (int count = 0; count < m_maxIterationsEAS; count++) {
             ChMatrixNM<double, 54, 1> result;
             MyForce formula(this, kl, &alphaEAS);
-            ChQuadrature::Integrate3D<ChMatrixNM<double, 54, 1> >(result,   // result of integration
-                                                                  formula,  // integrand formula
-                                                                  -1, 1,    // x limits
-                                                                  -1, 1,    // y limits
-                                                                  m_GaussZ[kl], m_GaussZ[kl + 1],  // z limits
-                                                                  2  // order of integration
-                                                                  );
+            formula.Integrate(result);
 
             // Extract vectors and matrices from result of integration
             Finternal.PasteClippedMatrix(result, 0, 0, 24, 1, 0, 0);
@@ -664,7 +587,8 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
 //      Kfactor * [K] + Rfactor * [R]
 // where K does not include the EAS contribution.
 // The last 120 entries represent the 5x24 cross-dependency matrix.
-class MyJacobian : public ChIntegrable3D<ChMatrixNM<double, 696, 1> > {
+// As for MyForce, the integrand is evaluated at the precomputed Gauss points of the layer.
+class MyJacobian {
   public:
     MyJacobian(ChElementShellANCF* element,  // Containing element
                double Kfactor,               // Scaling coefficient for stiffness component
@@ -673,118 +597,42 @@ class MyJacobian : public ChIntegrable3D<ChMatrixNM<double, 696, 1> > {
                )
         : m_element(element), m_Kfactor(Kfactor), m_Rfactor(Rfactor), m_kl(kl) {}
 
+    // Integrate over the layer, summing the weighted integrand over its Gauss points.
+    void Integrate(ChMatrixNM<double, 696, 1>& result);
+
   private:
     ChElementShellANCF* m_element;
     double m_Kfactor;
     double m_Rfactor;
     size_t m_kl;
 
-    // Evaluate integrand at the specified point.
-    virtual void Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, const double y, const double z) override;
+    // Evaluate integrand at the specified Gauss point.
+    void Evaluate(ChMatrixNM<double, 696, 1>& result, const ChElementShellANCF::GaussPoint& gp);
 };
 
-void MyJacobian::Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, const double y, const double z) {
-    // Element shape function
-    ChMatrixNM<double, 1, 8> N;
-    m_element->ShapeFunctions(N, x, y, z);
-
-    // Determinant of position vector gradient matrix: Initial configuration
-    ChMatrixNM<double, 1, 8> Nx;
-    ChMatrixNM<double, 1, 8> Ny;
-    ChMatrixNM<double, 1, 8> Nz;
-    ChMatrixNM<double, 1, 3> Nx_d0;
-    ChMatrixNM<double, 1, 3> Ny_d0;
-    ChMatrixNM<double, 1, 3> Nz_d0;
-    double detJ0 = m_element->Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
-
-    // ANS shape function
-    ChMatrixNM<double, 1, 4> S_ANS;  // Shape function vector for Assumed Natural Strain
-    ChMatrixNM<double, 6, 5> M;      // Shape function vector for Enhanced Assumed Strain
-    m_element->ShapeFunctionANSbilinearShell(S_ANS, x, y);
-    m_element->Basis_M(M, x, y, z);
-
-    // Transformation : Orthogonal transformation (A and J)
-    ChVector<double> G1xG2;  // Cross product of first and second column of
-    double G1dotG1;          // Dot product of first column of position vector gradient
-
-    G1xG2.x() = Nx_d0[0][1] * Ny_d0[0][2] - Nx_d0[0][2] * Ny_d0[0][1];
-    G1xG2.y() = Nx_d0[0][2] * Ny_d0[0][0] - Nx_d0[0][0] * Ny_d0[0][2];
-    G1xG2.z() = Nx_d0[0][0] * Ny_d0[0][1] - Nx_d0[0][1] * Ny_d0[0][0];
-    G1dotG1 = Nx_d0[0][0] * Nx_d0[0][0] + Nx_d0[0][1] * Nx_d0[0][1] + Nx_d0[0][2] * Nx_d0[0][2];
-
-    // Tangent Frame
-    ChVector<double> A1;
-    ChVector<double> A2;
-    ChVector<double> A3;
-    A1.x() = Nx_d0[0][0];
-    A1.y() = Nx_d0[0][1];
-    A1.z() = Nx_d0[0][2];
-    A1 = A1 / sqrt(G1dotG1);
-    A3 = G1xG2.GetNormalized();
-    A2.Cross(A3, A1);
-
-    // Direction for orthotropic material
-    double theta = m_element->GetLayer(m_kl).Get_theta();  // Fiber angle
-    ChVector<double> AA1;
-    ChVector<double> AA2;
-    ChVector<double> AA3;
-    AA1 = A1 * cos(theta) + A2 * sin(theta);
-    AA2 = -A1 * sin(theta) + A2 * cos(theta);
-    AA3 = A3;
-
-    /// Beta
-    ChMatrixNM<double, 3, 3> j0;
-    ChVector<double> j01;
-    ChVector<double> j02;
-    ChVector<double> j03;
-    ChMatrixNM<double, 9, 1> beta;
-    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
-    j0(0, 0) = Ny_d0[0][1] * Nz_d0[0][2] - Nz_d0[0][1] * Ny_d0[0][2];
-    j0(0, 1) = Ny_d0[0][2] * Nz_d0[0][0] - Ny_d0[0][0] * Nz_d0[0][2];
-    j0(0, 2) = Ny_d0[0][0] * Nz_d0[0][1] - Nz_d0[0][0] * Ny_d0[0][1];
-    j0(1, 0) = Nz_d0[0][1] * Nx_d0[0][2] - Nx_d0[0][1] * Nz_d0[0][2];
-    j0(1, 1) = Nz_d0[0][2] * Nx_d0[0][0] - Nx_d0[0][2] * Nz_d0[0][0];
-    j0(1, 2) = Nz_d0[0][0] * Nx_d0[0][1] - Nz_d0[0][1] * Nx_d0[0][0];
-    j0(2, 0) = Nx_d0[0][1] * Ny_d0[0][2] - Ny_d0[0][1] * Nx_d0[0][2];
-    j0(2, 1) = Ny_d0[0][0] * Nx_d0[0][2] - Nx_d0[0][0] * Ny_d0[0][2];
-    j0(2, 2) = Nx_d0[0][0] * Ny_d0[0][1] - Ny_d0[0][0] * Nx_d0[0][1];
-    j0.MatrDivScale(detJ0);
-
-    j01[0] = j0(0, 0);
-    j02[0] = j0(1, 0);
-    j03[0] = j0(2, 0);
-    j01[1] = j0(0, 1);
-    j02[1] = j0(1, 1);
-    j03[1] = j0(2, 1);
-    j01[2] = j0(0, 2);
-    j02[2] = j0(1, 2);
-    j03[2] = j0(2, 2);
-
-    // Coefficients of contravariant transformation
-    beta(0, 0) = Vdot(AA1, j01);
-    beta(1, 0) = Vdot(AA2, j01);
-    beta(2, 0) = Vdot(AA3, j01);
-    beta(3, 0) = Vdot(AA1, j02);
-    beta(4, 0) = Vdot(AA2, j02);
-    beta(5, 0) = Vdot(AA3, j02);
-    beta(6, 0) = Vdot(AA1, j03);
-    beta(7, 0) = Vdot(AA2, j03);
-    beta(8, 0) = Vdot(AA3, j03);
+void MyJacobian::Integrate(ChMatrixNM<double, 696, 1>& result) {
+    result.Reset();
+    ChMatrixNM<double, 696, 1> val;
+    for (size_t ig = 8 * m_kl; ig < 8 * (m_kl + 1); ig++) {
+        Evaluate(val, m_element->m_GaussPoints[ig]);
+        result += val;
+    }
+}
 
-    // Transformation matrix, function of fiber angle
-    const ChMatrixNM<double, 6, 6>& T0 = m_element->GetLayer(m_kl).Get_T0();
-    // Determinant of the initial position vector gradient at the element center
-    double detJ0C = m_element->GetLayer(m_kl).Get_detJ0C();
+void MyJacobian::Evaluate(ChMatrixNM<double, 696, 1>& result, const ChElementShellANCF::GaussPoint& gp) {
+    // Shape functions and quantities depending only on the initial configuration (precomputed)
+    const ChMatrixNM<double, 1, 8>& N = gp.N;
+    const ChMatrixNM<double, 1, 8>& Nx = gp.Nx;
+    const ChMatrixNM<double, 1, 8>& Ny = gp.Ny;
+    const ChMatrixNM<double, 1, 8>& Nz = gp.Nz;
+    const ChMatrixNM<double, 1, 4>& S_ANS = gp.S_ANS;
+    const ChMatrixNM<double, 3, 3>& j0 = gp.j0;
+    const ChMatrixNM<double, 9, 1>& beta = gp.beta;
+    const ChMatrixNM<double, 6, 5>& G = gp.G;
+    const ChMatrixNM<double, 8, 1>& d0d0Nx = gp.d0d0Nx;
+    const ChMatrixNM<double, 8, 1>& d0d0Ny = gp.d0d0Ny;
+    const ChMatrixNM<double, 8, 1>& d0d0Nz = gp.d0d0Nz;
 
-// Enhanced Assumed Strain
-#ifdef CHRONO_HAS_AVX
-    // Referring to test_AVX, expected speed up Vs. non-AVX operation: 1.7x
-    ChMatrixNM<double, 6, 5> G;
-    G.MatrMultiplyAVX(T0, M);
-    G = G * (detJ0C / detJ0);
-#else
-    ChMatrixNM<double, 6, 5> G = T0 * M * (detJ0C / detJ0);
-#endif
 
     ChMatrixNM<double, 6, 1> strain_EAS = G * m_element->m_alphaEAS[m_kl];
     ChMatrixNM<double, 8, 1> ddNx;
@@ -794,13 +642,6 @@ void MyJacobian::Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, co
     ddNy.MatrMultiplyT(m_element->m_ddT, Ny);
     ddNz.MatrMultiplyT(m_element->m_ddT, Nz);
 
-    ChMatrixNM<double, 8, 1> d0d0Nx;
-    ChMatrixNM<double, 8, 1> d0d0Ny;
-    ChMatrixNM<double, 8, 1> d0d0Nz;
-    d0d0Nx.MatrMultiplyT(m_element->m_d0d0T, Nx);
-    d0d0Ny.MatrMultiplyT(m_element->m_d0d0T, Ny);
-    d0d0Nz.MatrMultiplyT(m_element->m_d0d0T, Nz);
-
     // Strain component
     ChMatrixNM<double, 6, 1> strain_til;
     strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - (Nx * d0d0Nx)(0, 0));
@@ -1027,7 +868,7 @@ void MyJacobian::Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, co
     KTE = (temp246 * strainD) * (m_Kfactor + m_Rfactor * m_element->m_Alpha) + (temp249 * Gd) * m_Kfactor;
 #endif
 
-    KTE *= detJ0 * (m_element->m_GaussScaling);
+    KTE *= gp.weight;
 
     // EAS cross-dependency matrix.
     ChMatrixNM<double, 5, 6> temp56;
@@ -1036,9 +877,9 @@ void MyJacobian::Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, co
 #ifdef CHRONO_HAS_AVX
     ChMatrixNM<double, 5, 24> GDEPSP;
     GDEPSP.MatrMultiplyAVX(temp56, strainD);
-    GDEPSP = GDEPSP * (detJ0 * m_element->m_GaussScaling);
+    GDEPSP *= gp.weight;
 #else
-    ChMatrixNM<double, 5, 24> GDEPSP = (temp56 * strainD) * (detJ0 * m_element->m_GaussScaling);
+    ChMatrixNM<double, 5, 24> GDEPSP = (temp56 * strainD) * gp.weight;
 #endif
 
     // Load result vector (integrand)
@@ -1058,13 +899,7 @@ void ChElementShellANCF::ComputeInternalJacobians(double Kfactor, double Rfactor
     for (size_t kl = 0; kl < m_numLayers; kl++) {
         ChMatrixNM<double, 696, 1> result;
         MyJacobian formula(this, Kfactor, Rfactor, kl);
-        ChQuadrature::Integrate3D<ChMatrixNM<double, 696, 1> >(result,                          // result of integration
-                                                               formula,                         // integrand formula
-                                                               -1, 1,                           // x limits
-                                                               -1, 1,                           // y limits
-                                                               m_GaussZ[kl], m_GaussZ[kl + 1],  // z limits
-                                                               2                                // order of integration
-                                                               );
+        formula.Integrate(result);
 
         // Extract matrices from result of integration
         ChMatrixNM<double, 24, 24> KTE;
@@ -1194,6 +1029,98 @@ double ChElementShellANCF::Calc_detJ0(double x, double y, double z) {
     return Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
 }
 
+// Precompute the quantities at the Gauss points of all layers which only depend on the initial
+// configuration. Points are stored layer by layer, 2x2x2 per layer, with the quadrature weight, the
+// scaling due to the change of integration intervals and the determinant detJ0 folded into 'weight'.
+void ChElementShellANCF::ComputeGaussPoints() {
+    const std::vector<double>& roots = ChQuadrature::GetStaticTables()->Lroots[1];
+    const std::vector<double>& weights = ChQuadrature::GetStaticTables()->Weight[1];
+
+    m_GaussPoints.clear();
+    m_GaussPoints.reserve(8 * m_numLayers);
+
+    for (size_t kl = 0; kl < m_numLayers; kl++) {
+        double zc1 = (m_GaussZ[kl + 1] - m_GaussZ[kl]) / 2;
+        double zc2 = (m_GaussZ[kl + 1] + m_GaussZ[kl]) / 2;
+
+        const ChMatrixNM<double, 6, 6>& T0 = m_layers[kl].Get_T0();
+        double detJ0C = m_layers[kl].Get_detJ0C();
+        double theta = m_layers[kl].Get_theta();
+
+        for (int ix = 0; ix < 2; ix++) {
+            for (int iy = 0; iy < 2; iy++) {
+                for (int iz = 0; iz < 2; iz++) {
+                    double x = roots[ix];
+                    double y = roots[iy];
+                    double z = zc1 * roots[iz] + zc2;
+
+                    GaussPoint gp;
+                    ShapeFunctions(gp.N, x, y, z);
+                    ChMatrixNM<double, 1, 3> Nx_d0;
+                    ChMatrixNM<double, 1, 3> Ny_d0;
+                    ChMatrixNM<double, 1, 3> Nz_d0;
+                    double detJ0 = Calc_detJ0(x, y, z, gp.Nx, gp.Ny, gp.Nz, Nx_d0, Ny_d0, Nz_d0);
+                    ShapeFunctionANSbilinearShell(gp.S_ANS, x, y);
+
+                    gp.d0d0Nx.MatrMultiplyT(m_d0d0T, gp.Nx);
+                    gp.d0d0Ny.MatrMultiplyT(m_d0d0T, gp.Ny);
+                    gp.d0d0Nz.MatrMultiplyT(m_d0d0T, gp.Nz);
+
+                    // Tangent frame
+                    ChVector<double> A1(Nx_d0(0, 0), Nx_d0(0, 1), Nx_d0(0, 2));
+                    ChVector<double> G2(Ny_d0(0, 0), Ny_d0(0, 1), Ny_d0(0, 2));
+                    ChVector<double> A3 = Vcross(A1, G2).GetNormalized();
+                    A1.Normalize();
+                    ChVector<double> A2 = Vcross(A3, A1);
+
+                    // Direction for orthotropic material
+                    ChVector<double> AA1 = A1 * cos(theta) + A2 * sin(theta);
+                    ChVector<double> AA2 = -A1 * sin(theta) + A2 * cos(theta);
+                    ChVector<double> AA3 = A3;
+
+                    // Inverse of the initial position vector gradient
+                    ChMatrixNM<double, 3, 3>& j0 = gp.j0;
+                    j0(0, 0) = Ny_d0(0, 1) * Nz_d0(0, 2) - Nz_d0(0, 1) * Ny_d0(0, 2);
+                    j0(0, 1) = Ny_d0(0, 2) * Nz_d0(0, 0) - Ny_d0(0, 0) * Nz_d0(0, 2);
+                    j0(0, 2) = Ny_d0(0, 0) * Nz_d0(0, 1) - Nz_d0(0, 0) * Ny_d0(0, 1);
+                    j0(1, 0) = Nz_d0(0, 1) * Nx_d0(0, 2) - Nx_d0(0, 1) * Nz_d0(0, 2);
+                    j0(1, 1) = Nz_d0(0, 2) * Nx_d0(0, 0) - Nx_d0(0, 2) * Nz_d0(0, 0);
+                    j0(1, 2) = Nz_d0(0, 0) * Nx_d0(0, 1) - Nz_d0(0, 1) * Nx_d0(0, 0);
+                    j0(2, 0) = Nx_d0(0, 1) * Ny_d0(0, 2) - Ny_d0(0, 1) * Nx_d0(0, 2);
+                    j0(2, 1) = Ny_d0(0, 0) * Nx_d0(0, 2) - Nx_d0(0, 0) * Ny_d0(0, 2);
+                    j0(2, 2) = Nx_d0(0, 0) * Ny_d0(0, 1) - Ny_d0(0, 0) * Nx_d0(0, 1);
+                    j0.MatrDivScale(detJ0);
+
+                    ChVector<double> j01(j0(0, 0), j0(0, 1), j0(0, 2));
+                    ChVector<double> j02(j0(1, 0), j0(1, 1), j0(1, 2));
+                    ChVector<double> j03(j0(2, 0), j0(2, 1), j0(2, 2));
+
+                    // Coefficients of contravariant transformation
+                    gp.beta(0) = Vdot(AA1, j01);
+                    gp.beta(1) = Vdot(AA2, j01);
+                    gp.beta(2) = Vdot(AA3, j01);
+                    gp.beta(3) = Vdot(AA1, j02);
+                    gp.beta(4) = Vdot(AA2, j02);
+                    gp.beta(5) = Vdot(AA3, j02);
+                    gp.beta(6) = Vdot(AA1, j03);
+                    gp.beta(7) = Vdot(AA2, j03);
+                    gp.beta(8) = Vdot(AA3, j03);
+
+                    // Enhanced Assumed Strain
+                    ChMatrixNM<double, 6, 5> M;
+                    Basis_M(M, x, y, z);
+                    gp.G.MatrMultiply(T0, M);
+                    gp.G.MatrScale(detJ0C / detJ0);
+
+                    gp.weight = weights[ix] * weights[iy] * weights[iz] * zc1 * detJ0 * m_GaussScaling;
+
+                    m_GaussPoints.push_back(gp);
+                }
+            }
+        }
+    }
+}
+
 void ChElementShellANCF::CalcCoordMatrix(ChMatrixNM<double, 8, 3>& d) {
     const ChVector<>& pA = m_nodes[0]->GetPos();
     const ChVector<>& dA = m_nodes[0]->GetD();
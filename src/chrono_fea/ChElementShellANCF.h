@@ -209,6 +209,24 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     ChVector<> EvaluateSectionStrains();
 
   private:
+    /// Data at a Gauss point of a layer, depending only on the initial configuration.
+    /// Precomputed at setup, so that the internal forces and Jacobians do not re-evaluate the
+    /// shape functions and the initial geometry at each call.
+    struct GaussPoint {
+        ChMatrixNM<double, 1, 8> N;       ///< shape functions
+        ChMatrixNM<double, 1, 8> Nx;      ///< shape function derivatives w.r.t. x
+        ChMatrixNM<double, 1, 8> Ny;      ///< shape function derivatives w.r.t. y
+        ChMatrixNM<double, 1, 8> Nz;      ///< shape function derivatives w.r.t. z
+        ChMatrixNM<double, 8, 1> d0d0Nx;  ///< m_d0d0T * Nx^T
+        ChMatrixNM<double, 8, 1> d0d0Ny;  ///< m_d0d0T * Ny^T
+        ChMatrixNM<double, 8, 1> d0d0Nz;  ///< m_d0d0T * Nz^T
+        ChMatrixNM<double, 1, 4> S_ANS;   ///< ANS shape functions
+        ChMatrixNM<double, 3, 3> j0;      ///< inverse of the initial position vector gradient
+        ChMatrixNM<double, 9, 1> beta;    ///< coefficients of the contravariant transformation (layer fiber angle)
+        ChMatrixNM<double, 6, 5> G;       ///< EAS interpolation matrix, T0 * M * detJ0C / detJ0
+        double weight;                    ///< quadrature weight, times detJ0 and the integration scaling
+    };
+
     std::vector<std::shared_ptr<ChNodeFEAxyzD> > m_nodes;  ///< element nodes
     std::vector<Layer> m_layers;                           ///< element layers
     size_t m_numLayers;                                    ///< number of layers for this element
@@ -217,6 +235,7 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     double m_thickness;                                    ///< total element thickness
     std::vector<double> m_GaussZ;                          ///< layer separation z values (scaled to [-1,1])
     double m_GaussScaling;                                 ///< scaling factor due to change of integration intervals
+    std::vector<GaussPoint> m_GaussPoints;                 ///< precomputed Gauss point data (8 per layer)
     double m_Alpha;                                        ///< structural damping
     bool m_gravity_on;                                     ///< enable/disable gravity calculation
     ChMatrixNM<double, 24, 1> m_GravForce;                 ///< Gravity Force
@@ -335,6 +354,9 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
                       ChMatrixNM<double, 1, 3>& Ny_d0,
                       ChMatrixNM<double, 1, 3>& Nz_d0);
 
+    // Precompute the Gauss point data of all layers.
+    void ComputeGaussPoints();
+
     // Calculate the current 8x3 matrix of nodal coordinates.
     void CalcCoordMatrix(ChMatrixNM<double, 8, 3>& d);
 
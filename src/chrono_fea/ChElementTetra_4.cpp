@@ -12,6 +12,9 @@
 // Authors: Andrea Favali, Alessandro Tasora
 // =============================================================================
 
+#include <algorithm>
+
+#include "chrono_fea/ChCorotationalBatch.h"
 #include "chrono_fea/ChElementTetra_4.h"
 
 namespace chrono {
@@ -25,5 +28,48 @@ ChElementTetra_4::ChElementTetra_4() {
 
 ChElementTetra_4::~ChElementTetra_4() {}
 
+void ChElementTetra_4::UpdateBatch(ChElementTetra_4* const* elements, int n) {
+    const int width = ChCorotationalBatch::WIDTH;
+    ChMatrix33<> F[width];
+    const ChMatrix33<>* pF[width];
+    ChMatrix33<>* pA[width];
+    for (int start = 0; start < n; start += width) {
+        int count = std::min(width, n - start);
+        for (int l = 0; l < count; l++) {
+            ChElementTetra_4* element = elements[start + l];
+            element->ChElement3D::Update();  // as in ChElementTetrahedron::Update()
+            element->ComputeDeformationGradient(F[l]);
+            pF[l] = &F[l];
+            pA[l] = &element->A;
+        }
+        ChCorotationalBatch::PolarRotations(count, pF, pA);
+    }
+}
+
+void ChElementTetra_4::KRMmatricesLoadBatch(ChElementTetra_4* const* elements,
+                                            int n,
+                                            double Kfactor,
+                                            double Rfactor,
+                                            double Mfactor) {
+    const int width = ChCorotationalBatch::WIDTH;
+    const ChMatrix<>* pK[width];
+    const ChMatrix33<>* pA[width];
+    ChMatrix<>* pH[width];
+    double scale[width];
+    for (int start = 0; start < n; start += width) {
+        int count = std::min(width, n - start);
+        for (int l = 0; l < count; l++) {
+            ChElementTetra_4* element = elements[start + l];
+            pK[l] = &element->StiffnessMatrix;
+            pA[l] = &element->A;
+            pH[l] = element->Kmatr.Get_K();
+            scale[l] = Kfactor + Rfactor * element->Material->Get_RayleighDampingK();
+        }
+        ChCorotationalBatch::RotateStiffness(count, 4, pK, pA, scale, pH);
+        for (int l = 0; l < count; l++)
+            elements[start + l]->AddLumpedMass(*pH[l], Rfactor, Mfactor);
+    }
+}
+
 }  // end namespace fea
 }  // end namespace chrono
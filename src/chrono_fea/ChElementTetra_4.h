@@ -202,28 +202,8 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
 
     /// compute large rotation of element for corotational approach
     virtual void UpdateRotation() override {
-        // P = [ p_0  p_1  p_2  p_3 ]
-        //     [ 1    1    1    1   ]
-        ChMatrixNM<double, 4, 4> P;
-        P.PasteVector(nodes[0]->pos, 0, 0);
-        P.PasteVector(nodes[1]->pos, 0, 1);
-        P.PasteVector(nodes[2]->pos, 0, 2);
-        P.PasteVector(nodes[3]->pos, 0, 3);
-        P(3, 0) = 1.0;
-        P(3, 1) = 1.0;
-        P(3, 2) = 1.0;
-        P(3, 3) = 1.0;
-
-        ChMatrix33<double> F;
-        // F=P*mM (only upper-left 3x3 block!)
-        double sum;
-        for (int colres = 0; colres < 3; ++colres)
-            for (int row = 0; row < 3; ++row) {
-                sum = 0;
-                for (int col = 0; col < 4; ++col)
-                    sum += (P(row, col)) * (mM(col, colres));
-                F(row, colres) = sum;
-            }
+        ChMatrix33<> F;
+        ComputeDeformationGradient(F);
         ChMatrix33<> S;
         double det = ChPolarDecomposition<>::Compute(F, this->A, S, 1E-6);
         if (det < 0)
@@ -232,6 +212,18 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         // GetLog() << "FEM rotation: \n" << A << "\n" ;
     }
 
+    /// Same as calling Update() on 'n' elements, with the polar decompositions computed in batches
+    /// (see ChCorotationalBatch).
+    static void UpdateBatch(ChElementTetra_4* const* elements, int n);
+
+    /// Same as calling KRMmatricesLoad() on 'n' elements, with the stiffness matrices rotated in batches
+    /// (see ChCorotationalBatch).
+    static void KRMmatricesLoadBatch(ChElementTetra_4* const* elements,
+                                     int n,
+                                     double Kfactor,
+                                     double Rfactor,
+                                     double Mfactor);
+
     /// Sets H as the global stiffness matrix K, scaled  by Kfactor. Optionally, also
     /// superimposes global damping matrix R, scaled by Rfactor, and global mass matrix M multiplied by Mfactor.
     virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor = 0, double Mfactor = 0) override {
@@ -267,55 +259,6 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
             for (int col = row + 1; col < CKCt.GetColumns(); ++col)
                 CKCt(row, col) = CKCt(col, row);
 
-        //***DEBUG***
-        double max_err = 0;
-        int err_r = -1;
-        int err_c = -1;
-        for (int row = 0; row < StiffnessMatrix.GetRows(); ++row)
-            for (int col = 0; col < StiffnessMatrix.GetColumns(); ++col) {
-                double diff = fabs(StiffnessMatrix.GetElement(row, col) - StiffnessMatrix.GetElement(col, row));
-                if (diff > max_err) {
-                    max_err = diff;
-                    err_r = row;
-                    err_c = col;
-                }
-            }
-        if (max_err > 1e-10)
-            GetLog() << "NONSYMMETRIC local stiffness matrix! err " << max_err << " at " << err_r << "," << err_c
-                     << "\n";
-        max_err = 0;
-        err_r = -1;
-        err_c = -1;
-        double maxval = 0;
-        for (int row = 0; row < CKCt.GetRows(); ++row)
-            for (int col = 0; col < CKCt.GetColumns(); ++col) {
-                double diff = fabs(CKCt.GetElement(row, col) - CKCt.GetElement(col, row));
-                if (diff > max_err) {
-                    max_err = diff;
-                    err_r = row;
-                    err_c = col;
-                }
-                if (CKCt.GetElement(row, col) > maxval)
-                    maxval = CKCt.GetElement(row, col);
-            }
-        if (max_err > 1e-10)
-            GetLog() << "NONSYMMETRIC corotated matrix! err " << max_err << " at " << err_r << "," << err_c
-                     << ",   maxval=" << maxval << "\n";
-
-        // DEBUG
-        /*
-        ChMatrixDynamic<> Ctest(12,12);
-        Ctest.PasteMatrix(A,0,0);
-        Ctest.PasteMatrix(A,3,3);
-        Ctest.PasteMatrix(A,6,6);
-        Ctest.PasteMatrix(A,9,9);
-        ChMatrixDynamic<> CKtest(12,12);
-        CKtest.MatrMultiply(Ctest,StiffnessMatrix);
-        ChMatrixDynamic<> CKCttest(12,12);
-        CKCttest.MatrMultiplyT(CKtest,Ctest);
-        GetLog() << "CKCt difference \n" << CKCt-CKCttest << "\n";
-        */
-
         // For K stiffness matrix and R damping matrix:
 
         double mkfactor = Kfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingK();
@@ -325,14 +268,7 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         H.PasteMatrix(CKCt, 0, 0);
 
         // For M mass matrix:
-        if (Mfactor) {
-            double lumped_node_mass = (this->GetVolume() * this->Material->Get_density()) / 4.0;
-            for (int id = 0; id < 12; id++) {
-                double amfactor = Mfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingM();
-                H(id, id) += amfactor * lumped_node_mass;
-            }
-        }
-        //***TO DO*** better per-node lumping, or 12x12 consistent mass matrix.
+        AddLumpedMass(H, Rfactor, Mfactor);
     }
 
     /// Computes the internal forces (ex. the actual position of
@@ -504,6 +440,31 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
     /// If true, use quadrature over u,v,w in [0..1] range as tetrahedron volumetric coords, with z=1-u-v-w
     /// otherwise use quadrature over u,v,w in [-1..+1] as box isoparametric coords.
     virtual bool IsTetrahedronIntegrationNeeded() override { return true; }
+
+  protected:
+    /// Compute the deformation gradient F = P * mM (upper-left 3x3 block), with
+    /// P = [ p_0  p_1  p_2  p_3 ]
+    ///     [ 1    1    1    1   ]
+    void ComputeDeformationGradient(ChMatrix33<>& F) const {
+        for (int row = 0; row < 3; ++row)
+            for (int colres = 0; colres < 3; ++colres) {
+                double sum = 0;
+                for (int col = 0; col < 4; ++col)
+                    sum += nodes[col]->pos[row] * mM(col, colres);
+                F(row, colres) = sum;
+            }
+    }
+
+    /// Add the lumped mass matrix, scaled by Mfactor, and the mass-proportional damping, scaled by Rfactor.
+    void AddLumpedMass(ChMatrix<>& H, double Rfactor, double Mfactor) {
+        if (Mfactor) {
+            double lumped_node_mass = (this->GetVolume() * this->Material->Get_density()) / 4.0;
+            double amfactor = Mfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingM();
+            for (int id = 0; id < 12; id++)
+                H(id, id) += amfactor * lumped_node_mass;
+        }
+        //***TO DO*** better per-node lumping, or 12x12 consistent mass matrix.
+    }
 };
 
 /// Tetrahedron FEM element with 4 nodes for scalar fields (for Poisson-like problems).
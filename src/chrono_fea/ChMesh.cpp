@@ -13,20 +13,29 @@
 // =============================================================================
 
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <typeindex>
+#include <unordered_map>
 
 #include "chrono/core/ChMath.h"
+#include "chrono/core/ChSkylineMatrix.h"
 #include "chrono/physics/ChLoad.h"
 #include "chrono/physics/ChObject.h"
 #include "chrono/physics/ChSystem.h"
 
+#include "chrono_fea/ChCorotationalBatch.h"
+#include "chrono_fea/ChElementHexa_8.h"
 #include "chrono_fea/ChElementTetra_4.h"
 #include "chrono_fea/ChMesh.h"
 #include "chrono_fea/ChNodeFEAxyz.h"
+#include "chrono_fea/ChNodeFEAxyzP.h"
+#include "chrono_fea/ChNodeFEAxyzrot.h"
 
 using namespace std;
 
@@ -45,9 +54,15 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
 
     automatic_gravity_load = other.automatic_gravity_load;
     num_points_gravity = other.num_points_gravity;
+    topology_revision = 0;
+    batched_corotation = other.batched_corotation;
 
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
+
+    force_tables_valid = false;
+    gravity_num_points = 0;
+    gravity_loads_valid = false;
 }
 
 void ChMesh::SetupInitial() {
@@ -66,6 +81,8 @@ void ChMesh::SetupInitial() {
         //    - precompute matrices, such as the [Kl] local stiffness of each element, if needed, etc.
         velements[i]->SetupInitial(GetSystem());
     }
+
+    force_tables_valid = false;
 }
 
 void ChMesh::Relax() {
@@ -85,35 +102,222 @@ void ChMesh::SetNoSpeedNoAcceleration() {
 void ChMesh::AddNode(std::shared_ptr<ChNodeFEAbase> m_node) {
     m_node->SetIndex(vnodes.size() + 1);
     vnodes.push_back(m_node);
+    topology_revision++;
 }
 
 void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
     velements.push_back(m_elem);
+    force_tables_valid = false;
+    topology_revision++;
+}
+
+// -----------------------------------------------------------------------------
+// Reordering of nodes and elements
+// -----------------------------------------------------------------------------
+
+// Position of a point along a 3D Hilbert curve with 2^bits cells per side, from the integer coordinates
+// of its cell (J. Skilling, "Programming the Hilbert curve", 2004).
+static uint64_t HilbertIndex(unsigned int X[3], int bits) {
+    unsigned int M = 1u << (bits - 1);
+    for (unsigned int Q = M; Q > 1; Q >>= 1) {
+        unsigned int P = Q - 1;
+        for (int i = 0; i < 3; i++) {
+            if (X[i] & Q) {
+                X[0] ^= P;
+            } else {
+                unsigned int t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+    for (int i = 1; i < 3; i++)
+        X[i] ^= X[i - 1];
+    unsigned int t = 0;
+    for (unsigned int Q = M; Q > 1; Q >>= 1) {
+        if (X[2] & Q)
+            t ^= Q - 1;
+    }
+    for (int i = 0; i < 3; i++)
+        X[i] ^= t;
+
+    uint64_t index = 0;
+    for (int b = bits - 1; b >= 0; b--) {
+        for (int i = 0; i < 3; i++)
+            index = (index << 1) | ((X[i] >> b) & 1);
+    }
+    return index;
+}
+
+// Position of a node, if the node type has one.
+static bool GetNodePosition(ChNodeFEAbase* node, ChVector<>& pos) {
+    if (auto node_xyz = dynamic_cast<ChNodeFEAxyz*>(node)) {
+        pos = node_xyz->GetPos();
+        return true;
+    }
+    if (auto node_xyzrot = dynamic_cast<ChNodeFEAxyzrot*>(node)) {
+        pos = node_xyzrot->GetPos();
+        return true;
+    }
+    if (auto node_xyzP = dynamic_cast<ChNodeFEAxyzP*>(node)) {
+        pos = node_xyzP->GetPos();
+        return true;
+    }
+    return false;
+}
+
+void ChMesh::Reorder(eChMeshOrdering method) {
+    int n = (int)vnodes.size();
+    std::unordered_map<ChNodeFEAbase*, int> node_index;
+    for (int i = 0; i < n; i++)
+        node_index[vnodes[i].get()] = i;
+
+    // New order of the nodes: order[k] is the old index of the k-th node.
+    std::vector<int> order;
+    if (method == REORDER_RCM) {
+        std::vector<std::vector<int>> adjacency(n);
+        std::vector<int> element_nodes;
+        for (auto& element : velements) {
+            element_nodes.clear();
+            for (int in = 0; in < element->GetNnodes(); in++) {
+                auto found = node_index.find(element->GetNodeN(in).get());
+                if (found != node_index.end())
+                    element_nodes.push_back(found->second);
+            }
+            for (int a : element_nodes) {
+                for (int b : element_nodes) {
+                    if (a != b)
+                        adjacency[a].push_back(b);
+                }
+            }
+        }
+        for (auto& neighbors : adjacency) {
+            std::sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        }
+        order = ChSkylineMatrix::ReverseCuthillMcKee(adjacency);
+    } else {
+        // Nodes without a position are placed at the beginning.
+        std::vector<ChVector<>> positions(n);
+        std::vector<bool> has_position(n);
+        ChVector<> pmin(std::numeric_limits<double>::max());
+        ChVector<> pmax(-std::numeric_limits<double>::max());
+        for (int i = 0; i < n; i++) {
+            has_position[i] = GetNodePosition(vnodes[i].get(), positions[i]);
+            if (has_position[i]) {
+                for (int k = 0; k < 3; k++) {
+                    pmin[k] = std::min(pmin[k], positions[i][k]);
+                    pmax[k] = std::max(pmax[k], positions[i][k]);
+                }
+            }
+        }
+        const int bits = 16;
+        double size = ChMax(ChMax(pmax.x() - pmin.x(), pmax.y() - pmin.y()), pmax.z() - pmin.z());
+        double scale = size > 0 ? ((1 << bits) - 1) / size : 0;
+        std::vector<uint64_t> keys(n, 0);
+        for (int i = 0; i < n; i++) {
+            if (!has_position[i])
+                continue;
+            ChVector<> cell = (positions[i] - pmin) * scale;
+            unsigned int X[3] = {(unsigned int)cell.x(), (unsigned int)cell.y(), (unsigned int)cell.z()};
+            keys[i] = HilbertIndex(X, bits) + 1;
+        }
+        order.resize(n);
+        for (int i = 0; i < n; i++)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return keys[a] < keys[b]; });
+    }
+
+    std::vector<std::shared_ptr<ChNodeFEAbase>> new_nodes(n);
+    std::vector<int> new_index(n);
+    for (int k = 0; k < n; k++) {
+        new_nodes[k] = vnodes[order[k]];
+        new_index[order[k]] = k;
+    }
+    vnodes.swap(new_nodes);
+    for (int k = 0; k < n; k++)
+        vnodes[k]->SetIndex(k + 1);
+
+    // Sort elements by the first of their nodes in the new order.
+    std::vector<int> element_keys(velements.size());
+    for (size_t ie = 0; ie < velements.size(); ie++) {
+        int key = n;
+        for (int in = 0; in < velements[ie]->GetNnodes(); in++) {
+            auto found = node_index.find(velements[ie]->GetNodeN(in).get());
+            if (found != node_index.end())
+                key = std::min(key, new_index[found->second]);
+        }
+        element_keys[ie] = key;
+    }
+    std::vector<size_t> element_order(velements.size());
+    for (size_t ie = 0; ie < velements.size(); ie++)
+        element_order[ie] = ie;
+    std::stable_sort(element_order.begin(), element_order.end(),
+                     [&](size_t a, size_t b) { return element_keys[a] < element_keys[b]; });
+    std::vector<std::shared_ptr<ChElementBase>> new_elements(velements.size());
+    for (size_t ie = 0; ie < velements.size(); ie++)
+        new_elements[ie] = velements[element_order[ie]];
+    velements.swap(new_elements);
+
+    force_tables_valid = false;
+    topology_revision++;
+
+    // Update the state offsets of the nodes (the total number of coordinates does not change).
+    Setup();
+}
+
+unsigned int ChMesh::GetNodeBandwidth() const {
+    std::unordered_map<ChNodeFEAbase*, unsigned int> node_index;
+    for (unsigned int i = 0; i < vnodes.size(); i++)
+        node_index[vnodes[i].get()] = i;
+
+    unsigned int bandwidth = 0;
+    for (auto& element : velements) {
+        unsigned int imin = (unsigned int)vnodes.size();
+        unsigned int imax = 0;
+        for (int in = 0; in < element->GetNnodes(); in++) {
+            auto found = node_index.find(element->GetNodeN(in).get());
+            if (found != node_index.end()) {
+                imin = std::min(imin, found->second);
+                imax = std::max(imax, found->second);
+            }
+        }
+        if (imax > imin)
+            bandwidth = std::max(bandwidth, imax - imin);
+    }
+    return bandwidth;
 }
 
 void ChMesh::ClearElements() {
     velements.clear();
     vcontactsurfaces.clear();
+    force_tables_valid = false;
+    topology_revision++;
 }
 
 void ChMesh::ClearNodes() {
     velements.clear();
     vnodes.clear();
     vcontactsurfaces.clear();
+    force_tables_valid = false;
+    topology_revision++;
 }
 
 void ChMesh::AddContactSurface(std::shared_ptr<ChContactSurface> m_surf) {
     m_surf->SetMesh(this);
     vcontactsurfaces.push_back(m_surf);
+    topology_revision++;
 }
 
 void ChMesh::ClearContactSurfaces() {
     vcontactsurfaces.clear();
+    topology_revision++;
 }
 
 void ChMesh::AddMeshSurface(std::shared_ptr<ChMeshSurface> m_surf) {
     m_surf->SetMesh(this);
     vmeshsurfaces.push_back(m_surf);
+    topology_revision++;
 }
 
 /// This recomputes the number of DOFs, constraints,
@@ -140,10 +344,20 @@ void ChMesh::Update(double m_time, bool update_assets) {
     // Parent class update
     ChIndexedNodes::Update(m_time, update_assets);
 
-    for (unsigned int i = 0; i < velements.size(); i++) {
+    if (!force_tables_valid)
+        SetupInternalForces();
+
+    for (auto element : update_elements) {
         //    - update auxiliary stuff, ex. update element's rotation matrices if corotational..
-        velements[i]->Update();
+        element->Update();
     }
+
+    // Rotations of the linear tetrahedrons, in batches.
+    const int width = ChCorotationalBatch::WIDTH;
+    int ntetras = (int)batch_tetras.size();
+#pragma omp parallel for schedule(static)
+    for (int start = 0; start < ntetras; start += width)
+        ChElementTetra_4::UpdateBatch(&batch_tetras[start], std::min(width, ntetras - start));
 }
 
 void ChMesh::SyncCollisionModels() {
@@ -259,33 +473,187 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,
 
     // internal forces
     timer_internal_forces.start();
+    if (!force_tables_valid)
+        SetupInternalForces();
+
+    // Gravity loads do not depend on the state of the elements: they are computed once, and recomputed only if
+    // the gravity of the system, the number of integration points or the density of an element changed.
+    bool gravity = automatic_gravity_load;
+    if (gravity) {
+        ChVector<> G = GetSystem()->Get_G_acc();
+        if (G != gravity_acc || num_points_gravity != gravity_num_points) {
+            gravity_acc = G;
+            gravity_num_points = num_points_gravity;
+            gravity_loads_valid = false;
+        }
+    }
+
+    // Evaluate the internal forces of all elements in their own buffers (elements of the same type
+    // are contiguous, so that threads mostly process batches of the same element type), together with
+    // the gravity loads...
 #pragma omp parallel for schedule(dynamic, 4)
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
+    for (int ie = 0; ie < (int)force_elements.size(); ie++) {
+        force_elements[ie]->ComputeInternalForces(force_buffers[ie]);
+        if (!gravity || !gravity_loadables[ie])
+            continue;
+        double density = gravity_loadables[ie]->GetDensity();
+        if (!gravity_loads_valid || density != gravity_densities[ie]) {
+            gravity_densities[ie] = density;
+            gravity_buffers[ie].Reset(0);
+            if (density) {
+                ChLoaderGravity loader(gravity_loadables[ie]);
+                loader.Set_G_acc(gravity_acc);
+                loader.SetNumIntPoints(gravity_num_points);
+                loader.ComputeQ(nullptr, nullptr);
+                gravity_buffers[ie] = loader.Q;
+            }
+        }
+        if (gravity_buffers[ie].GetRows())
+            force_buffers[ie].MatrInc(gravity_buffers[ie]);
+    }
+    if (gravity)
+        gravity_loads_valid = true;
+
+    // ...then add them to the nodes. Each node sums its contributions in a fixed order, so that nodes
+    // can be processed in parallel without races and the result does not depend on the number of threads.
+#pragma omp parallel for schedule(static)
+    for (int in = 0; in < (int)force_nodes.size(); in++) {
+        ChNodeFEAbase* node = force_nodes[in];
+        if (node->GetFixed())
+            continue;
+        unsigned int offset = node->NodeGetOffset_w();
+        for (int ic = force_node_start[in]; ic < force_node_start[in + 1]; ic++) {
+            const ForceContribution& contribution = force_contributions[ic];
+            const ChMatrixDynamic<>& Fi = force_buffers[contribution.element];
+            for (int k = 0; k < contribution.ndofs; k++)
+                R(offset + k) += c * Fi(contribution.row + k);
+        }
+    }
+
+    // Elements not derived from ChElementGeneric add directly into R, possibly into the same nodes as
+    // other elements: they are processed serially (all element types of this module are batched above).
+    for (auto element : force_other_elements) {
+        element->EleIntLoadResidual_F(R, c);
     }
     timer_internal_forces.stop();
     ncalls_internal_forces++;
 
-    // Apply gravity loads without the need of adding
-    // a ChLoad object to each element: just instance here a single ChLoad and reuse
+    // Gravity loads of the elements not handled above: just instance here a single ChLoad and reuse
     // it for all 'volume' objects.
-    if (automatic_gravity_load) {
+    if (gravity && !gravity_other_loadables.empty()) {
         std::shared_ptr<ChLoadableUVW> mloadable;  // still null
         auto common_gravity_loader = std::make_shared<ChLoad<ChLoaderGravity>>(mloadable);
-        common_gravity_loader->loader.Set_G_acc(GetSystem()->Get_G_acc());
+        common_gravity_loader->loader.Set_G_acc(gravity_acc);
         common_gravity_loader->loader.SetNumIntPoints(num_points_gravity);
 
-        for (unsigned int ie = 0; ie < velements.size(); ie++) {
-            if ((mloadable = std::dynamic_pointer_cast<ChLoadableUVW>(velements[ie]))) {
-                if (mloadable->GetDensity()) {
-                    // temporary set loader target and compute generalized forces term
-                    common_gravity_loader->loader.loadable = mloadable;
-                    common_gravity_loader->ComputeQ(0, 0);
-                    common_gravity_loader->LoadIntLoadResidual_F(R, c);
-                }
+        for (auto& loadable : gravity_other_loadables) {
+            if (loadable->GetDensity()) {
+                // temporary set loader target and compute generalized forces term
+                common_gravity_loader->loader.loadable = loadable;
+                common_gravity_loader->ComputeQ(0, 0);
+                common_gravity_loader->LoadIntLoadResidual_F(R, c);
+            }
+        }
+    }
+}
+
+void ChMesh::SetupInternalForces() {
+    force_elements.clear();
+    force_other_elements.clear();
+    for (auto& element : velements) {
+        if (auto generic = dynamic_cast<ChElementGeneric*>(element.get()))
+            force_elements.push_back(generic);
+        else
+            force_other_elements.push_back(element.get());
+    }
+    std::stable_sort(force_elements.begin(), force_elements.end(), [](ChElementGeneric* a, ChElementGeneric* b) {
+        return std::type_index(typeid(*a)) < std::type_index(typeid(*b));
+    });
+
+    force_buffers.resize(force_elements.size());
+    for (size_t ie = 0; ie < force_elements.size(); ie++)
+        force_buffers[ie].Reset(force_elements[ie]->GetNdofs(), 1);
+
+    // Collect the nodes of the batched elements (the elements may reference nodes which were not
+    // added to this mesh) and the contributions of the elements to each of them.
+    std::unordered_map<ChNodeFEAbase*, int> node_index;
+    std::vector<std::vector<ForceContribution>> node_contributions;
+    force_nodes.clear();
+    for (size_t ie = 0; ie < force_elements.size(); ie++) {
+        ChElementGeneric* element = force_elements[ie];
+        int row = 0;
+        for (int in = 0; in < element->GetNnodes(); in++) {
+            ChNodeFEAbase* node = element->GetNodeN(in).get();
+            int ndofs = element->GetNodeNdofs(in);
+            auto found = node_index.find(node);
+            int index;
+            if (found == node_index.end()) {
+                index = (int)force_nodes.size();
+                node_index[node] = index;
+                force_nodes.push_back(node);
+                node_contributions.emplace_back();
+            } else {
+                index = found->second;
             }
+            node_contributions[index].push_back({(int)ie, row, ndofs});
+            row += ndofs;
         }
     }
+
+    force_node_start.resize(force_nodes.size() + 1);
+    force_contributions.clear();
+    for (size_t in = 0; in < force_nodes.size(); in++) {
+        force_node_start[in] = (int)force_contributions.size();
+        force_contributions.insert(force_contributions.end(), node_contributions[in].begin(),
+                                   node_contributions[in].end());
+    }
+    force_node_start[force_nodes.size()] = (int)force_contributions.size();
+
+    // Elements subject to the automatic gravity. The gravity loads of the batched elements are added to their
+    // internal forces, provided that the blocks of the loadable are the nodes of the element.
+    gravity_loadables.assign(force_elements.size(), nullptr);
+    gravity_buffers.assign(force_elements.size(), ChVectorDynamic<>());
+    gravity_densities.assign(force_elements.size(), 0.0);
+    std::unordered_map<ChElementBase*, int> force_index;
+    for (size_t ie = 0; ie < force_elements.size(); ie++)
+        force_index[force_elements[ie]] = (int)ie;
+    gravity_other_loadables.clear();
+    for (auto& element : velements) {
+        auto loadable = std::dynamic_pointer_cast<ChLoadableUVW>(element);
+        if (!loadable)
+            continue;
+        auto found = force_index.find(element.get());
+        bool batched = found != force_index.end() && loadable->LoadableGet_ndof_w() == element->GetNdofs() &&
+                       loadable->GetSubBlocks() == element->GetNnodes();
+        for (int in = 0; batched && in < element->GetNnodes(); in++)
+            batched = (int)loadable->GetSubBlockSize(in) == element->GetNodeNdofs(in);
+        if (batched)
+            gravity_loadables[found->second] = loadable;
+        else
+            gravity_other_loadables.push_back(loadable);
+    }
+    gravity_loads_valid = false;
+
+    // Elements handled by the batched corotational kernels. Only the exact types are batched, since
+    // derived classes may override UpdateRotation() or ComputeKRMmatricesGlobal().
+    batch_tetras.clear();
+    batch_hexas.clear();
+    update_elements.clear();
+    krm_elements.clear();
+    for (auto& element : velements) {
+        ChElementBase* base = element.get();
+        if (batched_corotation && typeid(*base) == typeid(ChElementTetra_4)) {
+            batch_tetras.push_back(static_cast<ChElementTetra_4*>(base));
+            continue;
+        }
+        update_elements.push_back(base);
+        if (batched_corotation && typeid(*base) == typeid(ChElementHexa_8))
+            batch_hexas.push_back(static_cast<ChElementHexa_8*>(base));
+        else
+            krm_elements.push_back(base);
+    }
+
+    force_tables_valid = true;
 }
 
 void ChMesh::ComputeMassProperties(double& mass,           // ChMesh object mass
@@ -366,9 +734,25 @@ void ChMesh::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 
 void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
     timer_KRMload.start();
+    if (!force_tables_valid)
+        SetupInternalForces();
+
 #pragma omp parallel for
-    for (int ie = 0; ie < velements.size(); ie++)
-        velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+    for (int ie = 0; ie < (int)krm_elements.size(); ie++)
+        krm_elements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+
+    // Rotated stiffness matrices of the linear tetrahedrons and hexahedrons, in batches.
+    const int width = ChCorotationalBatch::WIDTH;
+    int ntetras = (int)batch_tetras.size();
+#pragma omp parallel for schedule(static)
+    for (int start = 0; start < ntetras; start += width)
+        ChElementTetra_4::KRMmatricesLoadBatch(&batch_tetras[start], std::min(width, ntetras - start), Kfactor,
+                                               Rfactor, Mfactor);
+    int nhexas = (int)batch_hexas.size();
+#pragma omp parallel for schedule(static)
+    for (int start = 0; start < nhexas; start += width)
+        ChElementHexa_8::KRMmatricesLoadBatch(&batch_hexas[start], std::min(width, nhexas - start), Kfactor,
+                                              Rfactor, Mfactor);
     timer_KRMload.stop();
     ncalls_KRMload++;
 }
@@ -24,6 +24,7 @@
 #include "chrono/physics/ChMaterialSurfaceNSC.h"
 #include "chrono_fea/ChContactSurface.h"
 #include "chrono_fea/ChElementBase.h"
+#include "chrono_fea/ChElementGeneric.h"
 #include "chrono_fea/ChMeshSurface.h"
 #include "chrono_fea/ChNodeFEAbase.h"
 
@@ -31,6 +32,9 @@ namespace chrono {
 
 namespace fea {
 
+class ChElementTetra_4;
+class ChElementHexa_8;
+
 /// @addtogroup fea_module
 /// @{
 
@@ -51,19 +55,64 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     bool automatic_gravity_load;
     int num_points_gravity;
 
+    unsigned int topology_revision;  ///< incremented at each change of the lists of nodes, elements or surfaces
+
     ChTimer<> timer_internal_forces;
     ChTimer<> timer_KRMload;
     int ncalls_internal_forces;
     int ncalls_KRMload;
 
+    /// Contribution of one element to the internal forces of one node.
+    struct ForceContribution {
+        int element;  ///< index in the list of batched elements
+        int row;      ///< first row in the element force vector
+        int ndofs;    ///< number of rows
+    };
+
+    // Tables for the element-batched evaluation of internal forces (see IntLoadResidual_F).
+    std::vector<ChElementGeneric*> force_elements;       ///< batched elements, grouped by type
+    std::vector<ChMatrixDynamic<>> force_buffers;        ///< internal forces, one vector per batched element
+    std::vector<ChElementBase*> force_other_elements;    ///< elements not handled by the batched evaluation
+    std::vector<ChNodeFEAbase*> force_nodes;             ///< nodes of the batched elements
+    std::vector<int> force_node_start;                   ///< first contribution to each node (CSR layout)
+    std::vector<ForceContribution> force_contributions;  ///< element contributions, grouped by node
+    bool force_tables_valid;
+
+    // Corotational elements processed with the batched kernels (see Update and KRMmatricesLoad).
+    std::vector<ChElementTetra_4*> batch_tetras;  ///< rotations and KRM matrices computed in batches
+    std::vector<ChElementHexa_8*> batch_hexas;    ///< KRM matrices computed in batches
+    std::vector<ChElementBase*> update_elements;  ///< elements updated one at a time
+    std::vector<ChElementBase*> krm_elements;     ///< elements whose KRM matrices are loaded one at a time
+    bool batched_corotation;
+
+    // Automatic gravity loads, computed once and refreshed when G or the densities change (see IntLoadResidual_F).
+    std::vector<std::shared_ptr<ChLoadableUVW>> gravity_loadables;  ///< per batched element, null if no gravity
+    std::vector<ChVectorDynamic<>> gravity_buffers;                 ///< gravity loads of the batched elements
+    std::vector<double> gravity_densities;                          ///< densities used for the gravity loads
+    std::vector<std::shared_ptr<ChLoadableUVW>> gravity_other_loadables;  ///< gravity evaluated at each call
+    ChVector<> gravity_acc;
+    int gravity_num_points;
+    bool gravity_loads_valid;
+
   public:
+    /// Node orderings available in Reorder().
+    enum eChMeshOrdering {
+        REORDER_RCM,     ///< reverse Cuthill-McKee ordering of the node connectivity graph
+        REORDER_HILBERT  ///< nodes sorted along a Hilbert space-filling curve through their positions
+    };
+
     ChMesh()
         : n_dofs(0),
           n_dofs_w(0),
           automatic_gravity_load(true),
           num_points_gravity(1),
+          topology_revision(0),
           ncalls_internal_forces(0),
-          ncalls_KRMload(0) {}
+          ncalls_KRMload(0),
+          force_tables_valid(false),
+          batched_corotation(true),
+          gravity_num_points(0),
+          gravity_loads_valid(false) {}
     ChMesh(const ChMesh& other);
     ~ChMesh() {}
 
@@ -141,7 +190,26 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     unsigned int GetNmeshSurfaces() { return (unsigned int)vmeshsurfaces.size(); }
 
     /// Remove all mesh surfaces.
-    void ClearMeshSurfaces() { vmeshsurfaces.clear(); }
+    void ClearMeshSurfaces() {
+        vmeshsurfaces.clear();
+        topology_revision++;
+    }
+
+    /// Get a counter which is incremented whenever nodes, elements, contact surfaces or mesh surfaces are
+    /// added, removed or reordered. Compare it with a previously stored value to detect topology changes
+    /// without scanning the mesh (changes made directly to the face lists of the surfaces are not counted).
+    unsigned int GetTopologyRevision() const { return topology_revision; }
+
+    /// Renumber nodes and elements to improve memory locality.
+    /// Nodes are reordered with the given method (RCM also reduces the bandwidth of the system matrices),
+    /// then elements are sorted by the lowest new index of their nodes. The state offsets of the nodes
+    /// are updated accordingly. Meshes created by file loaders are often in an arbitrary order: call this
+    /// once the mesh is complete, before starting the simulation.
+    void Reorder(eChMeshOrdering method = REORDER_RCM);
+
+    /// Get the bandwidth of the node numbering, i.e. the largest difference between the indices
+    /// of two nodes of the same element.
+    unsigned int GetNodeBandwidth() const;
 
     /// Set reference position of nodes as current position, for all nodes.
     void Relax();
@@ -165,6 +233,8 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     /// If true, as by default, this mesh will add automatically a gravity load
     /// to all contained elements (that support gravity) using the G value from the ChSystem.
     /// So this saves you from adding many ChLoad<ChLoaderGravity> to all elements.
+    /// The generalized gravity loads of the elements are computed once, and recomputed only if G, the number
+    /// of integration points or the density of an element change.
     void SetAutomaticGravity(bool mg, int num_points = 1) {
         automatic_gravity_load = mg;
         num_points_gravity = num_points;
@@ -172,6 +242,17 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     /// Tell if this mesh will add automatically a gravity load to all contained elements.
     bool GetAutomaticGravity() { return automatic_gravity_load; }
 
+    /// Enable the batched evaluation of linear corotational elements (default: true). The rotations of
+    /// ChElementTetra_4 and the rotated stiffness matrices of ChElementTetra_4 and ChElementHexa_8 are then
+    /// computed a few elements at a time, with vectorized kernels (see ChCorotationalBatch). Classes derived
+    /// from these elements are always processed one element at a time.
+    void SetBatchedCorotation(bool val) {
+        batched_corotation = val;
+        force_tables_valid = false;
+    }
+    /// Tell if the batched evaluation of linear corotational elements is enabled.
+    bool GetBatchedCorotation() const { return batched_corotation; }
+
     /// Get ChMesh mass properties
     void ComputeMassProperties(double& mass,          ///< ChMesh object mass
                                ChVector<>& com,       ///< ChMesh center of gravity
@@ -269,6 +350,10 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
 
   private:
+    /// Build the tables used to evaluate the internal forces of all elements, and the lists of
+    /// elements processed by the batched corotational kernels.
+    void SetupInternalForces();
+
     /// Initial setup (before analysis).
     /// This function is called from ChSystem::SetupInitial, marking a point where system
     /// construction is completed.
@@ -0,0 +1,425 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#include "chrono/core/ChException.h"
+#include "chrono_fea/ChElementBar.h"
+#include "chrono_fea/ChElementBeam.h"
+#include "chrono_fea/ChElementBrick_9.h"
+#include "chrono_fea/ChElementHexa_20.h"
+#include "chrono_fea/ChElementHexa_8.h"
+#include "chrono_fea/ChElementShell.h"
+#include "chrono_fea/ChElementTetra_10.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMeshExporterVTK.h"
+#include "chrono_fea/ChNodeFEAxyz.h"
+#include "chrono_fea/ChNodeFEAxyzP.h"
+#include "chrono_fea/ChNodeFEAxyzrot.h"
+
+namespace chrono {
+namespace fea {
+
+// VTK cell types
+enum {
+    VTK_VERTEX = 1,
+    VTK_POLY_VERTEX = 2,
+    VTK_LINE = 3,
+    VTK_QUAD = 9,
+    VTK_TETRA = 10,
+    VTK_HEXAHEDRON = 12,
+    VTK_QUADRATIC_EDGE = 21,
+    VTK_QUADRATIC_TETRA = 24,
+    VTK_QUADRATIC_HEXAHEDRON = 25
+};
+
+// Append an array to the appended-data block, preceded by its size in bytes (UInt64 header).
+// Return the offset of the array in the block.
+template <typename T>
+static size_t AppendArray(std::vector<char>& buffer, const T* data, size_t n) {
+    size_t offset = buffer.size();
+    uint64_t nbytes = n * sizeof(T);
+    buffer.resize(offset + sizeof(uint64_t) + nbytes);
+    std::memcpy(&buffer[offset], &nbytes, sizeof(uint64_t));
+    if (nbytes)
+        std::memcpy(&buffer[offset + sizeof(uint64_t)], data, nbytes);
+    return offset;
+}
+
+static void WriteArrayTag(std::ostream& xml, const char* type, const char* name, int ncomp, size_t offset) {
+    xml << "        <DataArray type=\"" << type << "\" Name=\"" << name << "\"";
+    if (ncomp > 1)
+        xml << " NumberOfComponents=\"" << ncomp << "\"";
+    xml << " format=\"appended\" offset=\"" << offset << "\"/>\n";
+}
+
+static void StoreVector(float* dest, const ChVector<>& v) {
+    dest[0] = (float)v.x();
+    dest[1] = (float)v.y();
+    dest[2] = (float)v.z();
+}
+
+// -----------------------------------------------------------------------------
+
+ChMeshExporterVTK::ChMeshExporterVTK(std::shared_ptr<ChMesh> mesh,
+                                     const std::string& out_dir,
+                                     const std::string& basename)
+    : m_mesh(mesh),
+      m_dir(out_dir),
+      m_basename(basename),
+      m_fields(ALL_FIELDS),
+      m_undeformed(false),
+      m_connectivity_size(0),
+      m_has_p(false),
+      m_has_beams(false),
+      m_has_solids(false),
+      m_pvd_tail(0) {}
+
+ChMeshExporterVTK::~ChMeshExporterVTK() {}
+
+void ChMeshExporterVTK::UpdateTopology() {
+    unsigned int nnodes = m_mesh->GetNnodes();
+    unsigned int nelements = m_mesh->GetNelements();
+
+    // Nodes: remember the concrete type, so that per-frame access needs no casts.
+    std::unordered_map<ChNodeFEAbase*, int32_t> node_index;
+    m_nodes.resize(nnodes);
+    m_has_p = false;
+    for (unsigned int i = 0; i < nnodes; ++i) {
+        auto node = m_mesh->GetNodes()[i];
+        node_index[node.get()] = (int32_t)i;
+        m_nodes[i].xyz = dynamic_cast<ChNodeFEAxyz*>(node.get());
+        m_nodes[i].xyzrot = dynamic_cast<ChNodeFEAxyzrot*>(node.get());
+        m_nodes[i].xyzp = dynamic_cast<ChNodeFEAxyzP*>(node.get());
+        if (m_nodes[i].xyzp)
+            m_has_p = true;
+    }
+
+    // Elements: cell type and connectivity.
+    std::vector<int32_t> connectivity;
+    std::vector<int32_t> offsets(nelements);
+    std::vector<uint8_t> types(nelements);
+    m_elements.resize(nelements);
+    m_elem_kinds.resize(nelements);
+    m_has_beams = false;
+    m_has_solids = false;
+
+    for (unsigned int ie = 0; ie < nelements; ++ie) {
+        auto element = m_mesh->GetElement(ie);
+        int n = element->GetNnodes();
+        eChElementKind kind = ELEM_OTHER;
+        uint8_t type;
+
+        if (std::dynamic_pointer_cast<ChElementTetra_4>(element)) {
+            kind = ELEM_TETRA4;
+            type = VTK_TETRA;
+        } else if (std::dynamic_pointer_cast<ChElementTetra_10>(element)) {
+            kind = ELEM_TETRA10;
+            type = VTK_QUADRATIC_TETRA;
+        } else if (std::dynamic_pointer_cast<ChElementHexa_8>(element)) {
+            kind = ELEM_HEXA8;
+            type = VTK_HEXAHEDRON;
+        } else if (std::dynamic_pointer_cast<ChElementHexa_20>(element)) {
+            kind = ELEM_HEXA20;
+            type = VTK_QUADRATIC_HEXAHEDRON;
+        } else if (std::dynamic_pointer_cast<ChElementBrick_9>(element)) {
+            // corner nodes only (the 9th node carries the curvature)
+            type = VTK_HEXAHEDRON;
+            n = 8;
+        } else if (std::dynamic_pointer_cast<ChElementBeam>(element)) {
+            kind = ELEM_BEAM;
+            type = (n == 3) ? VTK_QUADRATIC_EDGE : VTK_LINE;
+        } else if (std::dynamic_pointer_cast<ChElementBar>(element)) {
+            kind = ELEM_BAR;
+            type = VTK_LINE;
+        } else if (std::dynamic_pointer_cast<ChElementShell>(element) && n == 4) {
+            type = VTK_QUAD;
+        } else if (n == 8) {
+            type = VTK_HEXAHEDRON;
+        } else if (n == 2) {
+            type = VTK_LINE;
+        } else if (n == 1) {
+            type = VTK_VERTEX;
+        } else {
+            type = VTK_POLY_VERTEX;
+        }
+
+        for (int in = 0; in < n; ++in) {
+            auto found = node_index.find(element->GetNodeN(in).get());
+            if (found == node_index.end())
+                throw ChException("ChMeshExporterVTK: element " + std::to_string(ie) +
+                                  " refers to a node not in the mesh.");
+            connectivity.push_back(found->second);
+        }
+        offsets[ie] = (int32_t)connectivity.size();
+        types[ie] = type;
+        m_elements[ie] = element.get();
+        m_elem_kinds[ie] = kind;
+        if (kind == ELEM_BEAM)
+            m_has_beams = true;
+        else if (kind != ELEM_OTHER)
+            m_has_solids = true;
+    }
+
+    m_connectivity_size = connectivity.size();
+    m_topology.clear();
+    AppendArray(m_topology, connectivity.data(), connectivity.size());
+    AppendArray(m_topology, offsets.data(), offsets.size());
+    AppendArray(m_topology, types.data(), types.size());
+}
+
+void ChMeshExporterVTK::EvaluateFields() {
+    int nnodes = (int)m_nodes.size();
+    int nelements = (int)m_elements.size();
+
+    // Only the requested node fields are evaluated.
+    bool displ = (m_fields & NODE_DISPLACEMENT) != 0;
+    bool speed = (m_fields & NODE_SPEED) != 0;
+    bool accel = (m_fields & NODE_ACCEL) != 0;
+    bool p = m_has_p && (m_fields & NODE_P);
+    m_points.resize(3 * nnodes);
+    m_displ.resize(displ ? 3 * nnodes : 0);
+    m_speed.resize(speed ? 3 * nnodes : 0);
+    m_accel.resize(accel ? 3 * nnodes : 0);
+    m_p.resize(p ? nnodes : 0);
+
+#pragma omp parallel for
+    for (int i = 0; i < nnodes; ++i) {
+        const NodeData& node = m_nodes[i];
+        ChVector<> pos, pos0;
+        if (node.xyz) {
+            pos = node.xyz->GetPos();
+            pos0 = node.xyz->GetX0();
+            if (speed)
+                StoreVector(&m_speed[3 * i], node.xyz->GetPos_dt());
+            if (accel)
+                StoreVector(&m_accel[3 * i], node.xyz->GetPos_dtdt());
+        } else if (node.xyzrot) {
+            pos = node.xyzrot->GetPos();
+            pos0 = node.xyzrot->GetX0().GetPos();
+            if (speed)
+                StoreVector(&m_speed[3 * i], node.xyzrot->GetPos_dt());
+            if (accel)
+                StoreVector(&m_accel[3 * i], node.xyzrot->GetPos_dtdt());
+        } else {
+            if (node.xyzp)
+                pos = node.xyzp->GetPos();
+            pos0 = pos;
+            if (speed)
+                StoreVector(&m_speed[3 * i], VNULL);
+            if (accel)
+                StoreVector(&m_accel[3 * i], VNULL);
+        }
+        StoreVector(&m_points[3 * i], m_undeformed ? pos0 : pos);
+        if (displ)
+            StoreVector(&m_displ[3 * i], pos - pos0);
+        if (p)
+            m_p[i] = node.xyzp ? (float)node.xyzp->GetP() : 0.f;
+    }
+
+    bool solid_fields = m_has_solids && (m_fields & (ELEM_STRAIN_VONMISES | ELEM_STRESS_VONMISES));
+    bool beam_fields = m_has_beams && (m_fields & ELEM_BEAM_FORCES);
+    m_strain.assign(solid_fields ? nelements : 0, 0.f);
+    m_stress.assign(solid_fields ? nelements : 0, 0.f);
+    m_beam_force.assign(beam_fields ? 3 * nelements : 0, 0.f);
+    m_beam_torque.assign(beam_fields ? 3 * nelements : 0, 0.f);
+    if (!solid_fields && !beam_fields)
+        return;
+
+#pragma omp parallel for schedule(dynamic, 16)
+    for (int ie = 0; ie < nelements; ++ie) {
+        ChElementBase* element = m_elements[ie];
+        switch (m_elem_kinds[ie]) {
+            case ELEM_TETRA4:
+                if (solid_fields) {
+                    auto tetra = static_cast<ChElementTetra_4*>(element);
+                    ChStrainTensor<> strain = tetra->GetStrain();
+                    ChStressTensor<> stress;
+                    stress.MatrMultiply(tetra->GetMaterial()->Get_StressStrainMatrix(), strain);
+                    m_strain[ie] = (float)strain.GetEquivalentVonMises();
+                    m_stress[ie] = (float)stress.GetEquivalentVonMises();
+                }
+                break;
+            case ELEM_TETRA10:
+                if (solid_fields) {
+                    auto tetra = static_cast<ChElementTetra_10*>(element);
+                    m_strain[ie] = (float)tetra->GetStrain(0.25, 0.25, 0.25, 0.25).GetEquivalentVonMises();
+                    m_stress[ie] = (float)tetra->GetStress(0.25, 0.25, 0.25, 0.25).GetEquivalentVonMises();
+                }
+                break;
+            case ELEM_HEXA8:
+                if (solid_fields) {
+                    auto hexa = static_cast<ChElementHexa_8*>(element);
+                    m_strain[ie] = (float)hexa->GetStrain(0, 0, 0).GetEquivalentVonMises();
+                    m_stress[ie] = (float)hexa->GetStress(0, 0, 0).GetEquivalentVonMises();
+                }
+                break;
+            case ELEM_HEXA20:
+                if (solid_fields) {
+                    auto hexa = static_cast<ChElementHexa_20*>(element);
+                    m_strain[ie] = (float)hexa->GetStrain(0, 0, 0).GetEquivalentVonMises();
+                    m_stress[ie] = (float)hexa->GetStress(0, 0, 0).GetEquivalentVonMises();
+                }
+                break;
+            case ELEM_BAR:
+                if (solid_fields) {
+                    auto bar = static_cast<ChElementBar*>(element);
+                    m_strain[ie] = (float)std::abs(bar->GetStrain());
+                    m_stress[ie] = (float)std::abs(bar->GetStress());
+                }
+                break;
+            case ELEM_BEAM:
+                if (beam_fields) {
+                    auto beam = static_cast<ChElementBeam*>(element);
+                    ChMatrixDynamic<> displ(beam->GetNdofs(), 1);
+                    beam->GetStateBlock(displ);
+                    ChVector<> force, torque;
+                    beam->EvaluateSectionForceTorque(0, displ, force, torque);
+                    StoreVector(&m_beam_force[3 * ie], force);
+                    StoreVector(&m_beam_torque[3 * ie], torque);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+std::string ChMeshExporterVTK::WriteFrame(double time) {
+    if (m_nodes.size() != m_mesh->GetNnodes() || m_elements.size() != m_mesh->GetNelements())
+        UpdateTopology();
+
+    EvaluateFields();
+
+    // Assemble the appended data block and the matching XML header.
+    std::ostringstream xml;
+    m_buffer.clear();
+
+    uint16_t endian_test = 1;
+    bool little_endian = *reinterpret_cast<char*>(&endian_test) == 1;
+
+    xml << "<?xml version=\"1.0\"?>\n";
+    xml << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+        << (little_endian ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\">\n";
+    xml << "  <UnstructuredGrid>\n";
+    xml << "    <FieldData>\n";
+    xml << "      <DataArray type=\"Float64\" Name=\"TimeValue\" NumberOfTuples=\"1\" format=\"ascii\">"
+        << std::setprecision(17) << time << std::setprecision(6)
+        << "</DataArray>\n";
+    xml << "    </FieldData>\n";
+    xml << "    <Piece NumberOfPoints=\"" << m_nodes.size() << "\" NumberOfCells=\"" << m_elements.size() << "\">\n";
+
+    xml << "      <PointData>\n";
+    if (!m_displ.empty())
+        WriteArrayTag(xml, "Float32", "Displacement", 3, AppendArray(m_buffer, m_displ.data(), m_displ.size()));
+    if (!m_speed.empty())
+        WriteArrayTag(xml, "Float32", "Speed", 3, AppendArray(m_buffer, m_speed.data(), m_speed.size()));
+    if (!m_accel.empty())
+        WriteArrayTag(xml, "Float32", "Acceleration", 3, AppendArray(m_buffer, m_accel.data(), m_accel.size()));
+    if (!m_p.empty())
+        WriteArrayTag(xml, "Float32", "P", 1, AppendArray(m_buffer, m_p.data(), m_p.size()));
+    xml << "      </PointData>\n";
+
+    xml << "      <CellData>\n";
+    if ((m_fields & ELEM_STRAIN_VONMISES) && !m_strain.empty())
+        WriteArrayTag(xml, "Float32", "StrainVonMises", 1, AppendArray(m_buffer, m_strain.data(), m_strain.size()));
+    if ((m_fields & ELEM_STRESS_VONMISES) && !m_stress.empty())
+        WriteArrayTag(xml, "Float32", "StressVonMises", 1, AppendArray(m_buffer, m_stress.data(), m_stress.size()));
+    if (!m_beam_force.empty()) {
+        WriteArrayTag(xml, "Float32", "SectionForce", 3,
+                      AppendArray(m_buffer, m_beam_force.data(), m_beam_force.size()));
+        WriteArrayTag(xml, "Float32", "SectionTorque", 3,
+                      AppendArray(m_buffer, m_beam_torque.data(), m_beam_torque.size()));
+    }
+    xml << "      </CellData>\n";
+
+    xml << "      <Points>\n";
+    WriteArrayTag(xml, "Float32", "Points", 3, AppendArray(m_buffer, m_points.data(), m_points.size()));
+    xml << "      </Points>\n";
+
+    // The topology block is copied as is; its arrays start right after the per-frame arrays.
+    size_t topo = m_buffer.size();
+    size_t offsets_offset = topo + sizeof(uint64_t) + m_connectivity_size * sizeof(int32_t);
+    size_t types_offset = offsets_offset + sizeof(uint64_t) + m_elements.size() * sizeof(int32_t);
+    xml << "      <Cells>\n";
+    WriteArrayTag(xml, "Int32", "connectivity", 1, topo);
+    WriteArrayTag(xml, "Int32", "offsets", 1, offsets_offset);
+    WriteArrayTag(xml, "UInt8", "types", 1, types_offset);
+    xml << "      </Cells>\n";
+
+    xml << "    </Piece>\n";
+    xml << "  </UnstructuredGrid>\n";
+    xml << "  <AppendedData encoding=\"raw\">\n_";
+
+    // Write the file.
+    char suffix[16];
+    sprintf(suffix, "_%05d.vtu", (int)m_frame_times.size());
+    std::string name = m_basename + suffix;
+    std::string filename = m_dir + "/" + name;
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.good())
+        throw ChException("ChMeshExporterVTK: cannot open file " + filename);
+    std::string header = xml.str();
+    file.write(header.data(), header.size());
+    file.write(m_buffer.data(), m_buffer.size());
+    file.write(m_topology.data(), m_topology.size());
+    file << "\n  </AppendedData>\n</VTKFile>\n";
+    if (!file.good())
+        throw ChException("ChMeshExporterVTK: error writing file " + filename);
+    file.close();
+
+    m_frame_times.push_back(time);
+    WritePvd();
+
+    return filename;
+}
+
+void ChMeshExporterVTK::WritePvd() {
+    // The collection is written in full at the first frame only; afterwards the new data set
+    // overwrites the closing tags, which are written again after it.
+    std::string filename = m_dir + "/" + m_basename + ".pvd";
+    std::fstream file;
+    if (m_frame_times.size() == 1) {
+        file.open(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!file.good())
+            throw ChException("ChMeshExporterVTK: cannot open file " + filename);
+        file << "<?xml version=\"1.0\"?>\n";
+        file << "<VTKFile type=\"Collection\" version=\"0.1\">\n";
+        file << "  <Collection>\n";
+    } else {
+        file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+        if (!file.good())
+            throw ChException("ChMeshExporterVTK: cannot open file " + filename);
+        file.seekp(m_pvd_tail);
+    }
+
+    char suffix[16];
+    sprintf(suffix, "_%05d.vtu", (int)m_frame_times.size() - 1);
+    file << "    <DataSet timestep=\"" << std::setprecision(17) << m_frame_times.back() << "\" part=\"0\" file=\""
+         << m_basename << suffix << "\"/>\n";
+    m_pvd_tail = file.tellp();
+    file << "  </Collection>\n";
+    file << "</VTKFile>\n";
+    if (!file.good())
+        throw ChException("ChMeshExporterVTK: error writing file " + filename);
+}
+
+}  // end namespace fea
+}  // end namespace chrono
@@ -0,0 +1,137 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHMESHEXPORTERVTK_H
+#define CHMESHEXPORTERVTK_H
+
+#include <ios>
+#include <string>
+#include <vector>
+
+#include "chrono_fea/ChMesh.h"
+
+namespace chrono {
+namespace fea {
+
+// Forward references
+class ChNodeFEAxyz;
+class ChNodeFEAxyzrot;
+class ChNodeFEAxyzP;
+
+/// @addtogroup fea_utils
+/// @{
+
+/// Exporter of the nodal and element fields of a ChMesh, for headless post-processing.
+/// Each call to WriteFrame() writes a VTK XML unstructured grid file (.vtu) with all arrays
+/// stored as raw binary appended data, and adds it to a ParaView collection file (.pvd),
+/// so that the whole sequence can be opened at once in ParaView. The collection file is kept
+/// valid after each frame, and only its tail is rewritten when a frame is added.
+/// The mesh topology (node indices, cell types) is computed once and cached in binary form;
+/// per frame only the node positions and the requested field arrays are evaluated, in parallel.
+///
+/// Usage:
+///   ChMeshExporterVTK exporter(my_mesh, "output_dir", "mesh");
+///   while (...) {
+///       system.DoStepDynamics(step);
+///       exporter.WriteFrame(system.GetChTime());
+///   }
+class ChApiFea ChMeshExporterVTK {
+  public:
+    /// Fields that can be exported.
+    enum eChField {
+        NODE_DISPLACEMENT = 1 << 0,   ///< nodal displacement from the reference position (3 comp.)
+        NODE_SPEED = 1 << 1,          ///< nodal speed (3 comp.)
+        NODE_ACCEL = 1 << 2,          ///< nodal acceleration (3 comp.)
+        NODE_P = 1 << 3,              ///< scalar field of ChNodeFEAxyzP nodes (ex. temperature)
+        ELEM_STRAIN_VONMISES = 1 << 4,  ///< equivalent strain at the element center (solid elements)
+        ELEM_STRESS_VONMISES = 1 << 5,  ///< equivalent stress at the element center (solid elements)
+        ELEM_BEAM_FORCES = 1 << 6,      ///< section force and torque at the mid span of beams (2 x 3 comp.)
+        ALL_FIELDS = 0x7F
+    };
+
+    /// Create an exporter writing files <out_dir>/<basename>_NNNNN.vtu and <out_dir>/<basename>.pvd.
+    /// The output directory must exist.
+    ChMeshExporterVTK(std::shared_ptr<ChMesh> mesh, const std::string& out_dir, const std::string& basename = "mesh");
+
+    ~ChMeshExporterVTK();
+
+    /// Set which fields are exported, as a combination of eChField flags (default: ALL_FIELDS).
+    void SetFields(int fields) { m_fields = fields; }
+    int GetFields() const { return m_fields; }
+
+    /// If true, node positions are written in the undeformed reference configuration (default: false).
+    /// The displacement field can then be applied in ParaView with the 'Warp By Vector' filter.
+    void SetUndeformedReference(bool val) { m_undeformed = val; }
+
+    /// Rebuild the cached topology. This is done automatically at the first frame and whenever
+    /// the number of nodes or elements changes; call it explicitly if the connectivity changed otherwise.
+    void UpdateTopology();
+
+    /// Write the current state of the mesh as a new frame at the given time.
+    /// Returns the name of the written .vtu file.
+    std::string WriteFrame(double time);
+
+    /// Number of frames written so far.
+    int GetNumFrames() const { return (int)m_frame_times.size(); }
+
+  private:
+    /// Kind of node, for fast access to its state.
+    struct NodeData {
+        ChNodeFEAxyz* xyz;
+        ChNodeFEAxyzrot* xyzrot;
+        ChNodeFEAxyzP* xyzp;
+    };
+
+    /// Kind of element, for the evaluation of element fields.
+    enum eChElementKind { ELEM_OTHER, ELEM_TETRA4, ELEM_TETRA10, ELEM_HEXA8, ELEM_HEXA20, ELEM_BEAM, ELEM_BAR };
+
+    void EvaluateFields();
+    void WritePvd();
+
+    std::shared_ptr<ChMesh> m_mesh;
+    std::string m_dir;
+    std::string m_basename;
+    int m_fields;
+    bool m_undeformed;
+
+    // Cached topology
+    std::vector<NodeData> m_nodes;
+    std::vector<ChElementBase*> m_elements;
+    std::vector<eChElementKind> m_elem_kinds;
+    std::vector<char> m_topology;  ///< connectivity, offsets and types, already in appended-data layout
+    size_t m_connectivity_size;     ///< number of entries in the connectivity array
+    bool m_has_p;
+    bool m_has_beams;
+    bool m_has_solids;
+
+    // Per-frame arrays (reused)
+    std::vector<float> m_points;
+    std::vector<float> m_displ;
+    std::vector<float> m_speed;
+    std::vector<float> m_accel;
+    std::vector<float> m_p;
+    std::vector<float> m_strain;
+    std::vector<float> m_stress;
+    std::vector<float> m_beam_force;
+    std::vector<float> m_beam_torque;
+    std::vector<char> m_buffer;
+
+    std::vector<double> m_frame_times;
+    std::streamoff m_pvd_tail;  ///< position of the closing tags in the .pvd file
+};
+
+/// @} fea_utils
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
@@ -14,13 +14,18 @@
 // Utilities for loading meshes from file
 // =============================================================================
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <sstream>
-#include <fstream>
 #include <string>
-#include <algorithm>
-#include <functional>
 
+#include "chrono/core/ChMappedFile.h"
 #include "chrono/core/ChMath.h"
 #include "chrono/physics/ChObject.h"
 #include "chrono/physics/ChLoad.h"
@@ -36,177 +41,288 @@ using namespace std;
 namespace chrono {
 namespace fea {
 
-void ChMeshFileLoader::FromTetGenFile(std::shared_ptr<ChMesh> mesh,
-                                      const char* filename_node,
-                                      const char* filename_ele,
-                                      std::shared_ptr<ChContinuumMaterial> my_material,
-                                      ChVector<> pos_transform,
-                                      ChMatrix33<> rot_transform) {
-    int totnodes = 0;
-    int nodes_offset = mesh->GetNnodes();
-    int added_nodes = 0;
+// -----------------------------------------------------------------------------
+// Parsing of mesh files
+// -----------------------------------------------------------------------------
 
-    // Load .node TetGen file
-    {
-        bool parse_header = true;
-        bool parse_nodes = false;
+// Content of a tetrahedral mesh file, before the creation of nodes and elements.
+struct ChParsedTetMesh {
+    std::vector<double> coords;               // x, y, z of each node (not transformed)
+    std::vector<int> tets;                    // indices (from 0) of the 4 corner nodes of each tetrahedron
+    std::vector<std::vector<int>> node_sets;  // indices (from 0) of the nodes of each node set
+};
 
-        ifstream fin(filename_node);
-        if (!fin.good())
-            throw ChException("ERROR opening TetGen .node file: " + std::string(filename_node) + "\n");
-
-        int nnodes = 0;
-        int ndims = 0;
-        int nattrs = 0;
-        int nboundarymark = 0;
-
-        string line;
-        while (getline(fin, line)) {
-            // trims white space from the beginning of the string
-            line.erase(line.begin(), find_if(line.begin(), line.end(), not1(ptr_fun<int, int>(isspace))));
-
-            if (line[0] == '#')
-                continue;  // skip comment
-            if (line[0] == 0)
-                continue;  // skip empty lines
-
-            if (parse_header) {
-                stringstream(line) >> nnodes >> ndims >> nattrs >> nboundarymark;
-                if (ndims != 3)
-                    throw ChException("ERROR in TetGen .node file. Only 3 dimensional nodes supported: \n" + line);
-                if (nattrs != 0)
-                    throw ChException("ERROR in TetGen .node file. Only nodes with 0 attrs supported: \n" + line);
-                if (nboundarymark != 0)
-                    throw ChException("ERROR in TetGen .node file. Only nodes with 0 markers supported: \n" + line);
-                parse_header = false;
-                parse_nodes = true;
-                totnodes = nnodes;
-                continue;
-            }
+// Kinds of entries stored in a geometry cache (distinct from those used by ChGeometryCache itself).
+enum { CACHE_ENTRY_TETGEN = 101, CACHE_ENTRY_ABAQUS = 102 };
 
-            int idnode = 0;
-            double x = -10e30;
-            double y = -10e30;
-            double z = -10e30;
+// A line of a mapped text file, without leading and trailing blanks.
+struct ChTextLine {
+    const char* begin;
+    const char* end;
+};
 
-            if (parse_nodes) {
-                stringstream(line) >> idnode >> x >> y >> z;
-                ++added_nodes;
-                if (idnode <= 0 || idnode > nnodes)
-                    throw ChException("ERROR in TetGen .node file. Node ID not in range: \n" + line + "\n");
-                if (idnode != added_nodes)
-                    throw ChException("ERROR in TetGen .node file. Nodes IDs must be sequential (1 2 3 ..): \n" + line +
-                                      "\n");
-                if (x == -10e30 || y == -10e30 || z == -10e30)
-                    throw ChException("ERROR in TetGen .node file, in parsing x,y,z coordinates of node: \n" + line +
-                                      "\n");
+static inline bool IsBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
 
-                ChVector<> node_position(x, y, z);
-                node_position = rot_transform * node_position;  // rotate/scale, if needed
-                node_position = pos_transform + node_position;  // move, if needed
+static inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
 
-                if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
-                    auto mnode = std::make_shared<ChNodeFEAxyz>(node_position);
-                    mesh->AddNode(mnode);
-                } else if (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                    auto mnode = std::make_shared<ChNodeFEAxyzP>(node_position);
-                    mesh->AddNode(mnode);
-                } else
-                    throw ChException("ERROR in TetGen generation. Material type not supported. \n");
+static std::string ToString(const ChTextLine& line) {
+    return std::string(line.begin, line.end);
+}
+
+// Split a text buffer in lines, skipping empty lines. If 'comment' is not 0, the text following this
+// character is discarded.
+static void SplitLines(const char* data, size_t size, char comment, std::vector<ChTextLine>& lines) {
+    const char* p = data;
+    const char* end = data + size;
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!eol)
+            eol = end;
+        const char* b = p;
+        const char* e = eol;
+        if (comment) {
+            const char* c = static_cast<const char*>(std::memchr(b, comment, e - b));
+            if (c)
+                e = c;
+        }
+        while (b < e && IsBlank(*b))
+            ++b;
+        while (e > b && IsBlank(e[-1]))
+            --e;
+        if (e > b)
+            lines.push_back({b, e});
+        p = eol + 1;
+    }
+}
+
+// Parse a decimal number. Numbers with at most 19 significant digits and a small exponent are converted
+// exactly with a single floating point operation; other numbers are converted by strtod. In both cases,
+// the result is correctly rounded.
+static bool ParseReal(const char*& p, const char* end, double& value) {
+    static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-'))
+        negative = (*p++ == '-');
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any_digit = false;
+    bool exact = true;
+    for (; p < end && IsDigit(*p); ++p) {
+        any_digit = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa)
+                ++digits;
+        } else {
+            ++exponent;
+            exact &= (*p == '0');
+        }
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && IsDigit(*p); ++p) {
+            any_digit = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa)
+                    ++digits;
+                --exponent;
+            } else {
+                exact &= (*p == '0');
             }
+        }
+    }
+    if (!any_digit) {
+        p = start;
+        return false;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool negative_exp = false;
+        if (q < end && (*q == '+' || *q == '-'))
+            negative_exp = (*q++ == '-');
+        if (q < end && IsDigit(*q)) {
+            int exp10 = 0;
+            for (; q < end && IsDigit(*q); ++q)
+                exp10 = std::min(exp10 * 10 + (*q - '0'), 100000);
+            exponent += negative_exp ? -exp10 : exp10;
+            p = q;
+        }
+    }
 
-        }  // end while
+    if (exact && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double v = (double)mantissa;
+        v = (exponent < 0) ? v / powers[-exponent] : v * powers[exponent];
+        value = negative ? -v : v;
+        return true;
+    }
+    std::string token(start, p);
+    value = std::strtod(token.c_str(), nullptr);
+    return true;
+}
 
-    }  // end .node file
+// Parse up to 'max_fields' numbers from a line, separated by blanks or by commas.
+// Return the number of fields read, or -1 if the line contains something else.
+static int ParseFields(const ChTextLine& line, double* fields, int max_fields) {
+    const char* p = line.begin;
+    int n = 0;
+    while (n < max_fields) {
+        while (p < line.end && IsBlank(*p))
+            ++p;
+        if (p == line.end)
+            break;
+        if (!ParseReal(p, line.end, fields[n]))
+            return -1;
+        ++n;
+        while (p < line.end && IsBlank(*p))
+            ++p;
+        if (p < line.end && *p == ',')
+            ++p;
+        else if (p < line.end && !IsDigit(*p) && *p != '-' && *p != '+' && *p != '.')
+            return -1;
+    }
+    return n;
+}
 
-    // Load .ele TetGen file
-    {
-        bool parse_header = true;
-        bool parse_tet = false;
+// Check that a parsed field is a node index in [1, num_nodes] and convert it to an index from 0.
+static inline bool GetNodeIndex(double field, size_t num_nodes, int& index) {
+    if (!(field >= 1 && field <= (double)num_nodes) || field != std::floor(field))
+        return false;
+    index = (int)field - 1;
+    return true;
+}
 
-        ifstream fin(filename_ele);
+// Map a text file and split it in lines.
+static void MapLines(ChMappedFile& file, const char* filename, const char* what, char comment,
+                     std::vector<ChTextLine>& lines) {
+    if (!file.Open(filename)) {
+        std::ifstream fin(filename);
         if (!fin.good())
-            throw ChException("ERROR opening TetGen .node file: " + std::string(filename_node) + "\n");
-
-        int ntets, nnodespertet, nattrs = 0;
-
-        string line;
-        while (getline(fin, line)) {
-            // trims white space from the beginning of the string
-            line.erase(line.begin(), find_if(line.begin(), line.end(), not1(ptr_fun<int, int>(isspace))));
-
-            if (line[0] == '#')
-                continue;  // skip comment
-            if (line[0] == 0)
-                continue;  // skip empty lines
-
-            if (parse_header) {
-                stringstream(line) >> ntets >> nnodespertet >> nattrs;
-                if (nnodespertet != 4)
-                    throw ChException("ERROR in TetGen .ele file. Only 4 -nodes per tes supported: \n" + line + "\n");
-                if (nattrs != 0)
-                    throw ChException("ERROR in TetGen .ele file. Only tets with 0 attrs supported: \n" + line + "\n");
-                parse_header = false;
-                parse_tet = true;
-                continue;
-            }
+            throw ChException("ERROR opening " + std::string(what) + " file: " + std::string(filename) + "\n");
+        return;  // empty file
+    }
+    SplitLines(file.GetData(), file.GetSize(), comment, lines);
+}
 
-            int idtet = 0;
-            int n1, n2, n3, n4;
-
-            if (parse_tet) {
-                stringstream(line) >> idtet >> n1 >> n2 >> n3 >> n4;
-                if (idtet <= 0 || idtet > ntets)
-                    throw ChException("ERROR in TetGen .node file. Tetrahedron ID not in range: \n" + line + "\n");
-                if (n1 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 1st node is out of range: \n" + line + "\n");
-                if (n2 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 2nd node is out of range: \n" + line + "\n");
-                if (n3 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 3rd node is out of range: \n" + line + "\n");
-                if (n4 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 4th node is out of range: \n" + line + "\n");
-                if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
-                    auto mel = std::make_shared<ChElementTetra_4>();
-                    mel->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n1 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n3 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n2 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n4 - 1)));
-                    mel->SetMaterial(std::static_pointer_cast<ChContinuumElastic>(my_material));
-                    mesh->AddElement(mel);
-                } else if (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                    auto mel = std::make_shared<ChElementTetra_4_P>();
-                    mel->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n1 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n3 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n2 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n4 - 1)));
-                    mel->SetMaterial(std::static_pointer_cast<ChContinuumPoisson3D>(my_material));
-                    mesh->AddElement(mel);
-                } else
-                    throw ChException("ERROR in TetGen generation. Material type not supported. \n");
+// Parse the data lines [first, first + count) in parallel. The function 'parse' is called for each line
+// with its index relative to 'first' and returns an error message or nullptr; the error on the first
+// invalid line, if any, is thrown as a ChException.
+static void ParseLines(const std::vector<const ChTextLine*>& lines,
+                       std::function<const char*(const ChTextLine&, int)> parse) {
+    int num_lines = (int)lines.size();
+    int error_line = num_lines;
+    const char* error = nullptr;
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < num_lines; i++) {
+        const char* message = parse(*lines[i], i);
+        if (message) {
+#pragma omp critical
+            if (i < error_line) {
+                error_line = i;
+                error = message;
             }
-
-        }  // end while
-
-    }  // end .ele file
+        }
+    }
+    if (error)
+        throw ChException(std::string(error) + "\n" + ToString(*lines[error_line]) + "\n");
 }
 
-void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
-                                      const char* filename,
-                                      std::shared_ptr<ChContinuumMaterial> my_material,
-                                      std::vector<std::vector<std::shared_ptr<ChNodeFEAbase>>>& node_sets,
-                                      ChVector<> pos_transform,
-                                      ChMatrix33<> rot_transform,
-                                      bool discard_unused_nodes) {
-    node_sets.resize(0);
+static void ParseTetGenFiles(const char* filename_node, const char* filename_ele, ChParsedTetMesh& parsed) {
+    // Load .node TetGen file
+    size_t num_nodes = 0;
+    {
+        ChMappedFile file;
+        std::vector<ChTextLine> lines;
+        MapLines(file, filename_node, "TetGen .node", '#', lines);
+        if (lines.empty())
+            throw ChException("ERROR in TetGen .node file, missing header: " + std::string(filename_node) + "\n");
+
+        double header[4] = {0, 0, 0, 0};
+        if (ParseFields(lines[0], header, 4) < 1)
+            throw ChException("ERROR in TetGen .node file, invalid header: \n" + ToString(lines[0]) + "\n");
+        if (header[1] != 3)
+            throw ChException("ERROR in TetGen .node file. Only 3 dimensional nodes supported: \n" +
+                              ToString(lines[0]));
+        if (header[2] != 0)
+            throw ChException("ERROR in TetGen .node file. Only nodes with 0 attrs supported: \n" +
+                              ToString(lines[0]));
+        if (header[3] != 0)
+            throw ChException("ERROR in TetGen .node file. Only nodes with 0 markers supported: \n" +
+                              ToString(lines[0]));
+        num_nodes = (size_t)header[0];
+
+        std::vector<const ChTextLine*> data;
+        for (size_t i = 1; i < lines.size(); i++)
+            data.push_back(&lines[i]);
+        if (data.size() > num_nodes)
+            throw ChException("ERROR in TetGen .node file. Node ID not in range: \n" + ToString(*data[num_nodes]) +
+                              "\n");
+        parsed.coords.resize(3 * data.size());
+
+        ParseLines(data, [&](const ChTextLine& line, int i) -> const char* {
+            double fields[4];
+            if (ParseFields(line, fields, 4) != 4)
+                return "ERROR in TetGen .node file, in parsing x,y,z coordinates of node:";
+            if (fields[0] != i + 1)
+                return "ERROR in TetGen .node file. Nodes IDs must be sequential (1 2 3 ..):";
+            parsed.coords[3 * i + 0] = fields[1];
+            parsed.coords[3 * i + 1] = fields[2];
+            parsed.coords[3 * i + 2] = fields[3];
+            return nullptr;
+        });
+    }
 
-    std::vector<std::shared_ptr<ChNodeFEAbase>> parsed_nodes;
-    std::vector<bool> parsed_nodes_used;
+    // Load .ele TetGen file
+    {
+        ChMappedFile file;
+        std::vector<ChTextLine> lines;
+        MapLines(file, filename_ele, "TetGen .ele", '#', lines);
+        if (lines.empty())
+            throw ChException("ERROR in TetGen .ele file, missing header: " + std::string(filename_ele) + "\n");
+
+        double header[3] = {0, 0, 0};
+        if (ParseFields(lines[0], header, 3) < 1)
+            throw ChException("ERROR in TetGen .ele file, invalid header: \n" + ToString(lines[0]) + "\n");
+        if (header[1] != 4)
+            throw ChException("ERROR in TetGen .ele file. Only 4 -nodes per tes supported: \n" + ToString(lines[0]) +
+                              "\n");
+        if (header[2] != 0)
+            throw ChException("ERROR in TetGen .ele file. Only tets with 0 attrs supported: \n" + ToString(lines[0]) +
+                              "\n");
+        double num_tets = header[0];
+
+        std::vector<const ChTextLine*> data;
+        for (size_t i = 1; i < lines.size(); i++)
+            data.push_back(&lines[i]);
+        parsed.tets.resize(4 * data.size());
+
+        size_t num_parsed_nodes = parsed.coords.size() / 3;
+        ParseLines(data, [&](const ChTextLine& line, int i) -> const char* {
+            double fields[5];
+            if (ParseFields(line, fields, 5) != 5)
+                return "ERROR in TetGen .ele file, in parsing IDs of tetrahedron:";
+            if (fields[0] <= 0 || fields[0] > num_tets)
+                return "ERROR in TetGen .ele file. Tetrahedron ID not in range:";
+            for (int k = 0; k < 4; k++) {
+                if (!GetNodeIndex(fields[k + 1], num_parsed_nodes, parsed.tets[4 * i + k]))
+                    return "ERROR in TetGen .ele file, ID of node is out of range:";
+            }
+            return nullptr;
+        });
+    }
+}
 
-    int totnodes = 0;
-    unsigned int nodes_offset = mesh->GetNnodes();
-    int added_nodes = 0;
-    int added_elements = 0;
+static void ParseAbaqusFile(const char* filename, ChParsedTetMesh& parsed) {
+    ChMappedFile file;
+    std::vector<ChTextLine> lines;
+    MapLines(file, filename, "Abaqus .inp", 0, lines);
 
     enum eChAbaqusParserSection {
         E_PARSE_UNKNOWN = 0,
@@ -216,214 +332,289 @@ void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
         E_PARSE_NODESET
     } e_parse_section = E_PARSE_UNKNOWN;
 
-    ifstream fin(filename);
-    if (!fin.good())
-        throw ChException("ERROR opening Abaqus .inp file: " + std::string(filename) + "\n");
-
-    int nnodes = 0;
-    int ndims = 0;
-    int nattrs = 0;
-
-    string line;
-    while (getline(fin, line)) {
-        // trims white space from the beginning of the string
-        line.erase(line.begin(), find_if(line.begin(), line.end(), not1(ptr_fun<int, int>(isspace))));
-
-        if (line[0] == 0)
-            continue;  // skip empty lines
-
-        if (line[0] == '*') {
+    // Find the sections (serial pass); node sets are short and are read directly.
+    std::vector<const ChTextLine*> node_lines;
+    std::vector<const ChTextLine*> tet_lines;
+    std::vector<char> tet_num_fields;
+    std::vector<std::vector<double>> node_set_ids;
+    for (const auto& line : lines) {
+        if (*line.begin == '*') {
+            std::string keyword = ToString(line);
             e_parse_section = E_PARSE_UNKNOWN;
 
-            if (line.find("*NODE") == 0) {
-                string::size_type nse = line.find("NSET=");
-                if (nse > 0) {
-                    string::size_type ncom = line.find(",", nse);
-                    string s_node_set = line.substr(nse + 5, ncom - (nse + 5));
-                    GetLog() << "Parsing: nodes " << s_node_set << "\n";
-                }
+            if (keyword.find("*NODE") == 0) {
                 e_parse_section = E_PARSE_NODES_XYZ;
-            }
-            if (line.find("*ELEMENT") == 0) {
-                string::size_type nty = line.find("TYPE=");
-                if (nty > 0) {
-                    string::size_type ncom = line.find(",", nty);
-                    string s_ele_type = line.substr(nty + 5, ncom - (nty + 5));
-                    e_parse_section = E_PARSE_UNKNOWN;
-                    if (s_ele_type == "C3D10") {
-                        e_parse_section = E_PARSE_TETS_10;
-                    } else if (s_ele_type == "DC3D10") {
-                        e_parse_section = E_PARSE_TETS_10;
-                    } else if (s_ele_type == "C3D4") {
-                        e_parse_section = E_PARSE_TETS_4;
-                    }
-                    if (e_parse_section == E_PARSE_UNKNOWN) {
-                        throw ChException("ERROR in .inp file, TYPE=" + s_ele_type +
-                                          " (only C3D10 or DC3D10 or C3D4 tetrahedrons supported) see: \n" + line + "\n");
-                    }
-                }
-                string::size_type nse = line.find("ELSET=");
-                if (nse > 0) {
-                    string::size_type ncom = line.find(",", nse);
-                    string s_ele_set = line.substr(nse + 6, ncom - (nse + 6));
-                    GetLog() << "Parsing: element set: " << s_ele_set << "\n";
+            } else if (keyword.find("*ELEMENT") == 0) {
+                std::string::size_type nty = keyword.find("TYPE=");
+                if (nty == std::string::npos)
+                    throw ChException("ERROR in .inp file, missing element TYPE, see: \n" + keyword + "\n");
+                std::string::size_type ncom = keyword.find(",", nty);
+                std::string s_ele_type = keyword.substr(nty + 5, ncom - (nty + 5));
+                s_ele_type.erase(s_ele_type.find_last_not_of(" \t") + 1);
+                if (s_ele_type == "C3D10" || s_ele_type == "DC3D10")
+                    e_parse_section = E_PARSE_TETS_10;
+                else if (s_ele_type == "C3D4")
+                    e_parse_section = E_PARSE_TETS_4;
+                else
+                    throw ChException("ERROR in .inp file, TYPE=" + s_ele_type +
+                                      " (only C3D10 or DC3D10 or C3D4 tetrahedrons supported) see: \n" + keyword +
+                                      "\n");
+                std::string::size_type nse = keyword.find("ELSET=");
+                if (nse != std::string::npos) {
+                    ncom = keyword.find(",", nse);
+                    GetLog() << "Parsing: element set: " << keyword.substr(nse + 6, ncom - (nse + 6)) << "\n";
                 }
-            }
-            if (line.find("*NSET") == 0) {
-                GetLog() << "Parsing: nodeset.. ";
-                string::size_type nse = line.find("NSET=", 5);
-                if (nse > 0) {
-                    string::size_type ncom = line.find(",", nse);
-                    string s_node_set = line.substr(nse + 5, ncom - (nse + 5));
-                    GetLog() << "Parsing: nodeset: " << s_node_set << "\n";
-
-                    std::vector<std::shared_ptr<ChNodeFEAbase>> empty_set;
-                    node_sets.push_back(empty_set);
+            } else if (keyword.find("*NSET") == 0) {
+                std::string::size_type nse = keyword.find("NSET=", 5);
+                if (nse != std::string::npos) {
+                    std::string::size_type ncom = keyword.find(",", nse);
+                    GetLog() << "Parsing: nodeset: " << keyword.substr(nse + 5, ncom - (nse + 5)) << "\n";
                 }
+                node_set_ids.push_back(std::vector<double>());
                 e_parse_section = E_PARSE_NODESET;
             }
-
-            continue;  // skip
+            continue;
         }
 
-        if (e_parse_section == E_PARSE_NODES_XYZ) {
-            int idnode = 0;
-            double x = -10e30;
-            double y = -10e30;
-            double z = -10e30;
-            double tokenvals[20];
-            int ntoken = 0;
-
-            string token;
-            std::istringstream ss(line);
-            while (getline(ss, token, ',') && ntoken < 20) {
-                std::istringstream stoken(token);
-                stoken >> tokenvals[ntoken];
-                ++ntoken;
+        switch (e_parse_section) {
+            case E_PARSE_NODES_XYZ:
+                node_lines.push_back(&line);
+                break;
+            case E_PARSE_TETS_4:
+            case E_PARSE_TETS_10:
+                tet_lines.push_back(&line);
+                tet_num_fields.push_back(e_parse_section == E_PARSE_TETS_4 ? 5 : 11);
+                break;
+            case E_PARSE_NODESET: {
+                double fields[100];
+                int nfields = ParseFields(line, fields, 100);
+                if (nfields < 0)
+                    throw ChException("ERROR in .inp file, in parsing node set: \n" + ToString(line) + "\n");
+                node_set_ids.back().insert(node_set_ids.back().end(), fields, fields + nfields);
+                break;
             }
-            ++added_nodes;
+            default:
+                break;
+        }
+    }
 
-            if (ntoken != 4)
-                throw ChException("ERROR in .inp file, nodes require ID and three x y z coords, see line:\n" + line +
+    // Parse nodes and tetrahedrons (parallel).
+    parsed.coords.resize(3 * node_lines.size());
+    ParseLines(node_lines, [&](const ChTextLine& line, int i) -> const char* {
+        double fields[4];
+        if (ParseFields(line, fields, 4) != 4)
+            return "ERROR in .inp file, nodes require ID and three x y z coords, see line:";
+        if (fields[0] != i + 1)
+            return "ERROR in .inp file. Nodes IDs must be sequential (1 2 3 ..):";
+        parsed.coords[3 * i + 0] = fields[1];
+        parsed.coords[3 * i + 1] = fields[2];
+        parsed.coords[3 * i + 2] = fields[3];
+        return nullptr;
+    });
+
+    size_t num_nodes = node_lines.size();
+    parsed.tets.resize(4 * tet_lines.size());
+    ParseLines(tet_lines, [&](const ChTextLine& line, int i) -> const char* {
+        double fields[11];
+        if (ParseFields(line, fields, 11) != tet_num_fields[i])
+            return (tet_num_fields[i] == 5) ? "ERROR in .inp file, tetrahedrons require ID and 4 node IDs, see line:"
+                                            : "ERROR in .inp file, tetrahedrons require ID and 10 node IDs, see line:";
+        if (fields[0] != i + 1)
+            return "ERROR in .inp file. Element IDs must be sequential (1 2 3 ..):";
+        // Only the corner nodes of 10-node tetrahedrons are used.
+        for (int k = 0; k < 4; k++) {
+            if (!GetNodeIndex(fields[k + 1], num_nodes, parsed.tets[4 * i + k]))
+                return "ERROR in .inp file, in parsing IDs of tetrahedron:";
+        }
+        return nullptr;
+    });
+
+    parsed.node_sets.resize(node_set_ids.size());
+    for (size_t is = 0; is < node_set_ids.size(); is++) {
+        for (double id : node_set_ids[is]) {
+            // Zero or negative entries are ignored.
+            if (id <= 0)
+                continue;
+            int index;
+            if (!GetNodeIndex(id, num_nodes, index))
+                throw ChException("ERROR in .inp file, node ID out of range in node set: " + std::to_string(id) +
                                   "\n");
-            idnode = (int)tokenvals[0];
-            if (idnode != added_nodes)
-                throw ChException("ERROR in .inp file. Nodes IDs must be sequential (1 2 3 ..): \n" + line + "\n");
-            x = tokenvals[1];
-            y = tokenvals[2];
-            z = tokenvals[3];
-            if (x == -10e30 || y == -10e30 || z == -10e30)
-                throw ChException("ERROR in in .inp file, in parsing x,y,z coordinates of node: \n" + line + "\n");
-
-            ChVector<> node_position(x, y, z);
-            node_position = rot_transform * node_position;  // rotate/scale, if needed
-            node_position = pos_transform + node_position;  // move, if needed
-
-            if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
-                auto mnode = std::make_shared<ChNodeFEAxyz>(node_position);
-                parsed_nodes.push_back(mnode);
-                parsed_nodes_used.push_back(false);
-            } else if (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                auto mnode = std::make_shared<ChNodeFEAxyzP>(ChVector<>(x, y, z));
-                parsed_nodes.push_back(mnode);
-                parsed_nodes_used.push_back(false);
-            } else
-                throw ChException("ERROR in .inp generation. Material type not supported. \n");
+            parsed.node_sets[is].push_back(index);
         }
+    }
+}
 
-        if (e_parse_section == E_PARSE_TETS_10 || e_parse_section == E_PARSE_TETS_4) {
-            int idelem = 0;
-            unsigned int tokenvals[20];
-            int ntoken = 0;
-
-            string token;
-            std::istringstream ss(line);
-            while (std::getline(ss, token, ',') && ntoken < 20) {
-                std::istringstream stoken(token);
-                stoken >> tokenvals[ntoken];
-                ++ntoken;
-            }
-            ++added_elements;
-            if (e_parse_section == E_PARSE_TETS_10) {
-                if (ntoken != 11)
-                    throw ChException("ERROR in .inp file, tetrahedrons require ID and 10 node IDs, see line:\n" + line +
-                                      "\n");
-                idelem = (int)tokenvals[0];
-                if (idelem != added_elements)
-                    throw ChException("ERROR in .inp file. Element IDs must be sequential (1 2 3 ..): \n" + line +
-                                      "\n");
-                for (int in = 0; in < 10; ++in)
-                    if (tokenvals[in + 1] == -10e30)
-                        throw ChException("ERROR in in .inp file, in parsing IDs of tetrahedron: \n" + line + "\n");
-            } else if (e_parse_section == E_PARSE_TETS_4) {
-                if (ntoken != 5)
-                    throw ChException("ERROR in .inp file, tetrahedrons require ID and 10 node IDs, see line:\n" + line +
-                                      "\n");
-                idelem = (int)tokenvals[0];
-                if (idelem != added_elements)
-                    throw ChException("ERROR in .inp file. Element IDs must be sequential (1 2 3 ..): \n" + line +
-                                      "\n");
-                for (int in = 0; in < 4; ++in)
-                    if (tokenvals[in + 1] == -10e30)
-                        throw ChException("ERROR in in .inp file, in parsing IDs of tetrahedron: \n" + line + "\n");
-            }
-            if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
-                auto mel = std::make_shared<ChElementTetra_4>();
-                mel->SetNodes(std::static_pointer_cast<ChNodeFEAxyz>(parsed_nodes[tokenvals[4] - 1]),
-                              std::static_pointer_cast<ChNodeFEAxyz>(parsed_nodes[tokenvals[2] - 1]),
-                              std::static_pointer_cast<ChNodeFEAxyz>(parsed_nodes[tokenvals[3] - 1]),
-                              std::static_pointer_cast<ChNodeFEAxyz>(parsed_nodes[tokenvals[1] - 1]));
-                mel->SetMaterial(std::static_pointer_cast<ChContinuumElastic>(my_material));
-                mesh->AddElement(mel);
-                parsed_nodes_used[tokenvals[1] - 1] = true;
-                parsed_nodes_used[tokenvals[2] - 1] = true;
-                parsed_nodes_used[tokenvals[3] - 1] = true;
-                parsed_nodes_used[tokenvals[4] - 1] = true;
-            } else if (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                auto mel = std::make_shared<ChElementTetra_4_P>();
-                mel->SetNodes(std::static_pointer_cast<ChNodeFEAxyzP>(parsed_nodes[tokenvals[1] - 1]),
-                              std::static_pointer_cast<ChNodeFEAxyzP>(parsed_nodes[tokenvals[2] - 1]),
-                              std::static_pointer_cast<ChNodeFEAxyzP>(parsed_nodes[tokenvals[3] - 1]),
-                              std::static_pointer_cast<ChNodeFEAxyzP>(parsed_nodes[tokenvals[4] - 1]));
-                mel->SetMaterial(std::static_pointer_cast<ChContinuumPoisson3D>(my_material));
-                mesh->AddElement(mel);
-                parsed_nodes_used[tokenvals[1] - 1] = true;
-                parsed_nodes_used[tokenvals[2] - 1] = true;
-                parsed_nodes_used[tokenvals[3] - 1] = true;
-                parsed_nodes_used[tokenvals[4] - 1] = true;
-            } else
-                throw ChException("ERROR in TetGen generation. Material type not supported. \n");
-        }
+// Read a parsed mesh from a cache entry. Return false if the entry does not exist or is invalid.
+static bool ReadCachedMesh(utils::ChGeometryCache& cache, uint64_t key, ChParsedTetMesh& parsed) {
+    std::vector<char> payload;
+    if (!cache.Read(key, payload))
+        return false;
+    const char* cursor = payload.data();
+    const char* end = cursor + payload.size();
+    std::vector<uint64_t> num_sets;
+    if (!utils::ChGeometryCache::GetArray(cursor, end, parsed.coords) ||
+        !utils::ChGeometryCache::GetArray(cursor, end, parsed.tets) ||
+        !utils::ChGeometryCache::GetArray(cursor, end, num_sets) || num_sets.size() != 1)
+        return false;
+    parsed.node_sets.resize(num_sets[0] <= payload.size() ? (size_t)num_sets[0] : 0);
+    for (auto& set : parsed.node_sets) {
+        if (!utils::ChGeometryCache::GetArray(cursor, end, set))
+            return false;
+    }
 
-        if (e_parse_section == E_PARSE_NODESET) {
-            int idelem = 0;
+    // Check the node indices, so that a corrupted entry cannot result in invalid memory accesses.
+    int num_nodes = (int)(parsed.coords.size() / 3);
+    bool valid = (num_sets[0] == parsed.node_sets.size()) && (parsed.tets.size() % 4 == 0);
+    for (int index : parsed.tets)
+        valid &= (index >= 0 && index < num_nodes);
+    for (auto& set : parsed.node_sets)
+        for (int index : set)
+            valid &= (index >= 0 && index < num_nodes);
+    return valid;
+}
 
-            unsigned int tokenvals[100];
-            int ntoken = 0;
+static void WriteCachedMesh(utils::ChGeometryCache& cache, uint64_t key, const ChParsedTetMesh& parsed) {
+    std::vector<char> payload;
+    utils::ChGeometryCache::PutArray(payload, parsed.coords);
+    utils::ChGeometryCache::PutArray(payload, parsed.tets);
+    utils::ChGeometryCache::PutArray(payload, std::vector<uint64_t>(1, parsed.node_sets.size()));
+    for (auto& set : parsed.node_sets)
+        utils::ChGeometryCache::PutArray(payload, set);
+    cache.Write(key, payload.data(), payload.size());
+}
 
-            string token;
-            std::istringstream ss(line);
-            while (std::getline(ss, token, ',') && ntoken < 100) {
-                std::istringstream stoken(token);
-                stoken >> tokenvals[ntoken];
-                ++ntoken;
-            }
+// Create nodes and tetrahedrons from a parsed mesh and add them to the mesh.
+// Each node and element is a separate allocation, so that its lifetime is that of its own shared pointer;
+// elements are created in parallel. Only the nodes flagged in 'add_node' are added to the mesh; 'corners'
+// gives the order in which the nodes of a tetrahedron in the file are passed to SetNodes(). Returns all
+// created nodes.
+template <class Tnode, class Telement, class Tmaterial>
+static std::vector<std::shared_ptr<ChNodeFEAbase>> CreateTetrahedrons(ChMesh& mesh,
+                                                                      const ChParsedTetMesh& parsed,
+                                                                      std::shared_ptr<Tmaterial> material,
+                                                                      const ChVector<>& pos_transform,
+                                                                      const ChMatrix33<>& rot_transform,
+                                                                      const int corners[4],
+                                                                      const std::vector<bool>& add_node) {
+    int num_nodes = (int)(parsed.coords.size() / 3);
+    int num_tets = (int)(parsed.tets.size() / 4);
+
+    std::vector<std::shared_ptr<Tnode>> nodes(num_nodes);
+    for (int i = 0; i < num_nodes; i++) {
+        ChVector<> position(parsed.coords[3 * i + 0], parsed.coords[3 * i + 1], parsed.coords[3 * i + 2]);
+        nodes[i] = std::make_shared<Tnode>(pos_transform + rot_transform * position);
+    }
 
-            for (int nt = 0; nt < ntoken; ++nt) {
-                int idnode = (int)tokenvals[nt];
-                if (idnode > 0) {
-                    node_sets.back().push_back(std::dynamic_pointer_cast<ChNodeFEAbase>(parsed_nodes[idnode - 1]));
-                    parsed_nodes_used[idnode - 1] = true;
-                }
-            }
-        }
+    std::vector<std::shared_ptr<Telement>> elements(num_tets);
+#pragma omp parallel for schedule(static)
+    for (int ie = 0; ie < num_tets; ie++) {
+        const int* tet = &parsed.tets[4 * ie];
+        elements[ie] = std::make_shared<Telement>();
+        elements[ie]->SetNodes(nodes[tet[corners[0]]], nodes[tet[corners[1]]], nodes[tet[corners[2]]],
+                               nodes[tet[corners[3]]]);
+        elements[ie]->SetMaterial(material);
+    }
+
+    for (int i = 0; i < num_nodes; i++) {
+        if (add_node[i])
+            mesh.AddNode(nodes[i]);
+    }
+    for (int ie = 0; ie < num_tets; ie++)
+        mesh.AddElement(elements[ie]);
 
-    }  // end while
+    return std::vector<std::shared_ptr<ChNodeFEAbase>>(nodes.begin(), nodes.end());
+}
+
+// -----------------------------------------------------------------------------
+
+void ChMeshFileLoader::FromTetGenFile(std::shared_ptr<ChMesh> mesh,
+                                      const char* filename_node,
+                                      const char* filename_ele,
+                                      std::shared_ptr<ChContinuumMaterial> my_material,
+                                      ChVector<> pos_transform,
+                                      ChMatrix33<> rot_transform,
+                                      utils::ChGeometryCache* cache) {
+    if (!std::dynamic_pointer_cast<ChContinuumElastic>(my_material) &&
+        !std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material))
+        throw ChException("ERROR in TetGen generation. Material type not supported. \n");
+
+    ChParsedTetMesh parsed;
+    uint64_t key = 0;
+    if (cache) {
+        uint64_t kind = CACHE_ENTRY_TETGEN;
+        key = utils::ChGeometryCache::Hash(&kind, sizeof(kind), utils::ChGeometryCache::HashFile(filename_node));
+        key = utils::ChGeometryCache::Hash(&key, sizeof(key), utils::ChGeometryCache::HashFile(filename_ele));
+    }
+    if (!cache || !ReadCachedMesh(*cache, key, parsed)) {
+        parsed = ChParsedTetMesh();
+        ParseTetGenFiles(filename_node, filename_ele, parsed);
+        if (cache)
+            WriteCachedMesh(*cache, key, parsed);
+    }
+
+    std::vector<bool> add_node(parsed.coords.size() / 3, true);
+    const int corners[4] = {0, 2, 1, 3};
+    if (auto material = std::dynamic_pointer_cast<ChContinuumElastic>(my_material))
+        CreateTetrahedrons<ChNodeFEAxyz, ChElementTetra_4>(*mesh, parsed, material, pos_transform, rot_transform,
+                                                           corners, add_node);
+    else
+        CreateTetrahedrons<ChNodeFEAxyzP, ChElementTetra_4_P>(*mesh, parsed,
+                                                              std::static_pointer_cast<ChContinuumPoisson3D>(my_material),
+                                                              pos_transform, rot_transform, corners, add_node);
+}
+
+void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
+                                      const char* filename,
+                                      std::shared_ptr<ChContinuumMaterial> my_material,
+                                      std::vector<std::vector<std::shared_ptr<ChNodeFEAbase>>>& node_sets,
+                                      ChVector<> pos_transform,
+                                      ChMatrix33<> rot_transform,
+                                      bool discard_unused_nodes,
+                                      utils::ChGeometryCache* cache) {
+    if (!std::dynamic_pointer_cast<ChContinuumElastic>(my_material) &&
+        !std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material))
+        throw ChException("ERROR in .inp generation. Material type not supported. \n");
+
+    ChParsedTetMesh parsed;
+    uint64_t key = 0;
+    if (cache) {
+        uint64_t kind = CACHE_ENTRY_ABAQUS;
+        key = utils::ChGeometryCache::Hash(&kind, sizeof(kind), utils::ChGeometryCache::HashFile(filename));
+    }
+    if (!cache || !ReadCachedMesh(*cache, key, parsed)) {
+        parsed = ChParsedTetMesh();
+        ParseAbaqusFile(filename, parsed);
+        if (cache)
+            WriteCachedMesh(*cache, key, parsed);
+    }
+
+    // Nodes not used by elements or node sets are not added to the mesh (as before, regardless of the
+    // discard_unused_nodes flag).
+    std::vector<bool> add_node(parsed.coords.size() / 3, false);
+    for (int index : parsed.tets)
+        add_node[index] = true;
+    for (auto& set : parsed.node_sets)
+        for (int index : set)
+            add_node[index] = true;
+
+    std::vector<std::shared_ptr<ChNodeFEAbase>> nodes;
+    if (auto material = std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
+        const int corners[4] = {3, 1, 2, 0};
+        nodes = CreateTetrahedrons<ChNodeFEAxyz, ChElementTetra_4>(*mesh, parsed, material, pos_transform,
+                                                                   rot_transform, corners, add_node);
+    } else {
+        // As before, the nodes with scalar field are placed at the coordinates in the file, not transformed.
+        const int corners[4] = {0, 1, 2, 3};
+        nodes = CreateTetrahedrons<ChNodeFEAxyzP, ChElementTetra_4_P>(
+            *mesh, parsed, std::static_pointer_cast<ChContinuumPoisson3D>(my_material), VNULL, ChMatrix33<>(1),
+            corners, add_node);
+    }
 
-    // Add nodes to the mesh (only those effectively used for elements or node sets)
-    for (unsigned int i = 0; i < parsed_nodes.size(); ++i) {
-        if (parsed_nodes_used[i] == true)
-            mesh->AddNode(parsed_nodes[i]);
+    node_sets.resize(parsed.node_sets.size());
+    for (size_t is = 0; is < parsed.node_sets.size(); is++) {
+        node_sets[is].clear();
+        for (int index : parsed.node_sets[is])
+            node_sets[is].push_back(nodes[index]);
     }
 }
 
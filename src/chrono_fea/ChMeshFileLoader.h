@@ -17,6 +17,8 @@
 #ifndef CHMESH_FILE_LOADER_H
 #define CHMESH_FILE_LOADER_H
 
+#include "chrono/utils/ChGeometryCache.h"
+
 #include "chrono_fea/ChElementShellANCF.h"
 #include "chrono_fea/ChMesh.h"
 
@@ -42,16 +44,21 @@ class ChApiFea ChMeshFileLoader {
     /// elements.
     /// If you pass a material inherited by ChContinuumPoisson3D, nodes with scalar field are used (ex. thermal,
     /// electrostatics, etc)
+    /// Files are memory-mapped and their lines parsed in parallel; elements are created in parallel.
+    /// If a cache is provided, the parsed mesh is stored in it and later loads of the same files skip
+    /// parsing altogether. Large meshes are usually worth reordering (see ChMesh::Reorder).
     static void FromTetGenFile(
         std::shared_ptr<ChMesh> mesh,                      ///< destination mesh
         const char* filename_node,                         ///< name of the .node file
         const char* filename_ele,                          ///< name of the .ele  file
         std::shared_ptr<ChContinuumMaterial> my_material,  ///< material for the created tetahedrons
         ChVector<> pos_transform = VNULL,                  ///< optional displacement of imported mesh
-        ChMatrix33<> rot_transform = ChMatrix33<>(1)       ///< optional rotation/scaling of imported mesh
+        ChMatrix33<> rot_transform = ChMatrix33<>(1),      ///< optional rotation/scaling of imported mesh
+        utils::ChGeometryCache* cache = nullptr            ///< optional cache of parsed meshes
     );
 
     /// Load tetrahedrons, if any, saved in a .inp file for Abaqus.
+    /// Only the corner nodes of 10-node tetrahedrons are used. Parsing and caching are as in FromTetGenFile.
     static void FromAbaqusFile(
         std::shared_ptr<ChMesh> mesh,                      ///< destination mesh
         const char* filename,                              ///< input file name
@@ -60,7 +67,8 @@ class ChApiFea ChMeshFileLoader {
         ChVector<> pos_transform = VNULL,              ///< optional displacement of imported mesh
         ChMatrix33<> rot_transform = ChMatrix33<>(1),  ///< optional rotation/scaling of imported mesh
         bool discard_unused_nodes =
-            true  ///< if true, Abaqus nodes that are not used in elements or sets are not imported in C::E
+            true,  ///< if true, Abaqus nodes that are not used in elements or sets are not imported in C::E
+        utils::ChGeometryCache* cache = nullptr  ///< optional cache of parsed meshes
     );
 
     static void ANCFShellFromGMFFile(
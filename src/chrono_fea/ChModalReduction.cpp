@@ -0,0 +1,334 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
+#include "chrono/core/ChLanczosEigenSolver.h"
+#include "chrono/core/ChSkylineMatrix.h"
+#include "chrono_fea/ChModalReduction.h"
+
+namespace chrono {
+namespace fea {
+
+// Symmetric sparse matrix assembled by rows; both triangles are stored.
+struct ReductionSparseRows {
+    std::vector<std::vector<std::pair<int, double>>> rows;
+
+    // Sort the entries of each row by column and sum the duplicates.
+    void Compress() {
+#pragma omp parallel for schedule(dynamic, 64)
+        for (int r = 0; r < (int)rows.size(); r++) {
+            auto& row = rows[r];
+            std::sort(row.begin(), row.end(),
+                      [](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.first < b.first; });
+            size_t last = 0;
+            for (size_t k = 1; k < row.size(); k++) {
+                if (row[k].first == row[last].first)
+                    row[last].second += row[k].second;
+                else
+                    row[++last] = row[k];
+            }
+            if (!row.empty())
+                row.resize(last + 1);
+        }
+    }
+};
+
+std::shared_ptr<ChElementCraigBampton> ChModalReduction::Reduce(
+    std::shared_ptr<ChMesh> reduced_mesh,
+    std::shared_ptr<ChMesh> mesh,
+    const std::vector<std::shared_ptr<ChNodeFEAxyz>>& boundary_nodes,
+    int num_modes) {
+    if (num_modes < 1)
+        throw ChException("ChModalReduction: at least one mode is needed.");
+
+    // Nodes of the mesh.
+    const auto& mesh_nodes = mesh->GetNodes();
+    int num_nodes = (int)mesh_nodes.size();
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes(num_nodes);
+    std::unordered_map<ChNodeFEAbase*, int> node_index;
+    for (int i = 0; i < num_nodes; i++) {
+        nodes[i] = std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh_nodes[i]);
+        if (!nodes[i])
+            throw ChException("ChModalReduction: only meshes of xyz nodes can be reduced.");
+        node_index[mesh_nodes[i].get()] = i;
+    }
+
+    // Boundary nodes: the given ones, then the fixed ones.
+    std::vector<bool> is_boundary(num_nodes, false);
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> boundary;
+    for (auto& node : boundary_nodes) {
+        auto found = node_index.find(node.get());
+        if (found == node_index.end())
+            throw ChException("ChModalReduction: a boundary node does not belong to the mesh.");
+        if (!is_boundary[found->second]) {
+            is_boundary[found->second] = true;
+            boundary.push_back(node);
+        }
+    }
+    for (int i = 0; i < num_nodes; i++) {
+        if (!is_boundary[i] && nodes[i]->GetFixed()) {
+            is_boundary[i] = true;
+            boundary.push_back(nodes[i]);
+        }
+    }
+    int nb = (int)boundary.size();
+
+    // Element connectivity.
+    const auto& elements = mesh->GetElements();
+    std::vector<std::vector<int>> element_nodes(elements.size());
+    for (size_t ie = 0; ie < elements.size(); ie++) {
+        for (int in = 0; in < elements[ie]->GetNnodes(); in++) {
+            auto found = node_index.find(elements[ie]->GetNodeN(in).get());
+            if (found == node_index.end() || elements[ie]->GetNodeNdofs(in) != 3)
+                throw ChException("ChModalReduction: an element uses a node which does not belong to the mesh.");
+            element_nodes[ie].push_back(found->second);
+        }
+    }
+
+    // Number the interior nodes in reverse Cuthill-McKee order, to keep the profile of their stiffness small.
+    std::vector<int> interior_index(num_nodes, -1);
+    int ni_nodes = 0;
+    for (int i = 0; i < num_nodes; i++) {
+        if (!is_boundary[i])
+            interior_index[i] = ni_nodes++;
+    }
+    if (ni_nodes == 0)
+        throw ChException("ChModalReduction: the mesh has no interior nodes.");
+    std::vector<std::vector<int>> adjacency(ni_nodes);
+    for (auto& enodes : element_nodes) {
+        for (int a : enodes) {
+            for (int b : enodes) {
+                if (a != b && interior_index[a] >= 0 && interior_index[b] >= 0)
+                    adjacency[interior_index[a]].push_back(interior_index[b]);
+            }
+        }
+    }
+    for (auto& neighbors : adjacency) {
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+    std::vector<int> order = ChSkylineMatrix::ReverseCuthillMcKee(adjacency);
+    std::vector<int> old_interior(ni_nodes);
+    for (int i = 0; i < num_nodes; i++) {
+        if (interior_index[i] >= 0)
+            old_interior[interior_index[i]] = i;
+    }
+
+    // Unknowns: the boundary displacements, then the interior ones.
+    std::vector<int> node_dof(num_nodes);
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> interior(ni_nodes);
+    for (int k = 0; k < nb; k++)
+        node_dof[node_index[boundary[k].get()]] = 3 * k;
+    for (int k = 0; k < ni_nodes; k++) {
+        int node = old_interior[order[k]];
+        node_dof[node] = 3 * (nb + k);
+        interior[k] = nodes[node];
+    }
+    int n_b = 3 * nb;
+    int n_i = 3 * ni_nodes;
+    int n = n_b + n_i;
+
+    // Assembly of the stiffness and mass matrices.
+    ReductionSparseRows K;
+    ReductionSparseRows M;
+    K.rows.resize(n);
+    M.rows.resize(n);
+    // The elements are set up in their initial configuration, and some of them need the system for that.
+    ChSystem* system = mesh->GetSystem();
+    if (!system)
+        throw ChException("ChModalReduction: the mesh to reduce must be added to a system.");
+    ChMatrixDynamic<> H;
+    for (size_t ie = 0; ie < elements.size(); ie++) {
+        auto& element = elements[ie];
+        element->SetupInitial(system);
+        element->Update();
+        int nd = element->GetNdofs();
+        for (int pass = 0; pass < 2; pass++) {
+            H.Reset(nd, nd);
+            if (pass == 0)
+                element->ComputeKRMmatricesGlobal(H, 1, 0, 0);
+            else
+                element->ComputeKRMmatricesGlobal(H, 0, 0, 1);
+            ReductionSparseRows& A = (pass == 0) ? K : M;
+            for (int a = 0; a < (int)element_nodes[ie].size(); a++) {
+                for (int ka = 0; ka < 3; ka++) {
+                    auto& row = A.rows[node_dof[element_nodes[ie][a]] + ka];
+                    for (int b = 0; b < (int)element_nodes[ie].size(); b++) {
+                        for (int kb = 0; kb < 3; kb++) {
+                            double value = H(3 * a + ka, 3 * b + kb);
+                            if (value != 0)
+                                row.push_back(std::make_pair(node_dof[element_nodes[ie][b]] + kb, value));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    // Lumped masses of the interior nodes only: the boundary nodes keep their own mass in the system.
+    for (int i = 0; i < num_nodes; i++) {
+        if (!is_boundary[i] && nodes[i]->GetMass()) {
+            for (int k = 0; k < 3; k++)
+                M.rows[node_dof[i] + k].push_back(std::make_pair(node_dof[i] + k, nodes[i]->GetMass()));
+        }
+    }
+    K.Compress();
+    M.Compress();
+
+    // Factorization of the interior stiffness.
+    std::vector<int> first_column(n_i);
+    for (int i = 0; i < n_i; i++) {
+        first_column[i] = i;
+        for (auto& entry : K.rows[n_b + i]) {
+            if (entry.first >= n_b) {
+                first_column[i] = std::min(first_column[i], entry.first - n_b);
+                break;
+            }
+        }
+    }
+    ChSkylineMatrix Kii;
+    Kii.Reset(first_column);
+    for (int i = 0; i < n_i; i++) {
+        for (auto& entry : K.rows[n_b + i]) {
+            if (entry.first >= n_b)
+                Kii.AddElement(i, entry.first - n_b, entry.second);
+        }
+    }
+    if (!Kii.Factorize())
+        throw ChException("ChModalReduction: the interior nodes are not restrained by the boundary nodes.");
+
+    // Static modes, Psi = -Kii^-1 * Kib.
+    ChMatrixDynamic<> Psi(n_i, n_b);
+    for (int i = 0; i < n_i; i++) {
+        for (auto& entry : K.rows[n_b + i]) {
+            if (entry.first < n_b)
+                Psi(i, entry.first) = -entry.second;
+        }
+    }
+    Kii.Solve(Psi);
+
+    // Fixed-interface modes, Kii * Phi = Mii * Phi * Lambda.
+    num_modes = std::min(num_modes, n_i);
+    ChLanczosEigenSolver eigen_solver;
+    ChVectorDynamic<> Lambda;
+    ChMatrixDynamic<> Phi;
+    int num_converged = eigen_solver.Solve(n_i,
+                                           [&](const ChVectorDynamic<>& x, ChVectorDynamic<>& y) {
+                                               y = x;
+                                               Kii.Solve(y);
+                                           },
+                                           [&](const ChVectorDynamic<>& x, ChVectorDynamic<>& y) {
+#pragma omp parallel for schedule(static)
+                                               for (int i = 0; i < n_i; i++) {
+                                                   double sum = 0;
+                                                   for (auto& entry : M.rows[n_b + i]) {
+                                                       if (entry.first >= n_b)
+                                                           sum += entry.second * x(entry.first - n_b);
+                                                   }
+                                                   y(i) = sum;
+                                               }
+                                           },
+                                           0, num_modes, Lambda, Phi);
+    if (num_converged < num_modes)
+        throw ChException("ChModalReduction: only " + std::to_string(num_converged) + " of " +
+                          std::to_string(num_modes) + " fixed-interface modes converged.");
+
+    // Reduced matrices, T' * K * T and T' * M * T with T = [I 0; Psi Phi].
+    int nr = n_b + num_modes;
+    ChMatrixDynamic<> Kr(nr, nr);
+    ChMatrixDynamic<> Mr(nr, nr);
+
+    // A = Mii * Psi + Mib
+    ChMatrixDynamic<> A(n_i, n_b);
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < n_i; i++) {
+        for (auto& entry : M.rows[n_b + i]) {
+            if (entry.first < n_b) {
+                A(i, entry.first) += entry.second;
+            } else {
+                for (int c = 0; c < n_b; c++)
+                    A(i, c) += entry.second * Psi(entry.first - n_b, c);
+            }
+        }
+    }
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int r = 0; r < n_b; r++) {
+        // Kbb + Kbi * Psi, Mbb + Mbi * Psi
+        for (auto& entry : K.rows[r]) {
+            if (entry.first < n_b) {
+                Kr(r, entry.first) += entry.second;
+            } else {
+                for (int c = 0; c < n_b; c++)
+                    Kr(r, c) += entry.second * Psi(entry.first - n_b, c);
+            }
+        }
+        for (auto& entry : M.rows[r]) {
+            if (entry.first < n_b) {
+                Mr(r, entry.first) += entry.second;
+            } else {
+                for (int c = 0; c < n_b; c++)
+                    Mr(r, c) += entry.second * Psi(entry.first - n_b, c);
+            }
+        }
+        // + Psi' * A
+        for (int i = 0; i < n_i; i++) {
+            double psi = Psi(i, r);
+            if (psi != 0)
+                for (int c = 0; c < n_b; c++)
+                    Mr(r, c) += psi * A(i, c);
+        }
+    }
+
+    // Phi' * A, Lambda, I
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int m = 0; m < num_modes; m++) {
+        for (int c = 0; c < n_b; c++) {
+            double sum = 0;
+            for (int i = 0; i < n_i; i++)
+                sum += Phi(i, m) * A(i, c);
+            Mr(n_b + m, c) = sum;
+            Mr(c, n_b + m) = sum;
+        }
+        Kr(n_b + m, n_b + m) = Lambda(m);
+        Mr(n_b + m, n_b + m) = 1;
+    }
+
+    // Remove the roundoff asymmetry of the boundary blocks.
+    for (int r = 0; r < n_b; r++) {
+        for (int c = r + 1; c < n_b; c++) {
+            double k = 0.5 * (Kr(r, c) + Kr(c, r));
+            Kr(r, c) = Kr(c, r) = k;
+            double m = 0.5 * (Mr(r, c) + Mr(c, r));
+            Mr(r, c) = Mr(c, r) = m;
+        }
+    }
+
+    // The superelement.
+    auto modal_node = std::make_shared<ChNodeFEAmodal>(num_modes);
+    auto element = std::make_shared<ChElementCraigBampton>();
+    element->SetNodes(boundary, modal_node);
+    element->SetReducedMatrices(Kr, Mr);
+    element->SetInteriorNodes(interior, Psi, Phi);
+    element->SetAutomaticGravity(mesh->GetAutomaticGravity());
+    for (auto& node : boundary)
+        reduced_mesh->AddNode(node);
+    reduced_mesh->AddNode(modal_node);
+    reduced_mesh->AddElement(element);
+
+    return element;
+}
+
+}  // end namespace fea
+}  // end namespace chrono
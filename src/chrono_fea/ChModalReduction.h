@@ -0,0 +1,59 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHMODALREDUCTION_H
+#define CHMODALREDUCTION_H
+
+#include "chrono_fea/ChElementCraigBampton.h"
+#include "chrono_fea/ChMesh.h"
+
+namespace chrono {
+namespace fea {
+
+/// @addtogroup fea_utils
+/// @{
+
+/// Craig-Bampton reduction of finite element meshes.
+class ChApiFea ChModalReduction {
+  public:
+    /// Replace a mesh of xyz nodes (e.g. tetrahedrons or hexahedrons) with a ChElementCraigBampton, whose
+    /// degrees of freedom are the positions of the boundary nodes and the amplitudes of the first
+    /// 'num_modes' fixed-interface modes. Fixed nodes are kept as boundary nodes too.
+    /// The stiffness and mass matrices are assembled from the elements and the nodal masses of the interior
+    /// nodes, in the current configuration of the mesh, which is assumed to be undeformed. The boundary nodes
+    /// keep their own nodal masses in the system, so these are not added to the element. The interior
+    /// stiffness matrix is factorized with a skyline LDL' solver in reverse Cuthill-McKee order, and the modes
+    /// are computed with the shift-invert Lanczos method, so meshes with tens of thousands of nodes can be
+    /// reduced.
+    /// The boundary nodes, a ChNodeFEAmodal and the element are added to 'reduced_mesh', which can replace
+    /// 'mesh' in the system; links and loads must act on the boundary nodes only. The other nodes are kept
+    /// by the element, to recover the deformed shape (see ChElementCraigBampton::UpdateInteriorNodes()).
+    /// The static modes are stored in a dense matrix of n_i x n_b doubles, n_i and n_b being three times the
+    /// numbers of interior and boundary nodes, which is kept by the element: for example, 30000 interior nodes
+    /// and 300 boundary nodes take 650 MB, so the boundary should be kept small.
+    /// Throws a ChException if the mesh is not in a system (its elements are set up with it), if the mesh
+    /// contains other kinds of nodes, or if the interior nodes are not restrained by the boundary nodes, or
+    /// if fewer than 'num_modes' modes converged.
+    static std::shared_ptr<ChElementCraigBampton> Reduce(
+        std::shared_ptr<ChMesh> reduced_mesh,                             ///< destination mesh
+        std::shared_ptr<ChMesh> mesh,                                     ///< mesh to reduce
+        const std::vector<std::shared_ptr<ChNodeFEAxyz>>& boundary_nodes, ///< interface nodes of the mesh
+        int num_modes                                                     ///< number of fixed-interface modes
+        );
+};
+
+/// @} fea_utils
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,137 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono_fea/ChNodeFEAmodal.h"
+
+namespace chrono {
+namespace fea {
+
+ChNodeFEAmodal::ChNodeFEAmodal(int num_modes)
+    : variables(num_modes), q(num_modes), q_dt(num_modes), q_dtdt(num_modes) {}
+
+ChNodeFEAmodal::ChNodeFEAmodal(const ChNodeFEAmodal& other)
+    : ChNodeFEAbase(other), variables(other.GetNumModes()) {
+    variables = other.variables;
+    q = other.q;
+    q_dt = other.q_dt;
+    q_dtdt = other.q_dtdt;
+}
+
+// -----------------------------------------------------------------------------
+
+ChNodeFEAmodal& ChNodeFEAmodal::operator=(const ChNodeFEAmodal& other) {
+    if (&other == this)
+        return *this;
+
+    ChNodeFEAbase::operator=(other);
+
+    variables = other.variables;
+    q = other.q;
+    q_dt = other.q_dt;
+    q_dtdt = other.q_dtdt;
+    return *this;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChNodeFEAmodal::Relax() {
+    q.FillElem(0);
+    SetNoSpeedNoAcceleration();
+}
+
+void ChNodeFEAmodal::SetNoSpeedNoAcceleration() {
+    q_dt.FillElem(0);
+    q_dtdt.FillElem(0);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChNodeFEAmodal::NodeIntStateGather(const unsigned int off_x,
+                                        ChState& x,
+                                        const unsigned int off_v,
+                                        ChStateDelta& v,
+                                        double& T) {
+    x.PasteMatrix(q, off_x, 0);
+    v.PasteMatrix(q_dt, off_v, 0);
+}
+
+void ChNodeFEAmodal::NodeIntStateScatter(const unsigned int off_x,
+                                         const ChState& x,
+                                         const unsigned int off_v,
+                                         const ChStateDelta& v,
+                                         const double T) {
+    q.PasteClippedMatrix(x, off_x, 0, GetNumModes(), 1, 0, 0);
+    q_dt.PasteClippedMatrix(v, off_v, 0, GetNumModes(), 1, 0, 0);
+}
+
+void ChNodeFEAmodal::NodeIntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
+    a.PasteMatrix(q_dtdt, off_a, 0);
+}
+
+void ChNodeFEAmodal::NodeIntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
+    q_dtdt.PasteClippedMatrix(a, off_a, 0, GetNumModes(), 1, 0, 0);
+}
+
+void ChNodeFEAmodal::NodeIntLoadResidual_Mv(const unsigned int off,
+                                            ChVectorDynamic<>& R,
+                                            const ChVectorDynamic<>& w,
+                                            const double c) {
+    // identity mass matrix
+    for (int i = 0; i < GetNumModes(); i++)
+        R(off + i) += c * w(off + i);
+}
+
+void ChNodeFEAmodal::NodeIntToDescriptor(const unsigned int off_v, const ChStateDelta& v, const ChVectorDynamic<>& R) {
+    variables.Get_qb().PasteClippedMatrix(v, off_v, 0, GetNumModes(), 1, 0, 0);
+    variables.Get_fb().PasteClippedMatrix(R, off_v, 0, GetNumModes(), 1, 0, 0);
+}
+
+void ChNodeFEAmodal::NodeIntFromDescriptor(const unsigned int off_v, ChStateDelta& v) {
+    v.PasteMatrix(variables.Get_qb(), off_v, 0);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChNodeFEAmodal::InjectVariables(ChSystemDescriptor& mdescriptor) {
+    mdescriptor.InsertVariables(&variables);
+}
+
+void ChNodeFEAmodal::VariablesFbReset() {
+    variables.Get_fb().FillElem(0.0);
+}
+
+void ChNodeFEAmodal::VariablesQbLoadSpeed() {
+    variables.Get_qb().CopyFromMatrix(q_dt);
+}
+
+void ChNodeFEAmodal::VariablesQbSetSpeed(double step) {
+    ChVectorDynamic<> old_dt(q_dt);
+    q_dt.CopyFromMatrix(variables.Get_qb());
+
+    // Compute accelerations by backward differentiation, if step is not 0
+    if (step) {
+        q_dtdt.MatrSub(q_dt, old_dt);
+        q_dtdt.MatrScale(1 / step);
+    }
+}
+
+void ChNodeFEAmodal::VariablesFbIncrementMq() {
+    variables.Compute_inc_Mb_v(variables.Get_fb(), variables.Get_qb());
+}
+
+void ChNodeFEAmodal::VariablesQbIncrementPosition(double step) {
+    for (int i = 0; i < GetNumModes(); i++)
+        q(i) += variables.Get_qb()(i) * step;
+}
+
+}  // end namespace fea
+}  // end namespace chrono
@@ -0,0 +1,114 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHNODEFEAMODAL_H
+#define CHNODEFEAMODAL_H
+
+#include "chrono/solver/ChVariablesGeneric.h"
+#include "chrono_fea/ChNodeFEAbase.h"
+
+namespace chrono {
+namespace fea {
+
+/// Class for a node holding the modal coordinates of a reduced-order flexible body (see
+/// ChElementCraigBampton). The coordinates are the amplitudes of mass-normalized modes, so the
+/// node has an identity mass matrix; the coupling with the other nodes is provided by the element.
+class ChApiFea ChNodeFEAmodal : public ChNodeFEAbase {
+  public:
+    ChNodeFEAmodal(int num_modes = 1);
+    ChNodeFEAmodal(const ChNodeFEAmodal& other);
+    ~ChNodeFEAmodal() {}
+
+    ChNodeFEAmodal& operator=(const ChNodeFEAmodal& other);
+
+    virtual ChVariablesGeneric& Variables() { return variables; }
+
+    /// Reset the modal coordinates, i.e. the current shape becomes the undeformed one.
+    virtual void Relax() override;
+
+    /// Reset to no speed and acceleration.
+    virtual void SetNoSpeedNoAcceleration() override;
+
+    /// Set the 'fixed' state of the node.
+    virtual void SetFixed(bool mev) override { variables.SetDisabled(mev); }
+    /// Get the 'fixed' state of the node.
+    virtual bool GetFixed() override { return variables.IsDisabled(); }
+
+    /// Number of modes.
+    int GetNumModes() const { return q.GetRows(); }
+
+    /// Get the modal coordinates.
+    const ChVectorDynamic<>& GetModalCoordinates() const { return q; }
+    /// Set the modal coordinates.
+    void SetModalCoordinates(const ChVectorDynamic<>& mq) { q = mq; }
+
+    /// Get the time derivatives of the modal coordinates.
+    const ChVectorDynamic<>& GetModalSpeeds() const { return q_dt; }
+    /// Set the time derivatives of the modal coordinates.
+    void SetModalSpeeds(const ChVectorDynamic<>& mq_dt) { q_dt = mq_dt; }
+
+    /// Get the second time derivatives of the modal coordinates.
+    const ChVectorDynamic<>& GetModalAccelerations() const { return q_dtdt; }
+
+    /// Get the number of degrees of freedom
+    virtual int Get_ndof_x() const override { return q.GetRows(); }
+
+    //
+    // Functions for interfacing to the state bookkeeping
+    //
+
+    virtual void NodeIntStateGather(const unsigned int off_x,
+                                    ChState& x,
+                                    const unsigned int off_v,
+                                    ChStateDelta& v,
+                                    double& T) override;
+    virtual void NodeIntStateScatter(const unsigned int off_x,
+                                     const ChState& x,
+                                     const unsigned int off_v,
+                                     const ChStateDelta& v,
+                                     const double T) override;
+    virtual void NodeIntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) override;
+    virtual void NodeIntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) override;
+    virtual void NodeIntLoadResidual_Mv(const unsigned int off,
+                                        ChVectorDynamic<>& R,
+                                        const ChVectorDynamic<>& w,
+                                        const double c) override;
+    virtual void NodeIntToDescriptor(const unsigned int off_v,
+                                     const ChStateDelta& v,
+                                     const ChVectorDynamic<>& R) override;
+    virtual void NodeIntFromDescriptor(const unsigned int off_v, ChStateDelta& v) override;
+
+    //
+    // Functions for interfacing to the solver
+    //
+
+    virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
+
+    virtual void VariablesFbReset() override;
+
+    virtual void VariablesFbLoadForces(double factor = 1) override {}
+    virtual void VariablesQbLoadSpeed() override;
+    virtual void VariablesQbSetSpeed(double step = 0) override;
+    virtual void VariablesFbIncrementMq() override;
+    virtual void VariablesQbIncrementPosition(double step) override;
+
+  private:
+    ChVariablesGeneric variables;  ///< solver proxy: modal coordinates
+    ChVectorDynamic<> q;           ///< modal coordinates
+    ChVectorDynamic<> q_dt;        ///< modal speeds
+    ChVectorDynamic<> q_dtdt;      ///< modal accelerations
+};
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
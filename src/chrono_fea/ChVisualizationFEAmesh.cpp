@@ -62,6 +62,14 @@ ChVisualizationFEAmesh::ChVisualizationFEAmesh(ChMesh& mymesh) {
 
     undeformed_reference = false;
 
+    update_enabled = true;
+    update_stride = 1;
+    update_counter = 0;
+
+    topology_revision = 0;
+    automatic_smoothing = true;
+    buffer_size = {0, 0, 0, 0};
+
     auto new_mesh_asset = std::make_shared<ChTriangleMeshShape>();
     this->AddAsset(new_mesh_asset);
 
@@ -84,9 +92,7 @@ ChVector<float> ChVisualizationFEAmesh::ComputeFalseColor(double mv) {
     return vc;
 }
 
-double ChVisualizationFEAmesh::ComputeScalarOutput(std::shared_ptr<ChNodeFEAxyz> mnode,
-                                                   int nodeID,
-                                                   std::shared_ptr<ChElementBase> melement) {
+double ChVisualizationFEAmesh::ComputeScalarOutput(ChNodeFEAxyz* mnode, int nodeID, ChElementBase* melement) {
     switch (this->fem_data_type) {
         case E_PLOT_SURFACE:
             return 1e30;  // to force 'white' in false color scale. Hack, to be improved.
@@ -115,19 +121,19 @@ double ChVisualizationFEAmesh::ComputeScalarOutput(std::shared_ptr<ChNodeFEAxyz>
         case E_PLOT_NODE_ACCEL_Z:
             return mnode->GetPos_dtdt().z();
         case E_PLOT_ELEM_STRAIN_VONMISES:
-            if (auto mytetra = std::dynamic_pointer_cast<ChElementTetra_4>(melement)) {
+            if (auto mytetra = dynamic_cast<ChElementTetra_4*>(melement)) {
                 return mytetra->GetStrain().GetEquivalentVonMises();
             }
         case E_PLOT_ELEM_STRESS_VONMISES:
-            if (auto mytetra = std::dynamic_pointer_cast<ChElementTetra_4>(melement)) {
+            if (auto mytetra = dynamic_cast<ChElementTetra_4*>(melement)) {
                 return mytetra->GetStress().GetEquivalentVonMises();
             }
         case E_PLOT_ELEM_STRAIN_HYDROSTATIC:
-            if (auto mytetra = std::dynamic_pointer_cast<ChElementTetra_4>(melement)) {
+            if (auto mytetra = dynamic_cast<ChElementTetra_4*>(melement)) {
                 return mytetra->GetStrain().GetEquivalentMeanHydrostatic();
             }
         case E_PLOT_ELEM_STRESS_HYDROSTATIC:
-            if (auto mytetra = std::dynamic_pointer_cast<ChElementTetra_4>(melement)) {
+            if (auto mytetra = dynamic_cast<ChElementTetra_4*>(melement)) {
                 return mytetra->GetStress().GetEquivalentMeanHydrostatic();
             }
         default:
@@ -137,9 +143,7 @@ double ChVisualizationFEAmesh::ComputeScalarOutput(std::shared_ptr<ChNodeFEAxyz>
     return 0;
 }
 
-double ChVisualizationFEAmesh::ComputeScalarOutput(std::shared_ptr<ChNodeFEAxyzP> mnode,
-                                                   int nodeID,
-                                                   std::shared_ptr<ChElementBase> melement) {
+double ChVisualizationFEAmesh::ComputeScalarOutput(ChNodeFEAxyzP* mnode, int nodeID, ChElementBase* melement) {
     switch (this->fem_data_type) {
         case E_PLOT_SURFACE:
             return 1e30;  // to force 'white' in false color scale. Hack, to be improved.
@@ -164,48 +168,22 @@ ChVector<float>& FetchOrAllocate(std::vector<ChVector<float>>& mvector, unsigned
     return mvector[id - 1];
 }
 
-void TriangleNormalsReset(std::vector<ChVector<>>& normals, std::vector<int>& accumul) {
-    for (unsigned int nn = 0; nn < normals.size(); ++nn) {
-        normals[nn] = ChVector<>(0, 0, 0);
-        accumul[nn] = 0;
-    }
-}
-void TriangleNormalsCompute(ChVector<int> norm_indexes,
-                            ChVector<int> vert_indexes,
-                            std::vector<ChVector<>>& vertexes,
-                            std::vector<ChVector<>>& normals,
-                            std::vector<int>& accumul) {
-    ChVector<> tnorm =
-        Vcross(vertexes[vert_indexes.y()] - vertexes[vert_indexes.x()], vertexes[vert_indexes.z()] - vertexes[vert_indexes.x()])
-            .GetNormalized();
-    normals[norm_indexes.x()] += tnorm;
-    normals[norm_indexes.y()] += tnorm;
-    normals[norm_indexes.z()] += tnorm;
-    accumul[norm_indexes.x()] += 1;
-    accumul[norm_indexes.y()] += 1;
-    accumul[norm_indexes.z()] += 1;
-}
-void TriangleNormalsSmooth(std::vector<ChVector<>>& normals, std::vector<int>& accumul) {
-    for (unsigned int nn = 0; nn < normals.size(); ++nn) {
-        normals[nn] = normals[nn] * (1.0 / (double)accumul[nn]);
-    }
-}
-
 // Helper function for updating visualization mesh buffers for hex elements.
-void ChVisualizationFEAmesh::UpdateBuffers_Hex(std::shared_ptr<ChElementBase> element,
+void ChVisualizationFEAmesh::UpdateBuffers_Hex(ChElementBase* element,
                                                geometry::ChTriangleMeshConnected& trianglemesh,
                                                unsigned int& i_verts,
                                                unsigned int& i_vnorms,
                                                unsigned int& i_vcols,
-                                               unsigned int& i_triindex) {
+                                               unsigned int& i_triindex,
+                                               bool update_indices) {
     unsigned int ivert_el = i_verts;
     unsigned int inorm_el = i_vnorms;
 
-    std::shared_ptr<ChNodeFEAxyz> nodes[8];
+    ChNodeFEAxyz* nodes[8];
     ChVector<> pt[8];
 
     for (int in = 0; in < 8; ++in) {
-        nodes[in] = std::static_pointer_cast<ChNodeFEAxyz>(element->GetNodeN(in));
+        nodes[in] = static_cast<ChNodeFEAxyz*>(element->GetNodeN(in).get());
         if (!undeformed_reference)
             pt[in] = nodes[in]->GetPos();
         else
@@ -234,6 +212,9 @@ void ChVisualizationFEAmesh::UpdateBuffers_Hex(std::shared_ptr<ChElementBase> el
         ++i_vcols;
     }
 
+    if (!update_indices)
+        return;
+
     // faces indexes
     ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
     trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 2, 1) + ivert_offset;
@@ -284,6 +265,10 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
     if (!this->FEMmesh)
         return;
 
+    // Skip the update if disabled, or if this is not one of every 'update_stride' calls.
+    if (!update_enabled || update_counter++ % update_stride != 0)
+        return;
+
     std::shared_ptr<ChTriangleMeshShape> mesh_asset;
     std::shared_ptr<ChGlyphs> glyphs_asset;
 
@@ -307,158 +292,224 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
     }
     geometry::ChTriangleMeshConnected& trianglemesh = mesh_asset->GetMesh();
 
-    size_t n_verts = 0;
-    size_t n_vcols = 0;
-    size_t n_vnorms = 0;
-    size_t n_triangles = 0;
+    bool draw_elements = this->fem_data_type != E_PLOT_NONE && this->fem_data_type != E_PLOT_LOADSURFACES &&
+                         this->fem_data_type != E_PLOT_CONTACTSURFACES;
 
     //
     // A - Count the needed vertexes and faces
     //
 
-    //   In case of colormap drawing:
-    //
-    if (this->fem_data_type != E_PLOT_NONE && this->fem_data_type != E_PLOT_LOADSURFACES &&
-        this->fem_data_type != E_PLOT_CONTACTSURFACES) {
-        for (unsigned int iel = 0; iel < this->FEMmesh->GetNelements(); ++iel) {
-            if (std::dynamic_pointer_cast<ChElementTetra_4>(this->FEMmesh->GetElement(iel))) {
-                // ELEMENT IS A TETRAHEDRON
-                n_verts += 4;
-                n_vcols += 4;
-                n_vnorms += 4;     // flat faces
-                n_triangles += 4;  // n. triangle faces
-            } else if (std::dynamic_pointer_cast<ChElementTetra_4_P>(this->FEMmesh->GetElement(iel))) {
-                // ELEMENT IS A TETRAHEDRON for scalar field
-                n_verts += 4;
-                n_vcols += 4;
-                n_vnorms += 4;     // flat faces
-                n_triangles += 4;  // n. triangle faces
-            } else if (std::dynamic_pointer_cast<ChElementHexa_8>(FEMmesh->GetElement(iel)) ||
-                       std::dynamic_pointer_cast<ChElementBrick>(FEMmesh->GetElement(iel)) ||
-                       std::dynamic_pointer_cast<ChElementBrick_9>(FEMmesh->GetElement(iel))) {
-                // ELEMENT IS A HEXAHEDRON
-                n_verts += 8;
-                n_vcols += 8;
-                n_vnorms += 24;
-                n_triangles += 12;  // n. triangle faces
-            } else if (std::dynamic_pointer_cast<ChElementBeam>(this->FEMmesh->GetElement(iel))) {
-                // ELEMENT IS A BEAM
-                bool m_circular = false;
-                // downcasting
-                if (auto mybeameuler = std::dynamic_pointer_cast<ChElementBeamEuler>(this->FEMmesh->GetElement(iel))) {
-                    if (mybeameuler->GetSection()->IsCircular())
-                        m_circular = true;
-                } else if (auto mybeamancf =
-                               std::dynamic_pointer_cast<ChElementCableANCF>(this->FEMmesh->GetElement(iel))) {
-                    if (mybeamancf->GetSection()->IsCircular())
-                        m_circular = true;
-                }
-                if (m_circular) {
-                    n_verts += beam_resolution_section * beam_resolution;
-                    n_vcols += beam_resolution_section * beam_resolution;
-                    n_vnorms += beam_resolution_section * beam_resolution;
-                    n_triangles += 2 * beam_resolution_section * (beam_resolution - 1);  // n. triangle faces
-                } else {                                                                 // rectangular
-                    n_verts += 4 * beam_resolution;
-                    n_vcols += 4 * beam_resolution;
-                    n_vnorms += 8 * beam_resolution;
-                    n_triangles += 8 * (beam_resolution - 1);  // n. triangle faces
-                }
-            } else if (std::dynamic_pointer_cast<ChElementShell>(this->FEMmesh->GetElement(iel))) {
-                // ELEMENT IS A SHELL
-                n_verts += shell_resolution * shell_resolution;
-                n_vcols += shell_resolution * shell_resolution;
-                n_vnorms += shell_resolution * shell_resolution;
-                n_triangles += 2 * (shell_resolution - 1) * (shell_resolution - 1);  // n. triangle faces
-            }
-
-            //***TO DO*** other types of elements...
-        }
+    // The layout of the buffers (range of each element, face indexes) depends only on the topology of the mesh
+    // and on the drawing settings: it is rebuilt only if these changed, otherwise only vertexes, normals and
+    // colors are refreshed. Topology changes are detected with the revision counter of the mesh; the sizes of
+    // the surfaces are also checked, because their faces can be added without the mesh knowing.
+    std::vector<uintptr_t> key;
+    key.reserve(this->FEMmesh->GetNmeshSurfaces() + this->FEMmesh->GetNcontactSurfaces() + 5);
+    key.push_back(this->fem_data_type);
+    key.push_back(this->beam_resolution);
+    key.push_back(this->beam_resolution_section);
+    key.push_back(this->shell_resolution);
+    key.push_back(this->smooth_faces);
+    for (unsigned int isu = 0; isu < this->FEMmesh->GetNmeshSurfaces(); ++isu)
+        key.push_back(this->FEMmesh->GetMeshSurface(isu)->GetFacesList().size());
+    for (unsigned int isu = 0; isu < this->FEMmesh->GetNcontactSurfaces(); ++isu) {
+        if (auto msurface = std::dynamic_pointer_cast<ChContactSurfaceMesh>(this->FEMmesh->GetContactSurface(isu)))
+            key.push_back(msurface->GetTriangleList().size());
+        else
+            key.push_back(0);
     }
 
-    //   In case mesh surfaces for pressure loads etc.:
-    //
-    if (this->fem_data_type == E_PLOT_LOADSURFACES) {
-        for (unsigned int isu = 0; isu < this->FEMmesh->GetNmeshSurfaces(); ++isu) {
-            std::shared_ptr<ChMeshSurface> msurface = this->FEMmesh->GetMeshSurface(isu);
-            for (unsigned int ifa = 0; ifa < msurface->GetFacesList().size(); ++ifa) {
-                std::shared_ptr<ChLoadableUV> mface = msurface->GetFacesList()[ifa];
-                if (std::dynamic_pointer_cast<ChFaceTetra_4>(mface)) {
-                    // FACE ELEMENT IS A TETRAHEDRON FACE
-                    n_verts += 3;
-                    n_vcols += 3;
-                    n_vnorms += 1;     // flat face
-                    n_triangles += 1;  // n. triangle faces
-                } else if (std::dynamic_pointer_cast<ChElementTetra_4_P>(mface)) {
-                    // FACE ELEMENT IS A SHELL
+    bool update_indices = this->FEMmesh->GetTopologyRevision() != topology_revision || key != layout_key ||
+                          trianglemesh.getCoordsVertices().size() != buffer_size.verts ||
+                          trianglemesh.getCoordsColors().size() != buffer_size.vcols ||
+                          trianglemesh.getIndicesVertexes().size() != buffer_size.triangles;
+
+    if (update_indices) {
+        topology_revision = this->FEMmesh->GetTopologyRevision();
+        layout_key.swap(key);
+        automatic_smoothing = true;
+
+        unsigned int n_verts = 0;
+        unsigned int n_vcols = 0;
+        unsigned int n_vnorms = 0;
+        unsigned int n_triangles = 0;
+
+        //   In case of colormap drawing:
+        //
+        elements.clear();
+        element_kinds.clear();
+        element_offsets.clear();
+        if (draw_elements) {
+            elements.resize(this->FEMmesh->GetNelements());
+            element_kinds.resize(this->FEMmesh->GetNelements());
+            element_offsets.resize(this->FEMmesh->GetNelements());
+            for (unsigned int iel = 0; iel < this->FEMmesh->GetNelements(); ++iel) {
+                std::shared_ptr<ChElementBase> element = this->FEMmesh->GetElement(iel);
+                elements[iel] = element.get();
+                element_kinds[iel] = ELEM_NONE;
+                element_offsets[iel] = {n_verts, n_vcols, n_vnorms, n_triangles};
+                if (std::dynamic_pointer_cast<ChElementTetra_4>(element)) {
+                    // ELEMENT IS A TETRAHEDRON
+                    element_kinds[iel] = ELEM_TETRA_4;
+                    n_verts += 4;
+                    n_vcols += 4;
+                    n_vnorms += 4;     // flat faces
+                    n_triangles += 4;  // n. triangle faces
+                } else if (std::dynamic_pointer_cast<ChElementTetra_4_P>(element)) {
+                    // ELEMENT IS A TETRAHEDRON for scalar field
+                    element_kinds[iel] = ELEM_TETRA_4_P;
+                    n_verts += 4;
+                    n_vcols += 4;
+                    n_vnorms += 4;     // flat faces
+                    n_triangles += 4;  // n. triangle faces
+                } else if (std::dynamic_pointer_cast<ChElementHexa_8>(element) ||
+                           std::dynamic_pointer_cast<ChElementBrick>(element) ||
+                           std::dynamic_pointer_cast<ChElementBrick_9>(element)) {
+                    // ELEMENT IS A HEXAHEDRON
+                    element_kinds[iel] = ELEM_HEXA;
+                    n_verts += 8;
+                    n_vcols += 8;
+                    n_vnorms += 24;
+                    n_triangles += 12;  // n. triangle faces
+                } else if (std::dynamic_pointer_cast<ChElementBeam>(element)) {
+                    // ELEMENT IS A BEAM
+                    bool m_circular = false;
+                    // downcasting
+                    element_kinds[iel] = ELEM_BEAM;
+                    if (auto mybeameuler = std::dynamic_pointer_cast<ChElementBeamEuler>(element)) {
+                        element_kinds[iel] = ELEM_BEAM_EULER;
+                        if (mybeameuler->GetSection()->IsCircular())
+                            m_circular = true;
+                    } else if (auto mybeamancf = std::dynamic_pointer_cast<ChElementCableANCF>(element)) {
+                        element_kinds[iel] = ELEM_CABLE_ANCF;
+                        if (mybeamancf->GetSection()->IsCircular())
+                            m_circular = true;
+                    }
+                    if (m_circular) {
+                        // no need to compute normals later with TriangleNormalsCompute
+                        automatic_smoothing = false;
+                        n_verts += beam_resolution_section * beam_resolution;
+                        n_vcols += beam_resolution_section * beam_resolution;
+                        n_vnorms += beam_resolution_section * beam_resolution;
+                        n_triangles += 2 * beam_resolution_section * (beam_resolution - 1);  // n. triangle faces
+                    } else {                                                                 // rectangular
+                        n_verts += 4 * beam_resolution;
+                        n_vcols += 4 * beam_resolution;
+                        n_vnorms += 8 * beam_resolution;
+                        n_triangles += 8 * (beam_resolution - 1);  // n. triangle faces
+                    }
+                } else if (std::dynamic_pointer_cast<ChElementShell>(element)) {
+                    // ELEMENT IS A SHELL
+                    element_kinds[iel] = ELEM_SHELL;
                     n_verts += shell_resolution * shell_resolution;
                     n_vcols += shell_resolution * shell_resolution;
                     n_vnorms += shell_resolution * shell_resolution;
                     n_triangles += 2 * (shell_resolution - 1) * (shell_resolution - 1);  // n. triangle faces
                 }
+
+                //***TO DO*** other types of elements...
             }
         }
-    }
 
-    //   In case of contact surfaces:
-    //
-    if (this->fem_data_type == E_PLOT_CONTACTSURFACES) {
-        for (unsigned int isu = 0; isu < this->FEMmesh->GetNcontactSurfaces(); ++isu) {
-            if (auto msurface =
-                    std::dynamic_pointer_cast<ChContactSurfaceMesh>(this->FEMmesh->GetContactSurface(isu))) {
-                n_verts += 3 * msurface->GetTriangleList().size();
-                n_vcols += 3 * msurface->GetTriangleList().size();
-                n_vnorms += msurface->GetTriangleList().size();     // flat faces
-                n_triangles += msurface->GetTriangleList().size();  // n. triangle faces
+        //   In case mesh surfaces for pressure loads etc.:
+        //
+        load_faces.clear();
+        if (this->fem_data_type == E_PLOT_LOADSURFACES) {
+            for (unsigned int isu = 0; isu < this->FEMmesh->GetNmeshSurfaces(); ++isu) {
+                std::shared_ptr<ChMeshSurface> msurface = this->FEMmesh->GetMeshSurface(isu);
+                for (unsigned int ifa = 0; ifa < msurface->GetFacesList().size(); ++ifa) {
+                    std::shared_ptr<ChLoadableUV> mface = msurface->GetFacesList()[ifa];
+                    if (auto mfacetetra = std::dynamic_pointer_cast<ChFaceTetra_4>(mface)) {
+                        // FACE ELEMENT IS A TETRAHEDRON FACE
+                        LoadFace face;
+                        for (int in = 0; in < 3; ++in)
+                            face.nodes[in] = mfacetetra->GetNodeN(in).get();
+                        face.offsets = {n_verts, n_vcols, n_vnorms, n_triangles};
+                        load_faces.push_back(face);
+                        n_verts += 3;
+                        n_vcols += 3;
+                        n_vnorms += 1;     // flat face
+                        n_triangles += 1;  // n. triangle faces
+                    } else if (std::dynamic_pointer_cast<ChElementTetra_4_P>(mface)) {
+                        // FACE ELEMENT IS A SHELL
+                        n_verts += shell_resolution * shell_resolution;
+                        n_vcols += shell_resolution * shell_resolution;
+                        n_vnorms += shell_resolution * shell_resolution;
+                        n_triangles += 2 * (shell_resolution - 1) * (shell_resolution - 1);  // n. triangle faces
+                    }
+                }
             }
         }
+
+        //   In case of contact surfaces:
+        //
+        surface_offsets.clear();
+        if (this->fem_data_type == E_PLOT_CONTACTSURFACES) {
+            surface_offsets.resize(this->FEMmesh->GetNcontactSurfaces());
+            for (unsigned int isu = 0; isu < this->FEMmesh->GetNcontactSurfaces(); ++isu) {
+                surface_offsets[isu] = {n_verts, n_vcols, n_vnorms, n_triangles};
+                if (auto msurface =
+                        std::dynamic_pointer_cast<ChContactSurfaceMesh>(this->FEMmesh->GetContactSurface(isu))) {
+                    n_verts += 3 * msurface->GetTriangleList().size();
+                    n_vcols += 3 * msurface->GetTriangleList().size();
+                    n_vnorms += msurface->GetTriangleList().size();     // flat faces
+                    n_triangles += msurface->GetTriangleList().size();  // n. triangle faces
+                }
+            }
+        }
+
+        buffer_size = {n_verts, n_vcols, n_vnorms, n_triangles};
     }
 
     //
     // B - resize mesh buffers if needed
     //
 
-    if (trianglemesh.getCoordsVertices().size() != n_verts)
-        trianglemesh.getCoordsVertices().resize(n_verts);
-    if (trianglemesh.getCoordsColors().size() != n_vcols)
-        trianglemesh.getCoordsColors().resize(n_vcols);
-    if (trianglemesh.getIndicesVertexes().size() != n_triangles)
-        trianglemesh.getIndicesVertexes().resize(n_triangles);
+    if (trianglemesh.getCoordsVertices().size() != buffer_size.verts)
+        trianglemesh.getCoordsVertices().resize(buffer_size.verts);
+    if (trianglemesh.getCoordsColors().size() != buffer_size.vcols)
+        trianglemesh.getCoordsColors().resize(buffer_size.vcols);
+    if (trianglemesh.getIndicesVertexes().size() != buffer_size.triangles)
+        trianglemesh.getIndicesVertexes().resize(buffer_size.triangles);
 
     if (this->smooth_faces) {
-        if (trianglemesh.getCoordsNormals().size() != n_vnorms)
-            trianglemesh.getCoordsNormals().resize(n_vnorms);
-        if (trianglemesh.getIndicesNormals().size() != n_triangles)
-            trianglemesh.getIndicesNormals().resize(n_triangles);
-        if (normal_accumulators.size() != n_vnorms)
-            normal_accumulators.resize(n_vnorms);
-
-        TriangleNormalsReset(trianglemesh.getCoordsNormals(), normal_accumulators);
+        if (trianglemesh.getCoordsNormals().size() != buffer_size.vnorms)
+            trianglemesh.getCoordsNormals().resize(buffer_size.vnorms);
+        if (trianglemesh.getIndicesNormals().size() != buffer_size.triangles)
+            trianglemesh.getIndicesNormals().resize(buffer_size.triangles);
+
+        // Normals are either all computed by smoothing (see below) or written by the elements.
+        if (!automatic_smoothing)
+            std::fill(trianglemesh.getCoordsNormals().begin(), trianglemesh.getCoordsNormals().end(), VNULL);
     }
 
     //
     // C - update mesh buffers
     //
 
-    bool need_automatic_smoothing = this->smooth_faces;
-
-    unsigned int i_verts = 0;
-    unsigned int i_vcols = 0;
-    unsigned int i_vnorms = 0;
-    unsigned int i_triindex = 0;
-    unsigned int i_normindex = 0;
+    bool need_automatic_smoothing = this->smooth_faces && automatic_smoothing;
 
     //   In case of colormap drawing:
-    if (this->fem_data_type != E_PLOT_NONE && this->fem_data_type != E_PLOT_LOADSURFACES &&
-        this->fem_data_type != E_PLOT_CONTACTSURFACES) {
-        for (unsigned int iel = 0; iel < this->FEMmesh->GetNelements(); ++iel) {
+    //   (each element writes its own range of the buffers, so elements are processed in parallel)
+    if (draw_elements) {
+        int n_elements = (int)elements.size();
+#pragma omp parallel for schedule(dynamic, 16)
+        for (int iel = 0; iel < n_elements; ++iel) {
+            unsigned int i_verts = element_offsets[iel].verts;
+            unsigned int i_vcols = element_offsets[iel].vcols;
+            unsigned int i_vnorms = element_offsets[iel].vnorms;
+            unsigned int i_triindex = element_offsets[iel].triangles;
+            ChElementBase* element = elements[iel];
+            eChElementKind kind = element_kinds[iel];
+
             // ------------ELEMENT IS A TETRAHEDRON 4 NODES?
 
-            if (auto mytetra = std::dynamic_pointer_cast<ChElementTetra_4>(this->FEMmesh->GetElement(iel))) {
-                auto node0 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(0));
-                auto node1 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(1));
-                auto node2 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(2));
-                auto node3 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(3));
+            if (kind == ELEM_TETRA_4) {
+                auto mytetra = static_cast<ChElementTetra_4*>(element);
+                auto node0 = static_cast<ChNodeFEAxyz*>(mytetra->GetNodeN(0).get());
+                auto node1 = static_cast<ChNodeFEAxyz*>(mytetra->GetNodeN(1).get());
+                auto node2 = static_cast<ChNodeFEAxyz*>(mytetra->GetNodeN(2).get());
+                auto node3 = static_cast<ChNodeFEAxyz*>(mytetra->GetNodeN(3).get());
 
                 unsigned int ivert_el = i_verts;
                 unsigned int inorm_el = i_vnorms;
@@ -493,18 +544,21 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
 
                 // color
                 trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node0, 0, this->FEMmesh->GetElement(iel)));
+                    ComputeFalseColor(ComputeScalarOutput(node0, 0, element));
                 ++i_vcols;
                 trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node1, 1, this->FEMmesh->GetElement(iel)));
+                    ComputeFalseColor(ComputeScalarOutput(node1, 1, element));
                 ++i_vcols;
                 trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node2, 2, this->FEMmesh->GetElement(iel)));
+                    ComputeFalseColor(ComputeScalarOutput(node2, 2, element));
                 ++i_vcols;
                 trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node3, 3, this->FEMmesh->GetElement(iel)));
+                    ComputeFalseColor(ComputeScalarOutput(node3, 3, element));
                 ++i_vcols;
 
+                if (!update_indices)
+                    continue;
+
                 // faces indexes
                 ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
                 trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 1, 2) + ivert_offset;
@@ -529,11 +583,12 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
 
             // ------------ELEMENT IS A TETRAHEDRON 4 NODES -for SCALAR field- ?
 
-            if (auto mytetra = std::dynamic_pointer_cast<ChElementTetra_4_P>(this->FEMmesh->GetElement(iel))) {
-                auto node0 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(0));
-                auto node1 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(1));
-                auto node2 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(2));
-                auto node3 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(3));
+            if (kind == ELEM_TETRA_4_P) {
+                auto mytetra = static_cast<ChElementTetra_4_P*>(element);
+                auto node0 = static_cast<ChNodeFEAxyzP*>(mytetra->GetNodeN(0).get());
+                auto node1 = static_cast<ChNodeFEAxyzP*>(mytetra->GetNodeN(1).get());
+                auto node2 = static_cast<ChNodeFEAxyzP*>(mytetra->GetNodeN(2).get());
+                auto node3 = static_cast<ChNodeFEAxyzP*>(mytetra->GetNodeN(3).get());
 
                 unsigned int ivert_el = i_verts;
                 unsigned int inorm_el = i_vnorms;
@@ -562,18 +617,21 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
 
                 // color
                 trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node0, 0, this->FEMmesh->GetElement(iel)));
+                    ComputeFalseColor(ComputeScalarOutput(node0, 0, element));
                 ++i_vcols;
                 trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node1, 1, this->FEMmesh->GetElement(iel)));
+                    ComputeFalseColor(ComputeScalarOutput(node1, 1, element));
                 ++i_vcols;
                 trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node2, 2, this->FEMmesh->GetElement(iel)));
+                    ComputeFalseColor(ComputeScalarOutput(node2, 2, element));
                 ++i_vcols;
                 trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node3, 3, this->FEMmesh->GetElement(iel)));
+                    ComputeFalseColor(ComputeScalarOutput(node3, 3, element));
                 ++i_vcols;
 
+                if (!update_indices)
+                    continue;
+
                 // faces indexes
                 ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
                 trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 1, 2) + ivert_offset;
@@ -597,26 +655,28 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
             }
 
             // ------------ELEMENT IS A HEXAHEDRON 8 NODES?
-            if (std::dynamic_pointer_cast<ChElementHexa_8>(FEMmesh->GetElement(iel)) ||
-                std::dynamic_pointer_cast<ChElementBrick>(FEMmesh->GetElement(iel)) ||
-                std::dynamic_pointer_cast<ChElementBrick_9>(FEMmesh->GetElement(iel))) {
-                UpdateBuffers_Hex(FEMmesh->GetElement(iel), trianglemesh, i_verts, i_vnorms, i_vcols, i_triindex);
+            if (kind == ELEM_HEXA) {
+                UpdateBuffers_Hex(element, trianglemesh, i_verts, i_vnorms, i_vcols, i_triindex,
+                                  update_indices);
             }
 
             // ------------ELEMENT IS A BEAM?
-            if (auto mybeam = std::dynamic_pointer_cast<ChElementBeam>(this->FEMmesh->GetElement(iel))) {
+            if (kind == ELEM_BEAM_EULER || kind == ELEM_CABLE_ANCF || kind == ELEM_BEAM) {
+                auto mybeam = static_cast<ChElementBeam*>(element);
                 double y_thick = 0.01;  // line thickness default value
                 double z_thick = 0.01;
                 bool m_circular = false;
                 double m_rad = 0;
 
-                if (auto mybeameuler = std::dynamic_pointer_cast<ChElementBeamEuler>(mybeam)) {
+                if (kind == ELEM_BEAM_EULER) {
+                    auto mybeameuler = static_cast<ChElementBeamEuler*>(element);
                     // if the beam has a section info, use section specific thickness for drawing
                     y_thick = 0.5 * mybeameuler->GetSection()->GetDrawThicknessY();
                     z_thick = 0.5 * mybeameuler->GetSection()->GetDrawThicknessZ();
                     m_circular = mybeameuler->GetSection()->IsCircular();
                     m_rad = mybeameuler->GetSection()->GetDrawCircularRadius();
-                } else if (auto mybeamancf = std::dynamic_pointer_cast<ChElementCableANCF>(mybeam)) {
+                } else if (kind == ELEM_CABLE_ANCF) {
+                    auto mybeamancf = static_cast<ChElementCableANCF*>(element);
                     // if the beam has a section info, use section specific thickness for drawing
                     y_thick = 0.5 * mybeamancf->GetSection()->GetDrawThicknessY();
                     z_thick = 0.5 * mybeamancf->GetSection()->GetDrawThicknessZ();
@@ -697,10 +757,7 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
                             trianglemesh.getCoordsNormals()[i_vnorms] = msectionrot.Rotate(Rw.GetNormalized());
                             ++i_vnorms;
                         }
-                        // no need to compute normals later with TriangleNormalsCompute
-                        need_automatic_smoothing = false;
-
-                        if (in > 0) {
+                        if (update_indices && in > 0) {
                             ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
                             ChVector<int> islice_offset((in - 1) * (int)msection_pts.size(), (in - 1) * (int)msection_pts.size(),
                                                         (in - 1) * (int)msection_pts.size());
@@ -748,7 +805,7 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
                         trianglemesh.getCoordsColors()[i_vcols] = mcol;
                         ++i_vcols;
 
-                        if (in > 0) {
+                        if (update_indices && in > 0) {
                             ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
                             ChVector<int> islice_offset((in - 1) * 4, (in - 1) * 4, (in - 1) * 4);
                             trianglemesh.getIndicesVertexes()[i_triindex] =
@@ -805,7 +862,8 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
             }
 
             // ------------ELEMENT IS A SHELL?
-            if (auto myshell = std::dynamic_pointer_cast<ChElementShell>(this->FEMmesh->GetElement(iel))) {
+            if (kind == ELEM_SHELL) {
+                auto myshell = static_cast<ChElementShell*>(element);
                 unsigned int ivert_el = i_verts;
                 unsigned int inorm_el = i_vnorms;
 
@@ -845,7 +903,7 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
 
                         ++i_vnorms;
 
-                        if (iu > 0 && iv > 0) {
+                        if (update_indices && iu > 0 && iv > 0) {
                             ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
 
                             trianglemesh.getIndicesVertexes()[i_triindex] =
@@ -882,64 +940,49 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
     //   In case mesh surfaces for pressure loads etc.:
     //
     if (this->fem_data_type == E_PLOT_LOADSURFACES) {
-        for (unsigned int isu = 0; isu < this->FEMmesh->GetNmeshSurfaces(); ++isu) {
-            std::shared_ptr<ChMeshSurface> msurface = this->FEMmesh->GetMeshSurface(isu);
-            for (unsigned int ifa = 0; ifa < msurface->GetFacesList().size(); ++ifa) {
-                std::shared_ptr<ChLoadableUV> mface = msurface->GetFacesList()[ifa];
-                // FACE ELEMENT IS A TETRAHEDRON FACE
-                if (auto mfacetetra = std::dynamic_pointer_cast<ChFaceTetra_4>(mface)) {
-                    auto node0 = std::static_pointer_cast<ChNodeFEAxyz>(mfacetetra->GetNodeN(0));
-                    auto node1 = std::static_pointer_cast<ChNodeFEAxyz>(mfacetetra->GetNodeN(1));
-                    auto node2 = std::static_pointer_cast<ChNodeFEAxyz>(mfacetetra->GetNodeN(2));
-
-                    unsigned int ivert_el = i_verts;
-                    unsigned int inorm_el = i_vnorms;
-
-                    // vertexes
-                    ChVector<> p0 = node0->GetPos();
-                    ChVector<> p1 = node1->GetPos();
-                    ChVector<> p2 = node2->GetPos();
-
-                    // debug: offset 1 m to show it better..
-                    //    p0.x() +=1;
-                    //    p1.x() +=1;
-                    //    p2.x() +=1;
-
-                    trianglemesh.getCoordsVertices()[i_verts] = p0;
-                    ++i_verts;
-                    trianglemesh.getCoordsVertices()[i_verts] = p1;
-                    ++i_verts;
-                    trianglemesh.getCoordsVertices()[i_verts] = p2;
-                    ++i_verts;
+        int n_faces = (int)load_faces.size();
+#pragma omp parallel for schedule(static)
+        for (int ifa = 0; ifa < n_faces; ++ifa) {
+            // FACE ELEMENT IS A TETRAHEDRON FACE
+            const LoadFace& face = load_faces[ifa];
+            unsigned int i_verts = face.offsets.verts;
+            unsigned int i_vcols = face.offsets.vcols;
+            unsigned int i_vnorms = face.offsets.vnorms;
+            unsigned int i_triindex = face.offsets.triangles;
+
+            unsigned int ivert_el = i_verts;
+            unsigned int inorm_el = i_vnorms;
+
+            // vertexes
+            for (int in = 0; in < 3; ++in) {
+                trianglemesh.getCoordsVertices()[i_verts] = face.nodes[in]->GetPos();
+                ++i_verts;
+            }
 
-                    // color
-                    trianglemesh.getCoordsColors()[i_vcols] = ChVector<float>(meshcolor.R, meshcolor.G, meshcolor.B);
-                    ++i_vcols;
-                    trianglemesh.getCoordsColors()[i_vcols] = ChVector<float>(meshcolor.R, meshcolor.G, meshcolor.B);
-                    ++i_vcols;
-                    trianglemesh.getCoordsColors()[i_vcols] = ChVector<float>(meshcolor.R, meshcolor.G, meshcolor.B);
-                    ++i_vcols;
+            // color
+            for (int in = 0; in < 3; ++in) {
+                trianglemesh.getCoordsColors()[i_vcols] = ChVector<float>(meshcolor.R, meshcolor.G, meshcolor.B);
+                ++i_vcols;
+            }
 
-                    // faces indexes
-                    ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
-                    trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 1, 2) + ivert_offset;
-                    ++i_triindex;
+            if (!update_indices)
+                continue;
 
-                    // normals indices (if not defaulting to flat triangles)
-                    if (this->smooth_faces) {
-                        ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
-                        trianglemesh.getIndicesNormals()[i_triindex - 4] = ChVector<int>(0, 0, 0) + inorm_offset;
-                        i_vnorms += 1;
-                    }
-                }
+            // faces indexes
+            ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
+            trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 1, 2) + ivert_offset;
+            ++i_triindex;
 
-                // FACE ELEMENT IS A SHELL
-                if (auto mfacetetra = std::dynamic_pointer_cast<ChElementTetra_4_P>(mface)) {
-                    //***TODO***
-                }
+            // normals indices (if not defaulting to flat triangles)
+            if (this->smooth_faces) {
+                ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
+                trianglemesh.getIndicesNormals()[i_triindex - 1] = ChVector<int>(0, 0, 0) + inorm_offset;
             }
-        }  // end loop on load surfaces
-    }      // End of case of load surfaces
+        }
+
+        // FACE ELEMENT IS A SHELL (ChElementTetra_4_P faces)
+        //***TODO***
+    }  // End of case of load surfaces
 
     //   In case of contact surfaces:
     //
@@ -947,9 +990,16 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
         for (unsigned int isu = 0; isu < this->FEMmesh->GetNcontactSurfaces(); ++isu) {
             if (auto msurface =
                     std::dynamic_pointer_cast<ChContactSurfaceMesh>(this->FEMmesh->GetContactSurface(isu))) {
-                for (unsigned int ifa = 0; ifa < msurface->GetTriangleList().size(); ++ifa) {
+                int n_faces = (int)msurface->GetTriangleList().size();
+#pragma omp parallel for schedule(static)
+                for (int ifa = 0; ifa < n_faces; ++ifa) {
                     std::shared_ptr<ChContactTriangleXYZ> mface = msurface->GetTriangleList()[ifa];
 
+                    unsigned int i_verts = surface_offsets[isu].verts + 3 * ifa;
+                    unsigned int i_vcols = surface_offsets[isu].vcols + 3 * ifa;
+                    unsigned int i_vnorms = surface_offsets[isu].vnorms + ifa;
+                    unsigned int i_triindex = surface_offsets[isu].triangles + ifa;
+
                     unsigned int ivert_el = i_verts;
                     unsigned int inorm_el = i_vnorms;
 
@@ -973,6 +1023,9 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
                     trianglemesh.getCoordsColors()[i_vcols] = ChVector<float>(meshcolor.R, meshcolor.G, meshcolor.B);
                     ++i_vcols;
 
+                    if (!update_indices)
+                        continue;
+
                     // faces indexes
                     ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
                     trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 1, 2) + ivert_offset;
@@ -981,7 +1034,7 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
                     // normals indices (if not defaulting to flat triangles)
                     if (this->smooth_faces) {
                         ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
-                        trianglemesh.getIndicesNormals()[i_triindex - 4] = ChVector<int>(0, 0, 0) + inorm_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex - 1] = ChVector<int>(0, 0, 0) + inorm_offset;
                         i_vnorms += 1;
                     }
                 }
@@ -990,12 +1043,44 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
     }      // End of case of contact surfaces
 
     if (need_automatic_smoothing) {
-        for (unsigned int itri = 0; itri < trianglemesh.getIndicesVertexes().size(); ++itri)
-            TriangleNormalsCompute(trianglemesh.getIndicesNormals()[itri], trianglemesh.getIndicesVertexes()[itri],
-                                   trianglemesh.getCoordsVertices(), trianglemesh.getCoordsNormals(),
-                                   normal_accumulators);
+        std::vector<ChVector<>>& vertexes = trianglemesh.getCoordsVertices();
+        std::vector<ChVector<>>& normals = trianglemesh.getCoordsNormals();
+        std::vector<ChVector<int>>& vert_indexes = trianglemesh.getIndicesVertexes();
+        std::vector<ChVector<int>>& norm_indexes = trianglemesh.getIndicesNormals();
+        int n_triangles = (int)vert_indexes.size();
+        int n_normals = (int)normals.size();
+
+        // Triangles sharing each normal, in a fixed order (rebuilt with the face indexes).
+        if (update_indices) {
+            normal_start.assign(n_normals + 1, 0);
+            for (int itri = 0; itri < n_triangles; ++itri)
+                for (int k = 0; k < 3; ++k)
+                    ++normal_start[norm_indexes[itri][k] + 1];
+            for (int in = 0; in < n_normals; ++in)
+                normal_start[in + 1] += normal_start[in];
+            normal_triangles.resize(normal_start[n_normals]);
+            std::vector<int> next(normal_start.begin(), normal_start.end() - 1);
+            for (int itri = 0; itri < n_triangles; ++itri)
+                for (int k = 0; k < 3; ++k)
+                    normal_triangles[next[norm_indexes[itri][k]]++] = itri;
+        }
 
-        TriangleNormalsSmooth(trianglemesh.getCoordsNormals(), normal_accumulators);
+        // Normals of the triangles, then their average at each normal index.
+        triangle_normals.resize(n_triangles);
+#pragma omp parallel for schedule(static)
+        for (int itri = 0; itri < n_triangles; ++itri) {
+            const ChVector<int>& iv = vert_indexes[itri];
+            triangle_normals[itri] =
+                Vcross(vertexes[iv.y()] - vertexes[iv.x()], vertexes[iv.z()] - vertexes[iv.x()]).GetNormalized();
+        }
+#pragma omp parallel for schedule(static)
+        for (int in = 0; in < n_normals; ++in) {
+            ChVector<> sum = VNULL;
+            for (int it = normal_start[in]; it < normal_start[in + 1]; ++it)
+                sum += triangle_normals[normal_triangles[it]];
+            int count = normal_start[in + 1] - normal_start[in];
+            normals[in] = count ? sum * (1.0 / count) : VNULL;
+        }
     }
 
     // other flags
@@ -15,6 +15,9 @@
 #ifndef CHVISUALIZATIONFEAMESH_H
 #define CHVISUALIZATIONFEAMESH_H
 
+#include <algorithm>
+#include <cstdint>
+
 #include "chrono/assets/ChAssetLevel.h"
 #include "chrono/assets/ChColor.h"
 #include "chrono/geometry/ChTriangleMeshConnected.h"
@@ -111,7 +114,47 @@ class ChApiFea ChVisualizationFEAmesh : public ChAssetLevel {
     ChColor meshcolor;
     ChColor symbolscolor;
 
-    std::vector<int> normal_accumulators;
+    bool update_enabled;
+    int update_stride;
+    unsigned int update_counter;
+
+    /// Position of the data of an element (or surface) in the buffers of the triangle mesh.
+    struct BufferOffsets {
+        unsigned int verts;
+        unsigned int vcols;
+        unsigned int vnorms;
+        unsigned int triangles;
+    };
+    /// Kind of an element, found when the buffer layout is built, so that updates need no casts.
+    enum eChElementKind {
+        ELEM_NONE,
+        ELEM_TETRA_4,
+        ELEM_TETRA_4_P,
+        ELEM_HEXA,
+        ELEM_BEAM_EULER,
+        ELEM_CABLE_ANCF,
+        ELEM_BEAM,
+        ELEM_SHELL
+    };
+    /// Triangular face of a load surface.
+    struct LoadFace {
+        ChNodeFEAxyz* nodes[3];
+        BufferOffsets offsets;
+    };
+    unsigned int topology_revision;              ///< revision of the mesh topology used to build the buffer layout
+    std::vector<uintptr_t> layout_key;           ///< settings and surface sizes used to build the buffer layout
+    std::vector<ChElementBase*> elements;        ///< elements of the mesh
+    std::vector<eChElementKind> element_kinds;   ///< kind of each element
+    std::vector<BufferOffsets> element_offsets;  ///< start of the data of each element
+    std::vector<BufferOffsets> surface_offsets;  ///< start of the data of each contact surface
+    std::vector<LoadFace> load_faces;            ///< faces of the load surfaces
+    BufferOffsets buffer_size;                   ///< total size of the buffers
+    bool automatic_smoothing;                    ///< false if some elements provide their own normals
+
+    // Smoothed normals: each normal is the average of the normals of the triangles sharing it.
+    std::vector<ChVector<>> triangle_normals;  ///< normal of each triangle
+    std::vector<int> normal_start;             ///< first entry of each normal in normal_triangles (CSR layout)
+    std::vector<int> normal_triangles;         ///< triangles sharing each normal
 
   public:
     //
@@ -195,25 +238,32 @@ class ChApiFea ChVisualizationFEAmesh : public ChAssetLevel {
     // undeformed (the reference position).
     void SetDrawInUndeformedReference(bool mdu) { this->undeformed_reference = mdu; }
 
+    /// Enable or disable the update of the triangle mesh and glyphs (default: enabled).
+    /// Since Update() is called at each update of the mesh, disable it when nothing is displayed.
+    void SetUpdateEnabled(bool menabled) { this->update_enabled = menabled; }
+    bool GetUpdateEnabled() const { return this->update_enabled; }
+
+    /// Update the triangle mesh and glyphs only once every 'mstride' calls to Update() (default: 1),
+    /// for example to refresh the visualization at the frame rate rather than at each step.
+    void SetUpdateStride(int mstride) { this->update_stride = std::max(mstride, 1); }
+    int GetUpdateStride() const { return this->update_stride; }
+
     // Updates the triangle visualization mesh so that it matches with the
     // FEM mesh (ex. tetrahedrons are converted in 4 surfaces, etc.
     virtual void Update(ChPhysicsItem* updater, const ChCoordsys<>& coords);
 
   private:
-    double ComputeScalarOutput(std::shared_ptr<ChNodeFEAxyz> mnode,
-                               int nodeID,
-                               std::shared_ptr<ChElementBase> melement);
-    double ComputeScalarOutput(std::shared_ptr<ChNodeFEAxyzP> mnode,
-                               int nodeID,
-                               std::shared_ptr<ChElementBase> melement);
+    double ComputeScalarOutput(ChNodeFEAxyz* mnode, int nodeID, ChElementBase* melement);
+    double ComputeScalarOutput(ChNodeFEAxyzP* mnode, int nodeID, ChElementBase* melement);
     ChVector<float> ComputeFalseColor(double in);
     ChColor ComputeFalseColor2(double in);
-    void UpdateBuffers_Hex(std::shared_ptr<ChElementBase> element,
+    void UpdateBuffers_Hex(ChElementBase* element,
                            geometry::ChTriangleMeshConnected& trianglemesh,
                            unsigned int& i_verts,
                            unsigned int& i_vnorms,
                            unsigned int& i_vcols,
-                           unsigned int& i_triindex);
+                           unsigned int& i_triindex,
+                           bool update_indices);
 };
 
 }  // end namespace fea
@@ -183,7 +183,7 @@ class ChSolverMKL : public ChSolver {
 
         m_setup_call++;
 
-        if (verbose) {
+        if (verbose && GetLog().IsEnabled(ChLog::CHSTATUS)) {
             GetLog() << " MKL setup n = " << m_dim << "  nnz = " << m_mat.GetNNZ() << "\n";
             GetLog() << "  assembly: " << m_timer_setup_assembly.GetTimeSecondsIntermediate() << "s"
                      << "  solver_call: " << m_timer_setup_solvercall.GetTimeSecondsIntermediate() << "\n";
@@ -220,7 +220,7 @@ class ChSolverMKL : public ChSolver {
             return -1.0;
         }
 
-        if (verbose) {
+        if (verbose && GetLog().IsEnabled(ChLog::CHSTATUS)) {
             double res_norm = m_engine.GetResidualNorm();
             GetLog() << " MKL solve call " << m_solve_call << "  |residual| = " << res_norm << "\n";
             GetLog() << "  assembly: " << m_timer_solve_assembly.GetTimeSecondsIntermediate() << "s\n"
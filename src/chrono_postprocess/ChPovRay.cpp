@@ -12,6 +12,9 @@
 // Authors: Alessandro Tasora
 // =============================================================================
 
+#include <algorithm>
+#include <cstring>
+
 #include "chrono/assets/ChAssetLevel.h"
 #include "chrono/assets/ChBoxShape.h"
 #include "chrono/assets/ChCamera.h"
@@ -72,6 +75,70 @@ ChPovRay::ChPovRay(ChSystem* system) : ChPostProcessBase(system) {
     this->contacts_colormap_endscale = 10;
     this->contacts_do_colormap = true;
     this->single_asset_file = true;
+    this->async_export = false;
+    this->max_queued_frames = 2;
+    this->writer_busy = false;
+    this->writer_stop = false;
+}
+
+ChPovRay::~ChPovRay() {
+    if (writer_thread.joinable()) {
+        {
+            std::unique_lock<std::mutex> lock(writer_mutex);
+            writer_stop = true;
+        }
+        writer_cv_work.notify_all();
+        writer_thread.join();
+    }
+}
+
+void ChPovRay::SetAsyncExport(bool async, size_t max_queued) {
+    if (!async)
+        Flush();
+    this->async_export = async;
+    this->max_queued_frames = std::max(max_queued, (size_t)1);
+    if (async && !writer_thread.joinable())
+        writer_thread = std::thread(&ChPovRay::ProcessQueue, this);
+}
+
+void ChPovRay::Flush() {
+    std::unique_lock<std::mutex> lock(writer_mutex);
+    writer_cv_space.wait(lock, [this]() { return writer_queue.empty() && !writer_busy; });
+    if (!writer_error.empty()) {
+        std::string error = writer_error;
+        writer_error.clear();
+        throw(ChException(error));
+    }
+}
+
+void ChPovRay::ProcessQueue() {
+    while (true) {
+        std::unique_ptr<FrameData> frame;
+        {
+            std::unique_lock<std::mutex> lock(writer_mutex);
+            writer_cv_work.wait(lock, [this]() { return !writer_queue.empty() || writer_stop; });
+            if (writer_queue.empty())
+                return;
+            frame = std::move(writer_queue.front());
+            writer_queue.pop_front();
+            writer_busy = true;
+        }
+
+        std::string error;
+        try {
+            WriteData(*frame);
+        } catch (ChException& e) {
+            error = e.what();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(writer_mutex);
+            writer_busy = false;
+            if (!error.empty() && writer_error.empty())
+                writer_error = error;
+        }
+        writer_cv_space.notify_all();
+    }
 }
 
 void ChPovRay::Add(std::shared_ptr<ChPhysicsItem> mitem) {
@@ -251,6 +318,7 @@ void ChPovRay::ExportScript(const std::string& filename) {
     this->out_script_filename = filename;
 
     pov_assets.clear();
+    pov_items.clear();
 
     this->SetupLists();
 
@@ -435,7 +503,7 @@ void ChPovRay::ExportScript(const std::string& filename) {
 }
 
 void ChPovRay::_recurseExportAssets(std::vector<std::shared_ptr<ChAsset> >& assetlist,
-                                    ChStreamOutAsciiFile& assets_file) {
+                                    ChStreamOutAscii& assets_file) {
     // Scan assets
     for (unsigned int k = 0; k < assetlist.size(); k++) {
         std::shared_ptr<ChAsset> k_asset = assetlist[k];
@@ -711,7 +779,7 @@ void ChPovRay::_recurseExportAssets(std::vector<std::shared_ptr<ChAsset> >& asse
     }  // end loop on assets of i-th object
 }
 
-void ChPovRay::ExportAssets(ChStreamOutAsciiFile& assets_file) {
+void ChPovRay::ExportAssets(ChStreamOutAscii& assets_file) {
     
     // This will scan all the ChPhysicsItem added objects, and if
     // they have some reference to renderizable assets, write geoemtries in
@@ -723,11 +791,24 @@ void ChPovRay::ExportAssets(ChStreamOutAsciiFile& assets_file) {
     }  // end loop on objects
 }
 
+namespace {
+
+// Write the POV transformation corresponding to the given coordinate system.
+void WriteTransform(ChStreamOutAscii& mfilepov, const ChCoordsys<>& csys) {
+    mfilepov << " quatRotation(<" << csys.rot.e0();
+    mfilepov << "," << csys.rot.e1();
+    mfilepov << "," << csys.rot.e2();
+    mfilepov << "," << csys.rot.e3() << ">) \n";
+    mfilepov << " translate  <" << csys.pos.x();
+    mfilepov << "," << csys.pos.y();
+    mfilepov << "," << csys.pos.z() << "> \n";
+}
+
+}  // end anonymous namespace
+
 void ChPovRay::_recurseExportObjData(std::vector<std::shared_ptr<ChAsset> >& assetlist,
                                      ChFrame<> parentframe,
-                                     ChStreamOutAsciiFile& mfilepov) {
-    mfilepov << "union{\n";   // begin union
-
+                                     ChStreamOutAscii& mfilepov) {
     // Scan assets in object and write the macro to set their position
     for (unsigned int k = 0; k < assetlist.size(); k++) {
         std::shared_ptr<ChAsset> k_asset = assetlist[k];
@@ -742,23 +823,16 @@ void ChPovRay::_recurseExportObjData(std::vector<std::shared_ptr<ChAsset> >& ass
             mfilepov << "sh_" << (size_t)k_asset.get() << "()\n";
         }
 
-        if (auto mycamera = std::dynamic_pointer_cast<ChCamera>(k_asset)) {
-            this->camera_found_in_assets = true;
-
-            this->camera_location = mycamera->GetPosition() >> parentframe;
-            this->camera_aim = mycamera->GetAimPoint() >> parentframe;
-            this->camera_up = mycamera->GetUpVector() >> parentframe;
-            this->camera_angle = mycamera->GetAngle();
-            this->camera_orthographic = mycamera->GetOrthographic();
-        }
-
         if (auto mylevel = std::dynamic_pointer_cast<ChAssetLevel>(k_asset)) {
             // recurse level...
-            ChFrame<> composedframe = mylevel->GetFrame() >> parentframe;
             ChFrame<> subassetframe = mylevel->GetFrame();
 
             std::vector<std::shared_ptr<ChAsset> >& subassetlist = mylevel->GetAssets();
+            mfilepov << "union{\n";  // begin union
             _recurseExportObjData(subassetlist, subassetframe, mfilepov);
+            if (!(subassetframe.GetCoord() == CSYSNORM))
+                WriteTransform(mfilepov, subassetframe.GetCoord());
+            mfilepov << "}\n";  // end union
         }
 
     }  // end loop on assets
@@ -773,22 +847,78 @@ void ChPovRay::_recurseExportObjData(std::vector<std::shared_ptr<ChAsset> >& ass
             mfilepov << "cm_" << (size_t)k_asset.get() << "()\n";
         }
     }
+}
+
+void ChPovRay::_recurseAssetStamp(std::vector<std::shared_ptr<ChAsset> >& assetlist,
+                                  const ChFrame<>& parentframe,
+                                  std::vector<uint64_t>& stamp) {
+    stamp.push_back(assetlist.size());
+    for (auto& k_asset : assetlist) {
+        stamp.push_back((uint64_t)(size_t)k_asset.get());
+
+        // Cameras move with the item, so they are processed at each frame.
+        if (auto mycamera = std::dynamic_pointer_cast<ChCamera>(k_asset)) {
+            this->camera_found_in_assets = true;
+
+            this->camera_location = mycamera->GetPosition() >> parentframe;
+            this->camera_aim = mycamera->GetAimPoint() >> parentframe;
+            this->camera_up = mycamera->GetUpVector() >> parentframe;
+            this->camera_angle = mycamera->GetAngle();
+            this->camera_orthographic = mycamera->GetOrthographic();
+        }
 
-    // write the rotation and position
-    if (!(parentframe.GetCoord() == CSYSNORM)) {
-        mfilepov << " quatRotation(<" << parentframe.GetRot().e0();
-        mfilepov << "," << parentframe.GetRot().e1();
-        mfilepov << "," << parentframe.GetRot().e2();
-        mfilepov << "," << parentframe.GetRot().e3() << ">) \n";
-        mfilepov << " translate  <" << parentframe.GetPos().x();
-        mfilepov << "," << parentframe.GetPos().y();
-        mfilepov << "," << parentframe.GetPos().z() << "> \n";
+        else if (auto mylevel = std::dynamic_pointer_cast<ChAssetLevel>(k_asset)) {
+            const ChCoordsys<>& csys = mylevel->GetFrame().GetCoord();
+            const double values[7] = {csys.pos.x(),  csys.pos.y(),  csys.pos.z(), csys.rot.e0(),
+                                      csys.rot.e1(), csys.rot.e2(), csys.rot.e3()};
+            for (double value : values) {
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                stamp.push_back(bits);
+            }
+            _recurseAssetStamp(mylevel->GetAssets(), mylevel->GetFrame(), stamp);
+        }
+    }
+}
+
+void ChPovRay::ExportItemShapes(std::shared_ptr<ChPhysicsItem> item,
+                                const ChFrame<>& frame,
+                                std::vector<char>& shapes,
+                                ChStreamOutAscii& macros) {
+    // The tree of shapes depends only on the addresses of the assets and on the frames of the asset levels:
+    // compare their stamp with the one of the cached tree, and export the tree again only if it changed.
+    ItemShapes& cached = pov_items[(size_t)item.get()];
+    asset_stamp.clear();
+    _recurseAssetStamp(item->GetAssets(), frame, asset_stamp);
+
+    bool changed = cached.version == 0 || cached.stamp != asset_stamp;
+    if (changed) {
+        cached.stamp.swap(asset_stamp);
+        cached.tree.clear();
+        ChStreamOutAsciiVector mtree(&cached.tree);
+        _recurseExportObjData(item->GetAssets(), frame, mtree);
+        cached.version++;
+    }
+
+    if (!single_asset_file) {
+        shapes = cached.tree;
+        return;
     }
 
-    mfilepov << "}\n";  // end union
+    // Declare the tree of shapes as a macro in the assets file, the first time the item is exported
+    // or whenever its assets changed (a new version of the macro is declared in that case).
+    if (changed) {
+        macros << "#macro ob_" << (size_t)item.get() << "_" << cached.version << "()\n";
+        std::string tree(cached.tree.begin(), cached.tree.end());
+        macros << tree;
+        macros << "#end \n";
+    }
+
+    ChStreamOutAsciiVector mshapes(&shapes);
+    mshapes << "ob_" << (size_t)item.get() << "_" << cached.version << "()\n";
 }
 
-void ChPovRay::ExportData(const std::string& filename) {
+void ChPovRay::CaptureData(const std::string& filename, FrameData& frame) {
     // Regenerate the list of objects that need POV rendering, by
     // scanning all ChPhysicsItems in the ChSystem that have a ChPovRayAsse attached.
     // Note that SetupLists() happens at each ExportData (i.e. at each timestep)
@@ -796,6 +926,70 @@ void ChPovRay::ExportData(const std::string& filename) {
 
     this->SetupLists();
 
+    frame.filename = filename;
+    frame.COGs_show = this->COGs_show;
+    frame.COGs_size = this->COGs_size;
+    frame.frames_show = this->frames_show;
+    frame.frames_size = this->frames_size;
+    frame.links_size = this->links_size;
+    frame.contacts_show = this->contacts_show;
+
+    this->camera_found_in_assets = false;
+
+    ChStreamOutAsciiVector mheader(&frame.header);
+
+    // If embedding assets in the .pov file:
+    if (!single_asset_file) {
+        this->pov_assets.clear();
+        this->ExportAssets(mheader);
+    }
+
+    // Write custom data commands, if provided by the user
+    if (this->custom_data.size() > 0) {
+        mheader << "// Custom user-added script: \n\n";
+        mheader << this->custom_data;
+        mheader << "\n\n";
+    }
+
+    // Take a snapshot of the positions of the items (only these change from frame to frame)
+    std::vector<char> item_macros;
+    ChStreamOutAsciiVector mmacros(&item_macros);
+
+    frame.items.resize(this->mdata.size());
+    for (unsigned int i = 0; i < this->mdata.size(); i++) {
+        ItemData& item = frame.items[i];
+        item.type = ItemData::OTHER;
+
+        // #) saving a body ?
+        if (auto mybody = std::dynamic_pointer_cast<ChBody>(mdata[i])) {
+            const ChFrame<>& bodyframe = mybody->GetFrame_REF_to_abs();
+            item.type = ItemData::BODY;
+            item.csys = bodyframe.GetCoord();
+            item.cog = mybody->GetFrame_COG_to_abs().GetCoord();
+            ExportItemShapes(mdata[i], bodyframe, item.shapes, mmacros);
+        }
+
+        // #) saving a cluster of particles ?
+        else if (auto myclones = std::dynamic_pointer_cast<ChParticlesClones>(mdata[i])) {
+            item.type = ItemData::PARTICLES;
+            ChFrame<> nullframe(CSYSNORM);
+            ExportItemShapes(mdata[i], nullframe, item.shapes, mmacros);
+            item.particles.resize(myclones->GetNparticles());
+            for (unsigned int m = 0; m < myclones->GetNparticles(); ++m)
+                item.particles[m] = myclones->GetParticle(m).GetCoord();
+        }
+
+        // #) saving a ChLinkMateGeneric constraint ?
+        else if (auto mylinkmate = std::dynamic_pointer_cast<ChLinkMateGeneric>(mdata[i])) {
+            if (mylinkmate->GetBody1() && mylinkmate->GetBody2() && this->links_show) {
+                item.type = ItemData::LINK;
+                item.frameA = (mylinkmate->GetFrame1() >> *mylinkmate->GetBody1()).GetCoord();
+                item.frameB = (mylinkmate->GetFrame2() >> *mylinkmate->GetBody2()).GetCoord();
+            }
+        }
+
+    }  // end loop on objects
+
     // If using a single-file asset, update it (because maybe that during the
     // animation someone created an object with asset)
     if (single_asset_file) {
@@ -805,201 +999,237 @@ void ChPovRay::ExportData(const std::string& filename) {
         // populate assets (note that already present
         // assets won't be appended!)
         this->ExportAssets(assets_file);
+        // append the macros of new (or modified) items
+        if (!item_macros.empty())
+            assets_file.Write(item_macros.data(), item_macros.size());
     }
 
-    // Generate the nnnn.dat and nnnn.pov files:
-
-    try {
-        char pathdat[200];
-        sprintf(pathdat, "%s.dat", filename.c_str());
-        ChStreamOutAsciiFile mfiledat(pathdat);
+    // #) saving contacts ?
+    if (this->contacts_show) {
+        class _reporter_class : public ChContactContainer::ReportContactCallback {
+          public:
+            virtual bool OnReportContact(
+                const ChVector<>& pA,             // contact pA
+                const ChVector<>& pB,             // contact pB
+                const ChMatrix33<>& plane_coord,  // contact plane coordsystem (A column 'X' is contact normal)
+                const double& distance,           // contact distance
+                const ChVector<>& react_forces,   // react.forces (in coordsystem 'plane_coord')
+                const ChVector<>& react_torques,  // react.torques (if rolling friction)
+                ChContactable* contactobjA,       // model A (note: could be nullptr)
+                ChContactable* contactobjB        // model B (note: could be nullptr)
+                ) override {
+                if (fabs(react_forces.x()) > 1e-8 || fabs(react_forces.y()) > 1e-8 ||
+                    fabs(react_forces.z()) > 1e-8) {
+                    ChMatrix33<> localmatr(plane_coord);
+                    ChVector<> n1 = localmatr.Get_A_Xaxis();
+                    ChVector<> absreac = localmatr * react_forces;
+                    for (int j = 0; j < 3; j++)
+                        data->push_back(pA[j]);
+                    for (int j = 0; j < 3; j++)
+                        data->push_back(n1[j]);
+                    for (int j = 0; j < 3; j++)
+                        data->push_back(absreac[j]);
+                }
+                return true;  // to continue scanning contacts
+            }
+            // Data
+            std::vector<double>* data;
+        };
 
-        char pathpov[200];
-        sprintf(pathpov, "%s.pov", filename.c_str());
-        ChStreamOutAsciiFile mfilepov(pathpov);
+        _reporter_class my_contact_reporter;
+        my_contact_reporter.data = &frame.contacts;
 
-        this->camera_found_in_assets = false;
+        // scan all contacts
+        this->mSystem->GetContactContainer()->ReportAllContacts(&my_contact_reporter);
+    }
 
-        // If embedding assets in the .pov file:
-        if (!single_asset_file) {
-            this->pov_assets.clear();
-            this->ExportAssets(mfilepov);
+    // If a camera have been found in assets, create it and override the default one
+    if (this->camera_found_in_assets) {
+        ChStreamOutAsciiVector mcamera(&frame.camera);
+        mcamera << "camera { \n";
+        if (camera_orthographic) {
+            mcamera << " orthographic \n";
+            mcamera << " right x * " << (camera_location - camera_aim).Length() << " * tan ((( " << camera_angle
+                    << " *0.5)/180)*3.14) \n";
+            mcamera << " up y * image_height/image_width * " << (camera_location - camera_aim).Length()
+                    << " * tan (((" << camera_angle << "*0.5)/180)*3.14) \n";
+            ChVector<> mdir = (camera_aim - camera_location) * 0.00001;
+            mcamera << " direction <" << mdir.x() << "," << mdir.y() << "," << mdir.z() << "> \n";
+        } else {
+            mcamera << " right -x*image_width/image_height \n";
+            mcamera << " angle " << camera_angle << " \n";
         }
+        mcamera << " location <" << camera_location.x() << "," << camera_location.y() << "," << camera_location.z()
+                << "> \n"
+                << " look_at <" << camera_aim.x() << "," << camera_aim.y() << "," << camera_aim.z() << "> \n"
+                << " sky <" << camera_up.x() << "," << camera_up.y() << "," << camera_up.z() << "> \n";
+        mcamera << "}\n\n\n";
+    }
+}
 
-        // Write custom data commands, if provided by the user
-        if (this->custom_data.size() > 0) {
-            mfilepov << "// Custom user-added script: \n\n";
-            mfilepov << this->custom_data;
-            mfilepov << "\n\n";
+void ChPovRay::WriteItemData(const FrameData& frame,
+                             const ItemData& item,
+                             ChStreamOutAscii& mfilepov,
+                             ChStreamOutAscii& mfiledat) {
+    switch (item.type) {
+        case ItemData::BODY: {
+            // Dump the POV macro that generates the contained asset(s) tree!!!
+            mfilepov << "union{\n";  // begin union
+            std::string shapes(item.shapes.begin(), item.shapes.end());
+            mfilepov << shapes;
+            if (!(item.csys == CSYSNORM))
+                WriteTransform(mfilepov, item.csys);
+            mfilepov << "}\n";  // end union
+
+            // Show body COG?
+            if (frame.COGs_show) {
+                mfilepov << "sh_csysCOG(";
+                mfilepov << item.cog.pos.x() << "," << item.cog.pos.y() << "," << item.cog.pos.z() << ",";
+                mfilepov << item.cog.rot.e0() << "," << item.cog.rot.e1() << "," << item.cog.rot.e2() << ","
+                         << item.cog.rot.e3() << ",";
+                mfilepov << frame.COGs_size << ")\n";
+            }
+            // Show body frame ref?
+            if (frame.frames_show) {
+                mfilepov << "sh_csysFRM(";
+                mfilepov << item.csys.pos.x() << "," << item.csys.pos.y() << "," << item.csys.pos.z() << ",";
+                mfilepov << item.csys.rot.e0() << "," << item.csys.rot.e1() << "," << item.csys.rot.e2() << ","
+                         << item.csys.rot.e3() << ",";
+                mfilepov << frame.frames_size << ")\n";
+            }
+            break;
         }
+        case ItemData::PARTICLES: {
+            // (uses a POV '#while' loop reading the particle coordinates from the .dat file)
+            mfilepov << " \n";
+            mfilepov << "#declare Index = 0; \n";
+            mfilepov << "#while(Index < " << (unsigned int)item.particles.size() << ") \n";
+            mfilepov << "  #read (MyDatFile, apx, apy, apz, aq0, aq1, aq2, aq3) \n";
+            mfilepov << "  union{\n";
+            mfilepov << "union{\n";
+            std::string shapes(item.shapes.begin(), item.shapes.end());
+            mfilepov << shapes;
+            mfilepov << "}\n";
+            mfilepov << "  quatRotation(<aq0,aq1,aq2,aq3>)\n";
+            mfilepov << "  translate(<apx,apy,apz>)\n";
+            mfilepov << "  }\n";
+            mfilepov << "  #declare Index = Index + 1; \n";
+            mfilepov << "#end \n";
+
+            // Loop on all particle clones
+            for (const auto& assetcsys : item.particles) {
+                mfiledat << assetcsys.pos.x() << ", ";
+                mfiledat << assetcsys.pos.y() << ", ";
+                mfiledat << assetcsys.pos.z() << ", ";
+                mfiledat << assetcsys.rot.e0() << ", ";
+                mfiledat << assetcsys.rot.e1() << ", ";
+                mfiledat << assetcsys.rot.e2() << ", ";
+                mfiledat << assetcsys.rot.e3() << ", \n";
+            }  // end loop on particles
+            break;
+        }
+        case ItemData::LINK: {
+            const ChCoordsys<>& frA = item.frameA;
+            const ChCoordsys<>& frB = item.frameB;
+            mfilepov << "sh_csysFRM(";
+            mfilepov << frA.pos.x() << "," << frA.pos.y() << "," << frA.pos.z() << ",";
+            mfilepov << frA.rot.e0() << "," << frA.rot.e1() << "," << frA.rot.e2() << "," << frA.rot.e3() << ",";
+            mfilepov << frame.links_size * 0.7 << ")\n";  // smaller, as 'slave' csys.
+            mfilepov << "sh_csysFRM(";
+            mfilepov << frB.pos.x() << "," << frB.pos.y() << "," << frB.pos.z() << ",";
+            mfilepov << frB.rot.e0() << "," << frB.rot.e1() << "," << frB.rot.e2() << "," << frB.rot.e3() << ",";
+            mfilepov << frame.links_size << ")\n";
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void ChPovRay::WriteData(const FrameData& frame) {
+    // Generate the nnnn.dat and nnnn.pov files:
+
+    try {
+        std::string pathdat = frame.filename + ".dat";
+        ChStreamOutAsciiFile mfiledat(pathdat.c_str());
+
+        std::string pathpov = frame.filename + ".pov";
+        ChStreamOutAsciiFile mfilepov(pathpov.c_str());
+
+        // Embedded assets and custom data commands
+        if (!frame.header.empty())
+            mfilepov.Write(frame.header.data(), frame.header.size());
 
         // Tell POV to open the .dat file, that could be used by
         // ChParticleClones for efficiency (xyz raw data with center of particles will
         // be saved in dat and load using a #while POV loop, helping to reduce size of .pov file)
-        mfilepov << "#declare dat_file = \"" << pathdat << "\"\n";
+        mfilepov << "#declare dat_file = \"" << pathdat.c_str() << "\"\n";
         mfilepov << "#fopen MyDatFile dat_file read \n\n";
 
-        // Save time-dependent data for the geometry of objects in ...nnnn.POV
-        // and in ...nnnn.DAT file
-
-        for (unsigned int i = 0; i < this->mdata.size(); i++) {
-            // #) saving a body ?
-            if (auto mybody = std::dynamic_pointer_cast<ChBody>(mdata[i])) {
-                // Get the current coordinate frame of the i-th object
-                ChCoordsys<> assetcsys = CSYSNORM;
-                const ChFrame<>& bodyframe = mybody->GetFrame_REF_to_abs();
-                assetcsys = bodyframe.GetCoord();
-
-                // Dump the POV macro that generates the contained asset(s) tree!!!
-                _recurseExportObjData(mdata[i]->GetAssets(), bodyframe, mfilepov);
-
-                // Show body COG?
-                if (this->COGs_show) {
-                    const ChCoordsys<>& cogcsys = mybody->GetFrame_COG_to_abs().GetCoord();
-                    mfilepov << "sh_csysCOG(";
-                    mfilepov << cogcsys.pos.x() << "," << cogcsys.pos.y() << "," << cogcsys.pos.z() << ",";
-                    mfilepov << cogcsys.rot.e0() << "," << cogcsys.rot.e1() << "," << cogcsys.rot.e2() << ","
-                             << cogcsys.rot.e3() << ",";
-                    mfilepov << this->COGs_size << ")\n";
-                }
-                // Show body frame ref?
-                if (this->frames_show) {
-                    mfilepov << "sh_csysFRM(";
-                    mfilepov << assetcsys.pos.x() << "," << assetcsys.pos.y() << "," << assetcsys.pos.z() << ",";
-                    mfilepov << assetcsys.rot.e0() << "," << assetcsys.rot.e1() << "," << assetcsys.rot.e2() << ","
-                             << assetcsys.rot.e3() << ",";
-                    mfilepov << this->frames_size << ")\n";
-                }
-            }
-
-            // #) saving a cluster of particles ?  (NEW method that uses a POV '#while' loop and a .dat file)
-            if (auto myclones = std::dynamic_pointer_cast<ChParticlesClones>(mdata[i])) {
-                mfilepov << " \n";
-                // mfilepov << "union{\n";
-                mfilepov << "#declare Index = 0; \n";
-                mfilepov << "#while(Index < " << myclones->GetNparticles() << ") \n";
-                mfilepov << "  #read (MyDatFile, apx, apy, apz, aq0, aq1, aq2, aq3) \n";
-                mfilepov << "  union{\n";
-                ChFrame<> nullframe(CSYSNORM);
-                _recurseExportObjData(mdata[i]->GetAssets(), nullframe, mfilepov);
-                mfilepov << "  quatRotation(<aq0,aq1,aq2,aq3>)\n";
-                mfilepov << "  translate(<apx,apy,apz>)\n";
-                mfilepov << "  }\n";
-                mfilepov << "  #declare Index = Index + 1; \n";
-                mfilepov << "#end \n";
-                // mfilepov << "} \n";
-
-                // Loop on all particle clones
-                for (unsigned int m = 0; m < myclones->GetNparticles(); ++m) {
-                    // Get the current coordinate frame of the i-th particle
-                    ChCoordsys<> assetcsys = CSYSNORM;
-                    assetcsys = myclones->GetParticle(m).GetCoord();
-
-                    mfiledat << assetcsys.pos.x() << ", ";
-                    mfiledat << assetcsys.pos.y() << ", ";
-                    mfiledat << assetcsys.pos.z() << ", ";
-                    mfiledat << assetcsys.rot.e0() << ", ";
-                    mfiledat << assetcsys.rot.e1() << ", ";
-                    mfiledat << assetcsys.rot.e2() << ", ";
-                    mfiledat << assetcsys.rot.e3() << ", \n";
-                }  // end loop on particles
-            }
-
-            // #) saving a ChLinkMateGeneric constraint ?
-            if (auto mylinkmate = std::dynamic_pointer_cast<ChLinkMateGeneric>(mdata[i])) {
-                if (mylinkmate->GetBody1() && mylinkmate->GetBody2() && this->links_show) {
-                    ChFrame<> frAabs = mylinkmate->GetFrame1() >> *mylinkmate->GetBody1();
-                    ChFrame<> frBabs = mylinkmate->GetFrame2() >> *mylinkmate->GetBody2();
-                    mfilepov << "sh_csysFRM(";
-                    mfilepov << frAabs.GetPos().x() << "," << frAabs.GetPos().y() << "," << frAabs.GetPos().z() << ",";
-                    mfilepov << frAabs.GetRot().e0() << "," << frAabs.GetRot().e1() << "," << frAabs.GetRot().e2() << ","
-                             << frAabs.GetRot().e3() << ",";
-                    mfilepov << this->links_size * 0.7 << ")\n";  // smaller, as 'slave' csys.
-                    mfilepov << "sh_csysFRM(";
-                    mfilepov << frBabs.GetPos().x() << "," << frBabs.GetPos().y() << "," << frBabs.GetPos().z() << ",";
-                    mfilepov << frBabs.GetRot().e0() << "," << frBabs.GetRot().e1() << "," << frBabs.GetRot().e2() << ","
-                             << frBabs.GetRot().e3() << ",";
-                    mfilepov << this->links_size << ")\n";
-                }
-            }
+        // Format the items in parallel, each in its own buffers, then write
+        // the buffers in the original order.
+        int nitems = (int)frame.items.size();
+        std::vector<std::vector<char> > pov_chunks(nitems);
+        std::vector<std::vector<char> > dat_chunks(nitems);
+
+#pragma omp parallel for schedule(dynamic, 16)
+        for (int i = 0; i < nitems; i++) {
+            ChStreamOutAsciiVector mpov(&pov_chunks[i]);
+            ChStreamOutAsciiVector mdat(&dat_chunks[i]);
+            WriteItemData(frame, frame.items[i], mpov, mdat);
+        }
 
-        }  // end loop on objects
+        for (int i = 0; i < nitems; i++) {
+            if (!pov_chunks[i].empty())
+                mfilepov.Write(pov_chunks[i].data(), pov_chunks[i].size());
+            if (!dat_chunks[i].empty())
+                mfiledat.Write(dat_chunks[i].data(), dat_chunks[i].size());
+        }
 
         // #) saving contacts ?
-        if (this->contacts_show) {
-              char pathcontacts[200];
-              sprintf(pathcontacts, "%s.contacts", filename.c_str());
-              ChStreamOutAsciiFile data_contacts(pathcontacts);
-
-              class _reporter_class : public ChContactContainer::ReportContactCallback {
-                public:
-                  virtual bool OnReportContact(
-                      const ChVector<>& pA,             // contact pA
-                      const ChVector<>& pB,             // contact pB
-                      const ChMatrix33<>& plane_coord,  // contact plane coordsystem (A column 'X' is contact normal)
-                      const double& distance,           // contact distance
-                      const ChVector<>& react_forces,   // react.forces (in coordsystem 'plane_coord')
-                      const ChVector<>& react_torques,  // react.torques (if rolling friction)
-                      ChContactable* contactobjA,       // model A (note: could be nullptr)
-                      ChContactable* contactobjB        // model B (note: could be nullptr)
-                      ) override {
-                      if (fabs(react_forces.x()) > 1e-8 || fabs(react_forces.y()) > 1e-8 ||
-                          fabs(react_forces.z()) > 1e-8) {
-                          ChMatrix33<> localmatr(plane_coord);
-                          ChVector<> n1 = localmatr.Get_A_Xaxis();
-                          ChVector<> absreac = localmatr * react_forces;
-                          (*mfile) << pA.x() << ", ";
-                          (*mfile) << pA.y() << ", ";
-                          (*mfile) << pA.z() << ", ";
-                          (*mfile) << n1.x() << ", ";
-                          (*mfile) << n1.y() << ", ";
-                          (*mfile) << n1.z() << ", ";
-                          (*mfile) << absreac.x() << ", ";
-                          (*mfile) << absreac.y() << ", ";
-                          (*mfile) << absreac.z() << ", \n";
-                      }
-                      return true;  // to continue scanning contacts
-                  }
-                  // Data
-                  ChStreamOutAsciiFile* mfile;
-              };
-
-              _reporter_class my_contact_reporter;
-              my_contact_reporter.mfile = &data_contacts;
-
-              // scan all contacts
-              this->mSystem->GetContactContainer()->ReportAllContacts(&my_contact_reporter);
+        if (frame.contacts_show) {
+            std::string pathcontacts = frame.filename + ".contacts";
+            ChStreamOutAsciiFile data_contacts(pathcontacts.c_str());
+            for (size_t ic = 0; ic + 9 <= frame.contacts.size(); ic += 9) {
+                for (size_t j = 0; j < 8; j++)
+                    data_contacts << frame.contacts[ic + j] << ", ";
+                data_contacts << frame.contacts[ic + 8] << ", \n";
+            }
         }
 
         // If a camera have been found in assets, create it and override the default one
-        if (this->camera_found_in_assets) {
-            mfilepov << "camera { \n";
-            if (camera_orthographic) {
-                mfilepov << " orthographic \n";
-                mfilepov << " right x * " << (camera_location - camera_aim).Length() << " * tan ((( " << camera_angle
-                         << " *0.5)/180)*3.14) \n";
-                mfilepov << " up y * image_height/image_width * " << (camera_location - camera_aim).Length()
-                         << " * tan (((" << camera_angle << "*0.5)/180)*3.14) \n";
-                ChVector<> mdir = (camera_aim - camera_location) * 0.00001;
-                mfilepov << " direction <" << mdir.x() << "," << mdir.y() << "," << mdir.z() << "> \n";
-            } else {
-                mfilepov << " right -x*image_width/image_height \n";
-                mfilepov << " angle " << camera_angle << " \n";
-            }
-            mfilepov << " location <" << camera_location.x() << "," << camera_location.y() << "," << camera_location.z()
-                     << "> \n"
-                     << " look_at <" << camera_aim.x() << "," << camera_aim.y() << "," << camera_aim.z() << "> \n"
-                     << " sky <" << camera_up.x() << "," << camera_up.y() << "," << camera_up.z() << "> \n";
-            mfilepov << "}\n\n\n";
-        }
+        if (!frame.camera.empty())
+            mfilepov.Write(frame.camera.data(), frame.camera.size());
 
         // At the end of the .pov file, remember to close the .dat
         mfilepov << "\n\n#fclose MyDatFile \n";
     } catch (ChException) {
         char error[400];
-        sprintf(error, "Can't save data into file %s.pov (or .dat)", filename.c_str());
+        sprintf(error, "Can't save data into file %s.pov (or .dat)", frame.filename.c_str());
         throw(ChException(error));
     }
+}
+
+void ChPovRay::ExportData(const std::string& filename) {
+    // Take the snapshot on the calling thread; the files are written either
+    // right away, or by the background writer thread.
+    std::unique_ptr<FrameData> frame(new FrameData);
+    this->CaptureData(filename, *frame);
+
+    if (async_export) {
+        std::unique_lock<std::mutex> lock(writer_mutex);
+        if (!writer_error.empty()) {
+            std::string error = writer_error;
+            writer_error.clear();
+            throw(ChException(error));
+        }
+        writer_cv_space.wait(lock, [this]() { return writer_queue.size() < max_queued_frames; });
+        writer_queue.push_back(std::move(frame));
+        lock.unlock();
+        writer_cv_work.notify_one();
+    } else {
+        WriteData(*frame);
+    }
 
     // Increment the number of the frame.
     this->framenumber++;
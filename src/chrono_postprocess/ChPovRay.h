@@ -15,10 +15,16 @@
 #ifndef CHPOVRAY_H
 #define CHPOVRAY_H
 
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "chrono/assets/ChVisualization.h"
 #include "chrono/physics/ChSystem.h"
@@ -38,7 +44,9 @@ namespace postprocess {
 class ChApiPostProcess ChPovRay : public ChPostProcessBase {
   public:
     ChPovRay(ChSystem* system);
-    virtual ~ChPovRay() {}
+
+    /// Write all pending frames (if using asynchronous export) and stop the writer thread.
+    virtual ~ChPovRay();
 
     enum eChContactSymbol {  // used for displaying contacts
         SYMBOL_VECTOR_SCALELENGTH = 0,
@@ -199,21 +207,101 @@ class ChApiPostProcess ChPovRay : public ChPostProcessBase {
     /// single large file "rendering_frames.pov.assets". If not, assets will be written inside 
     /// each state0001.dat, state0002.dat, etc files; this would waste more disk space but would be
     /// a bit faster in POV parsing and would allow assets whose settings change during time (ex time-changing colors)
+    /// In this mode, also the tree of shapes of each rendered item is written only once in the assets
+    /// file (as a POV macro), so that the files of the single timesteps contain only the positions.
     void SetUseSingleAssetFile(bool muse) {
         this->single_asset_file = muse;
     }
 
+    /// Turn on/off the asynchronous export of the data files (default: off).
+    /// If on, ExportData() only takes a snapshot of the positions of the rendered items (and of the
+    /// contacts, if shown) and returns; the .pov, .dat and .contacts files are formatted and written
+    /// by a background thread. At most 'max_queued_frames' snapshots are kept in memory: if the writer
+    /// falls behind, ExportData() waits until a frame has been written.
+    void SetAsyncExport(bool async, size_t max_queued_frames = 2);
+
+    /// Wait until all the frames enqueued by ExportData() have been written.
+    /// An error occurred in the background writer is re-thrown here as a ChException.
+    void Flush();
+
   protected:
+    /// Snapshot of the time-dependent data of one rendered item.
+    struct ItemData {
+        enum Type { OTHER, BODY, PARTICLES, LINK };
+        Type type;
+        std::vector<char> shapes;              ///< POV calls to the shape and material macros of the item
+        ChCoordsys<> csys;                     ///< body reference frame
+        ChCoordsys<> cog;                      ///< body center of mass frame
+        ChCoordsys<> frameA;                   ///< link frame on body 1
+        ChCoordsys<> frameB;                   ///< link frame on body 2
+        std::vector<ChCoordsys<> > particles;  ///< particle frames
+    };
+
+    /// Snapshot of all the data written by one ExportData() call.
+    struct FrameData {
+        std::string filename;          ///< base name of the .pov, .dat and .contacts files
+        std::vector<char> header;      ///< embedded assets and custom commands
+        std::vector<ItemData> items;   ///< rendered items
+        std::vector<double> contacts;  ///< 9 values (point, normal, force) per contact
+        std::vector<char> camera;      ///< camera declared in the assets, if any
+        bool COGs_show;
+        double COGs_size;
+        bool frames_show;
+        double frames_size;
+        double links_size;
+        bool contacts_show;
+    };
+
     virtual void SetupLists();
-    virtual void ExportAssets(ChStreamOutAsciiFile& assets_file);
-    void _recurseExportAssets(std::vector<std::shared_ptr<ChAsset> >& assetlist, ChStreamOutAsciiFile& assets_file);
+    virtual void ExportAssets(ChStreamOutAscii& assets_file);
+    void _recurseExportAssets(std::vector<std::shared_ptr<ChAsset> >& assetlist, ChStreamOutAscii& assets_file);
 
+    /// Write the calls to the shape and material macros of an asset tree (without the enclosing
+    /// union and transformation). Asset levels are written as nested unions.
     void _recurseExportObjData(std::vector<std::shared_ptr<ChAsset> >& assetlist,
                                ChFrame<> parentframe,
-                               ChStreamOutAsciiFile& mfilepov);
+                               ChStreamOutAscii& mfilepov);
+
+    /// Append to 'stamp' the addresses of the assets of an asset tree and the frames of its asset levels,
+    /// which determine the output of _recurseExportObjData. Also sets the camera, if found in the tree.
+    void _recurseAssetStamp(std::vector<std::shared_ptr<ChAsset> >& assetlist,
+                            const ChFrame<>& parentframe,
+                            std::vector<uint64_t>& stamp);
+
+    /// Write in 'shapes' the POV code that builds the asset tree of an item. If using a single asset
+    /// file, the tree is declared once as a macro in 'macros' and 'shapes' only calls that macro.
+    void ExportItemShapes(std::shared_ptr<ChPhysicsItem> item,
+                          const ChFrame<>& frame,
+                          std::vector<char>& shapes,
+                          ChStreamOutAscii& macros);
+
+    /// Fill the snapshot of the current state of the system (called on the simulation thread).
+    virtual void CaptureData(const std::string& filename, FrameData& frame);
+
+    /// Format and write the files of a snapshot (items are formatted in parallel).
+    static void WriteData(const FrameData& frame);
+
+    /// Format the data of one item in the .pov and .dat buffers.
+    static void WriteItemData(const FrameData& frame,
+                              const ItemData& item,
+                              ChStreamOutAscii& mfilepov,
+                              ChStreamOutAscii& mfiledat);
+
+    /// Loop of the background writer thread.
+    void ProcessQueue();
 
     std::vector<std::shared_ptr<ChPhysicsItem> > mdata;
     std::unordered_map<size_t, std::shared_ptr<ChAsset> > pov_assets;
+    /// Cached tree of shapes of a rendered item.
+    struct ItemShapes {
+        ItemShapes() : version(0) {}
+        std::vector<uint64_t> stamp;  ///< stamp of the asset tree (see _recurseAssetStamp)
+        std::vector<char> tree;       ///< POV code of the tree of shapes
+        unsigned int version;         ///< version of the macro declaring the tree
+    };
+
+    std::unordered_map<size_t, ItemShapes> pov_items;
+    std::vector<uint64_t> asset_stamp;  ///< buffer for the stamp of the current item
 
     std::string template_filename;
     std::string pic_filename;
@@ -262,6 +350,17 @@ class ChApiPostProcess ChPovRay : public ChPostProcessBase {
     std::string custom_data;
 
     bool single_asset_file;
+
+    bool async_export;
+    size_t max_queued_frames;
+    std::thread writer_thread;
+    std::mutex writer_mutex;
+    std::condition_variable writer_cv_work;   ///< signaled when a frame is enqueued or the writer is stopped
+    std::condition_variable writer_cv_space;  ///< signaled when a frame has been written
+    std::deque<std::unique_ptr<FrameData> > writer_queue;
+    bool writer_busy;
+    bool writer_stop;
+    std::string writer_error;
 };
 
 }  // end namespace postprocess
@@ -19,6 +19,8 @@
 #ifndef CH_TERRAIN_H
 #define CH_TERRAIN_H
 
+#include <vector>
+
 #include "chrono/core/ChVector.h"
 
 #include "chrono_vehicle/ChApiVehicle.h"
@@ -47,6 +49,20 @@ class CH_VEHICLE_API ChTerrain {
 
     /// Get the terrain normal at the specified (x,y) location.
     virtual ChVector<> GetNormal(double x, double y) const = 0;
+
+    /// Get the terrain heights and normals at several (x,y) locations (the Z components are ignored).
+    /// The default implementation calls GetHeight and GetNormal at each location.
+    virtual void GetHeightsAndNormals(const std::vector<ChVector<> >& loc,  ///< [in] query locations
+                                      std::vector<double>& heights,         ///< [out] terrain heights
+                                      std::vector<ChVector<> >& normals     ///< [out] terrain normals
+                                      ) const {
+        heights.resize(loc.size());
+        normals.resize(loc.size());
+        for (size_t i = 0; i < loc.size(); i++) {
+            heights[i] = GetHeight(loc[i].x(), loc[i].y());
+            normals[i] = GetNormal(loc[i].x(), loc[i].y());
+        }
+    }
 };
 
 /// @} vehicle_terrain
@@ -157,19 +157,16 @@ class BoundaryContact : public ChSystem::CustomCollisionCallback {
 };
 
 void BoundaryContact::OnCustomCollision(ChSystem* system) {
-    auto bodylist = system->Get_bodylist();
-    for (size_t i = 0; i < bodylist->size(); ++i) {
-        auto body = (*bodylist)[i].get();
+    for (const auto& particle : m_terrain->m_particles) {
+        auto body = particle.get();
         auto center = body->GetPos();
-        if (body->GetIdentifier() > m_terrain->m_start_id) {
-            CheckBottom(body, center);
-            CheckLeft(body, center);
-            CheckRight(body, center);
-            CheckFront(body, center);
-            CheckRear(body, center);
-            if (m_terrain->m_rough_surface)
-                CheckFixedSpheres(body, center);
-        }
+        CheckBottom(body, center);
+        CheckLeft(body, center);
+        CheckRight(body, center);
+        CheckFront(body, center);
+        CheckRear(body, center);
+        if (m_terrain->m_rough_surface)
+            CheckFixedSpheres(body, center);
     }
 }
 
@@ -439,6 +436,14 @@ void GranularTerrain::Initialize(const ChVector<>& center,
         m_num_particles = generator.getTotalNumBodies();
     }
 
+    // Collect the particles in a pool, in the order of the system body list.
+    m_particles.clear();
+    m_particles.reserve(m_num_particles);
+    for (const auto& body : *m_ground->GetSystem()->Get_bodylist()) {
+        if (body->GetIdentifier() > m_start_id)
+            m_particles.push_back(body);
+    }
+
     // If enabled, create visualization assets for the boundaries.
     if (m_vis_enabled) {
         auto box = std::make_shared<ChBoxShape>();
@@ -470,14 +475,19 @@ void GranularTerrain::Synchronize(double time) {
     // Shift rear boundary.
     m_rear += m_shift_distance;
 
-    // Count particles that must be relocated.
-    unsigned int num_moved_particles = 0;
-    auto bodylist = m_ground->GetSystem()->Get_bodylist();
-    for (auto body : *bodylist) {
-        if (body->GetIdentifier() > m_start_id && body->GetPos().x() - m_radius < m_rear) {
-            num_moved_particles++;
-        }
+    // Find the particles that must be relocated, in pool order.
+    int num_particles = (int)m_particles.size();
+    std::vector<char> behind(num_particles);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < num_particles; i++) {
+        behind[i] = m_particles[i]->GetPos().x() - m_radius < m_rear;
+    }
+    std::vector<int> moved;
+    for (int i = 0; i < num_particles; i++) {
+        if (behind[i])
+            moved.push_back(i);
     }
+    unsigned int num_moved_particles = (unsigned int)moved.size();
 
     // Create a Poisson Disk sampler and generate points in layers within the relocation volume.
     std::vector<ChVector<>> new_points;
@@ -492,12 +502,11 @@ void GranularTerrain::Synchronize(double time) {
     }
 
     // Relocate particles at their new locations.
-    size_t ip = 0;
-    for (auto body : *bodylist) {
-        if (body->GetIdentifier() > m_start_id && body->GetPos().x() - m_radius < m_rear) {
-            body->SetPos(new_points[ip++]);
-            body->SetPos_dt(m_init_part_vel);
-        }
+    // The collision models of all bodies are synchronized with their new positions at the next collision detection.
+#pragma omp parallel for schedule(static)
+    for (int ip = 0; ip < (int)num_moved_particles; ip++) {
+        m_particles[moved[ip]]->SetPos(new_points[ip]);
+        m_particles[moved[ip]]->SetPos_dt(m_init_part_vel);
     }
 
     // Shift front boundary.
@@ -513,11 +522,10 @@ void GranularTerrain::Synchronize(double time) {
 }
 
 double GranularTerrain::GetHeight(double x, double y) const {
-    auto bodylist = m_ground->GetSystem()->Get_bodylist();
     double highest = m_bottom;
-    for (auto body : *bodylist) {
-        if (body->GetIdentifier() > m_start_id && body->GetPos().z() > highest)
-            highest = body->GetPos().z();
+    for (const auto& particle : m_particles) {
+        if (particle->GetPos().z() > highest)
+            highest = particle->GetPos().z();
     }
     return highest + m_radius;
 }
@@ -28,6 +28,8 @@
 #ifndef GRANULAR_TERRAIN_H
 #define GRANULAR_TERRAIN_H
 
+#include <vector>
+
 #include "chrono/assets/ChColorAsset.h"
 #include "chrono/physics/ChBody.h"
 
@@ -105,7 +107,7 @@ class CH_VEHICLE_API GranularTerrain : public ChTerrain {
                            );
 
     /// Set start value for body identifiers of generated particles (default: 1000000).
-    /// It is assumed that all bodies with a larger identifier are granular material particles.
+    /// It is assumed that all bodies with a larger identifier at initialization are granular material particles.
     void SetStartIdentifier(int id) { m_start_id = id; }
 
     /// Get coefficient of friction for contact material.
@@ -171,6 +173,9 @@ class CH_VEHICLE_API GranularTerrain : public ChTerrain {
     /// Get the number of particles.
     unsigned int GetNumParticles() const { return m_num_particles; }
 
+    /// Get the granular material particles, in creation order.
+    const std::vector<std::shared_ptr<ChBody>>& GetParticles() const { return m_particles; }
+
     /// Get the terrain height at the specified (x,y) location.
     /// This function returns the heighest point over all granular particles.
     virtual double GetHeight(double x, double y) const override;
@@ -183,6 +188,8 @@ class CH_VEHICLE_API GranularTerrain : public ChTerrain {
     int m_start_id;                ///< start body identifier for particles
     double m_radius;               ///< particle radius
 
+    std::vector<std::shared_ptr<ChBody>> m_particles;  ///< pool of particles, recycled when the patch moves
+
     // Patch dimensions
     double m_length;  ///< length (X direction) of granular patch
     double m_width;   ///< width (Y direction) of granular patch
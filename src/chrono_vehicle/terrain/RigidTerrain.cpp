@@ -24,6 +24,7 @@
 #include "chrono/assets/ChTexture.h"
 #include "chrono/assets/ChBoxShape.h"
 #include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/collision/ChCModelBullet.h"
 #include "chrono/utils/ChUtilsInputOutput.h"
 
 #include "chrono_vehicle/ChVehicleModelData.h"
@@ -268,6 +269,7 @@ void RigidTerrain::Initialize(double height, double sizeX, double sizeY, bool ti
         m_ground->AddAsset(box);
     }
 
+    m_mesh.reset();
     m_type = FLAT;
     m_height = height;
 }
@@ -276,25 +278,7 @@ void RigidTerrain::Initialize(double height, double sizeX, double sizeY, bool ti
 // Initialize the terrain from a specified mesh file.
 // -----------------------------------------------------------------------------
 void RigidTerrain::Initialize(const std::string& mesh_file, const std::string& mesh_name, double sweep_sphere_radius) {
-    m_trimesh.LoadWavefrontMesh(mesh_file, true, true);
-
-    // Create the visualization asset.
-    if (m_vis_enabled) {
-        auto trimesh_shape = std::make_shared<ChTriangleMeshShape>();
-        trimesh_shape->SetMesh(m_trimesh);
-        trimesh_shape->SetName(mesh_name);
-        m_ground->AddAsset(trimesh_shape);
-    }
-
-    // Create contact geometry.
-    m_ground->GetCollisionModel()->ClearModel();
-    m_ground->GetCollisionModel()->AddTriangleMesh(m_trimesh, true, false, ChVector<>(0, 0, 0), ChMatrix33<>(1), sweep_sphere_radius);
-    m_ground->GetCollisionModel()->BuildModel();
-
-    ApplyContactMaterial();
-
-    m_mesh_name = mesh_name;
-    m_type = MESH;
+    Initialize(std::make_shared<RigidTerrainMesh>(mesh_file, mesh_name, sweep_sphere_radius));
 }
 
 // -----------------------------------------------------------------------------
@@ -306,6 +290,144 @@ void RigidTerrain::Initialize(const std::string& heightmap_file,
                               double sizeY,
                               double hMin,
                               double hMax) {
+    Initialize(std::make_shared<RigidTerrainMesh>(heightmap_file, mesh_name, sizeX, sizeY, hMin, hMax));
+}
+
+// -----------------------------------------------------------------------------
+// Initialize the terrain from a (possibly shared) terrain mesh.
+// -----------------------------------------------------------------------------
+void RigidTerrain::Initialize(std::shared_ptr<RigidTerrainMesh> mesh) {
+    // Use the shared visualization asset.
+    if (m_vis_enabled) {
+        m_ground->AddAsset(mesh->GetMeshShape());
+    }
+
+    // Create contact geometry, sharing the contact shapes if the ground uses the same type of collision model.
+    auto model = m_ground->GetCollisionModel();
+    model->ClearModel();
+    if (dynamic_cast<collision::ChModelBullet*>(model.get())) {
+        model->AddCopyOfAnotherModel(mesh->GetCollisionModel().get());
+    } else {
+        model->AddTriangleMesh(mesh->GetTriangleMesh(), true, false, ChVector<>(0, 0, 0), ChMatrix33<>(1),
+                               mesh->GetSweepSphereRadius());
+    }
+    model->BuildModel();
+
+    ApplyContactMaterial();
+
+    m_mesh = mesh;
+    m_type = mesh->IsHeightMap() ? HEIGHT_MAP : MESH;
+}
+
+// -----------------------------------------------------------------------------
+// Export the terrain mesh (if any) as a macro in a PovRay include file.
+// -----------------------------------------------------------------------------
+void RigidTerrain::ExportMeshPovray(const std::string& out_dir) {
+    switch (m_type) {
+        case MESH:
+            utils::WriteMeshPovray(m_mesh->GetTriangleMesh(), m_mesh->GetName(), out_dir, ChColor(1, 1, 1));
+            break;
+        case HEIGHT_MAP:
+            utils::WriteMeshPovray(m_mesh->GetTriangleMesh(), m_mesh->GetName(), out_dir, ChColor(1, 1, 1),
+                                   ChVector<>(0, 0, 0), ChQuaternion<>(1, 0, 0, 0), true);
+            break;
+        default:
+                break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Return the terrain height and normal at the specified location.
+// For a mesh terrain, this is the same as casting a ray into the terrain mesh from below.
+// -----------------------------------------------------------------------------
+double RigidTerrain::GetHeight(double x, double y) const {
+    switch (m_type) {
+        case FLAT:
+            return m_height;
+        case MESH:
+        case HEIGHT_MAP: {
+            double height;
+            ChVector<> normal;
+            return m_mesh->GetHeightIndex().Query(x, y, height, normal) ? height : 0.0;
+        }
+        default:
+            return 0;
+    }
+}
+
+ChVector<> RigidTerrain::GetNormal(double x, double y) const {
+    switch (m_type) {
+        case FLAT:
+            return ChVector<>(0, 0, 1);
+        case MESH:
+        case HEIGHT_MAP: {
+            double height;
+            ChVector<> normal;
+            return m_mesh->GetHeightIndex().Query(x, y, height, normal) ? normal : ChVector<>(0, 0, 1);
+        }
+        default:
+            return ChVector<>(0, 0, 1);
+    }
+}
+
+const TerrainHeightIndex& RigidTerrain::GetHeightIndex() const {
+    static const TerrainHeightIndex empty_index;
+    return m_mesh ? m_mesh->GetHeightIndex() : empty_index;
+}
+
+void RigidTerrain::GetHeightsAndNormals(const std::vector<ChVector<> >& loc,
+                                        std::vector<double>& heights,
+                                        std::vector<ChVector<> >& normals) const {
+    switch (m_type) {
+        case MESH:
+        case HEIGHT_MAP:
+            m_mesh->GetHeightIndex().Query(loc, heights, normals);
+            break;
+        default:
+            heights.assign(loc.size(), m_height);
+            normals.assign(loc.size(), ChVector<>(0, 0, 1));
+            break;
+    }
+}
+
+// =============================================================================
+// Shared terrain mesh
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// Load the terrain mesh from a Wavefront OBJ file.
+// -----------------------------------------------------------------------------
+RigidTerrainMesh::RigidTerrainMesh(const std::string& mesh_file,
+                                   const std::string& mesh_name,
+                                   double sweep_sphere_radius)
+    : m_heightmap(false), m_sweep_sphere_radius(sweep_sphere_radius) {
+    m_shape = std::make_shared<ChTriangleMeshShape>();
+    m_shape->SetName(mesh_name);
+
+    geometry::ChTriangleMeshConnected& trimesh = m_shape->GetMesh();
+    trimesh.LoadWavefrontMesh(mesh_file, true, true);
+
+    CreateCollisionModel();
+
+    // Create the height index.
+    m_index.Build(trimesh.getCoordsVertices(), trimesh.getIndicesVertexes());
+}
+
+// -----------------------------------------------------------------------------
+// Create the terrain mesh from a height map.
+// -----------------------------------------------------------------------------
+RigidTerrainMesh::RigidTerrainMesh(const std::string& heightmap_file,
+                                   const std::string& mesh_name,
+                                   double sizeX,
+                                   double sizeY,
+                                   double hMin,
+                                   double hMax)
+    : m_heightmap(true), m_sweep_sphere_radius(0) {
+    m_shape = std::make_shared<ChTriangleMeshShape>();
+    m_shape->SetName(mesh_name);
+
+    geometry::ChTriangleMeshConnected& trimesh = m_shape->GetMesh();
+
     // Read the BMP file and extract number of pixels.
     BMP hmap;
     if (!hmap.ReadFromFile(heightmap_file.c_str())) {
@@ -329,22 +451,25 @@ void RigidTerrain::Initialize(const std::string& heightmap_file,
     unsigned int n_faces = 2 * (nv_x - 1) * (nv_y - 1);
 
     // Resize mesh arrays.
-    m_trimesh.getCoordsVertices().resize(n_verts);
-    m_trimesh.getCoordsNormals().resize(n_verts);
-    m_trimesh.getCoordsUV().resize(n_verts);
-    m_trimesh.getCoordsColors().resize(n_verts);
+    trimesh.getCoordsVertices().resize(n_verts);
+    trimesh.getCoordsNormals().resize(n_verts);
+    trimesh.getCoordsUV().resize(n_verts);
+    trimesh.getCoordsColors().resize(n_verts);
 
-    m_trimesh.getIndicesVertexes().resize(n_faces);
-    m_trimesh.getIndicesNormals().resize(n_faces);
+    trimesh.getIndicesVertexes().resize(n_faces);
+    trimesh.getIndicesNormals().resize(n_faces);
 
     // Initialize the array of accumulators (number of adjacent faces to a vertex)
     std::vector<int> accumulators(n_verts, 0);
 
     // Readability aliases
-    std::vector<ChVector<> >& vertices = m_trimesh.getCoordsVertices();
-    std::vector<ChVector<> >& normals = m_trimesh.getCoordsNormals();
-    std::vector<ChVector<int> >& idx_vertices = m_trimesh.getIndicesVertexes();
-    std::vector<ChVector<int> >& idx_normals = m_trimesh.getIndicesNormals();
+    std::vector<ChVector<> >& vertices = trimesh.getCoordsVertices();
+    std::vector<ChVector<> >& normals = trimesh.getCoordsNormals();
+    std::vector<ChVector<int> >& idx_vertices = trimesh.getIndicesVertexes();
+    std::vector<ChVector<int> >& idx_normals = trimesh.getIndicesNormals();
+
+    // Heights of the vertices, for the height index.
+    std::vector<double> heights(n_verts);
 
     // Load mesh vertices.
     // Note that pixels in a BMP start at top-left corner.
@@ -365,12 +490,13 @@ void RigidTerrain::Initialize(const std::string& heightmap_file,
             double z = hMin + gray * h_scale;
             // Set vertex location
             vertices[iv] = ChVector<>(x, y, z);
+            heights[iv] = z;
             // Initialize vertex normal to (0, 0, 0).
             normals[iv] = ChVector<>(0, 0, 0);
             // Assign color white to all vertices
-            m_trimesh.getCoordsColors()[iv] = ChVector<float>(1, 1, 1);
+            trimesh.getCoordsColors()[iv] = ChVector<float>(1, 1, 1);
             // Set UV coordinates in [0,1] x [0,1]
-            m_trimesh.getCoordsUV()[iv] = ChVector<>(ix * x_scale, iy * y_scale, 0.0);
+            trimesh.getCoordsUV()[iv] = ChVector<>(ix * x_scale, iy * y_scale, 0.0);
             ++iv;
         }
     }
@@ -413,79 +539,20 @@ void RigidTerrain::Initialize(const std::string& heightmap_file,
         normals[in] /= (double)accumulators[in];
     }
 
-    // Create the visualization asset.
-    if (m_vis_enabled) {
-        auto trimesh_shape = std::make_shared<ChTriangleMeshShape>();
-        trimesh_shape->SetMesh(m_trimesh);
-        trimesh_shape->SetName(mesh_name);
-        m_ground->AddAsset(trimesh_shape);
-    }
-
-    // Create contact geometry.
-    m_ground->GetCollisionModel()->ClearModel();
-    m_ground->GetCollisionModel()->AddTriangleMesh(m_trimesh, true, false, ChVector<>(0, 0, 0));
-    m_ground->GetCollisionModel()->BuildModel();
+    CreateCollisionModel();
 
-    ApplyContactMaterial();
-
-    m_mesh_name = mesh_name;
-    m_type = HEIGHT_MAP;
+    // Create the height index, with the same triangulation as the mesh.
+    m_index.BuildGrid(-0.5 * sizeX, -0.5 * sizeY, dx, dy, nv_x, nv_y, heights);
 }
 
 // -----------------------------------------------------------------------------
-// Export the terrain mesh (if any) as a macro in a PovRay include file.
+// Create the contact shapes of the mesh, in a collision model not attached to any body.
+// The shapes keep pointers to the mesh vertices, which are never modified after construction.
 // -----------------------------------------------------------------------------
-void RigidTerrain::ExportMeshPovray(const std::string& out_dir) {
-    switch (m_type) {
-        case MESH:
-            utils::WriteMeshPovray(m_trimesh, m_mesh_name, out_dir, ChColor(1, 1, 1));
-            break;
-        case HEIGHT_MAP:
-            utils::WriteMeshPovray(m_trimesh, m_mesh_name, out_dir, ChColor(1, 1, 1), ChVector<>(0, 0, 0),
-                                   ChQuaternion<>(1, 0, 0, 0), true);
-            break;
-        default:
-                break;
-    }
-}
-
-// -----------------------------------------------------------------------------
-// Return the terrain height and normal at the specified location.
-// This is done by casting a ray into the collision model from below, 
-// assuming that there are no other contact shapes under the terrain.
-// -----------------------------------------------------------------------------
-double RigidTerrain::GetHeight(double x, double y) const {
-    switch (m_type) {
-        case FLAT:
-            return m_height;
-        case MESH:
-        case HEIGHT_MAP: {
-            collision::ChCollisionSystem::ChRayhitResult result;
-            m_ground->GetSystem()->GetCollisionSystem()->RayHit(ChVector<>(x, y, -1000), ChVector<>(x, y, +1000),
-                                                                result);
-
-            return result.hit ? result.abs_hitPoint.z() : 0.0;
-        }
-        default:
-            return 0;
-    }
-}
-
-ChVector<> RigidTerrain::GetNormal(double x, double y) const {
-    switch (m_type) {
-        case FLAT:
-            return ChVector<>(0, 0, 1);
-        case MESH:
-        case HEIGHT_MAP: {
-            collision::ChCollisionSystem::ChRayhitResult result;
-            m_ground->GetSystem()->GetCollisionSystem()->RayHit(ChVector<>(x, y, -1000), ChVector<>(x, y, +1000),
-                                                                result);
-
-            return result.hit ? -result.abs_hitNormal : ChVector<>(0, 0, 1);
-        }
-        default:
-            return ChVector<>(0, 0, 1);
-    }
+void RigidTerrainMesh::CreateCollisionModel() {
+    m_model = std::make_shared<collision::ChModelBullet>();
+    m_model->AddTriangleMesh(m_shape->GetMesh(), true, false, ChVector<>(0, 0, 0), ChMatrix33<>(1),
+                             m_sweep_sphere_radius);
 }
 
 }  // end namespace vehicle
@@ -19,16 +19,19 @@
 #ifndef RIGID_TERRAIN_H
 #define RIGID_TERRAIN_H
 
+#include <memory>
 #include <string>
 
 #include "chrono/assets/ChColor.h"
 #include "chrono/assets/ChColorAsset.h"
+#include "chrono/assets/ChTriangleMeshShape.h"
 #include "chrono/geometry/ChTriangleMeshConnected.h"
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChSystem.h"
 
 #include "chrono_vehicle/ChApiVehicle.h"
 #include "chrono_vehicle/ChTerrain.h"
+#include "chrono_vehicle/terrain/TerrainHeightIndex.h"
 
 namespace chrono {
 namespace vehicle {
@@ -36,6 +39,8 @@ namespace vehicle {
 /// @addtogroup vehicle_terrain
 /// @{
 
+class RigidTerrainMesh;
+
 /// Rigid terrain model.
 /// This class implements a terrain modeled as a rigid shape which can interact
 /// through contact and friction with any other bodies whose contact flag is
@@ -146,24 +151,47 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
                     double hMax                         ///< [in] maximum height (white level)
                     );
 
+    /// Initialize the terrain system (shared mesh).
+    /// This version uses a terrain mesh (loaded from a mesh file or created from a height map) which can be shared
+    /// by several RigidTerrain objects, possibly in different systems. The mesh geometry, the contact shapes and
+    /// the height index are not copied, so that the initialization is cheap. The mesh must not be modified while
+    /// in use; it is kept alive by this terrain, which must itself outlive the simulation of its system.
+    /// The ground body must not be moved (it is fixed at the origin by the constructor): the height index of the
+    /// shared mesh is expressed in the absolute frame.
+    void Initialize(std::shared_ptr<RigidTerrainMesh> mesh  ///< [in] shared terrain mesh
+                    );
+
     /// Export the terrain mesh (if any) as a macro in a PovRay include file.
     void ExportMeshPovray(const std::string& out_dir  ///< [in] output directory
                           );
 
     /// Get the terrain height at the specified (x,y) location.
+    /// For a mesh or height map terrain, this is the lowest point of the terrain surface at (x,y), or 0 if
+    /// (x,y) is outside the terrain. The queries use a height index of the terrain surface, built at
+    /// initialization, and can be called concurrently from several threads.
     virtual double GetHeight(double x, double y) const override;
 
     /// Get the terrain normal at the specified (x,y) location.
     virtual chrono::ChVector<> GetNormal(double x, double y) const override;
 
+    /// Get the terrain heights and normals at several (x,y) locations.
+    virtual void GetHeightsAndNormals(const std::vector<ChVector<> >& loc,
+                                      std::vector<double>& heights,
+                                      std::vector<ChVector<> >& normals) const override;
+
+    /// Return the height index of the terrain surface (empty for a flat terrain).
+    const TerrainHeightIndex& GetHeightIndex() const;
+
+    /// Return the terrain mesh (empty for a flat terrain).
+    std::shared_ptr<RigidTerrainMesh> GetMesh() const { return m_mesh; }
+
   private:
     Type m_type;
     bool m_vis_enabled;
     std::shared_ptr<ChBody> m_ground;
     std::shared_ptr<ChColorAsset> m_color;
-    geometry::ChTriangleMeshConnected m_trimesh;
-    std::string m_mesh_name;
     double m_height;
+    std::shared_ptr<RigidTerrainMesh> m_mesh;  ///< mesh or height map, possibly shared with other terrains
 
     float m_friction;       ///< contact coefficient of friction
     float m_restitution;    ///< contact coefficient of restitution
@@ -177,6 +205,65 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     void ApplyContactMaterial();
 };
 
+/// Terrain mesh for rigid terrain models, which can be shared by several RigidTerrain objects.
+/// The mesh data (geometry, visualization asset, contact shapes with their bounding volume tree, and height index)
+/// is built once, at construction, and is only read afterwards. The RigidTerrain objects initialized with the same
+/// mesh can therefore be used in independent systems simulated concurrently on separate threads, for example to
+/// run many vehicle scenarios on the same terrain in one process.
+/// Ground bodies with a Bullet collision model share the contact shapes; other ground bodies get their own contact
+/// geometry, built on the shared mesh. The collision envelope and safe margin of the shared contact shapes
+/// are the default ones (see ChCollisionModel::SetDefaultSuggestedEnvelope) at construction of the mesh.
+/// The mesh is given in the absolute frame, so the ground bodies of the terrains using it must not move.
+class CH_VEHICLE_API RigidTerrainMesh {
+  public:
+    /// Load the terrain mesh from a Wavefront OBJ file.
+    RigidTerrainMesh(const std::string& mesh_file,   ///< [in] filename of the input mesh (OBJ)
+                     const std::string& mesh_name,   ///< [in] name of the mesh asset
+                     double sweep_sphere_radius = 0  ///< [in] radius of sweep sphere
+                     );
+
+    /// Create the terrain mesh from a height map.
+    /// Each pixel of the BMP file is a mesh vertex, whose height is mapped from the gray level of the pixel.
+    RigidTerrainMesh(const std::string& heightmap_file,  ///< [in] filename for the height map (BMP)
+                     const std::string& mesh_name,       ///< [in] name of the mesh asset
+                     double sizeX,                       ///< [in] terrain dimension in the X direction
+                     double sizeY,                       ///< [in] terrain dimension in the Y direction
+                     double hMin,                        ///< [in] minimum height (black level)
+                     double hMax                         ///< [in] maximum height (white level)
+                     );
+
+    /// Return true if the mesh was created from a height map.
+    bool IsHeightMap() const { return m_heightmap; }
+
+    /// Return the name of the mesh asset.
+    const std::string& GetName() const { return m_shape->GetName(); }
+
+    /// Return the triangle mesh.
+    const geometry::ChTriangleMeshConnected& GetTriangleMesh() const { return m_shape->GetMesh(); }
+
+    /// Return the visualization asset, shared by the ground bodies of all terrains using this mesh.
+    std::shared_ptr<ChTriangleMeshShape> GetMeshShape() const { return m_shape; }
+
+    /// Return the collision model holding the shared contact shapes.
+    /// This model does not belong to any body or system.
+    std::shared_ptr<collision::ChCollisionModel> GetCollisionModel() const { return m_model; }
+
+    /// Return the radius of the sweep sphere of the contact shapes.
+    double GetSweepSphereRadius() const { return m_sweep_sphere_radius; }
+
+    /// Return the height index of the terrain surface.
+    const TerrainHeightIndex& GetHeightIndex() const { return m_index; }
+
+  private:
+    void CreateCollisionModel();
+
+    bool m_heightmap;
+    double m_sweep_sphere_radius;
+    std::shared_ptr<ChTriangleMeshShape> m_shape;          ///< visualization asset, holding the mesh
+    std::shared_ptr<collision::ChCollisionModel> m_model;  ///< contact shapes, pointing to the mesh vertices
+    TerrainHeightIndex m_index;                            ///< height index of the mesh or height map
+};
+
 /// @} vehicle_terrain
 
 }  // end namespace vehicle
@@ -17,8 +17,11 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cmath>
+#include <numeric>
 
 #include "chrono/physics/ChMaterialSurfaceNSC.h"
 #include "chrono/physics/ChMaterialSurfaceSMC.h"
@@ -121,7 +124,9 @@ void SCMDeformableTerrain::SetBulldozingParameters(double mbulldozing_erosion_an
     m_ground->bulldozing_erosion_n_propagations = mbulldozing_erosion_n_propagations;
 }
 
-void SCMDeformableTerrain::SetAutomaticRefinement(bool mr) { 
+void SCMDeformableTerrain::SetAutomaticRefinement(bool mr) {
+    if (mr && m_ground->window_body)
+        throw ChException("SCMDeformableTerrain: automatic refinement cannot be used with the moving window");
     m_ground->do_refinement = mr;
 }
 
@@ -159,6 +164,8 @@ void SCMDeformableTerrain::Initialize(double height, double sizeX, double sizeY,
 
 // Initialize the terrain from a specified .obj mesh file.
 void SCMDeformableTerrain::Initialize(const std::string& mesh_file) {
+    if (m_ground->window_body)
+        throw ChException("SCMDeformableTerrain: the moving window requires a flat terrain");
     m_ground->Initialize(mesh_file);
 }
 
@@ -169,9 +176,42 @@ void SCMDeformableTerrain::Initialize(const std::string& heightmap_file,
                                    double sizeY,
                                    double hMin,
                                    double hMax) {
+    if (m_ground->window_body)
+        throw ChException("SCMDeformableTerrain: the moving window requires a flat terrain");
     m_ground->Initialize(heightmap_file, mesh_name, sizeX, sizeY, hMin, hMax);
 }
 
+// Add a moving patch, following the specified body.
+void SCMDeformableTerrain::AddMovingPatch(std::shared_ptr<ChBody> body,
+                                          const ChVector<>& point_on_body,
+                                          double dimX,
+                                          double dimY) {
+    SCMDeformableSoil::MovingPatch patch;
+    patch.body = body;
+    patch.point = point_on_body;
+    patch.dimX = dimX;
+    patch.dimY = dimY;
+    m_ground->patches.push_back(patch);
+}
+
+// Enable the moving window, following the specified body.
+void SCMDeformableTerrain::EnableMovingWindow(std::shared_ptr<ChBody> body, int tile_divisions) {
+    if (tile_divisions < 1)
+        throw ChException("SCMDeformableTerrain: invalid tile size for the moving window");
+    if (!m_ground->grid || !m_ground->grid_flat || m_ground->do_refinement)
+        throw ChException("SCMDeformableTerrain: the moving window requires a flat terrain, without refinement");
+    m_ground->window_body = body;
+    m_ground->window_tile = tile_divisions;
+}
+
+// Return the number of deformed vertices stored out of the moving window.
+size_t SCMDeformableTerrain::GetNumStoredVertices() const {
+    size_t num = 0;
+    for (const auto& tile : m_ground->stored_tiles)
+        num += tile.second.size();
+    return num;
+}
+
 // -----------------------------------------------------------------------------
 // Implementation of SCMDeformableSoil
 // -----------------------------------------------------------------------------
@@ -277,6 +317,24 @@ void SCMDeformableSoil::Initialize(double height, double sizeX, double sizeY, in
         }
     }
 
+    // The vertices are a regular grid, row after row starting at (-sizeX/2, -sizeY/2)
+    grid = true;
+    grid_nx = nvx;
+    grid_ny = nvy;
+    grid_x0 = -0.5 * sizeX;
+    grid_y0 = -0.5 * sizeY;
+    grid_dx = dx;
+    grid_dy = dy;
+
+    // The moving window starts at this grid, on an unbounded flat terrain
+    grid_flat = true;
+    grid_height = height;
+    window_ix = 0;
+    window_iy = 0;
+    window_x0 = grid_x0;
+    window_y0 = grid_y0;
+    stored_tiles.clear();
+
     // Needed! pre-computes aux.topology 
     // data structures for the mesh, aux. material data, etc.
     SetupAuxData();
@@ -286,6 +344,10 @@ void SCMDeformableSoil::Initialize(double height, double sizeX, double sizeY, in
 void SCMDeformableSoil::Initialize(const std::string& mesh_file) {
     m_trimesh_shape->GetMesh().Clear();
     m_trimesh_shape->GetMesh().LoadWavefrontMesh(mesh_file, true, true);
+
+    grid = false;
+    grid_flat = false;
+    SetupAuxData();
 }
 
 // Initialize the terrain from a specified height map.
@@ -404,6 +466,16 @@ void SCMDeformableSoil::Initialize(const std::string& heightmap_file,
         normals[in] /= (double)accumulators[in];
     }
 
+    // The vertices are a regular grid, row after row starting at (-sizeX/2, -sizeY/2)
+    grid = true;
+    grid_nx = nv_x;
+    grid_ny = nv_y;
+    grid_x0 = -0.5 * sizeX;
+    grid_y0 = -0.5 * sizeY;
+    grid_dx = dx;
+    grid_dy = dy;
+    grid_flat = false;
+
     // Needed! pre-computes auxiliary topology 
     // data structures for the mesh, aux. material data, etc.
     SetupAuxData();
@@ -412,213 +484,549 @@ void SCMDeformableSoil::Initialize(const std::string& heightmap_file,
 // Set up auxiliary data structures.
 void SCMDeformableSoil::SetupAuxData() {
     // better readability:
-    std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
     std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
 
     // Reset and initialize computation data:
     //
+    size_t n = vertices.size();
     p_vertices_initial= vertices;
-    p_speeds.resize( vertices.size());
-    p_step_plastic_flow.resize( vertices.size());
-    p_level.resize( vertices.size());
-    p_level_initial.resize( vertices.size());
-    p_hit_level.resize( vertices.size());
-    p_sinkage.resize( vertices.size());
-    p_sinkage_plastic.resize( vertices.size());
-    p_sinkage_elastic.resize( vertices.size());
-    p_kshear.resize( vertices.size());
-    p_area.resize( vertices.size());
-    p_sigma.resize( vertices.size());
-    p_sigma_yeld.resize( vertices.size());
-    p_tau.resize( vertices.size());  
-    p_massremainder.resize( vertices.size());  
-    p_id_island.resize (vertices.size());
-    p_erosion.resize(vertices.size());
+    p_speeds.assign(n, VNULL);
+    p_step_plastic_flow.assign(n, 0);
+    p_level.resize(n);
+    p_level_initial.resize(n);
+    p_hit_level.assign(n, 1e9);
+    p_sinkage.assign(n, 0);
+    p_sinkage_plastic.assign(n, 0);
+    p_sinkage_elastic.assign(n, 0);
+    p_kshear.assign(n, 0);
+    p_area.assign(n, 0);
+    p_sigma.assign(n, 0);
+    p_sigma_yeld.assign(n, 0);
+    p_tau.assign(n, 0);
+    p_massremainder.assign(n, 0);
+    p_id_island.assign(n, 0);
+    p_erosion.assign(n, false);
+    p_deformed.assign(n, 0);
 
     for (int i=0; i< vertices.size(); ++i) {
         p_level[i] = plane.TransformParentToLocal(vertices[i]).y();
         p_level_initial[i] = p_level[i];
     }
 
-    connected_vertexes.resize( vertices.size() );
-    for (unsigned int iface = 0; iface < idx_vertices.size(); ++iface) {
-        connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][1]);
-        connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][2]);
-        connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][0]);
-        connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][2]);
-        connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][0]);
-        connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][1]);
-    }
+    modified_vertices.clear();
+    vertex_stamp.clear();
+    normal_stamp.clear();
+    stamp = 0;
+
+    SetupTopology();
 
     m_trimesh_shape->GetMesh().ComputeNeighbouringTriangleMap(this->tri_map);
 }
 
-// Reset the list of forces, and fills it with forces from a soil contact model.
-void SCMDeformableSoil::ComputeInternalForces() {
+// Build the table (CSR layout) of the triangles incident to each of n items (vertices or normals), in increasing
+// order, given the items of each triangle.
+static void BuildIncidence(size_t n,
+                           const std::vector<ChVector<int> >& faces,
+                           std::vector<int>& start,
+                           std::vector<int>& list) {
+    start.assign(n + 1, 0);
+    for (size_t it = 0; it < faces.size(); ++it)
+        for (int k = 0; k < 3; ++k)
+            start[faces[it][k] + 1]++;
+    for (size_t i = 0; i < n; ++i)
+        start[i + 1] += start[i];
+    list.resize(start.back());
+    std::vector<int> next(start.begin(), start.end() - 1);
+    for (size_t it = 0; it < faces.size(); ++it)
+        for (int k = 0; k < 3; ++k)
+            list[next[faces[it][k]]++] = (int)it;
+}
 
-    // Readability aliases
+void SCMDeformableSoil::SetupTopology() {
     std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
     std::vector<ChVector<> >& normals = m_trimesh_shape->GetMesh().getCoordsNormals();
-    std::vector<ChVector<float> >& colors =  m_trimesh_shape->GetMesh().getCoordsColors();
     std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
     std::vector<ChVector<int> >& idx_normals = m_trimesh_shape->GetMesh().getIndicesNormals();
-    
-    // 
-    // Reset the load list
-    //
+    size_t n = vertices.size();
 
-    this->GetLoadList().clear();
+    BuildIncidence(n, idx_vertices, vertex_triangles_start, vertex_triangles);
+    if (idx_normals.size() == idx_vertices.size()) {
+        BuildIncidence(normals.size(), idx_normals, normal_triangles_start, normal_triangles);
+    } else {
+        normal_triangles_start.clear();
+        normal_triangles.clear();
+    }
 
-    //
-    // Compute (pseudo)areas per node
-    //
-    
-    // for a X-Z rectangular grid-like mesh it is simply area[i]= xsize/xsteps * zsize/zsteps, 
-    // but the following is more general, also for generic meshes:
-    for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
-        p_area[iv] = 0;
+    // Adjacency: implicit for a grid, otherwise the other vertices of the triangles of each vertex.
+    adjacency_start.clear();
+    adjacency.clear();
+    if (grid) {
+        max_neighbours = 6;
+    } else {
+        max_neighbours = 0;
+        adjacency_start.resize(n + 1, 0);
+        for (size_t iv = 0; iv < n; ++iv) {
+            size_t first = adjacency.size();
+            for (int j = vertex_triangles_start[iv]; j < vertex_triangles_start[iv + 1]; ++j)
+                for (int k = 0; k < 3; ++k)
+                    if (idx_vertices[vertex_triangles[j]][k] != (int)iv)
+                        adjacency.push_back(idx_vertices[vertex_triangles[j]][k]);
+            std::sort(adjacency.begin() + first, adjacency.end());
+            adjacency.erase(std::unique(adjacency.begin() + first, adjacency.end()), adjacency.end());
+            adjacency_start[iv + 1] = (int)adjacency.size();
+            max_neighbours = std::max(max_neighbours, (int)(adjacency.size() - first));
+        }
     }
+
+    // Compute (pseudo)areas per node: for a X-Z rectangular grid-like mesh it is simply
+    // area[i]= xsize/xsteps * zsize/zsteps, but the following is more general, also for generic meshes.
+    // The areas are projected on the soil plane, so they do not change with the sinkage.
+    p_area.assign(n, 0);
     for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
         ChVector<> AB = vertices[idx_vertices[it][1]] - vertices[idx_vertices[it][0]];
-        ChVector<> AC = vertices[idx_vertices[it][2]] - vertices[idx_vertices[it][1]];
+        ChVector<> AC = vertices[idx_vertices[it][2]] - vertices[idx_vertices[it][0]];
         AB = plane.TransformDirectionParentToLocal(AB);
         AC = plane.TransformDirectionParentToLocal(AC);
-        AB.y()=0;
-        AC.y()=0;
-        double triangle_area = 0.5*(Vcross(AB,AC)).Length();
-        p_area[idx_normals[it][0]] += triangle_area /3.0;
-        p_area[idx_normals[it][1]] += triangle_area /3.0;
-        p_area[idx_normals[it][2]] += triangle_area /3.0;
+        AB.y() = 0;
+        AC.y() = 0;
+        double triangle_area = 0.5 * (Vcross(AB, AC)).Length();
+        p_area[idx_vertices[it][0]] += triangle_area / 3.0;
+        p_area[idx_vertices[it][1]] += triangle_area / 3.0;
+        p_area[idx_vertices[it][2]] += triangle_area / 3.0;
+    }
+
+    vertex_stamp.resize(n, -1);
+    normal_stamp.resize(normals.size(), -1);
+}
+
+const int* SCMDeformableSoil::GetNeighbours(int iv, int* buffer, int& n) const {
+    if (!grid) {
+        n = adjacency_start[iv + 1] - adjacency_start[iv];
+        return adjacency.data() + adjacency_start[iv];
+    }
+
+    // Neighbours in the grid triangulation, whose diagonals join the vertices iv and iv + grid_nx + 1.
+    int ix = iv % grid_nx;
+    int iy = iv / grid_nx;
+    n = 0;
+    if (ix > 0 && iy > 0)
+        buffer[n++] = iv - grid_nx - 1;
+    if (iy > 0)
+        buffer[n++] = iv - grid_nx;
+    if (ix > 0)
+        buffer[n++] = iv - 1;
+    if (ix < grid_nx - 1)
+        buffer[n++] = iv + 1;
+    if (iy < grid_ny - 1)
+        buffer[n++] = iv + grid_nx;
+    if (ix < grid_nx - 1 && iy < grid_ny - 1)
+        buffer[n++] = iv + grid_nx + 1;
+    return buffer;
+}
+
+void SCMDeformableSoil::FindActiveVertices(std::vector<int>& active) const {
+    const std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    int num_vertices = (int)vertices.size();
+
+    active.clear();
+    if (patches.empty()) {
+        active.resize(num_vertices);
+        std::iota(active.begin(), active.end(), 0);
+        return;
+    }
+
+    // Rectangles of the patches in the XZ plane of the soil.
+    std::vector<ChVector<> > pmin(patches.size());
+    std::vector<ChVector<> > pmax(patches.size());
+    for (size_t ip = 0; ip < patches.size(); ++ip) {
+        ChVector<> center = plane.TransformParentToLocal(
+            patches[ip].body->TransformPointLocalToParent(patches[ip].point));
+        ChVector<> half(0.5 * patches[ip].dimX, 0, 0.5 * patches[ip].dimY);
+        pmin[ip] = center - half;
+        pmax[ip] = center + half;
+    }
+
+    if (grid) {
+        for (size_t ip = 0; ip < patches.size(); ++ip) {
+            int ix0 = std::max(0, (int)std::ceil((pmin[ip].x() - grid_x0) / grid_dx));
+            int ix1 = std::min(grid_nx - 1, (int)std::floor((pmax[ip].x() - grid_x0) / grid_dx));
+            int iy0 = std::max(0, (int)std::ceil((pmin[ip].z() - grid_y0) / grid_dy));
+            int iy1 = std::min(grid_ny - 1, (int)std::floor((pmax[ip].z() - grid_y0) / grid_dy));
+            for (int iy = iy0; iy <= iy1; ++iy)
+                for (int ix = ix0; ix <= ix1; ++ix)
+                    active.push_back(ix + grid_nx * iy);
+        }
+        if (patches.size() > 1) {
+            std::sort(active.begin(), active.end());
+            active.erase(std::unique(active.begin(), active.end()), active.end());
+        }
+        return;
+    }
+
+    for (int iv = 0; iv < num_vertices; ++iv) {
+        ChVector<> v = plane.TransformParentToLocal(vertices[iv]);
+        for (size_t ip = 0; ip < patches.size(); ++ip) {
+            if (v.x() >= pmin[ip].x() && v.x() <= pmax[ip].x() && v.z() >= pmin[ip].z() && v.z() <= pmax[ip].z()) {
+                active.push_back(iv);
+                break;
+            }
+        }
+    }
+}
+
+// Index of the tile containing the terrain vertex i (rounding down, also for negative indices).
+static int TileIndex(int i, int tile) {
+    return i >= 0 ? i / tile : -((-i - 1) / tile) - 1;
+}
+
+// Key of a tile in the store: the two tile indices, as 32-bit patterns (no shift of negative values).
+static uint64_t TileKey(int tx, int ty) {
+    return ((uint64_t)(uint32_t)tx << 32) | (uint64_t)(uint32_t)ty;
+}
+
+// Move the window by whole tiles, if needed (see SCMDeformableTerrain::EnableMovingWindow for the preconditions).
+void SCMDeformableSoil::MoveWindow() {
+    // Shift of the window, in tiles, to center it on the body.
+    ChVector<> pos = plane.TransformParentToLocal(window_body->GetPos());
+    double tile_x = window_tile * grid_dx;
+    double tile_y = window_tile * grid_dy;
+    double dx = pos.x() - (grid_x0 + 0.5 * (grid_nx - 1) * grid_dx);
+    double dy = pos.z() - (grid_y0 + 0.5 * (grid_ny - 1) * grid_dy);
+    int shift_x = std::abs(dx) > tile_x ? (int)std::floor(dx / tile_x + 0.5) : 0;
+    int shift_y = std::abs(dy) > tile_y ? (int)std::floor(dy / tile_y + 0.5) : 0;
+    if (shift_x == 0 && shift_y == 0)
+        return;
+
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    std::vector<ChVector<> >& normals = m_trimesh_shape->GetMesh().getCoordsNormals();
+    std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
+    int n = grid_nx * grid_ny;
+    int dix = shift_x * window_tile;
+    int diy = shift_y * window_tile;
+    int new_ix = window_ix + dix;
+    int new_iy = window_iy + diy;
+
+    // Undeformed soil, by default.
+    std::vector<ChVector<> > new_vertices(n);
+    std::vector<double> new_level(n, grid_height);
+    std::vector<double> new_level_initial(n, grid_height);
+    std::vector<double> new_sinkage(n, 0);
+    std::vector<double> new_sinkage_plastic(n, 0);
+    std::vector<double> new_kshear(n, 0);
+    std::vector<double> new_sigma_yeld(n, 0);
+    std::vector<double> new_massremainder(n, 0);
+    std::vector<int> new_deformed(n, 0);
+    for (int iy = 0; iy < grid_ny; ++iy) {
+        for (int ix = 0; ix < grid_nx; ++ix) {
+            new_vertices[ix + grid_nx * iy] = plane * ChVector<>(window_x0 + (new_ix + ix) * grid_dx, grid_height,
+                                                                 window_y0 + (new_iy + iy) * grid_dy);
+        }
+    }
+    std::vector<ChVector<> > new_vertices_initial = new_vertices;
+
+    // The vertices which stay in the window keep their state; those which leave it are stored, if deformed.
+    for (int iy = 0; iy < grid_ny; ++iy) {
+        for (int ix = 0; ix < grid_nx; ++ix) {
+            int i = ix + grid_nx * iy;
+            int jx = ix - dix;
+            int jy = iy - diy;
+            if (jx >= 0 && jx < grid_nx && jy >= 0 && jy < grid_ny) {
+                int j = jx + grid_nx * jy;
+                new_vertices[j] = vertices[i];
+                new_vertices_initial[j] = p_vertices_initial[i];
+                new_level[j] = p_level[i];
+                new_level_initial[j] = p_level_initial[i];
+                new_sinkage[j] = p_sinkage[i];
+                new_sinkage_plastic[j] = p_sinkage_plastic[i];
+                new_kshear[j] = p_kshear[i];
+                new_sigma_yeld[j] = p_sigma_yeld[i];
+                new_massremainder[j] = p_massremainder[i];
+                new_deformed[j] = p_deformed[i];
+            } else if (p_deformed[i]) {
+                StoredVertex sv;
+                sv.ix = window_ix + ix;
+                sv.iy = window_iy + iy;
+                sv.level = plane.TransformParentToLocal(vertices[i]).y();
+                sv.level_initial = p_level_initial[i];
+                sv.sinkage = p_sinkage[i];
+                sv.sinkage_plastic = p_sinkage_plastic[i];
+                sv.kshear = p_kshear[i];
+                sv.sigma_yeld = p_sigma_yeld[i];
+                sv.massremainder = p_massremainder[i];
+                stored_tiles[TileKey(TileIndex(sv.ix, window_tile), TileIndex(sv.iy, window_tile))].push_back(sv);
+            }
+        }
+    }
+
+    // Restore the stored vertices which enter the window.
+    for (int ty = TileIndex(new_iy, window_tile); ty <= TileIndex(new_iy + grid_ny - 1, window_tile); ++ty) {
+        for (int tx = TileIndex(new_ix, window_tile); tx <= TileIndex(new_ix + grid_nx - 1, window_tile); ++tx) {
+            auto tile = stored_tiles.find(TileKey(tx, ty));
+            if (tile == stored_tiles.end())
+                continue;
+            std::vector<StoredVertex>& stored = tile->second;
+            size_t kept = 0;
+            for (size_t k = 0; k < stored.size(); ++k) {
+                const StoredVertex& sv = stored[k];
+                int jx = sv.ix - new_ix;
+                int jy = sv.iy - new_iy;
+                if (jx < 0 || jx >= grid_nx || jy < 0 || jy >= grid_ny) {
+                    stored[kept++] = sv;
+                    continue;
+                }
+                int j = jx + grid_nx * jy;
+                ChVector<> v = plane.TransformParentToLocal(new_vertices[j]);
+                v.y() = sv.level;
+                new_vertices[j] = plane * v;
+                v.y() = sv.level_initial;
+                new_vertices_initial[j] = plane * v;
+                new_level[j] = sv.level;
+                new_level_initial[j] = sv.level_initial;
+                new_sinkage[j] = sv.sinkage;
+                new_sinkage_plastic[j] = sv.sinkage_plastic;
+                new_kshear[j] = sv.kshear;
+                new_sigma_yeld[j] = sv.sigma_yeld;
+                new_massremainder[j] = sv.massremainder;
+                new_deformed[j] = 1;
+            }
+            stored.resize(kept);
+            if (stored.empty())
+                stored_tiles.erase(tile);
+        }
     }
 
+    // Set the new state, with reset per-step data.
+    window_ix = new_ix;
+    window_iy = new_iy;
+    grid_x0 = window_x0 + window_ix * grid_dx;
+    grid_y0 = window_y0 + window_iy * grid_dy;
+    vertices.swap(new_vertices);
+    p_vertices_initial.swap(new_vertices_initial);
+    p_level.swap(new_level);
+    p_level_initial.swap(new_level_initial);
+    p_sinkage.swap(new_sinkage);
+    p_sinkage_plastic.swap(new_sinkage_plastic);
+    p_kshear.swap(new_kshear);
+    p_sigma_yeld.swap(new_sigma_yeld);
+    p_massremainder.swap(new_massremainder);
+    p_deformed.swap(new_deformed);
+    p_speeds.assign(n, VNULL);
+    p_step_plastic_flow.assign(n, 0);
+    p_hit_level.assign(n, 1e9);
+    p_sinkage_elastic.assign(n, 0);
+    p_sigma.assign(n, 0);
+    p_tau.assign(n, 0);
+    p_id_island.assign(n, 0);
+    p_erosion.assign(n, false);
+
+    modified_vertices.clear();
+    vertex_stamp.clear();
+    normal_stamp.clear();
+    SetupTopology();
+
+    // Update all the normals.
+    if (!normal_triangles_start.empty()) {
+        for (size_t in = 0; in < normals.size(); ++in) {
+            ChVector<> sum(0, 0, 0);
+            for (int l = normal_triangles_start[in]; l < normal_triangles_start[in + 1]; ++l) {
+                int it = normal_triangles[l];
+                ChVector<> nrm = -Vcross(vertices[idx_vertices[it][1]] - vertices[idx_vertices[it][0]],
+                                         vertices[idx_vertices[it][2]] - vertices[idx_vertices[it][0]]);
+                nrm.Normalize();
+                sum += nrm;
+            }
+            if (normal_triangles_start[in + 1] > normal_triangles_start[in])
+                normals[in] = sum / (double)(normal_triangles_start[in + 1] - normal_triangles_start[in]);
+        }
+    }
+}
+
+// Reset the list of forces, and fills it with forces from a soil contact model.
+void SCMDeformableSoil::ComputeInternalForces() {
+
+    // Readability aliases
+    std::vector<ChVector<> >& vertices = m_trimesh_shape->GetMesh().getCoordsVertices();
+    std::vector<ChVector<> >& normals = m_trimesh_shape->GetMesh().getCoordsNormals();
+    std::vector<ChVector<float> >& colors =  m_trimesh_shape->GetMesh().getCoordsColors();
+    std::vector<ChVector<int> >& idx_vertices = m_trimesh_shape->GetMesh().getIndicesVertexes();
+    std::vector<ChVector<int> >& idx_normals = m_trimesh_shape->GetMesh().getIndicesNormals();
+
+    //
+    // Reset the load list
+    //
+
+    this->ClearLoads();
+
+    if (window_body)
+        MoveWindow();
+
     ChVector<> N    = plane.TransformDirectionLocalToParent(ChVector<>(0,1,0));
+    double step = this->GetSystem()->GetStep();
 
     //
-    // Perform ray-hit test to detect the contact point sinkage
-    // 
-    
-    
-//#pragma omp parallel for
-    for (int i=0; i< vertices.size(); ++i) {
-        collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
+    // Reset the per-step data of the vertices modified in the previous step (the other vertices
+    // still have the reset values) and of the vertices to be tested for contact.
+    //
+
+    auto reset_vertex = [&](int i) {
         p_sigma[i] = 0;
         p_sinkage_elastic[i] = 0;
-        p_step_plastic_flow[i]=0;
+        p_step_plastic_flow[i] = 0;
         p_erosion[i] = false;
-
+        p_id_island[i] = 0;
+        p_hit_level[i] = 1e9;
         p_level[i] = plane.TransformParentToLocal(vertices[i]).y();
+    };
+
+    for (auto iv : modified_vertices)
+        reset_vertex(iv);
+    modified_vertices.clear();
+    ++stamp;
 
-        ChVector<> to   = vertices[i] +N*test_high_offset; 
+    std::vector<int> active;
+    FindActiveVertices(active);
+    int num_active = (int)active.size();
+
+    //
+    // Perform ray-hit test to detect the contact point sinkage.
+    // The collision system is not thread-safe for ray tests (the concave meshes are locked during the
+    // tests), so this is done serially, for the active vertices only.
+    //
+
+    std::vector<ChContactable*> hit_contactables(num_active, nullptr);
+    for (int k = 0; k < num_active; ++k) {
+        int i = active[k];
+        reset_vertex(i);
+        MarkModified(i);
+
+        collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
+        ChVector<> to   = vertices[i] +N*test_high_offset;
         ChVector<> from = to - N*test_low_offset;
-        
-        p_hit_level[i] = 1e9;
-        double p_hit_offset = 1e9;
 
         // DO THE RAY-HIT TEST HERE:
         this->GetSystem()->GetCollisionSystem()->RayHit(from,to,mrayhit_result);
 
         if (mrayhit_result.hit == true) {
+            hit_contactables[k] = mrayhit_result.hitModel->GetContactable();
+            p_hit_level[i] = plane.TransformParentToLocal(mrayhit_result.abs_hitPoint).y();
+        }
+    }
+
+    //
+    // Update the soil at the hit vertices, independently of each other.
+    //
 
-            ChContactable* contactable = mrayhit_result.hitModel->GetContactable();
+    std::vector<ChVector<> > forces(num_active);
+    std::vector<ChVector<> > points(num_active);
+    std::vector<char> loaded(num_active, 0);
 
-            p_hit_level[i] = plane.TransformParentToLocal(mrayhit_result.abs_hitPoint).y();
-            p_hit_offset = -p_hit_level[i] + p_level_initial[i];
-
-            p_speeds[i] = contactable->GetContactPointSpeed(vertices[i]);
-
-            ChVector<> T = -p_speeds[i];
-            T = plane.TransformDirectionParentToLocal(T);
-            double Vn = -T.y();
-            T.y() = 0;
-            T = plane.TransformDirectionLocalToParent(T);
-            T.Normalize();   
-
-            // Compute i-th force:
-            ChVector<> Fn;
-            ChVector<> Ft;
-
-            // Elastic try:
-            p_sigma[i] = elastic_K * (p_hit_offset - p_sinkage_plastic[i]);   
-
-            // Handle unilaterality:
-            if (p_sigma[i] <0) {
-                p_sigma[i] =0;
-            } else {
-                
-                // add compressive speed-proportional damping 
-                //if (Vn < 0) {
-                //    p_sigma[i] += -Vn*this->damping_R;
-                //}
-                
-                p_sinkage[i] = p_hit_offset;
-                p_level[i]   = p_hit_level[i];
-
-                // Accumulate shear for Janosi-Hanamoto
-                p_kshear[i] += Vdot(p_speeds[i],-T) * this->GetSystem()->GetStep();
-
-                // Plastic correction:
-                if (p_sigma[i] > p_sigma_yeld[i]) {
-                    // Bekker formula, neglecting Bekker_Kc and 'b'
-                    p_sigma[i] = this->Bekker_Kphi * pow(p_sinkage[i], this->Bekker_n );
-                    p_sigma_yeld[i]= p_sigma[i];
-                    double old_sinkage_plastic = p_sinkage_plastic[i];
-                    p_sinkage_plastic[i] = p_sinkage[i] - p_sigma[i]/elastic_K;
-                    p_step_plastic_flow[i] =
-                        (p_sinkage_plastic[i] - old_sinkage_plastic) / this->GetSystem()->GetStep();
-                }
+#pragma omp parallel for schedule(static)
+    for (int k = 0; k < num_active; ++k) {
+        ChContactable* contactable = hit_contactables[k];
+        if (!contactable)
+            continue;
 
-                p_sinkage_elastic[i] = p_sinkage[i] - p_sinkage_plastic[i];
-
-                // add compressive speed-proportional damping (not clamped by pressure yield)
-                //if (Vn < 0) {
-                    p_sigma[i] += -Vn*this->damping_R;
-                //}
-
-                // Mohr-Coulomb
-                double tau_max = this->Mohr_cohesion + p_sigma[i] * tan(this->Mohr_friction*CH_C_DEG_TO_RAD);
-
-                // Janosi-Hanamoto
-                p_tau[i] = tau_max * (1.0 - exp(- (p_kshear[i]/this->Janosi_shear)));
-            
-                Fn = N * p_area[i] * p_sigma[i];
-                Ft = T * p_area[i] * p_tau[i];
-
-                if (ChBody* rigidbody = dynamic_cast<ChBody*>(contactable)) {
-                    // [](){} Trick: no deletion for this shared ptr, since 'rigidbody' was not a new ChBody() 
-                    // object, but an already used pointer because mrayhit_result.hitModel->GetPhysicsItem() 
-                    // cannot return it as shared_ptr, as needed by the ChLoadBodyForce:
-                    std::shared_ptr<ChBody> srigidbody(rigidbody, [](ChBody*){}); 
-                    std::shared_ptr<ChLoadBodyForce> mload(
-                        new ChLoadBodyForce(srigidbody, Fn + Ft, false, vertices[i], false));
-                    this->Add(mload);
-                }
-                if (ChLoadableUV* surf = dynamic_cast<ChLoadableUV*>(contactable)) {
-                    // [](){} Trick: no deletion for this shared ptr
-                    std::shared_ptr<ChLoadableUV> ssurf(surf, [](ChLoadableUV*){});
-                    std::shared_ptr<ChLoad<ChLoaderForceOnSurface>> mload(
-                        new ChLoad<ChLoaderForceOnSurface>(ssurf));
-                    mload->loader.SetForce( Fn +Ft );
-                    mload->loader.SetApplication(0.5, 0.5); //***TODO*** set UV, now just in middle
-                    this->Add(mload);
-                }
-                
-                // Update mesh representation
-                vertices[i] = p_vertices_initial[i] - N * p_sinkage[i];
+        int i = active[k];
+        double p_hit_offset = -p_hit_level[i] + p_level_initial[i];
 
-            } // end positive contact force
+        p_speeds[i] = contactable->GetContactPointSpeed(vertices[i]);
 
-        } // end successful hit test
+        ChVector<> T = -p_speeds[i];
+        T = plane.TransformDirectionParentToLocal(T);
+        double Vn = -T.y();
+        T.y() = 0;
+        T = plane.TransformDirectionLocalToParent(T);
+        T.Normalize();
+
+        // Compute i-th force:
+        ChVector<> Fn;
+        ChVector<> Ft;
+
+        // Elastic try:
+        p_sigma[i] = elastic_K * (p_hit_offset - p_sinkage_plastic[i]);
+
+        // Handle unilaterality:
+        if (p_sigma[i] <0) {
+            p_sigma[i] =0;
+            continue;
+        }
+
+        p_sinkage[i] = p_hit_offset;
+        p_level[i]   = p_hit_level[i];
+
+        // Accumulate shear for Janosi-Hanamoto
+        p_kshear[i] += Vdot(p_speeds[i],-T) * step;
+
+        // Plastic correction:
+        if (p_sigma[i] > p_sigma_yeld[i]) {
+            // Bekker formula, neglecting Bekker_Kc and 'b'
+            p_sigma[i] = this->Bekker_Kphi * pow(p_sinkage[i], this->Bekker_n );
+            p_sigma_yeld[i]= p_sigma[i];
+            double old_sinkage_plastic = p_sinkage_plastic[i];
+            p_sinkage_plastic[i] = p_sinkage[i] - p_sigma[i]/elastic_K;
+            p_step_plastic_flow[i] = (p_sinkage_plastic[i] - old_sinkage_plastic) / step;
+        }
+
+        p_sinkage_elastic[i] = p_sinkage[i] - p_sinkage_plastic[i];
+
+        // add compressive speed-proportional damping (not clamped by pressure yield)
+        p_sigma[i] += -Vn*this->damping_R;
+
+        // Mohr-Coulomb
+        double tau_max = this->Mohr_cohesion + p_sigma[i] * tan(this->Mohr_friction*CH_C_DEG_TO_RAD);
+
+        // Janosi-Hanamoto
+        p_tau[i] = tau_max * (1.0 - exp(- (p_kshear[i]/this->Janosi_shear)));
+
+        Fn = N * p_area[i] * p_sigma[i];
+        Ft = T * p_area[i] * p_tau[i];
+
+        forces[k] = Fn + Ft;
+        points[k] = vertices[i];
+        loaded[k] = 1;
+
+        // Update mesh representation
+        vertices[i] = p_vertices_initial[i] - N * p_sinkage[i];
+        p_deformed[i] = 1;
+    }
+
+    //
+    // Apply the forces, in the order of the vertices.
+    //
+
+    for (int k = 0; k < num_active; ++k) {
+        if (!loaded[k])
+            continue;
+        ChContactable* contactable = hit_contactables[k];
+
+        if (ChBody* rigidbody = dynamic_cast<ChBody*>(contactable)) {
+            // [](){} Trick: no deletion for this shared ptr, since 'rigidbody' was not a new ChBody()
+            // object, but an already used pointer because mrayhit_result.hitModel->GetPhysicsItem()
+            // cannot return it as shared_ptr, as needed by the ChLoadBodyForce:
+            std::shared_ptr<ChBody> srigidbody(rigidbody, [](ChBody*){});
+            std::shared_ptr<ChLoadBodyForce> mload(
+                new ChLoadBodyForce(srigidbody, forces[k], false, points[k], false));
+            this->Add(mload);
+        }
+        if (ChLoadableUV* surf = dynamic_cast<ChLoadableUV*>(contactable)) {
+            // [](){} Trick: no deletion for this shared ptr
+            std::shared_ptr<ChLoadableUV> ssurf(surf, [](ChLoadableUV*){});
+            std::shared_ptr<ChLoad<ChLoaderForceOnSurface>> mload(
+                new ChLoad<ChLoaderForceOnSurface>(ssurf));
+            mload->loader.SetForce( forces[k] );
+            mload->loader.SetApplication(0.5, 0.5); //***TODO*** set UV, now just in middle
+            this->Add(mload);
+        }
+    }
 
-    } // end loop on vertexes
 
-    
     //
     // Refine the mesh detail
     //
 
-    if (do_refinement) {  
-        
-        std::vector<std::vector<double>*> aux_data_double; 
+    if (do_refinement) {
+
+        std::vector<std::vector<double>*> aux_data_double;
         aux_data_double.push_back(&p_level);
         aux_data_double.push_back(&p_level_initial);
         aux_data_double.push_back(&p_hit_level);
@@ -632,26 +1040,26 @@ void SCMDeformableSoil::ComputeInternalForces() {
         aux_data_double.push_back(&p_sigma_yeld);
         aux_data_double.push_back(&p_tau);
         aux_data_double.push_back(&p_massremainder);
-        std::vector<std::vector<int>*> aux_data_int;  
+        std::vector<std::vector<int>*> aux_data_int;
         aux_data_int.push_back(&p_id_island);
-        std::vector<std::vector<bool>*> aux_data_bool; 
+        aux_data_int.push_back(&p_deformed);
+        std::vector<std::vector<bool>*> aux_data_bool;
         aux_data_bool.push_back(&p_erosion);
         std::vector<std::vector<ChVector<>>*> aux_data_vect;
         aux_data_vect.push_back(&p_vertices_initial);
         aux_data_vect.push_back(&p_speeds);
 
-        // loop on triangles to see which needs refinement
+        // see which triangles need refinement: those with at least one of the vertexes touching
         std::vector<int> marked_tris;
-        for (int it = 0; it< idx_vertices.size(); ++it) {
-            // see if at least one of the vertexes are touching
-            if ( p_sigma[idx_vertices[it][0]] >0 || 
-                 p_sigma[idx_vertices[it][1]] >0 ||
-                 p_sigma[idx_vertices[it][2]] >0 ) {
-                marked_tris.push_back(it);
-            }
+        for (auto iv : active) {
+            if (p_sigma[iv] > 0)
+                marked_tris.insert(marked_tris.end(), vertex_triangles.begin() + vertex_triangles_start[iv],
+                                   vertex_triangles.begin() + vertex_triangles_start[iv + 1]);
         }
-    
-        // custom edge refinement criterion: do not use default edge length, 
+        std::sort(marked_tris.begin(), marked_tris.end());
+        marked_tris.erase(std::unique(marked_tris.begin(), marked_tris.end()), marked_tris.end());
+
+        // custom edge refinement criterion: do not use default edge length,
         // length of the edge as projected on soil plane
         class MyRefinement : public geometry::ChTriangleMeshConnected::ChRefineEdgeCriterion {
         public:
@@ -666,111 +1074,92 @@ void SCMDeformableSoil::ComputeInternalForces() {
         MyRefinement refinement_criterion;
         refinement_criterion.A = ChMatrix33<>(this->plane.rot);
 
+        size_t old_num_vertices = vertices.size();
+        size_t old_num_triangles = idx_vertices.size();
+
         // perform refinement using the LEPP  algorithm, also refining the soil-specific vertex attributes
         for (int i=0; i<1; ++i) {
             m_trimesh_shape->GetMesh().RefineMeshEdges(
-                marked_tris, 
-                refinement_resolution, 
+                marked_tris,
+                refinement_resolution,
                 &refinement_criterion,
                 0, //&tri_map, // note, update triangle connectivity map incrementally
-                aux_data_double, 
-                aux_data_int, 
-                aux_data_bool, 
+                aux_data_double,
+                aux_data_int,
+                aux_data_bool,
                 aux_data_vect);
         }
-        // TO DO adjust this incrementally
-        
-        connected_vertexes.clear();
-        connected_vertexes.resize( vertices.size() );
-        for (unsigned int iface = 0; iface < idx_vertices.size(); ++iface) {
-            connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][1]);
-            connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][2]);
-            connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][0]);
-            connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][2]);
-            connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][0]);
-            connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][1]);
-        }
 
-        // Recompute areas (could be optimized)
-        for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
-            p_area[iv] = 0;
-        }
-        for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
-            ChVector<> AB = vertices[idx_vertices[it][1]] - vertices[idx_vertices[it][0]];
-            ChVector<> AC = vertices[idx_vertices[it][2]] - vertices[idx_vertices[it][0]];
-            AB = plane.TransformDirectionParentToLocal(AB);
-            AC = plane.TransformDirectionParentToLocal(AC);
-            AB.y() = 0;
-            AC.y() = 0;
-            double triangle_area = 0.5 * (Vcross(AB, AC)).Length();
-            p_area[idx_normals[it][0]] += triangle_area /3.0;
-            p_area[idx_normals[it][1]] += triangle_area /3.0;
-            p_area[idx_normals[it][2]] += triangle_area /3.0;
+        // Recompute the topology and the areas of the refined mesh, which is no more a regular grid.
+        // TO DO adjust this incrementally
+        if (idx_vertices.size() != old_num_triangles) {
+            grid = false;
+            SetupTopology();
+            // The new vertices are under the patches too: add them to the active vertices, which stay sorted,
+            // so that they also seed the flood fill of the bulldozing islands.
+            for (size_t iv = old_num_vertices; iv < vertices.size(); ++iv) {
+                MarkModified((int)iv);
+                active.push_back((int)iv);
+            }
         }
     }
 
     //
     // Flow material to the side of rut, using heuristics
-    // 
+    //
 
     if (do_bulldozing) {
-        std::set<int> touched_vertexes;
-        for (int iv = 0; iv< vertices.size(); ++iv) {
-            p_id_island[iv] = 0;
-            if (p_sigma[iv]>0)
-                touched_vertexes.insert(iv);
-        }
-
-        std::set<int> domain_boundaries;
+        std::vector<int> neighbours_buffer(max_neighbours);
+        std::vector<int> domain_boundaries;
 
-        // Compute contact islands (and their displaced material) by flood-filling the mesh
+        // Compute contact islands (and their displaced material) by flood-filling the mesh, from the
+        // touched vertexes (only active vertexes, including the ones created by the refinement, can be
+        // touched) not yet in an island
         int id_island = 0;
-        for (auto fillseed = touched_vertexes.begin(); fillseed != touched_vertexes.end(); fillseed = touched_vertexes.begin()) {
+        for (auto fillseed : active) {
+            if (!(p_sigma[fillseed] > 0) || p_id_island[fillseed] != 0)
+                continue;
+
             // new island:
             ++id_island;
-            std::set<int> fill_front;
+            std::vector<int> fill_front;
 
-            std::set<int> boundary;
-            int n_vert_boundary = 0;
+            std::vector<int> boundary;
             double tot_area_boundary = 0;
 
-            int n_vert_island = 1;
-            double tot_step_flow_island = p_area[*fillseed] * p_step_plastic_flow[*fillseed] * this->GetSystem()->GetStep();
-            double tot_Nforce_island = p_area[*fillseed] * p_sigma[*fillseed];
-            double tot_area_island = p_area[*fillseed];
-            fill_front.insert(*fillseed);
-            p_id_island[*fillseed] = id_island;
-            touched_vertexes.erase(fillseed);
+            double tot_step_flow_island = p_area[fillseed] * p_step_plastic_flow[fillseed] * step;
+            fill_front.push_back(fillseed);
+            p_id_island[fillseed] = id_island;
             while (fill_front.size() >0) {
                 // fill next front
-                std::set<int> fill_front_2;
+                std::vector<int> fill_front_2;
                 for (auto ifront : fill_front) {
-                    for (auto ivconnect : connected_vertexes[ifront]) {
+                    int n_connected;
+                    const int* connected = GetNeighbours(ifront, neighbours_buffer.data(), n_connected);
+                    for (int ic = 0; ic < n_connected; ++ic) {
+                        int ivconnect = connected[ic];
                         if ((p_sigma[ivconnect]>0) && (p_id_island[ivconnect]==0)) {
-                            ++n_vert_island;
-                            tot_step_flow_island += p_area[ivconnect] * p_step_plastic_flow[ivconnect] * this->GetSystem()->GetStep();
-                            tot_Nforce_island += p_area[ivconnect] * p_sigma[ivconnect];
-                            tot_area_island += p_area[ivconnect];
-                            fill_front_2.insert(ivconnect);
+                            tot_step_flow_island += p_area[ivconnect] * p_step_plastic_flow[ivconnect] * step;
+                            fill_front_2.push_back(ivconnect);
                             p_id_island[ivconnect] = id_island;
-                            touched_vertexes.erase(ivconnect);
-                        } 
+                        }
                         else if ((p_sigma[ivconnect] == 0) && (p_id_island[ivconnect] <= 0) && (p_id_island[ivconnect] != -id_island)) {
-                            ++n_vert_boundary;
                             tot_area_boundary += p_area[ivconnect];
                             p_id_island[ivconnect] = -id_island; // negative to mark as boundary
-                            boundary.insert(ivconnect);
+                            boundary.push_back(ivconnect);
+                            MarkDeformed(ivconnect);
                         }
                     }
                 }
                 // advance to next front
-                fill_front= fill_front_2;
+                std::sort(fill_front_2.begin(), fill_front_2.end());
+                fill_front.swap(fill_front_2);
             }
-            //GetLog() << " island " << id_island << " flow volume =" << tot_step_flow_island << " N force=" << tot_Nforce_island << "\n"; 
 
             // Raise the boundary because of material flow (it gives a sharp spike around the
             // island boundary, but later we'll use the erosion algorithm to smooth it out)
 
+            std::sort(boundary.begin(), boundary.end());
             for (auto ibv : boundary) {
                 double d_y = bulldozing_flow_factor * ((p_area[ibv]/tot_area_boundary) *  (1/p_area[ibv]) * tot_step_flow_island);
                 double clamped_d_y = d_y; // ChMin(d_y, ChMin(p_hit_level[ibv]-p_level[ibv], test_high_offset) );
@@ -784,47 +1173,56 @@ void SCMDeformableSoil::ComputeInternalForces() {
                 p_vertices_initial[ibv] += N * clamped_d_y;
             }
 
-            domain_boundaries.insert(boundary.begin(), boundary.end());
+            domain_boundaries.insert(domain_boundaries.end(), boundary.begin(), boundary.end());
 
         }// end for islands
- //***TEST***
-//int mm = p_massremainder.size();
-//p_massremainder.clear();p_massremainder.resize(mm);
+        std::sort(domain_boundaries.begin(), domain_boundaries.end());
+        domain_boundaries.erase(std::unique(domain_boundaries.begin(), domain_boundaries.end()), domain_boundaries.end());
 
-        // Erosion domain area select, by topologically dilation of all the 
+        // Erosion domain area select, by topologically dilation of all the
         // boundaries of the islands:
-        std::set<int> domain_erosion= domain_boundaries;
+        std::vector<int> domain_erosion= domain_boundaries;
         for (auto ie : domain_boundaries)
             p_erosion[ie] = true;
-        std::set<int> front_erosion = domain_boundaries;
+        std::vector<int> front_erosion = domain_boundaries;
         for (int iloop = 0; iloop <10; ++iloop) {
-            std::set<int> front_erosion2;
+            std::vector<int> front_erosion2;
             for(auto is : front_erosion) {
-                for (auto ivconnect : connected_vertexes[is]) {
+                int n_connected;
+                const int* connected = GetNeighbours(is, neighbours_buffer.data(), n_connected);
+                for (int ic = 0; ic < n_connected; ++ic) {
+                    int ivconnect = connected[ic];
                     if ((p_id_island[ivconnect]==0) && (p_erosion[ivconnect]==0)) {
-                        front_erosion2.insert(ivconnect);
+                        front_erosion2.push_back(ivconnect);
                         p_erosion[ivconnect] = true;
+                        MarkDeformed(ivconnect);
                     }
                 }
             }
-            domain_erosion.insert(front_erosion2.begin(), front_erosion2.end());
-            front_erosion = front_erosion2;
+            std::sort(front_erosion2.begin(), front_erosion2.end());
+            domain_erosion.insert(domain_erosion.end(), front_erosion2.begin(), front_erosion2.end());
+            front_erosion.swap(front_erosion2);
         }
+        std::sort(domain_erosion.begin(), domain_erosion.end());
+
         // Erosion smoothing algorithm on domain
         for (int ismo = 0; ismo <3; ++ismo) {
             for (auto is : domain_erosion) {
-                for (auto ivc : connected_vertexes[is]) {
+                int n_connected;
+                const int* connected = GetNeighbours(is, neighbours_buffer.data(), n_connected);
+                for (int ic = 0; ic < n_connected; ++ic) {
+                    int ivc = connected[ic];
                     ChVector<> vis = this->plane.TransformParentToLocal(vertices[is]);
-                    // flow remainder material 
+                    // flow remainder material
                     if (true) {
                         if (p_massremainder[is]>p_massremainder[ivc]) {
                             double clamped_d_y_i;
                             double clamped_d_y_c;
- 
-                            // if i higher than c: clamp c upward correction as it might invalidate 
+
+                            // if i higher than c: clamp c upward correction as it might invalidate
                             // the ceiling constraint, if collision is nearby
-                            double d_y_c = (p_massremainder[is]-p_massremainder[ivc])* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
-                            clamped_d_y_c = d_y_c; 
+                            double d_y_c = (p_massremainder[is]-p_massremainder[ivc])* (1/(double)n_connected) *  p_area[is]/(p_area[is]+p_area[ivc]);
+                            clamped_d_y_c = d_y_c;
                             if (d_y_c > p_hit_level[ivc]-p_level[ivc]) {
                                 p_massremainder[ivc] += d_y_c - (p_hit_level[ivc]-p_level[ivc]);
                                 clamped_d_y_c = p_hit_level[ivc]-p_level[ivc];
@@ -839,7 +1237,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
                                 p_massremainder[is] = 0;
                                 clamped_d_y_i = d_y_i + p_massremainder[is];
                             }
-                            
+
                             // correct vertexes
                             p_level[ivc]            += clamped_d_y_c;
                             p_level_initial[ivc]    += clamped_d_y_c;
@@ -849,7 +1247,8 @@ void SCMDeformableSoil::ComputeInternalForces() {
                             p_level[is]             += clamped_d_y_i;
                             p_level_initial[is]     += clamped_d_y_i;
                             vertices[is]            += N * clamped_d_y_i;
-                            p_vertices_initial[is]  += N * clamped_d_y_i;      
+                            p_vertices_initial[is]  += N * clamped_d_y_i;
+                            MarkDeformed(ivc);
                         }
                     }
                     // smooth
@@ -863,10 +1262,10 @@ void SCMDeformableSoil::ComputeInternalForces() {
                         if (fabs(dy)>dy_lim) {
                             double clamped_d_y_i;
                             double clamped_d_y_c;
-                            if (dy > 0) { 
-                                // if i higher than c: clamp c upward correction as it might invalidate 
+                            if (dy > 0) {
+                                // if i higher than c: clamp c upward correction as it might invalidate
                                 // the ceiling constraint, if collision is nearby
-                                double d_y_c = (fabs(dy)-dy_lim)* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
+                                double d_y_c = (fabs(dy)-dy_lim)* (1/(double)n_connected) *  p_area[is]/(p_area[is]+p_area[ivc]);
                                 clamped_d_y_c = d_y_c; //clamped_d_y_c = ChMin(d_y_c, p_hit_level[ivc]-p_level[ivc] );
                                 if (d_y_c > p_hit_level[ivc]-p_level[ivc]) {
                                     p_massremainder[ivc] += d_y_c - (p_hit_level[ivc]-p_level[ivc]);
@@ -883,10 +1282,10 @@ void SCMDeformableSoil::ComputeInternalForces() {
                                     clamped_d_y_i = d_y_i + p_massremainder[is];
                                 }
                             } else {
-                                // if c higher than i: clamp i upward correction as it might invalidate 
+                                // if c higher than i: clamp i upward correction as it might invalidate
                                 // the ceiling constraint, if collision is nearby
-                                double d_y_i = (fabs(dy)-dy_lim)* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
-                                clamped_d_y_i = d_y_i; 
+                                double d_y_i = (fabs(dy)-dy_lim)* (1/(double)n_connected) *  p_area[is]/(p_area[is]+p_area[ivc]);
+                                clamped_d_y_i = d_y_i;
                                 if (d_y_i > p_hit_level[is]-p_level[is]) {
                                     p_massremainder[is] += d_y_i - (p_hit_level[is]-p_level[is]);
                                     clamped_d_y_i = p_hit_level[is]-p_level[is];
@@ -912,23 +1311,26 @@ void SCMDeformableSoil::ComputeInternalForces() {
                             p_level[is]             += clamped_d_y_i;
                             p_level_initial[is]     += clamped_d_y_i;
                             vertices[is]            += N * clamped_d_y_i;
-                            p_vertices_initial[is]  += N * clamped_d_y_i;      
+                            p_vertices_initial[is]  += N * clamped_d_y_i;
+                            MarkDeformed(ivc);
                         }
                     }
                 }
             }
         }
 
-    } // end bulldozing flow 
+    } // end bulldozing flow
 
 
 
     //
     // Update the visualization colors
-    // 
+    //
     if (plot_type != SCMDeformableTerrain::PLOT_NONE) {
         colors.resize(vertices.size());
-        for (size_t iv = 0; iv< vertices.size(); ++iv) {
+        int num_vertices = (int)vertices.size();
+#pragma omp parallel for schedule(static)
+        for (int iv = 0; iv< num_vertices; ++iv) {
             ChColor mcolor;
             switch (plot_type) {
                 case SCMDeformableTerrain::PLOT_LEVEL:
@@ -976,7 +1378,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
                 case SCMDeformableTerrain::PLOT_IS_TOUCHED:
                     if (p_sigma[iv]>0)
                         mcolor = ChColor(1,0,0);
-                    else 
+                    else
                         mcolor = ChColor(0,0,1);
                     break;
             }
@@ -987,30 +1389,39 @@ void SCMDeformableSoil::ComputeInternalForces() {
     }
 
     //
-    // Update the visualization normals
-    // 
-
-    std::vector<int> accumulators(vertices.size(), 0);
+    // Update the visualization normals, of the triangles with modified vertices
+    //
 
-    // Calculate normals and then average the normals from all adjacent faces.
-    for (unsigned int it = 0; it < idx_vertices.size(); ++it) {
-        // Calculate the triangle normal as a normalized cross product.
-        ChVector<> nrm = -Vcross(vertices[idx_vertices[it][1]] - vertices[idx_vertices[it][0]],
-                                vertices[idx_vertices[it][2]] - vertices[idx_vertices[it][0]]);
-        nrm.Normalize();
-        // Increment the normals of all incident vertices by the face normal
-        normals[idx_normals[it][0]] += nrm;
-        normals[idx_normals[it][1]] += nrm;
-        normals[idx_normals[it][2]] += nrm;
-        // Increment the count of all incident vertices by 1
-        accumulators[idx_normals[it][0]] += 1;
-        accumulators[idx_normals[it][1]] += 1;
-        accumulators[idx_normals[it][2]] += 1;
-    }
+    if (!normal_triangles_start.empty()) {
+        std::vector<int> modified_normals;
+        for (auto iv : modified_vertices) {
+            for (int j = vertex_triangles_start[iv]; j < vertex_triangles_start[iv + 1]; ++j) {
+                for (int k = 0; k < 3; ++k) {
+                    int in = idx_normals[vertex_triangles[j]][k];
+                    if (normal_stamp[in] != stamp) {
+                        normal_stamp[in] = stamp;
+                        modified_normals.push_back(in);
+                    }
+                }
+            }
+        }
 
-    // Set the normals to the average values.
-    for (unsigned int in = 0; in < vertices.size(); ++in) {
-        normals[in] /= (double)accumulators[in];
+        // Average the normals of all adjacent faces.
+        int num_modified_normals = (int)modified_normals.size();
+#pragma omp parallel for schedule(static)
+        for (int j = 0; j < num_modified_normals; ++j) {
+            int in = modified_normals[j];
+            ChVector<> sum(0, 0, 0);
+            for (int l = normal_triangles_start[in]; l < normal_triangles_start[in + 1]; ++l) {
+                int it = normal_triangles[l];
+                // Calculate the triangle normal as a normalized cross product.
+                ChVector<> nrm = -Vcross(vertices[idx_vertices[it][1]] - vertices[idx_vertices[it][0]],
+                                         vertices[idx_vertices[it][2]] - vertices[idx_vertices[it][0]]);
+                nrm.Normalize();
+                sum += nrm;
+            }
+            normals[in] = sum / (double)(normal_triangles_start[in + 1] - normal_triangles_start[in]);
+        }
     }
 
     // 
@@ -20,8 +20,10 @@
 #ifndef SCM_DEFORMABLE_TERRAIN_H
 #define SCM_DEFORMABLE_TERRAIN_H
 
-#include <set>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "chrono/assets/ChColorAsset.h"
 #include "chrono/assets/ChTriangleMeshShape.h"
@@ -155,6 +157,36 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
     void SetTestHighOffset(double moff);
     double GetTestHighOffset() const;
 
+    /// Add a moving patch: a rectangle of the terrain plane, of size dimX x dimY along the X and Z axes of the
+    /// plane (see SetPlane), centered at the projection of the specified point of the body.
+    /// If moving patches are defined, only the vertices under the patches are tested for contact, so that the
+    /// cost of the soil update does not grow with the size of the terrain. The patches must cover the contact
+    /// areas, for example with one patch per wheel, a bit larger than the wheel. If no patches are defined, as by
+    /// default, all vertices are tested.
+    /// Contacts out of all patches are not detected, and no warning is given: a body touching the soil out of the
+    /// patches (e.g. a wheel without its own patch, or the part of a wheel beyond the border of its patch) gets
+    /// no soil forces and leaves no rut there. The vertices created by the mesh refinement under the patches are
+    /// handled as the other vertices under the patches.
+    void AddMovingPatch(std::shared_ptr<ChBody> body,     ///< [in] monitored body
+                        const ChVector<>& point_on_body,  ///< [in] patch center, in the body reference frame
+                        double dimX,                      ///< [in] patch dimension along the X axis of the plane
+                        double dimY                       ///< [in] patch dimension along the Z axis of the plane
+                        );
+
+    /// Enable a moving window on a flat terrain: the soil mesh, of the size and resolution specified in Initialize,
+    /// then covers only a window of an unbounded flat terrain, which is moved by whole tiles of
+    /// tile_divisions x tile_divisions mesh cells to stay centered on the specified body.
+    /// The state of the deformed vertices which leave the window is stored, in a compact form, and restored when
+    /// they re-enter the window: the memory grows with the deformed area only, not with the traveled distance.
+    /// Must be called after Initialize, on a flat terrain without automatic refinement; throws a ChException
+    /// otherwise, or if a height map or a mesh is loaded, or the refinement enabled, later on.
+    void EnableMovingWindow(std::shared_ptr<ChBody> body,  ///< [in] monitored body
+                            int tile_divisions = 10        ///< [in] tile size, in mesh divisions
+                            );
+
+    /// Get the number of deformed vertices out of the moving window, whose state is stored.
+    size_t GetNumStoredVertices() const;
+
     /// Set the color plot type for the soil mesh.
     /// Also, when a scalar plot is used, also define which is the max-min range in the falsecolor colormap.
     void SetPlotType(DataPlotType mplot, double mmin, double mmax);
@@ -224,6 +256,8 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
         // GetLog() << " Setup update soil t= "<< this->ChTime << "\n";
         this->ComputeInternalForces();
 
+        // The list of loads was rebuilt: invalidate the residual tables of the base class.
+        ChLoadContainer::Setup();
         ChLoadContainer::Update(ChTime, true);
     }
 
@@ -256,6 +290,33 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     // data structures for the mesh, aux. material data, etc.
     void SetupAuxData();
 
+    // Compute the topology tables (adjacency, triangles of each vertex and normal) and the vertex areas.
+    void SetupTopology();
+
+    // Get the neighbours of a vertex, in increasing order, and their number. The neighbours are written in
+    // 'buffer' (which must hold max_neighbours entries) for a grid, or taken from the adjacency table otherwise.
+    const int* GetNeighbours(int iv, int* buffer, int& n) const;
+
+    // Collect the vertices under the moving patches (all vertices, if there are no patches), in increasing order.
+    void FindActiveVertices(std::vector<int>& active) const;
+
+    // Add a vertex to the vertices modified in the current step, if not already there.
+    void MarkModified(int iv) {
+        if (vertex_stamp[iv] != stamp) {
+            vertex_stamp[iv] = stamp;
+            modified_vertices.push_back(iv);
+        }
+    }
+
+    // Same as MarkModified, for a vertex whose deformation state changes.
+    void MarkDeformed(int iv) {
+        MarkModified(iv);
+        p_deformed[iv] = 1;
+    }
+
+    // Move the window by whole tiles, if the monitored body is more than a tile away from its center.
+    void MoveWindow();
+
     std::shared_ptr<ChColorAsset> m_color;
     std::shared_ptr<ChTriangleMeshShape> m_trimesh_shape;
     double m_height;
@@ -277,6 +338,7 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     std::vector<double> p_massremainder;
     std::vector<int> p_id_island;
     std::vector<bool> p_erosion;
+    std::vector<int> p_deformed;  // non-zero if the vertex was ever deformed
 
     double Bekker_Kphi;
     double Bekker_Kc;
@@ -294,9 +356,71 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     ChCoordsys<> plane;
 
     // aux. topology data
-    std::vector<std::set<int>> connected_vertexes;
     std::vector<std::array<int, 4>> tri_map;
 
+    // Regular grid of vertices (flat or height map terrain, not refined): the vertex in column ix and row iy has
+    // index ix + grid_nx * iy, at (grid_x0 + ix * grid_dx, grid_y0 + iy * grid_dy) in the XZ plane, and its
+    // neighbours are implicit.
+    bool grid;
+    int grid_nx;
+    int grid_ny;
+    double grid_x0;
+    double grid_y0;
+    double grid_dx;
+    double grid_dy;
+
+    // Vertex adjacency (CSR layout, neighbours in increasing order), if the vertices are not a grid
+    std::vector<int> adjacency_start;
+    std::vector<int> adjacency;
+    int max_neighbours;
+
+    // Triangles of each vertex and of each normal (CSR layout), for the update of the normals
+    std::vector<int> vertex_triangles_start;
+    std::vector<int> vertex_triangles;
+    std::vector<int> normal_triangles_start;
+    std::vector<int> normal_triangles;
+
+    // Moving patches (see SCMDeformableTerrain::AddMovingPatch)
+    struct MovingPatch {
+        std::shared_ptr<ChBody> body;
+        ChVector<> point;
+        double dimX;
+        double dimY;
+    };
+    std::vector<MovingPatch> patches;
+
+    // Moving window (see SCMDeformableTerrain::EnableMovingWindow) on a flat terrain at height grid_height.
+    // The vertex (ix, iy) of the grid is the vertex (window_ix + ix, window_iy + iy) of the terrain, at
+    // (window_x0 + (window_ix + ix) * grid_dx, window_y0 + (window_iy + iy) * grid_dy) in the XZ plane.
+    // The stored vertices, out of the window, are grouped by tile.
+    struct StoredVertex {
+        int ix;  // terrain vertex indices
+        int iy;
+        double level;
+        double level_initial;
+        double sinkage;
+        double sinkage_plastic;
+        double kshear;
+        double sigma_yeld;
+        double massremainder;
+    };
+    bool grid_flat;
+    double grid_height;
+    std::shared_ptr<ChBody> window_body;
+    int window_tile;
+    int window_ix;
+    int window_iy;
+    double window_x0;
+    double window_y0;
+    std::unordered_map<uint64_t, std::vector<StoredVertex>> stored_tiles;
+
+    // Vertices modified in the current step, whose per-step data is reset at the beginning of the next step;
+    // the other vertices keep the reset values.
+    std::vector<int> modified_vertices;
+    std::vector<int> vertex_stamp;
+    std::vector<int> normal_stamp;
+    int stamp;
+
     bool do_bulldozing;
     double bulldozing_flow_factor;
     double bulldozing_erosion_angle;
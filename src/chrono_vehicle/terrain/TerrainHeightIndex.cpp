@@ -0,0 +1,271 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Index for height and normal queries on a 2.5D terrain surface
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/core/ChException.h"
+
+#include "chrono_vehicle/terrain/TerrainHeightIndex.h"
+
+namespace chrono {
+namespace vehicle {
+
+// Tolerance on the barycentric coordinates, so that points on the edges shared by two triangles are not missed.
+static const double tolerance = 1e-10;
+
+// Maximum number of buckets per triangle, on average.
+static const double max_cells_per_triangle = 4;
+
+TerrainHeightIndex::TerrainHeightIndex()
+    : m_type(NONE), m_x0(0), m_y0(0), m_dx(1), m_dy(1), m_nx(0), m_ny(0) {}
+
+void TerrainHeightIndex::Clear() {
+    m_type = NONE;
+    m_nx = 0;
+    m_ny = 0;
+    m_heights.clear();
+    m_triangles.clear();
+    m_cell_start.clear();
+    m_cell_triangles.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Height map
+// -----------------------------------------------------------------------------
+void TerrainHeightIndex::BuildGrid(double x0,
+                                   double y0,
+                                   double dx,
+                                   double dy,
+                                   int nx,
+                                   int ny,
+                                   const std::vector<double>& heights) {
+    if (nx < 2 || ny < 2 || dx <= 0 || dy <= 0 || heights.size() != (size_t)nx * ny)
+        throw ChException("TerrainHeightIndex: invalid height map grid");
+
+    Clear();
+    m_type = GRID;
+    m_x0 = x0;
+    m_y0 = y0;
+    m_dx = dx;
+    m_dy = dy;
+    m_nx = nx;
+    m_ny = ny;
+    m_heights = heights;
+}
+
+bool TerrainHeightIndex::QueryGrid(double x, double y, double& height, ChVector<>& normal) const {
+    double u = (x - m_x0) / m_dx;
+    double v = (y - m_y0) / m_dy;
+    if (!(u >= -tolerance && u <= m_nx - 1 + tolerance && v >= -tolerance && v <= m_ny - 1 + tolerance))
+        return false;
+
+    // Cell, and local coordinates in the cell.
+    int ix = std::min(std::max((int)std::floor(u), 0), m_nx - 2);
+    int iy = std::min(std::max((int)std::floor(v), 0), m_ny - 2);
+    u -= ix;
+    v -= iy;
+
+    const double* h = &m_heights[iy * m_nx + ix];
+    double h00 = h[0];
+    double h10 = h[1];
+    double h01 = h[m_nx];
+    double h11 = h[m_nx + 1];
+
+    // Lower-right triangle (h00, h10, h11) or upper-left triangle (h00, h11, h01).
+    double sx, sy;
+    if (u >= v) {
+        sx = h10 - h00;
+        sy = h11 - h10;
+    } else {
+        sx = h11 - h01;
+        sy = h01 - h00;
+    }
+    height = h00 + u * sx + v * sy;
+    normal = ChVector<>(-sx / m_dx, -sy / m_dy, 1).GetNormalized();
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Triangle mesh
+// -----------------------------------------------------------------------------
+void TerrainHeightIndex::Build(const std::vector<ChVector<>>& vertices,
+                               const std::vector<ChVector<int>>& faces,
+                               double cell_size) {
+    Clear();
+
+    // Projections of the triangles in the XY plane. Vertical triangles cannot be hit by a vertical ray.
+    std::vector<int> faces_used;
+    double xmin = 1e300, xmax = -1e300;
+    double ymin = 1e300, ymax = -1e300;
+    for (size_t i = 0; i < faces.size(); i++) {
+        const ChVector<>& p0 = vertices[faces[i][0]];
+        const ChVector<>& p1 = vertices[faces[i][1]];
+        const ChVector<>& p2 = vertices[faces[i][2]];
+        double e1x = p1.x() - p0.x();
+        double e1y = p1.y() - p0.y();
+        double e2x = p2.x() - p0.x();
+        double e2y = p2.y() - p0.y();
+        double det = e1x * e2y - e2x * e1y;
+        double scale = (e1x * e1x + e1y * e1y) + (e2x * e2x + e2y * e2y);
+        if (std::abs(det) <= 1e-12 * scale)
+            continue;
+
+        Triangle t;
+        t.x0 = p0.x();
+        t.y0 = p0.y();
+        t.a00 = e2y / det;
+        t.a01 = -e2x / det;
+        t.a10 = -e1y / det;
+        t.a11 = e1x / det;
+        double dz1 = p1.z() - p0.z();
+        double dz2 = p2.z() - p0.z();
+        t.z0 = p0.z();
+        t.gx = dz1 * t.a00 + dz2 * t.a10;
+        t.gy = dz1 * t.a01 + dz2 * t.a11;
+        m_triangles.push_back(t);
+        faces_used.push_back((int)i);
+
+        for (int k = 0; k < 3; k++) {
+            const ChVector<>& p = vertices[faces[i][k]];
+            xmin = std::min(xmin, p.x());
+            xmax = std::max(xmax, p.x());
+            ymin = std::min(ymin, p.y());
+            ymax = std::max(ymax, p.y());
+        }
+    }
+    if (m_triangles.empty())
+        return;
+
+    // Buckets: by default, about as many as the triangles; at most a few per triangle on average.
+    int ntriangles = (int)m_triangles.size();
+    double sizeX = std::max(xmax - xmin, 1e-9);
+    double sizeY = std::max(ymax - ymin, 1e-9);
+    double min_cell_size = std::sqrt(sizeX * sizeY / (max_cells_per_triangle * ntriangles));
+    if (cell_size <= 0)
+        cell_size = std::sqrt(sizeX * sizeY / ntriangles);
+    cell_size = std::max(cell_size, min_cell_size);
+    m_nx = std::max(1, (int)std::ceil(sizeX / cell_size));
+    m_ny = std::max(1, (int)std::ceil(sizeY / cell_size));
+    m_x0 = xmin;
+    m_y0 = ymin;
+    m_dx = sizeX / m_nx;
+    m_dy = sizeY / m_ny;
+
+    // Range of buckets overlapped by the bounding box of each triangle.
+    auto cell_range = [&](int it, int& ix0, int& ix1, int& iy0, int& iy1) {
+        const ChVector<int>& f = faces[faces_used[it]];
+        double x0 = std::min(std::min(vertices[f[0]].x(), vertices[f[1]].x()), vertices[f[2]].x());
+        double x1 = std::max(std::max(vertices[f[0]].x(), vertices[f[1]].x()), vertices[f[2]].x());
+        double y0 = std::min(std::min(vertices[f[0]].y(), vertices[f[1]].y()), vertices[f[2]].y());
+        double y1 = std::max(std::max(vertices[f[0]].y(), vertices[f[1]].y()), vertices[f[2]].y());
+        ix0 = std::min(std::max((int)std::floor((x0 - m_x0) / m_dx), 0), m_nx - 1);
+        ix1 = std::min(std::max((int)std::floor((x1 - m_x0) / m_dx), 0), m_nx - 1);
+        iy0 = std::min(std::max((int)std::floor((y0 - m_y0) / m_dy), 0), m_ny - 1);
+        iy1 = std::min(std::max((int)std::floor((y1 - m_y0) / m_dy), 0), m_ny - 1);
+    };
+
+    // Counting sort of the triangles by bucket.
+    m_cell_start.assign(m_nx * m_ny + 1, 0);
+    for (int it = 0; it < ntriangles; it++) {
+        int ix0, ix1, iy0, iy1;
+        cell_range(it, ix0, ix1, iy0, iy1);
+        for (int iy = iy0; iy <= iy1; iy++)
+            for (int ix = ix0; ix <= ix1; ix++)
+                m_cell_start[iy * m_nx + ix + 1]++;
+    }
+    for (int ic = 0; ic < m_nx * m_ny; ic++)
+        m_cell_start[ic + 1] += m_cell_start[ic];
+    m_cell_triangles.resize(m_cell_start.back());
+    std::vector<int> next(m_cell_start.begin(), m_cell_start.end() - 1);
+    for (int it = 0; it < ntriangles; it++) {
+        int ix0, ix1, iy0, iy1;
+        cell_range(it, ix0, ix1, iy0, iy1);
+        for (int iy = iy0; iy <= iy1; iy++)
+            for (int ix = ix0; ix <= ix1; ix++)
+                m_cell_triangles[next[iy * m_nx + ix]++] = it;
+    }
+
+    m_type = MESH;
+}
+
+bool TerrainHeightIndex::QueryMesh(double x, double y, double& height, ChVector<>& normal) const {
+    double u = (x - m_x0) / m_dx;
+    double v = (y - m_y0) / m_dy;
+    if (!(u >= -tolerance && u <= m_nx + tolerance && v >= -tolerance && v <= m_ny + tolerance))
+        return false;
+    int ix = std::min(std::max((int)std::floor(u), 0), m_nx - 1);
+    int iy = std::min(std::max((int)std::floor(v), 0), m_ny - 1);
+    int ic = iy * m_nx + ix;
+
+    // Lowest of the triangles containing the point.
+    const Triangle* found = nullptr;
+    double zmin = 0;
+    for (int k = m_cell_start[ic]; k < m_cell_start[ic + 1]; k++) {
+        const Triangle& t = m_triangles[m_cell_triangles[k]];
+        double px = x - t.x0;
+        double py = y - t.y0;
+        double s = t.a00 * px + t.a01 * py;
+        double r = t.a10 * px + t.a11 * py;
+        if (s < -tolerance || r < -tolerance || s + r > 1 + tolerance)
+            continue;
+        double z = t.z0 + t.gx * px + t.gy * py;
+        if (!found || z < zmin) {
+            found = &t;
+            zmin = z;
+        }
+    }
+    if (!found)
+        return false;
+
+    height = zmin;
+    normal = ChVector<>(-found->gx, -found->gy, 1).GetNormalized();
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+bool TerrainHeightIndex::Query(double x, double y, double& height, ChVector<>& normal) const {
+    switch (m_type) {
+        case GRID:
+            return QueryGrid(x, y, height, normal);
+        case MESH:
+            return QueryMesh(x, y, height, normal);
+        default:
+            return false;
+    }
+}
+
+void TerrainHeightIndex::Query(const std::vector<ChVector<>>& loc,
+                               std::vector<double>& heights,
+                               std::vector<ChVector<>>& normals,
+                               double default_height,
+                               const ChVector<>& default_normal) const {
+    int n = (int)loc.size();
+    heights.resize(n);
+    normals.resize(n);
+#pragma omp parallel for schedule(static) if (n > 1000)
+    for (int i = 0; i < n; i++) {
+        if (!Query(loc[i].x(), loc[i].y(), heights[i], normals[i])) {
+            heights[i] = default_height;
+            normals[i] = default_normal;
+        }
+    }
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
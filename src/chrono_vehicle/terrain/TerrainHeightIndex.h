@@ -0,0 +1,114 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Index for height and normal queries on a 2.5D terrain surface
+//
+// =============================================================================
+
+#ifndef TERRAIN_HEIGHT_INDEX_H
+#define TERRAIN_HEIGHT_INDEX_H
+
+#include <vector>
+
+#include "chrono/core/ChVector.h"
+
+#include "chrono_vehicle/ChApiVehicle.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_terrain
+/// @{
+
+/// Index for height and normal queries on a terrain surface given as a triangle mesh.
+/// The result of a query at (x,y) is the lowest intersection of the vertical line through (x,y) with the
+/// surface, as for a ray cast upward from below the terrain, and the normal of the intersected triangle
+/// (pointing upward). Height maps are stored as a regular grid of heights; other meshes as a uniform grid
+/// of buckets, each listing the triangles which overlap it in the XY plane, so that queries take constant
+/// time. The index is not modified by queries, which can therefore run concurrently.
+class CH_VEHICLE_API TerrainHeightIndex {
+  public:
+    TerrainHeightIndex();
+
+    /// Build the index of a triangle mesh.
+    void Build(const std::vector<ChVector<>>& vertices,  ///< [in] mesh vertices
+               const std::vector<ChVector<int>>& faces,  ///< [in] vertex indices of the triangles
+               double cell_size = 0                      ///< [in] size of the buckets (0: automatic)
+               );
+
+    /// Build the index of a height map: a regular grid of nx by ny heights, row after row starting at the
+    /// corner (x0, y0), where each cell is split in two triangles along the diagonal through its lower-left
+    /// and upper-right corners.
+    void BuildGrid(double x0,                          ///< [in] X coordinate of the first grid point
+                   double y0,                          ///< [in] Y coordinate of the first grid point
+                   double dx,                          ///< [in] grid spacing in the X direction
+                   double dy,                          ///< [in] grid spacing in the Y direction
+                   int nx,                             ///< [in] number of grid points in the X direction
+                   int ny,                             ///< [in] number of grid points in the Y direction
+                   const std::vector<double>& heights  ///< [in] heights at the nx*ny grid points
+                   );
+
+    /// Remove all data from the index.
+    void Clear();
+
+    /// Return true if the index has no data.
+    bool IsEmpty() const { return m_type == NONE; }
+
+    /// Find the terrain height and normal at the specified (x,y) location.
+    /// Return false, leaving the outputs unchanged, if the location is outside the terrain.
+    bool Query(double x, double y, double& height, ChVector<>& normal) const;
+
+    /// Find the terrain heights and normals at several (x,y) locations (the Z component is ignored).
+    /// Locations outside the terrain get the specified default height and normal.
+    void Query(const std::vector<ChVector<>>& loc,  ///< [in] query locations
+               std::vector<double>& heights,        ///< [out] terrain heights
+               std::vector<ChVector<>>& normals,    ///< [out] terrain normals
+               double default_height = 0,           ///< [in] height outside the terrain
+               const ChVector<>& default_normal = ChVector<>(0, 0, 1)  ///< [in] normal outside the terrain
+               ) const;
+
+  private:
+    enum Type { NONE, GRID, MESH };
+
+    /// Triangle, projected in the XY plane: z(x,y) = z0 + gx * (x - x0) + gy * (y - y0) inside the triangle.
+    struct Triangle {
+        double x0, y0;              ///< first vertex
+        double a00, a01, a10, a11;  ///< inverse of the matrix of the edges, giving the barycentric coordinates
+        double z0, gx, gy;          ///< height of the first vertex and slopes of the plane
+    };
+
+    bool QueryGrid(double x, double y, double& height, ChVector<>& normal) const;
+    bool QueryMesh(double x, double y, double& height, ChVector<>& normal) const;
+
+    Type m_type;
+
+    // Grid of cells: of the height map, or of the buckets of triangles
+    double m_x0;
+    double m_y0;
+    double m_dx;
+    double m_dy;
+    int m_nx;  ///< number of grid points (height map) or buckets (mesh) in the X direction
+    int m_ny;  ///< number of grid points (height map) or buckets (mesh) in the Y direction
+
+    std::vector<double> m_heights;  ///< heights of the grid points (height map)
+
+    std::vector<Triangle> m_triangles;  ///< non-vertical triangles (mesh)
+    std::vector<int> m_cell_start;      ///< first triangle of each bucket (CSR layout)
+    std::vector<int> m_cell_triangles;  ///< triangles, grouped by bucket
+};
+
+/// @} vehicle_terrain
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
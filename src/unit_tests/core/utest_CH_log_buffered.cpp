@@ -0,0 +1,99 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the buffered logger.
+//
+// Several threads write numbered lines through small ring buffers, so that
+// they repeatedly block until the background thread drains them. All lines
+// must be output, complete, and in order for each thread. Also checks the
+// levels of the messages written with CH_LOG.
+//
+// =============================================================================
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChLogBuffered.h"
+
+using namespace chrono;
+
+int main(int argc, char* argv[]) {
+    const int num_threads = 8;
+    const int num_lines = 2000;
+
+    std::ostringstream out;
+    uint64_t num_blocked;
+    {
+        ChLogBuffered log(out, 256, 1);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&log, t, num_lines]() {
+                for (int i = 0; i < num_lines; i++)
+                    log << "thread " << t << " line " << i << "\n";
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        log.Flush();
+        num_blocked = log.GetNumBlocked();
+    }
+
+    // Check that each thread's lines are complete and in order.
+    bool passed = true;
+    std::vector<int> next(num_threads, 0);
+    std::istringstream in(out.str());
+    std::string line;
+    int count = 0;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string word1, word2;
+        int t = -1, i = -1;
+        fields >> word1 >> t >> word2 >> i;
+        if (word1 != "thread" || word2 != "line" || t < 0 || t >= num_threads || i != next[t]) {
+            std::cout << "Unexpected line: " << line << std::endl;
+            passed = false;
+            break;
+        }
+        next[t]++;
+        count++;
+    }
+    if (count != num_threads * num_lines) {
+        std::cout << "Wrong number of lines: " << count << std::endl;
+        passed = false;
+    }
+    std::cout << "Lines: " << count << "  blocked writes: " << num_blocked << std::endl;
+
+    // CH_LOG writes with the given level, even if the current level of the log was left quiet, and discards
+    // the levels above the maximum one.
+    {
+        std::ostringstream level_out;
+        ChLogBuffered log(level_out, 256, 1);
+        SetLog(log);
+        log.SetMaxLevel(ChLog::CHMESSAGE);
+        log.SetCurrentLevel(ChLog::CHQUIET);
+        CH_LOG(ChLog::CHMESSAGE) << "message\n";
+        CH_LOG(ChLog::CHSTATUS) << "status\n";
+        log.Flush();
+        SetLogDefault();
+        if (level_out.str() != "message\n") {
+            std::cout << "Unexpected output of CH_LOG: " << level_out.str() << std::endl;
+            passed = false;
+        }
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
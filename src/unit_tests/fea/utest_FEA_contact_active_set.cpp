@@ -0,0 +1,141 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the active set of ChContactSurfaceMesh: a cube of tetrahedrons
+// falling on the ground must behave the same with and without the active set,
+// while only the triangles near the ground are in the collision system.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono_fea/ChContactSurfaceMesh.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+static const int n = 3;           // cubes per side
+static const double h = 0.05;     // cube size
+static const double drop = 0.01;  // initial height of the bottom face
+
+// Simulate the fall, return the final height of the center of the cube and the number of active triangles.
+static double Simulate(bool active_set, unsigned int& num_active, unsigned int& num_triangles) {
+    ChSystemSMC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    auto solver = std::make_shared<ChSolverMINRES>();
+    solver->SetMaxIterations(100);
+    solver->SetTolerance(1e-10);
+    system.SetSolver(solver);
+
+    auto surface_material = std::make_shared<ChMaterialSurfaceSMC>();
+    surface_material->SetYoungModulus(1e6f);
+    surface_material->SetRestitution(0.1f);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(1, 1, 0.1, 1000, true, false, ChMaterialSurface::SMC);
+    ground->SetPos(ChVector<>(0, 0, -0.05));
+    ground->SetBodyFixed(true);
+    ground->SetMaterialSurface(surface_material);
+    system.Add(ground);
+
+    auto mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e6);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= n; i++)
+        for (int j = 0; j <= n; j++)
+            for (int k = 0; k <= n; k++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i * h, j * h, drop + k * h));
+                nodes.push_back(node);
+                mesh->AddNode(node);
+            }
+    auto N = [&](int i, int j, int k) { return nodes[(i * (n + 1) + j) * (n + 1) + k]; };
+    const int perm[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            for (int k = 0; k < n; k++)
+                for (int p = 0; p < 6; p++) {
+                    int c[3] = {i, j, k};
+                    std::shared_ptr<ChNodeFEAxyz> v[4];
+                    v[0] = N(c[0], c[1], c[2]);
+                    for (int s = 0; s < 2; s++) {
+                        c[perm[p][s]]++;
+                        v[s + 1] = N(c[0], c[1], c[2]);
+                    }
+                    v[3] = N(i + 1, j + 1, k + 1);
+                    if (Vdot(Vcross(v[1]->GetPos() - v[0]->GetPos(), v[2]->GetPos() - v[0]->GetPos()),
+                             v[3]->GetPos() - v[0]->GetPos()) < 0)
+                        std::swap(v[1], v[2]);
+                    auto element = std::make_shared<ChElementTetra_4>();
+                    element->SetNodes(v[0], v[1], v[2], v[3]);
+                    element->SetMaterial(material);
+                    mesh->AddElement(element);
+                }
+
+    auto surface = std::make_shared<ChContactSurfaceMesh>();
+    mesh->AddContactSurface(surface);
+    surface->AddFacesFromBoundary(0.001);
+    surface->SetMaterialSurface(surface_material);
+    surface->SetActiveSet(active_set, 0.005);
+    surface->AddActiveSetPartner(ground->GetCollisionModel());
+    system.Add(mesh);
+
+    system.SetupInitial();
+    while (system.GetChTime() < 0.1)
+        system.DoStepDynamics(1e-3);
+
+    num_active = surface->GetNumActiveTriangles();
+    num_triangles = surface->GetNumTriangles();
+    double z = 0;
+    for (auto& node : nodes)
+        z += node->GetPos().z();
+    return z / nodes.size();
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    unsigned int num_active;
+    unsigned int num_triangles;
+    double z_all = Simulate(false, num_active, num_triangles);
+    std::cout << "All triangles: final height = " << z_all << ", active triangles = " << num_active << " of "
+              << num_triangles << std::endl;
+    if (num_active != num_triangles) {
+        std::cout << "Wrong number of active triangles" << std::endl;
+        passed = false;
+    }
+
+    double z_active = Simulate(true, num_active, num_triangles);
+    std::cout << "Active set: final height = " << z_active << ", active triangles = " << num_active << " of "
+              << num_triangles << std::endl;
+    if (num_active == 0 || num_active >= num_triangles / 2) {
+        std::cout << "Wrong number of active triangles" << std::endl;
+        passed = false;
+    }
+
+    // The cube rests on the ground in both cases (it would have fallen by ~0.05 without contacts).
+    if (std::abs(z_active - z_all) > 1e-6 || z_all < drop + 0.5 * n * h - 0.005) {
+        std::cout << "Wrong contact with the active set" << std::endl;
+        passed = false;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
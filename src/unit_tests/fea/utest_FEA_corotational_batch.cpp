@@ -0,0 +1,163 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the batched corotational kernels: the polar decompositions must
+// match ChPolarDecomposition, and a mesh of tetrahedrons and hexahedrons must
+// give the same rotations and stiffness matrices with and without batching.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono_fea/ChCorotationalBatch.h"
+#include "chrono_fea/ChElementHexa_8.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+static double MaxDifference(const ChMatrix<>& A, const ChMatrix<>& B) {
+    double max_diff = 0;
+    for (int i = 0; i < A.GetRows(); i++)
+        for (int j = 0; j < A.GetColumns(); j++)
+            max_diff = std::max(max_diff, std::abs(A(i, j) - B(i, j)));
+    return max_diff;
+}
+
+static bool TestPolarRotations() {
+    // Rotated stretches, a reflection and a singular matrix; 7 matrices, so that the last batch is partial.
+    const int n = 7;
+    std::vector<ChMatrix33<>> F(n);
+    for (int i = 0; i < n; i++) {
+        ChMatrix33<> rot(Q_from_AngAxis(0.4 * i + 0.1, ChVector<>(1, i, 2 - i).GetNormalized()));
+        ChMatrix33<> stretch;
+        stretch.FillRandom(0.3 * i, -0.3 * i);
+        for (int k = 0; k < 3; k++)
+            stretch(k, k) += 1;
+        F[i].MatrMultiply(rot, stretch);
+    }
+    F[5].MatrScale(-1.0);
+    F[6].FillDiag(0.0);
+    F[6](0, 0) = 1;
+    F[6](1, 1) = 2;
+
+    std::vector<ChMatrix33<>> R(n);
+    std::vector<const ChMatrix33<>*> pF(n);
+    std::vector<ChMatrix33<>*> pR(n);
+    for (int i = 0; i < n; i++) {
+        pF[i] = &F[i];
+        pR[i] = &R[i];
+    }
+    ChCorotationalBatch::PolarRotations(n, pF.data(), pR.data());
+
+    bool passed = true;
+    for (int i = 0; i < n; i++) {
+        ChMatrix33<> Q;
+        ChMatrix33<> S;
+        if (ChPolarDecomposition<>::Compute(F[i], Q, S, 1E-6) < 0)
+            Q.MatrScale(-1.0);
+        double error = MaxDifference(Q, R[i]);
+        std::cout << "Polar decomposition " << i << ": error = " << error << std::endl;
+        if (error > 1e-6) {
+            std::cout << "Wrong rotation" << std::endl;
+            passed = false;
+        }
+    }
+    return passed;
+}
+
+static bool TestMesh() {
+    ChSystemNSC system;
+    auto mesh = std::make_shared<ChMesh>();
+    system.Add(mesh);
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+    material->Set_RayleighDampingK(0.01);
+    material->Set_RayleighDampingM(0.1);
+
+    // Two cubes along X: the first split into 5 tetrahedrons, the second one is a hexahedron.
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= 2; i++)
+        for (int j = 0; j <= 1; j++)
+            for (int k = 0; k <= 1; k++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i, j, k));
+                nodes.push_back(node);
+                mesh->AddNode(node);
+            }
+    auto N = [&](int i, int j, int k) { return nodes[(i * 2 + j) * 2 + k]; };
+
+    const int tets[5][4] = {{0, 1, 2, 4}, {3, 2, 1, 7}, {5, 4, 7, 1}, {6, 7, 4, 2}, {1, 2, 4, 7}};
+    for (auto& tet : tets) {
+        std::shared_ptr<ChNodeFEAxyz> v[4];
+        for (int c = 0; c < 4; c++)
+            v[c] = N(tet[c] & 1, (tet[c] >> 1) & 1, (tet[c] >> 2) & 1);
+        if (Vdot(Vcross(v[1]->GetPos() - v[0]->GetPos(), v[2]->GetPos() - v[0]->GetPos()),
+                 v[3]->GetPos() - v[0]->GetPos()) < 0)
+            std::swap(v[1], v[2]);
+        auto element = std::make_shared<ChElementTetra_4>();
+        element->SetNodes(v[0], v[1], v[2], v[3]);
+        element->SetMaterial(material);
+        mesh->AddElement(element);
+    }
+    auto hexa = std::make_shared<ChElementHexa_8>();
+    hexa->SetNodes(N(1, 0, 0), N(2, 0, 0), N(2, 1, 0), N(1, 1, 0), N(1, 0, 1), N(2, 0, 1), N(2, 1, 1), N(1, 1, 1));
+    hexa->SetMaterial(material);
+    mesh->AddElement(hexa);
+
+    system.SetupInitial();
+
+    // Large rotation with a small deformation.
+    ChMatrix33<> rot(Q_from_AngAxis(1.2, ChVector<>(1, -2, 1).GetNormalized()));
+    for (size_t i = 0; i < nodes.size(); i++) {
+        ChVector<> x0 = nodes[i]->GetX0();
+        ChVector<> strain(0.01 * x0.y() * x0.z(), -0.02 * x0.x(), 0.015 * x0.x() * x0.y());
+        nodes[i]->SetPos(ChVector<>(0.5, 1, -2) + rot * (x0 + strain));
+    }
+
+    bool passed = true;
+    std::vector<ChMatrixDynamic<>> K[2];
+    std::vector<ChMatrix33<>> A[2];
+    for (int batched = 0; batched < 2; batched++) {
+        mesh->SetBatchedCorotation(batched == 1);
+        mesh->Update(0);
+        mesh->KRMmatricesLoad(1.0, 0.5, 2.0);
+        for (auto& element : mesh->GetElements()) {
+            auto generic = std::dynamic_pointer_cast<ChElementGeneric>(element);
+            K[batched].push_back(*generic->Kstiffness().Get_K());
+            A[batched].push_back(std::dynamic_pointer_cast<ChElementCorotational>(element)->Rotation());
+        }
+    }
+    for (size_t ie = 0; ie < K[0].size(); ie++) {
+        double errorA = MaxDifference(A[0][ie], A[1][ie]);
+        double errorK = MaxDifference(K[0][ie], K[1][ie]) / K[0][ie].NormInf();
+        std::cout << "Element " << ie << ": rotation error = " << errorA << ", relative stiffness error = " << errorK
+                  << std::endl;
+        if (errorA > 1e-6 || errorK > 1e-6) {
+            std::cout << "Wrong batched element" << std::endl;
+            passed = false;
+        }
+    }
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = TestPolarRotations();
+    passed &= TestMesh();
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
@@ -0,0 +1,144 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the cached gravity loads of ChMesh, which must follow changes of
+// G and of the density, and for the parallel residual of ChLoadContainer, which
+// must match the loads added one after the other.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "chrono/physics/ChLoadContainer.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// Total gravity force on the mesh, from the residual of the system.
+static ChVector<> TotalForce(ChSystemNSC& system) {
+    ChVectorDynamic<> R(system.GetNcoords_w());
+    system.IntLoadResidual_F(0, R, 1.0);
+    ChVector<> force(0);
+    for (int i = 0; i < R.GetRows(); i += 3)
+        force += ChVector<>(R(i), R(i + 1), R(i + 2));
+    return force;
+}
+
+static bool CheckForce(const ChVector<>& force, const ChVector<>& expected, const char* name) {
+    std::cout << name << ": total force = " << force.x() << " " << force.y() << " " << force.z() << std::endl;
+    if ((force - expected).Length() > 1e-9 * expected.Length()) {
+        std::cout << "Wrong gravity load" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    auto mesh = std::make_shared<ChMesh>();
+    system.Add(mesh);
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+
+    // A unit cube split into 5 tetrahedrons.
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i < 8; i++) {
+        auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i & 1, (i >> 1) & 1, (i >> 2) & 1));
+        nodes.push_back(node);
+        mesh->AddNode(node);
+    }
+    const int tets[5][4] = {{0, 1, 2, 4}, {3, 2, 1, 7}, {5, 4, 7, 1}, {6, 7, 4, 2}, {1, 2, 4, 7}};
+    std::vector<std::shared_ptr<ChElementTetra_4>> elements;
+    for (auto& tet : tets) {
+        std::shared_ptr<ChNodeFEAxyz> v[4] = {nodes[tet[0]], nodes[tet[1]], nodes[tet[2]], nodes[tet[3]]};
+        if (Vdot(Vcross(v[1]->GetPos() - v[0]->GetPos(), v[2]->GetPos() - v[0]->GetPos()),
+                 v[3]->GetPos() - v[0]->GetPos()) < 0)
+            std::swap(v[1], v[2]);
+        auto element = std::make_shared<ChElementTetra_4>();
+        element->SetNodes(v[0], v[1], v[2], v[3]);
+        element->SetMaterial(material);
+        mesh->AddElement(element);
+        elements.push_back(element);
+    }
+
+    system.SetupInitial();
+    system.Setup();
+    system.Update();
+
+    // The mesh is undeformed, so that the residual is the gravity load only.
+    bool passed = CheckForce(TotalForce(system), ChVector<>(0, 0, -9810), "Initial gravity");
+
+    system.Set_G_acc(ChVector<>(0, -2, 0));
+    passed &= CheckForce(TotalForce(system), ChVector<>(0, -2000, 0), "Changed gravity");
+
+    material->Set_density(2000);
+    passed &= CheckForce(TotalForce(system), ChVector<>(0, -4000, 0), "Changed density");
+
+    // The same loads, in a load container; two loads on each element, so that rows have several contributions.
+    mesh->SetAutomaticGravity(false);
+    auto container = std::make_shared<ChLoadContainer>();
+    system.Add(container);
+    for (int k = 0; k < 2; k++)
+        for (auto& element : elements) {
+            auto load = std::make_shared<ChLoad<ChLoaderGravity>>(element);
+            load->loader.Set_G_acc(ChVector<>(1, k, -3));
+            container->Add(load);
+        }
+    system.Setup();
+    system.Update();
+
+    ChVectorDynamic<> R(system.GetNcoords_w());
+    ChVectorDynamic<> R_serial(system.GetNcoords_w());
+    container->IntLoadResidual_F(0, R, 0.5);
+    for (auto& load : container->GetLoadList())
+        load->LoadIntLoadResidual_F(R_serial, 0.5);
+    double max_diff = 0;
+    for (int i = 0; i < R.GetRows(); i++)
+        max_diff = std::max(max_diff, std::abs(R(i) - R_serial(i)));
+    std::cout << "Load container: difference from the serial residual = " << max_diff << std::endl;
+    if (max_diff != 0) {
+        std::cout << "Wrong load container residual" << std::endl;
+        passed = false;
+    }
+    passed &= CheckForce(TotalForce(system), ChVector<>(4000, 2000, -12000), "Load container");
+
+    // Parallel update of the loads gives the same residual.
+    container->SetParallel(true);
+    system.Update();
+    ChVectorDynamic<> R_parallel(system.GetNcoords_w());
+    container->IntLoadResidual_F(0, R_parallel, 0.5);
+    if (!(R_parallel == R)) {
+        std::cout << "Wrong load container residual with parallel update" << std::endl;
+        passed = false;
+    }
+
+    // Removing the loads also removes their contributions to the residual.
+    container->ClearLoads();
+    ChVectorDynamic<> R_empty(system.GetNcoords_w());
+    container->IntLoadResidual_F(0, R_empty, 0.5);
+    if (R_empty.NormInf() != 0) {
+        std::cout << "Residual of removed loads" << std::endl;
+        passed = false;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
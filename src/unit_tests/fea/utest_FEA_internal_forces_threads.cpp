@@ -0,0 +1,133 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the internal forces of a ChMesh with several OpenMP threads.
+//
+// A deformed block of tetrahedrons and hexahedrons, with nodes shared by many
+// elements, is evaluated with 1 and N threads. The residual must be exactly
+// the same for any number of threads, and must match the sum of the element
+// contributions added one after the other.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono_fea/ChElementHexa_8.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC system;
+    system.Set_G_acc(VNULL);
+    auto mesh = std::make_shared<ChMesh>();
+    mesh->SetAutomaticGravity(false);
+    system.Add(mesh);
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+    material->Set_RayleighDampingK(0.01);
+
+    // A block of cubes, alternately split into 5 tetrahedrons or meshed as one hexahedron.
+    const int nx = 4, ny = 3, nz = 3;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= nx; i++)
+        for (int j = 0; j <= ny; j++)
+            for (int k = 0; k <= nz; k++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i, j, k));
+                nodes.push_back(node);
+                mesh->AddNode(node);
+            }
+    auto N = [&](int i, int j, int k) { return nodes[(i * (ny + 1) + j) * (nz + 1) + k]; };
+
+    const int tets[5][4] = {{0, 1, 2, 4}, {3, 2, 1, 7}, {5, 4, 7, 1}, {6, 7, 4, 2}, {1, 2, 4, 7}};
+    std::vector<std::shared_ptr<ChElementBase>> elements;
+    for (int i = 0; i < nx; i++)
+        for (int j = 0; j < ny; j++)
+            for (int k = 0; k < nz; k++) {
+                if ((i + j + k) % 2 == 0) {
+                    auto hexa = std::make_shared<ChElementHexa_8>();
+                    hexa->SetNodes(N(i, j, k), N(i + 1, j, k), N(i + 1, j + 1, k), N(i, j + 1, k), N(i, j, k + 1),
+                                   N(i + 1, j, k + 1), N(i + 1, j + 1, k + 1), N(i, j + 1, k + 1));
+                    hexa->SetMaterial(material);
+                    mesh->AddElement(hexa);
+                    elements.push_back(hexa);
+                    continue;
+                }
+                for (auto& tet : tets) {
+                    std::shared_ptr<ChNodeFEAxyz> v[4];
+                    for (int c = 0; c < 4; c++)
+                        v[c] = N(i + (tet[c] & 1), j + ((tet[c] >> 1) & 1), k + ((tet[c] >> 2) & 1));
+                    if (Vdot(Vcross(v[1]->GetPos() - v[0]->GetPos(), v[2]->GetPos() - v[0]->GetPos()),
+                             v[3]->GetPos() - v[0]->GetPos()) < 0)
+                        std::swap(v[1], v[2]);
+                    auto tetra = std::make_shared<ChElementTetra_4>();
+                    tetra->SetNodes(v[0], v[1], v[2], v[3]);
+                    tetra->SetMaterial(material);
+                    mesh->AddElement(tetra);
+                    elements.push_back(tetra);
+                }
+            }
+
+    system.SetupInitial();
+
+    // Deform the block and give the nodes some speed (for the damping forces).
+    for (size_t i = 0; i < nodes.size(); i++) {
+        ChVector<> x0 = nodes[i]->GetX0();
+        nodes[i]->SetPos(x0 + ChVector<>(0.01 * std::sin(3.0 * i), 0.02 * x0.x() * x0.z(), -0.01 * x0.y()));
+        nodes[i]->SetPos_dt(ChVector<>(0.1 * std::cos(5.0 * i), 0.05, -0.2 * x0.x()));
+    }
+    system.Setup();
+    system.Update();
+
+    // Reference: element contributions added one after the other.
+    ChVectorDynamic<> R_ref(system.GetNcoords_w());
+    for (auto& element : elements)
+        element->EleIntLoadResidual_F(R_ref, 0.5);
+    double scale = R_ref.NormInf();
+
+    bool passed = scale > 0;
+    ChVectorDynamic<> R_1(system.GetNcoords_w());
+    for (int num_threads : {1, 2, 4, 7}) {
+        CHOMPfunctions::SetNumThreads(num_threads);
+        ChVectorDynamic<> R(system.GetNcoords_w());
+        system.IntLoadResidual_F(0, R, 0.5);
+        if (num_threads == 1)
+            R_1 = R;
+
+        double error = 0;
+        bool same = true;
+        for (int i = 0; i < R.GetRows(); i++) {
+            error = std::max(error, std::abs(R(i) - R_ref(i)));
+            same = same && (R(i) == R_1(i));
+        }
+        std::cout << num_threads << " threads: error = " << error << " (scale " << scale << ")" << std::endl;
+        if (error > 1e-12 * scale) {
+            std::cout << "Wrong internal forces" << std::endl;
+            passed = false;
+        }
+        if (!same) {
+            std::cout << "Internal forces depend on the number of threads" << std::endl;
+            passed = false;
+        }
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
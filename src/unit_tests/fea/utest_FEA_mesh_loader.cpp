@@ -0,0 +1,155 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the TetGen and Abaqus mesh loaders: coordinates written in
+// various formats must be read exactly as strtod reads them, and loading
+// through a geometry cache must produce the same mesh.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMeshFileLoader.h"
+#include "chrono_fea/ChNodeFEAxyz.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// Node coordinates, as written in the files.
+static const char* coords[5][3] = {{"0", "0.0", "-0.0"},
+                                   {"1.5", "+2", "1e-3"},
+                                   {"0.1", "3.14159265358979323846264", "-2.5E+2"},
+                                   {"1.", ".25", "123456789012345678901234e-20"},
+                                   {"7e-30", "0.30000000000000004", "-1.7976931348623157e308"}};
+
+static bool CheckNodes(ChMesh& mesh) {
+    if (mesh.GetNnodes() != 5 || mesh.GetNelements() != 2)
+        return false;
+    for (int i = 0; i < 5; i++) {
+        auto node = std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh.GetNodes()[i]);
+        ChVector<> expected(std::strtod(coords[i][0], nullptr), std::strtod(coords[i][1], nullptr),
+                            std::strtod(coords[i][2], nullptr));
+        if (!node || !(node->GetPos() == expected))
+            return false;
+    }
+    return true;
+}
+
+static bool SameMesh(ChMesh& a, ChMesh& b) {
+    if (a.GetNnodes() != b.GetNnodes() || a.GetNelements() != b.GetNelements())
+        return false;
+    std::map<ChNodeFEAbase*, int> index_a, index_b;
+    for (unsigned int i = 0; i < a.GetNnodes(); i++) {
+        index_a[a.GetNodes()[i].get()] = i;
+        index_b[b.GetNodes()[i].get()] = i;
+        auto node_a = std::dynamic_pointer_cast<ChNodeFEAxyz>(a.GetNodes()[i]);
+        auto node_b = std::dynamic_pointer_cast<ChNodeFEAxyz>(b.GetNodes()[i]);
+        if (!(node_a->GetPos() == node_b->GetPos()))
+            return false;
+    }
+    for (unsigned int ie = 0; ie < a.GetNelements(); ie++) {
+        for (int in = 0; in < 4; in++) {
+            if (index_a[a.GetElement(ie)->GetNodeN(in).get()] != index_b[b.GetElement(ie)->GetNodeN(in).get()])
+                return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    auto material = std::make_shared<ChContinuumElastic>();
+
+    // TetGen files, with comments and blank lines.
+    {
+        std::ofstream node("utest_mesh_loader.node");
+        node << "# nodes\n5 3 0 0\n\n";
+        for (int i = 0; i < 5; i++)
+            node << "  " << i + 1 << "\t" << coords[i][0] << " " << coords[i][1] << " " << coords[i][2] << "\r\n";
+        std::ofstream ele("utest_mesh_loader.ele");
+        ele << "2 4 0  # tetrahedrons\n1 1 2 3 4\n2 2 3 4 5\n";
+    }
+    auto tetgen = std::make_shared<ChMesh>();
+    ChMeshFileLoader::FromTetGenFile(tetgen, "utest_mesh_loader.node", "utest_mesh_loader.ele", material);
+    if (!CheckNodes(*tetgen)) {
+        std::cout << "TetGen mesh not read correctly" << std::endl;
+        passed = false;
+    }
+
+    // Abaqus file, with an unused node and a node set.
+    {
+        std::ofstream inp("utest_mesh_loader.inp");
+        inp << "** test\n*HEADING\n*NODE, NSET=ALL\n";
+        for (int i = 0; i < 5; i++)
+            inp << i + 1 << ", " << coords[i][0] << ", " << coords[i][1] << ", " << coords[i][2] << "\n";
+        inp << "6, 9, 9, 9\n";
+        inp << "*ELEMENT, TYPE=C3D4, ELSET=TETS\n1, 1, 2, 3, 4\n2, 2, 3, 4, 5\n";
+        inp << "*NSET, NSET=FIXED\n1, 2,\n5\n";
+    }
+    std::vector<std::vector<std::shared_ptr<ChNodeFEAbase>>> node_sets;
+    auto abaqus = std::make_shared<ChMesh>();
+    ChMeshFileLoader::FromAbaqusFile(abaqus, "utest_mesh_loader.inp", material, node_sets);
+    if (!CheckNodes(*abaqus) || node_sets.size() != 1 || node_sets[0].size() != 3 ||
+        node_sets[0][2] != abaqus->GetNodes()[4]) {
+        std::cout << "Abaqus mesh not read correctly" << std::endl;
+        passed = false;
+    }
+
+    // Loads through a cache (the first one writes the entry, the second one reads it).
+    utils::ChGeometryCache cache(".");
+    for (int i = 0; i < 2; i++) {
+        auto cached = std::make_shared<ChMesh>();
+        ChMeshFileLoader::FromTetGenFile(cached, "utest_mesh_loader.node", "utest_mesh_loader.ele", material, VNULL,
+                                         ChMatrix33<>(1), &cache);
+        if (!SameMesh(*cached, *tetgen)) {
+            std::cout << "Cached TetGen mesh differs" << std::endl;
+            passed = false;
+        }
+        std::vector<std::vector<std::shared_ptr<ChNodeFEAbase>>> cached_sets;
+        cached = std::make_shared<ChMesh>();
+        ChMeshFileLoader::FromAbaqusFile(cached, "utest_mesh_loader.inp", material, cached_sets, VNULL,
+                                         ChMatrix33<>(1), true, &cache);
+        if (!SameMesh(*cached, *abaqus) || cached_sets.size() != 1 || cached_sets[0].size() != 3) {
+            std::cout << "Cached Abaqus mesh differs" << std::endl;
+            passed = false;
+        }
+    }
+
+    // Invalid files are reported.
+    {
+        std::ofstream ele("utest_mesh_loader.ele");
+        ele << "2 4 0\n1 1 2 3 4\n2 2 3 4 6\n";
+    }
+    bool thrown = false;
+    try {
+        auto invalid = std::make_shared<ChMesh>();
+        ChMeshFileLoader::FromTetGenFile(invalid, "utest_mesh_loader.node", "utest_mesh_loader.ele", material);
+    } catch (const ChException&) {
+        thrown = true;
+    }
+    if (!thrown) {
+        std::cout << "Invalid node ID not detected" << std::endl;
+        passed = false;
+    }
+
+    std::remove("utest_mesh_loader.node");
+    std::remove("utest_mesh_loader.ele");
+    std::remove("utest_mesh_loader.inp");
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
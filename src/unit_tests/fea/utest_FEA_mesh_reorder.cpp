@@ -0,0 +1,161 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChMesh::Reorder: a tetrahedral mesh of a bar, with nodes and
+// elements added in random order, is reordered with both methods. The node
+// bandwidth must decrease and the internal forces on each node must not change.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChNodeFEAxyz.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+static std::shared_ptr<ChMesh> CreateMesh(ChSystem& system, int nx, int ny, int nz, std::mt19937& rng) {
+    auto mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+
+    auto index = [&](int i, int j, int k) { return (i * (ny + 1) + j) * (nz + 1) + k; };
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= nx; i++)
+        for (int j = 0; j <= ny; j++)
+            for (int k = 0; k <= nz; k++)
+                nodes.push_back(std::make_shared<ChNodeFEAxyz>(ChVector<>(i * 0.1, j * 0.1, k * 0.1)));
+
+    // Split each cube in 6 tetrahedra around its main diagonal.
+    const int paths[6][2] = {{1, 3}, {1, 5}, {2, 3}, {2, 6}, {4, 5}, {4, 6}};
+    std::vector<std::shared_ptr<ChElementTetra_4>> elements;
+    for (int i = 0; i < nx; i++) {
+        for (int j = 0; j < ny; j++) {
+            for (int k = 0; k < nz; k++) {
+                auto corner = [&](int c) { return nodes[index(i + (c & 1), j + ((c >> 1) & 1), k + (c >> 2))]; };
+                for (auto& path : paths) {
+                    auto element = std::make_shared<ChElementTetra_4>();
+                    element->SetNodes(corner(0), corner(path[0]), corner(path[1]), corner(7));
+                    element->SetMaterial(material);
+                    elements.push_back(element);
+                }
+            }
+        }
+    }
+
+    std::shuffle(nodes.begin(), nodes.end(), rng);
+    std::shuffle(elements.begin(), elements.end(), rng);
+    for (auto& node : nodes)
+        mesh->AddNode(node);
+    for (auto& element : elements)
+        mesh->AddElement(element);
+    system.Add(mesh);
+    system.SetupInitial();
+    system.Setup();
+
+    // Deform the mesh, so that the internal forces are not zero.
+    std::uniform_real_distribution<double> displacement(-0.01, 0.01);
+    for (auto& node : nodes)
+        node->SetPos(node->GetPos() + ChVector<>(displacement(rng), displacement(rng), displacement(rng)));
+    mesh->Update(0, false);
+
+    return mesh;
+}
+
+// Internal forces of the mesh, per node.
+static std::map<ChNodeFEAbase*, ChVector<>> NodeForces(ChMesh& mesh) {
+    ChVectorDynamic<> R(mesh.GetDOF_w());
+    R.Reset();
+    mesh.IntLoadResidual_F(0, R, 1.0);
+    std::map<ChNodeFEAbase*, ChVector<>> forces;
+    for (auto& node : mesh.GetNodes()) {
+        unsigned int offset = node->NodeGetOffset_w();
+        forces[node.get()] = ChVector<>(R(offset), R(offset + 1), R(offset + 2));
+    }
+    return forces;
+}
+
+static bool CheckReorder(ChMesh::eChMeshOrdering method, const char* name) {
+    std::mt19937 rng(42);
+    ChSystemNSC system;
+    auto mesh = CreateMesh(system, 12, 3, 3, rng);
+    unsigned int bandwidth = mesh->GetNodeBandwidth();
+    auto forces = NodeForces(*mesh);
+    auto nodes = mesh->GetNodes();
+    unsigned int num_elements = mesh->GetNelements();
+
+    mesh->Reorder(method);
+
+    unsigned int new_bandwidth = mesh->GetNodeBandwidth();
+    std::cout << name << ": bandwidth " << bandwidth << " -> " << new_bandwidth << std::endl;
+
+    // RCM targets the bandwidth directly; a space-filling curve only bounds it loosely.
+    bool passed = true;
+    unsigned int max_bandwidth = (method == ChMesh::REORDER_RCM) ? bandwidth / 4 : bandwidth;
+    if (new_bandwidth >= max_bandwidth) {
+        std::cout << "  Bandwidth not reduced" << std::endl;
+        passed = false;
+    }
+
+    // Same nodes and elements, node indexes and offsets following the new order.
+    std::vector<std::shared_ptr<ChNodeFEAbase>> new_nodes;
+    unsigned int offset = 0;
+    for (unsigned int i = 0; i < mesh->GetNnodes(); i++) {
+        auto node = mesh->GetNodes()[i];
+        new_nodes.push_back(node);
+        if (node->GetIndex() != i + 1 || node->NodeGetOffset_w() != offset) {
+            std::cout << "  Wrong index or offset for node " << i << std::endl;
+            passed = false;
+        }
+        offset += node->Get_ndof_w();
+    }
+    std::sort(nodes.begin(), nodes.end());
+    std::sort(new_nodes.begin(), new_nodes.end());
+    if (nodes != new_nodes || mesh->GetNelements() != num_elements) {
+        std::cout << "  Nodes or elements changed" << std::endl;
+        passed = false;
+    }
+
+    auto new_forces = NodeForces(*mesh);
+    double max_force = 0;
+    double max_error = 0;
+    for (auto& force : forces) {
+        max_force = std::max(max_force, force.second.Length());
+        max_error = std::max(max_error, (new_forces[force.first] - force.second).Length());
+    }
+    std::cout << "  max force: " << max_force << "  max error: " << max_error << std::endl;
+    if (max_force == 0 || max_error > 1e-10 * max_force) {
+        std::cout << "  Internal forces changed" << std::endl;
+        passed = false;
+    }
+
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= CheckReorder(ChMesh::REORDER_RCM, "RCM");
+    passed &= CheckReorder(ChMesh::REORDER_HILBERT, "Hilbert");
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
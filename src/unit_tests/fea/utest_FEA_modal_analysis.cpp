@@ -0,0 +1,177 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the modal analysis of a system: a cantilever of tetrahedrons
+// must have the same modes whether its root nodes are fixed or constrained by
+// links, and a free beam must have six rigid body modes. The analysis must not
+// leave its matrices in the system descriptor.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/core/ChLinkedListMatrix.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChLinkPointFrame.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+static const int nx = 8;
+static const int ny = 2;
+static const int nz = 2;
+static const double h = 0.1;
+
+static int NodeId(int i, int j, int k) {
+    return (i * (ny + 1) + j) * (nz + 1) + k;
+}
+
+// Beam along X, optionally with the nodes at x = 0 fixed. Each cube is split into 6 tetrahedrons.
+static std::shared_ptr<ChMesh> CreateBeam(std::vector<std::shared_ptr<ChNodeFEAxyz>>& nodes, bool fixed) {
+    auto mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(2.1e11);
+    material->Set_v(0.3);
+    material->Set_density(7800);
+
+    nodes.clear();
+    for (int i = 0; i <= nx; i++)
+        for (int j = 0; j <= ny; j++)
+            for (int k = 0; k <= nz; k++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i * h, j * h, k * h));
+                node->SetFixed(fixed && i == 0);
+                nodes.push_back(node);
+                mesh->AddNode(node);
+            }
+
+    const int perm[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for (int i = 0; i < nx; i++)
+        for (int j = 0; j < ny; j++)
+            for (int k = 0; k < nz; k++)
+                for (int p = 0; p < 6; p++) {
+                    int c[3] = {i, j, k};
+                    int id[4];
+                    id[0] = NodeId(c[0], c[1], c[2]);
+                    for (int s = 0; s < 2; s++) {
+                        c[perm[p][s]]++;
+                        id[s + 1] = NodeId(c[0], c[1], c[2]);
+                    }
+                    id[3] = NodeId(i + 1, j + 1, k + 1);
+                    ChVector<> a = nodes[id[1]]->GetPos() - nodes[id[0]]->GetPos();
+                    ChVector<> b = nodes[id[2]]->GetPos() - nodes[id[0]]->GetPos();
+                    ChVector<> d = nodes[id[3]]->GetPos() - nodes[id[0]]->GetPos();
+                    if (Vdot(Vcross(a, b), d) < 0)
+                        std::swap(id[1], id[2]);
+                    auto element = std::make_shared<ChElementTetra_4>();
+                    element->SetNodes(nodes[id[0]], nodes[id[1]], nodes[id[2]], nodes[id[3]]);
+                    element->SetMaterial(material);
+                    mesh->AddElement(element);
+                }
+    return mesh;
+}
+
+enum BeamSupport { FIXED_NODES, LINKS, FREE };
+
+static int BeamModes(BeamSupport support, int num_modes, ChVectorDynamic<>& eigenvalues) {
+    ChSystemNSC system;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    auto mesh = CreateBeam(nodes, support == FIXED_NODES);
+    system.Add(mesh);
+    if (support == LINKS) {
+        auto ground = std::make_shared<ChBody>();
+        ground->SetBodyFixed(true);
+        system.Add(ground);
+        for (int j = 0; j <= ny; j++)
+            for (int k = 0; k <= nz; k++) {
+                auto link = std::make_shared<ChLinkPointFrame>();
+                link->Initialize(nodes[NodeId(0, j, k)], ground);
+                system.Add(link);
+            }
+    }
+    system.SetupInitial();
+
+    ChMatrixDynamic<> modes;
+    return system.ComputeModes(num_modes, eigenvalues, modes);
+}
+
+// The system descriptor is left as it was: KRM blocks cleared and same mass factor.
+static bool CheckDescriptor() {
+    ChSystemNSC system;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    system.Add(CreateBeam(nodes, true));
+    system.SetupInitial();
+    system.GetSystemDescriptor()->SetMassFactor(0.25);
+
+    ChVectorDynamic<> eigenvalues;
+    ChMatrixDynamic<> modes;
+    system.ComputeModes(2, eigenvalues, modes);
+    if (system.GetSystemDescriptor()->GetMassFactor() != 0.25)
+        return false;
+
+    // The nodes have no mass of their own, so H is zero unless the KRM blocks were left loaded.
+    ChLinkedListMatrix H;
+    system.GetSystemDescriptor()->ConvertToMatrixForm(nullptr, &H, nullptr, nullptr, nullptr, nullptr, false, false);
+    int n = H.GetNumRows();
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            if (H.GetElement(i, j) != 0)
+                return false;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    const int num_modes = 4;
+
+    ChVectorDynamic<> fixed;
+    ChVectorDynamic<> linked;
+    ChVectorDynamic<> free;
+    if (BeamModes(FIXED_NODES, num_modes, fixed) != num_modes || BeamModes(LINKS, num_modes, linked) != num_modes ||
+        BeamModes(FREE, 8, free) != 8) {
+        std::cout << "Modes not converged" << std::endl;
+        passed = false;
+    }
+
+    for (int m = 0; m < num_modes; m++) {
+        double error = std::abs(linked(m) - fixed(m)) / fixed(m);
+        std::cout << "Mode " << m << ": fixed nodes f = " << std::sqrt(fixed(m)) / CH_C_2PI
+                  << " Hz, links f = " << std::sqrt(linked(m)) / CH_C_2PI << " Hz" << std::endl;
+        if (error > 1e-6) {
+            std::cout << "Constrained modes differ" << std::endl;
+            passed = false;
+        }
+    }
+
+    for (int m = 0; m < 8; m++)
+        std::cout << "Free beam, eigenvalue " << m << " = " << free(m) << std::endl;
+    for (int m = 0; m < 6; m++) {
+        if (std::abs(free(m)) > 1e-6 * free(6)) {
+            std::cout << "Wrong rigid body mode" << std::endl;
+            passed = false;
+        }
+    }
+    if (free(6) < fixed(0)) {
+        std::cout << "Wrong first elastic mode of the free beam" << std::endl;
+        passed = false;
+    }
+
+    if (!CheckDescriptor()) {
+        std::cout << "System descriptor changed by the modal analysis" << std::endl;
+        passed = false;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
@@ -0,0 +1,234 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the Craig-Bampton reduction of a cantilever of tetrahedrons:
+// the eigenfrequencies of the reduced model must approximate those of the full
+// mesh from above, rigid motions must not produce internal forces, and the
+// nodal masses of the boundary nodes must not be added to the element.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "chrono/core/ChLinearAlgebra.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChModalReduction.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+static const int nx = 8;
+static const int ny = 2;
+static const int nz = 2;
+static const double h = 0.1;
+
+static int NodeId(int i, int j, int k) {
+    return (i * (ny + 1) + j) * (nz + 1) + k;
+}
+
+// Cantilever along X, with the nodes at x = 0 fixed. Each cube is split into 6 tetrahedrons.
+static std::shared_ptr<ChMesh> CreateBeam(ChSystem& system, std::vector<std::shared_ptr<ChNodeFEAxyz>>& nodes) {
+    auto mesh = std::make_shared<ChMesh>();
+    system.Add(mesh);
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(2.1e11);
+    material->Set_v(0.3);
+    material->Set_density(7800);
+
+    nodes.clear();
+    for (int i = 0; i <= nx; i++)
+        for (int j = 0; j <= ny; j++)
+            for (int k = 0; k <= nz; k++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i * h, j * h, k * h));
+                node->SetFixed(i == 0);
+                nodes.push_back(node);
+                mesh->AddNode(node);
+            }
+
+    const int perm[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for (int i = 0; i < nx; i++)
+        for (int j = 0; j < ny; j++)
+            for (int k = 0; k < nz; k++)
+                for (int p = 0; p < 6; p++) {
+                    int c[3] = {i, j, k};
+                    int id[4];
+                    id[0] = NodeId(c[0], c[1], c[2]);
+                    for (int s = 0; s < 2; s++) {
+                        c[perm[p][s]]++;
+                        id[s + 1] = NodeId(c[0], c[1], c[2]);
+                    }
+                    id[3] = NodeId(i + 1, j + 1, k + 1);
+                    ChVector<> a = nodes[id[1]]->GetPos() - nodes[id[0]]->GetPos();
+                    ChVector<> b = nodes[id[2]]->GetPos() - nodes[id[0]]->GetPos();
+                    ChVector<> d = nodes[id[3]]->GetPos() - nodes[id[0]]->GetPos();
+                    if (Vdot(Vcross(a, b), d) < 0)
+                        std::swap(id[1], id[2]);
+                    auto element = std::make_shared<ChElementTetra_4>();
+                    element->SetNodes(nodes[id[0]], nodes[id[1]], nodes[id[2]], nodes[id[3]]);
+                    element->SetMaterial(material);
+                    mesh->AddElement(element);
+                }
+    return mesh;
+}
+
+// Eigenvalues of K * x = lambda * M * x, for the rows and columns listed in 'dofs' (dense Cholesky of M).
+static void GeneralizedEigenvalues(const ChMatrixDynamic<>& K,
+                                   const ChMatrixDynamic<>& M,
+                                   const std::vector<int>& dofs,
+                                   ChMatrixDynamic<>& lambda) {
+    int n = (int)dofs.size();
+    ChMatrixDynamic<> L(n, n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j <= i; j++) {
+            double sum = M(dofs[i], dofs[j]);
+            for (int k = 0; k < j; k++)
+                sum -= L(i, k) * L(j, k);
+            L(i, j) = (i == j) ? std::sqrt(sum) : sum / L(j, j);
+        }
+    // C = L^-1 * K * L^-T
+    ChMatrixDynamic<> C(n, n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            C(i, j) = K(dofs[i], dofs[j]);
+    for (int pass = 0; pass < 2; pass++) {
+        for (int c = 0; c < n; c++)
+            for (int i = 0; i < n; i++) {
+                double sum = C(i, c);
+                for (int k = 0; k < i; k++)
+                    sum -= L(i, k) * C(k, c);
+                C(i, c) = sum / L(i, i);
+            }
+        ChMatrixDynamic<> T(n, n);
+        T.CopyFromMatrixT(C);
+        C = T;
+    }
+    ChMatrixDynamic<> V;
+    ChLinearAlgebra::SymmetricEigen(C, V, lambda);
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    const int num_check = 3;
+    ChSystemNSC system;
+
+    // Modes of the full mesh, as the fixed-interface modes of a reduction on the fixed nodes only.
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    auto mesh = CreateBeam(system, nodes);
+    auto full = ChModalReduction::Reduce(std::make_shared<ChMesh>(), mesh, {}, num_check);
+    const ChMatrixDynamic<>& Kfull = full->GetReducedStiffness();
+    int nfixed = 3 * (ny + 1) * (nz + 1);
+    std::vector<double> exact(num_check);
+    for (int m = 0; m < num_check; m++) {
+        exact[m] = Kfull(nfixed + m, nfixed + m);
+        std::cout << "Full mesh, mode " << m << ": f = " << std::sqrt(exact[m]) / CH_C_2PI << " Hz" << std::endl;
+    }
+
+    // Reduction with the tip nodes as boundary nodes.
+    mesh = CreateBeam(system, nodes);
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> tip;
+    for (int j = 0; j <= ny; j++)
+        for (int k = 0; k <= nz; k++)
+            tip.push_back(nodes[NodeId(nx, j, k)]);
+    auto reduced_mesh = std::make_shared<ChMesh>();
+    auto element = ChModalReduction::Reduce(reduced_mesh, mesh, tip, 6);
+    if (reduced_mesh->GetNnodes() != tip.size() + (ny + 1) * (nz + 1) + 1 || reduced_mesh->GetNelements() != 1) {
+        std::cout << "Wrong reduced mesh" << std::endl;
+        passed = false;
+    }
+
+    // Free unknowns: the tip nodes and the modes (the modal mass block is the identity).
+    int nr = element->GetNdofs();
+    ChMatrixDynamic<> Mr(element->GetReducedMass());
+    std::vector<int> free_dofs;
+    for (int i = 0; i < nr; i++) {
+        if (i < 3 * (int)tip.size() || i >= 3 * (int)(tip.size() + (ny + 1) * (nz + 1)))
+            free_dofs.push_back(i);
+        if (i >= nr - 6)
+            Mr(i, i) = 1;
+    }
+    ChMatrixDynamic<> lambda;
+    GeneralizedEigenvalues(element->GetReducedStiffness(), Mr, free_dofs, lambda);
+    for (int m = 0; m < num_check; m++) {
+        double error = (lambda(m) - exact[m]) / exact[m];
+        std::cout << "Reduced model, mode " << m << ": f = " << std::sqrt(lambda(m)) / CH_C_2PI
+                  << " Hz, relative error on eigenvalue = " << error << std::endl;
+        if (error < -1e-6 || error > 0.01) {
+            std::cout << "Wrong eigenvalue" << std::endl;
+            passed = false;
+        }
+    }
+
+    // Nodal masses of the boundary nodes stay in the system and are not added to the element.
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes2;
+    auto mesh2 = CreateBeam(system, nodes2);
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> tip2;
+    for (int j = 0; j <= ny; j++)
+        for (int k = 0; k <= nz; k++) {
+            tip2.push_back(nodes2[NodeId(nx, j, k)]);
+            tip2.back()->SetMass(5);
+        }
+    auto element2 = ChModalReduction::Reduce(std::make_shared<ChMesh>(), mesh2, tip2, 6);
+    const ChMatrixDynamic<>& M1 = element->GetReducedMass();
+    const ChMatrixDynamic<>& M2 = element2->GetReducedMass();
+    double mass_diff = 0;
+    double mass_scale = 0;
+    for (int i = 0; i < nr; i++)
+        for (int j = 0; j < nr; j++) {
+            mass_diff = std::max(mass_diff, std::abs(M2(i, j) - M1(i, j)));
+            mass_scale = std::max(mass_scale, std::abs(M1(i, j)));
+        }
+    if (mass_diff > 1e-9 * mass_scale) {
+        std::cout << "Masses of the boundary nodes added to the element, difference = " << mass_diff << std::endl;
+        passed = false;
+    }
+
+    // A rigid motion of the boundary nodes does not produce internal forces.
+    ChQuaternion<> rot = Q_from_AngAxis(0.7, ChVector<>(1, 2, 3).GetNormalized());
+    ChVector<> shift(0.3, -1, 2);
+    for (auto& node : nodes)
+        node->SetPos(shift + rot.Rotate(node->GetX0()));
+    element->Update();
+    ChMatrixDynamic<> Fi(nr, 1);
+    element->ComputeInternalForces(Fi);
+    double max_force = Fi.NormInf();
+    // Compare with the forces of a 1 mm tip displacement.
+    for (auto& node : tip)
+        node->SetPos(node->GetPos() + ChVector<>(0, 0, 1e-3));
+    element->Update();
+    ChMatrixDynamic<> Fd(nr, 1);
+    element->ComputeInternalForces(Fd);
+    std::cout << "Max force for rigid motion = " << max_force << ", for 1 mm tip displacement = " << Fd.NormInf()
+              << std::endl;
+    if (max_force > 1e-9 * Fd.NormInf()) {
+        std::cout << "Rigid motion produces internal forces" << std::endl;
+        passed = false;
+    }
+
+    // The interior nodes follow the rigid motion.
+    for (auto& node : tip)
+        node->SetPos(node->GetPos() - ChVector<>(0, 0, 1e-3));
+    element->Update();
+    element->UpdateInteriorNodes();
+    double max_error = 0;
+    for (auto& node : element->GetInteriorNodes())
+        max_error = std::max(max_error, (node->GetPos() - (shift + rot.Rotate(node->GetX0()))).Length());
+    if (max_error > 1e-9) {
+        std::cout << "Wrong interior nodes, error = " << max_error << std::endl;
+        passed = false;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
@@ -0,0 +1,175 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the incremental update of ChVisualizationFEAmesh.
+//
+// The triangle mesh built for a block of tetrahedrons is checked against the
+// nodes of the elements and against smoothed normals computed one triangle
+// after the other. The buffers must follow a change of the elements that keeps
+// their number, must not depend on the number of threads, and must show the
+// faces of a load surface.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChFaceTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChMeshSurface.h"
+#include "chrono_fea/ChVisualizationFEAmesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+static geometry::ChTriangleMeshConnected& GetTriangles(ChVisualizationFEAmesh& vis) {
+    return std::static_pointer_cast<ChTriangleMeshShape>(vis.GetAssets()[0])->GetMesh();
+}
+
+// Check that the vertexes of each tetrahedron are its nodes.
+static bool CheckVertexes(ChVisualizationFEAmesh& vis, ChMesh& mesh, const char* name) {
+    auto& trimesh = GetTriangles(vis);
+    if (trimesh.getCoordsVertices().size() != 4 * mesh.GetNelements()) {
+        std::cout << name << ": wrong number of vertexes" << std::endl;
+        return false;
+    }
+    for (unsigned int ie = 0; ie < mesh.GetNelements(); ie++) {
+        auto element = mesh.GetElement(ie);
+        for (int in = 0; in < 4; in++) {
+            auto node = std::static_pointer_cast<ChNodeFEAxyz>(element->GetNodeN(in));
+            if (trimesh.getCoordsVertices()[4 * ie + in] != node->GetPos()) {
+                std::cout << name << ": wrong vertex " << in << " of element " << ie << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Check the smoothed normals against normals accumulated one triangle after the other.
+static bool CheckNormals(ChVisualizationFEAmesh& vis, const char* name) {
+    auto& trimesh = GetTriangles(vis);
+    auto& vertexes = trimesh.getCoordsVertices();
+    std::vector<ChVector<>> normals(trimesh.getCoordsNormals().size(), VNULL);
+    std::vector<int> count(normals.size(), 0);
+    for (size_t it = 0; it < trimesh.getIndicesVertexes().size(); it++) {
+        ChVector<int> iv = trimesh.getIndicesVertexes()[it];
+        ChVector<int> in = trimesh.getIndicesNormals()[it];
+        ChVector<> n = Vcross(vertexes[iv.y()] - vertexes[iv.x()], vertexes[iv.z()] - vertexes[iv.x()]);
+        n.Normalize();
+        for (int k = 0; k < 3; k++) {
+            normals[in[k]] += n;
+            count[in[k]]++;
+        }
+    }
+    for (size_t i = 0; i < normals.size(); i++) {
+        if (count[i] == 0 || (normals[i] * (1.0 / count[i]) - trimesh.getCoordsNormals()[i]).Length() > 1e-12) {
+            std::cout << name << ": wrong normal " << i << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    auto mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+
+    // Two cubes along X, each split into 5 tetrahedrons.
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= 2; i++)
+        for (int j = 0; j <= 1; j++)
+            for (int k = 0; k <= 1; k++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i, j, k));
+                nodes.push_back(node);
+                mesh->AddNode(node);
+            }
+    auto N = [&](int i, int j, int k) { return nodes[(i * 2 + j) * 2 + k]; };
+
+    const int tets[5][4] = {{0, 1, 2, 4}, {3, 2, 1, 7}, {5, 4, 7, 1}, {6, 7, 4, 2}, {1, 2, 4, 7}};
+    std::vector<std::shared_ptr<ChElementTetra_4>> elements;
+    for (int i = 0; i < 2; i++)
+        for (auto& tet : tets) {
+            std::shared_ptr<ChNodeFEAxyz> v[4];
+            for (int c = 0; c < 4; c++)
+                v[c] = N(i + (tet[c] & 1), (tet[c] >> 1) & 1, (tet[c] >> 2) & 1);
+            if (Vdot(Vcross(v[1]->GetPos() - v[0]->GetPos(), v[2]->GetPos() - v[0]->GetPos()),
+                     v[3]->GetPos() - v[0]->GetPos()) < 0)
+                std::swap(v[1], v[2]);
+            auto element = std::make_shared<ChElementTetra_4>();
+            element->SetNodes(v[0], v[1], v[2], v[3]);
+            element->SetMaterial(material);
+            mesh->AddElement(element);
+            elements.push_back(element);
+        }
+
+    ChVisualizationFEAmesh vis(*mesh);
+    vis.SetFEMdataType(ChVisualizationFEAmesh::E_PLOT_NODE_DISP_NORM);
+    vis.SetSmoothFaces(true);
+
+    bool passed = true;
+    vis.Update(nullptr, CSYSNORM);
+    passed &= CheckVertexes(vis, *mesh, "Initial mesh");
+    passed &= CheckNormals(vis, "Initial mesh");
+
+    // Same number of elements, in a different order: the layout must be rebuilt.
+    mesh->ClearElements();
+    for (auto it = elements.rbegin(); it != elements.rend(); ++it)
+        mesh->AddElement(*it);
+    for (size_t i = 0; i < nodes.size(); i++)
+        nodes[i]->SetPos(nodes[i]->GetX0() + ChVector<>(0.1 * std::sin(i), 0.05 * std::cos(3.0 * i), 0.02 * i));
+    vis.Update(nullptr, CSYSNORM);
+    passed &= CheckVertexes(vis, *mesh, "Reordered elements");
+    passed &= CheckNormals(vis, "Reordered elements");
+
+    // The buffers do not depend on the number of threads.
+    auto& trimesh = GetTriangles(vis);
+    CHOMPfunctions::SetNumThreads(1);
+    vis.Update(nullptr, CSYSNORM);
+    auto normals_1 = trimesh.getCoordsNormals();
+    auto colors_1 = trimesh.getCoordsColors();
+    CHOMPfunctions::SetNumThreads(4);
+    vis.Update(nullptr, CSYSNORM);
+    if (trimesh.getCoordsNormals() != normals_1 || trimesh.getCoordsColors() != colors_1) {
+        std::cout << "Buffers depend on the number of threads" << std::endl;
+        passed = false;
+    }
+
+    // Faces of a load surface.
+    auto surface = std::make_shared<ChMeshSurface>();
+    mesh->AddMeshSurface(surface);
+    surface->AddFacesFromBoundary();
+    vis.SetFEMdataType(ChVisualizationFEAmesh::E_PLOT_LOADSURFACES);
+    vis.Update(nullptr, CSYSNORM);
+    size_t nfaces = surface->GetFacesList().size();
+    bool faces_ok = nfaces > 0 && trimesh.getCoordsVertices().size() == 3 * nfaces &&
+                    trimesh.getIndicesVertexes().size() == nfaces;
+    for (size_t ifa = 0; faces_ok && ifa < nfaces; ifa++) {
+        auto face = std::static_pointer_cast<ChFaceTetra_4>(surface->GetFacesList()[ifa]);
+        for (int in = 0; in < 3; in++)
+            faces_ok = faces_ok && trimesh.getCoordsVertices()[3 * ifa + in] == face->GetNodeN(in)->GetPos();
+        int iv = 3 * (int)ifa;
+        faces_ok = faces_ok && trimesh.getIndicesVertexes()[ifa] == ChVector<int>(iv, iv + 1, iv + 2);
+    }
+    passed &= CheckNormals(vis, "Load surface");
+    if (!faces_ok) {
+        std::cout << "Wrong load surface faces" << std::endl;
+        passed = false;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
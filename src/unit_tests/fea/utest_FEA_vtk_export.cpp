@@ -0,0 +1,185 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the VTK exporter of FEA meshes.
+//
+// A quadratic tetrahedron and a quadratic hexahedron, with nodes placed as
+// given by their shape functions, are exported over a few frames. The test
+// checks that:
+// - the mid-edge nodes of the exported cells are on the edges expected by VTK,
+// - only the requested node fields are written,
+// - the collection file lists all frames, with times written exactly.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chrono_fea/ChElementHexa_20.h"
+#include "chrono_fea/ChElementTetra_10.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChMeshExporterVTK.h"
+#include "chrono_fea/ChNodeFEAxyz.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+static std::string ReadFile(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+// Read an array of the appended data block of a .vtu file.
+template <typename T>
+static std::vector<T> ReadArray(const std::string& vtu, const std::string& name) {
+    size_t tag = vtu.find("Name=\"" + name + "\"");
+    size_t offset = std::stoul(vtu.substr(vtu.find("offset=\"", tag) + 8));
+    size_t data = vtu.find("<AppendedData encoding=\"raw\">\n_") + 31 + offset;
+    uint64_t nbytes;
+    std::memcpy(&nbytes, &vtu[data], sizeof(uint64_t));
+    std::vector<T> array(nbytes / sizeof(T));
+    std::memcpy(array.data(), &vtu[data + sizeof(uint64_t)], nbytes);
+    return array;
+}
+
+// Check that the mid-edge nodes of a cell, in VTK order, are at the middle of the given edges.
+static bool CheckMidNodes(const std::vector<float>& points,
+                          const std::vector<int32_t>& connectivity,
+                          size_t first,
+                          int ncorners,
+                          const std::vector<std::pair<int, int>>& edges,
+                          const char* name) {
+    for (size_t k = 0; k < edges.size(); ++k) {
+        const float* a = &points[3 * connectivity[first + edges[k].first]];
+        const float* b = &points[3 * connectivity[first + edges[k].second]];
+        const float* m = &points[3 * connectivity[first + ncorners + k]];
+        for (int j = 0; j < 3; ++j) {
+            if (std::abs(0.5f * (a[j] + b[j]) - m[j]) > 1e-6f) {
+                std::cout << name << ": node " << ncorners + k << " is not on edge " << edges[k].first << "-"
+                          << edges[k].second << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    auto mesh = std::make_shared<ChMesh>();
+
+    // Node positions from the natural coordinates of the nodes in the shape functions of the elements.
+    std::vector<ChVector<>> tetra_pos = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    int tetra_mid[6][2] = {{0, 1}, {1, 2}, {2, 0}, {0, 3}, {1, 3}, {2, 3}};
+    for (auto& e : tetra_mid)
+        tetra_pos.push_back(0.5 * (tetra_pos[e[0]] + tetra_pos[e[1]]));
+
+    std::vector<ChVector<>> hexa_pos = {{-1, -1, -1}, {1, -1, -1}, {1, 1, -1}, {-1, 1, -1}, {-1, -1, 1},
+                                        {1, -1, 1},   {1, 1, 1},   {-1, 1, 1}, {0, -1, -1}, {1, 0, -1},
+                                        {0, 1, -1},   {-1, 0, -1}, {0, -1, 1}, {1, 0, 1},   {0, 1, 1},
+                                        {-1, 0, 1},   {-1, -1, 0}, {1, -1, 0}, {1, 1, 0},   {-1, 1, 0}};
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> tn, hn;
+    for (auto& pos : tetra_pos)
+        tn.push_back(std::make_shared<ChNodeFEAxyz>(pos));
+    for (auto& pos : hexa_pos)
+        hn.push_back(std::make_shared<ChNodeFEAxyz>(pos + ChVector<>(3, 0, 0)));
+
+    // Add the nodes in reverse order, so that the connectivity is not the identity.
+    for (auto it = hn.rbegin(); it != hn.rend(); ++it)
+        mesh->AddNode(*it);
+    for (auto it = tn.rbegin(); it != tn.rend(); ++it)
+        mesh->AddNode(*it);
+
+    auto tetra = std::make_shared<ChElementTetra_10>();
+    tetra->SetNodes(tn[0], tn[1], tn[2], tn[3], tn[4], tn[5], tn[6], tn[7], tn[8], tn[9]);
+    mesh->AddElement(tetra);
+    auto hexa = std::make_shared<ChElementHexa_20>();
+    hexa->SetNodes(hn[0], hn[1], hn[2], hn[3], hn[4], hn[5], hn[6], hn[7], hn[8], hn[9], hn[10], hn[11], hn[12],
+                   hn[13], hn[14], hn[15], hn[16], hn[17], hn[18], hn[19]);
+    mesh->AddElement(hexa);
+
+    ChMeshExporterVTK exporter(mesh, ".", "utest_vtk");
+    exporter.SetFields(ChMeshExporterVTK::NODE_SPEED);
+
+    std::vector<double> times = {0.1, 1.0 / 3.0, 2.0 / 3.0 + 1e-13};
+    std::vector<std::string> files;
+    for (double time : times) {
+        files.push_back(exporter.WriteFrame(time));
+        tn[0]->SetPos_dt(ChVector<>(time, 0, 0));
+    }
+
+    bool passed = true;
+
+    // Node ordering of the quadratic cells.
+    std::string vtu = ReadFile(files.back());
+    auto points = ReadArray<float>(vtu, "Points");
+    auto connectivity = ReadArray<int32_t>(vtu, "connectivity");
+    auto types = ReadArray<uint8_t>(vtu, "types");
+    if (connectivity.size() != 30 || types.size() != 2 || types[0] != 24 || types[1] != 25) {
+        std::cout << "Wrong cells" << std::endl;
+        passed = false;
+    } else {
+        passed &= CheckMidNodes(points, connectivity, 0, 4, {{0, 1}, {1, 2}, {0, 2}, {0, 3}, {1, 3}, {2, 3}},
+                                "quadratic tetra");
+        passed &= CheckMidNodes(points, connectivity, 10, 8,
+                                {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6}, {6, 7}, {7, 4}, {0, 4}, {1, 5},
+                                 {2, 6}, {3, 7}},
+                                "quadratic hexahedron");
+    }
+
+    // Requested fields only.
+    auto speed = ReadArray<float>(vtu, "Speed");
+    if (speed.size() != 3 * 30 || speed[3 * connectivity[0]] != (float)times[1] ||
+        vtu.find("Displacement") != std::string::npos || vtu.find("Acceleration") != std::string::npos) {
+        std::cout << "Wrong node fields" << std::endl;
+        passed = false;
+    }
+
+    // Collection file: one data set per frame, times written with full precision.
+    std::string pvd = ReadFile("utest_vtk.pvd");
+    std::istringstream lines(pvd);
+    std::string line;
+    size_t frame = 0;
+    while (std::getline(lines, line)) {
+        size_t pos = line.find("timestep=\"");
+        if (pos == std::string::npos)
+            continue;
+        if (frame >= times.size() || std::stod(line.substr(pos + 10)) != times[frame] ||
+            line.find(files[frame].substr(2)) == std::string::npos) {
+            std::cout << "Wrong data set: " << line << std::endl;
+            passed = false;
+        }
+        frame++;
+    }
+    const char* tail = "  </Collection>\n</VTKFile>\n";
+    if (frame != times.size() || pvd.size() < std::strlen(tail) ||
+        pvd.compare(pvd.size() - std::strlen(tail), std::strlen(tail), tail) != 0) {
+        std::cout << "Wrong collection file" << std::endl;
+        passed = false;
+    }
+
+    for (auto& file : files)
+        std::remove(file.c_str());
+    std::remove("utest_vtk.pvd");
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
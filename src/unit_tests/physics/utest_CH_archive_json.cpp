@@ -0,0 +1,142 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the streaming JSON archives.
+//
+// A double pendulum is simulated, written with ChArchiveOutJSONStream and read
+// back into a new system with ChArchiveInJSONStream. The restored system must
+// have exactly the same state, and must be archived to the same file again.
+// The file must also be readable with the DOM-based ChArchiveInJSON.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/serialization/ChArchiveJSON.h"
+
+using namespace chrono;
+
+void CreateModel(ChSystemNSC& system) {
+    system.Set_G_acc(ChVector<>(0, -10, 0));
+
+    auto ground = std::make_shared<ChBody>();
+    system.AddBody(ground);
+    ground->SetIdentifier(-1);
+    ground->SetBodyFixed(true);
+
+    auto pend1 = std::make_shared<ChBody>();
+    system.AddBody(pend1);
+    pend1->SetIdentifier(1);
+    pend1->SetPos(ChVector<>(0.5, 0, 0));
+
+    auto pend2 = std::make_shared<ChBody>();
+    system.AddBody(pend2);
+    pend2->SetIdentifier(2);
+    pend2->SetPos(ChVector<>(1.5, 0, 0));
+
+    auto rev1 = std::make_shared<ChLinkLockRevolute>();
+    rev1->Initialize(ground, pend1, ChCoordsys<>(ChVector<>(0, 0, 0), QUNIT));
+    system.AddLink(rev1);
+
+    auto rev2 = std::make_shared<ChLinkLockRevolute>();
+    rev2->Initialize(pend1, pend2, ChCoordsys<>(ChVector<>(1, 0, 0), QUNIT));
+    system.AddLink(rev2);
+}
+
+static void WriteSystem(ChSystem& system, const std::string& filename) {
+    ChArchiveOutJSONStream marchive(filename);
+    marchive << CHNVP(system, "system");
+}
+
+static std::string ReadFile(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+// Largest difference between the states of two systems (infinite if the sizes differ).
+static double StateDifference(ChSystem& system1, ChSystem& system2) {
+    system1.Setup();
+    system2.Setup();
+    ChState x1(system1.GetNcoords_x(), &system1);
+    ChState x2(system2.GetNcoords_x(), &system2);
+    ChStateDelta v1(system1.GetNcoords_v(), &system1);
+    ChStateDelta v2(system2.GetNcoords_v(), &system2);
+    double T1, T2;
+    system1.StateGather(x1, v1, T1);
+    system2.StateGather(x2, v2, T2);
+    if (x1.GetRows() != x2.GetRows() || v1.GetRows() != v2.GetRows())
+        return INFINITY;
+    double diff = std::abs(T1 - T2);
+    for (int i = 0; i < x1.GetRows(); i++)
+        diff = std::max(diff, std::abs(x1(i) - x2(i)));
+    for (int i = 0; i < v1.GetRows(); i++)
+        diff = std::max(diff, std::abs(v1(i) - v2(i)));
+    return diff;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    ChSystemNSC system1;
+    CreateModel(system1);
+    for (int it = 0; it < 100; it++)
+        system1.DoStepDynamics(1e-3);
+    WriteSystem(system1, "utest_archive1.json");
+
+    // Round trip through the streaming reader.
+    ChSystemNSC system2;
+    {
+        ChArchiveInJSONStream marchive("utest_archive1.json");
+        marchive >> CHNVP(system2, "system");
+    }
+    double diff = StateDifference(system1, system2);
+    std::cout << "Streaming reader: state difference " << diff << std::endl;
+    if (diff != 0 || system2.Get_bodylist()->size() != 3 || system2.Get_linklist()->size() != 2) {
+        std::cout << "Restored system differs from the original one" << std::endl;
+        passed = false;
+    }
+
+    WriteSystem(system2, "utest_archive2.json");
+    if (ReadFile("utest_archive1.json") != ReadFile("utest_archive2.json")) {
+        std::cout << "Archive of the restored system differs from the original archive" << std::endl;
+        passed = false;
+    }
+
+    // The same file read with the DOM-based reader.
+    ChSystemNSC system3;
+    {
+        ChStreamInAsciiFile mfile("utest_archive1.json");
+        ChArchiveInJSON marchive(mfile);
+        marchive >> CHNVP(system3, "system");
+    }
+    diff = StateDifference(system1, system3);
+    std::cout << "DOM reader: state difference " << diff << std::endl;
+    if (!(diff < 1e-12)) {
+        std::cout << "System read with ChArchiveInJSON differs from the original one" << std::endl;
+        passed = false;
+    }
+
+    std::remove("utest_archive1.json");
+    std::remove("utest_archive2.json");
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
@@ -0,0 +1,153 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for binary checkpoints (WriteCheckpointBinary/ReadCheckpointBinary).
+//
+// A double pendulum is simulated, checkpointed and simulated further. A second
+// system restored from the checkpoint must reproduce the same trajectory.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "chrono/core/ChLog.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChUtilsInputOutput.h"
+
+using namespace chrono;
+
+void CreateModel(ChSystemNSC& system) {
+    system.Set_G_acc(ChVector<>(0, -10, 0));
+
+    auto ground = std::make_shared<ChBody>();
+    system.AddBody(ground);
+    ground->SetIdentifier(-1);
+    ground->SetBodyFixed(true);
+
+    auto pend1 = std::make_shared<ChBody>();
+    system.AddBody(pend1);
+    pend1->SetIdentifier(1);
+    pend1->SetPos(ChVector<>(0.5, 0, 0));
+
+    auto pend2 = std::make_shared<ChBody>();
+    system.AddBody(pend2);
+    pend2->SetIdentifier(2);
+    pend2->SetPos(ChVector<>(1.5, 0, 0));
+
+    auto rev1 = std::make_shared<ChLinkLockRevolute>();
+    rev1->Initialize(ground, pend1, ChCoordsys<>(ChVector<>(0, 0, 0), QUNIT));
+    system.AddLink(rev1);
+
+    auto rev2 = std::make_shared<ChLinkLockRevolute>();
+    rev2->Initialize(pend1, pend2, ChCoordsys<>(ChVector<>(1, 0, 0), QUNIT));
+    system.AddLink(rev2);
+}
+
+// A box dropped on the ground with a horizontal velocity, which then slides on it.
+void CreateContactModel(ChSystemNSC& system) {
+    system.Set_G_acc(ChVector<>(0, -10, 0));
+
+    auto ground = std::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, true, false);
+    system.AddBody(ground);
+    ground->SetIdentifier(-1);
+    ground->SetBodyFixed(true);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+
+    auto box = std::make_shared<ChBodyEasyBox>(0.4, 0.2, 0.3, 1000, true, false);
+    system.AddBody(box);
+    box->SetIdentifier(1);
+    box->SetPos(ChVector<>(0, 0.15, 0));
+    box->SetRot(Q_from_AngY(0.3));
+    box->SetPos_dt(ChVector<>(0.2, 0, 0));
+}
+
+std::vector<double> Simulate(ChSystem& system, int num_steps) {
+    std::vector<double> data;
+    for (int it = 0; it < num_steps; it++) {
+        system.DoStepDynamics(1e-3);
+        data.push_back(system.GetChTime());
+        for (auto body : *system.Get_bodylist()) {
+            data.push_back(body->GetPos().x());
+            data.push_back(body->GetPos().y());
+            data.push_back(body->GetPos_dt().x());
+            data.push_back(body->GetPos_dt().y());
+        }
+    }
+    return data;
+}
+
+int main(int argc, char* argv[]) {
+    std::string filename = "checkpoint.bin";
+
+    // Reference run, with a checkpoint half way
+    ChSystemNSC system1;
+    CreateModel(system1);
+    Simulate(system1, 200);
+    utils::WriteCheckpointBinary(&system1, filename);
+    auto ref = Simulate(system1, 200);
+
+    // Restart from the checkpoint
+    ChSystemNSC system2;
+    utils::ReadCheckpointBinary(&system2, filename);
+    auto res = Simulate(system2, 200);
+
+    std::remove(filename.c_str());
+
+    // The restart must be exact.
+    bool passed = (ref == res);
+    if (!passed)
+        GetLog() << "Restarted trajectory differs from the reference one\n";
+
+    // Same with contacts: a box sliding on the ground, checkpointed while in contact.
+    ChSystemNSC system3;
+    CreateContactModel(system3);
+    Simulate(system3, 200);
+    utils::WriteCheckpointBinary(&system3, filename);
+    ref = Simulate(system3, 200);
+
+    ChSystemNSC system4;
+    utils::ReadCheckpointBinary(&system4, filename);
+    res = Simulate(system4, 200);
+
+    std::remove(filename.c_str());
+
+    // The box must be on the ground, and the restart must follow the reference run (contacts are found
+    // again at the first step; only their cached reactions, used as solver warm start, are lost).
+    double box_height = 0;
+    for (auto body : *system4.Get_bodylist()) {
+        if (body->GetIdentifier() == 1)
+            box_height = body->GetPos().y();
+    }
+    GetLog() << "Box height after the restart: " << box_height << "\n";
+    if (std::abs(box_height - 0.1) > 1e-3) {
+        GetLog() << "Restarted box is not on the ground\n";
+        passed = false;
+    }
+
+    double error = 0;
+    for (size_t i = 0; i < ref.size() && i < res.size(); i++)
+        error = std::max(error, std::abs(ref[i] - res[i]));
+    GetLog() << "Restart with contacts: " << (int)system3.GetNcontacts() << " contacts, max error " << error << "\n";
+    if (ref.size() != res.size() || error > 1e-6) {
+        GetLog() << "Restarted trajectory with contacts differs from the reference one\n";
+        passed = false;
+    }
+
+    // Return 0 if all tests passed.
+    std::cout << "\n\n" << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
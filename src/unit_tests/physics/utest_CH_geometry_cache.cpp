@@ -0,0 +1,129 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the content-hashed geometry cache.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "chrono/utils/ChGeometryCache.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+static void WriteBox(const std::string& filename, double size) {
+    std::ofstream obj(filename);
+    for (int i = 0; i < 8; i++)
+        obj << "v " << ((i & 1) ? size : -size) << " " << ((i & 2) ? size : -size) << " "
+            << ((i & 4) ? size : -size) << "\n";
+    obj << "f 1 3 4\nf 1 4 2\nf 5 6 8\nf 5 8 7\nf 1 2 6\nf 1 6 5\n"
+        << "f 3 7 8\nf 3 8 4\nf 1 5 7\nf 1 7 3\nf 2 4 8\nf 2 8 6\n";
+}
+
+static bool SameMesh(const geometry::ChTriangleMeshConnected& a, const geometry::ChTriangleMeshConnected& b) {
+    if (a.m_vertices.size() != b.m_vertices.size() || a.m_face_v_indices.size() != b.m_face_v_indices.size())
+        return false;
+    for (size_t i = 0; i < a.m_vertices.size(); i++)
+        if (!a.m_vertices[i].Equals(b.m_vertices[i]))
+            return false;
+    for (size_t i = 0; i < a.m_face_v_indices.size(); i++)
+        if (!(a.m_face_v_indices[i] == b.m_face_v_indices[i]))
+            return false;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    std::string objfile = "utest_geometry_cache.obj";
+
+    WriteBox(objfile, 1.0);
+    geometry::ChTriangleMeshConnected reference;
+    reference.LoadWavefrontMesh(objfile, false, false);
+
+    // First load computes the entry, second load reads it.
+    ChGeometryCache cache(".");
+    uint64_t key = ChGeometryCache::GetWavefrontMeshKey(objfile, false, false);
+    cache.Remove(key);
+    auto mesh1 = cache.LoadWavefrontMesh(objfile, false, false);
+    auto mesh2 = cache.LoadWavefrontMesh(objfile, false, false);
+    std::cout << "hits: " << cache.GetNumHits() << "  misses: " << cache.GetNumMisses() << std::endl;
+    if (cache.GetNumMisses() != 1 || cache.GetNumHits() != 1 || !SameMesh(*mesh1, reference) ||
+        !SameMesh(*mesh2, reference)) {
+        std::cout << "Cached mesh differs from loaded mesh" << std::endl;
+        passed = false;
+    }
+
+    // A new cache object on the same directory finds the entry.
+    ChGeometryCache cache2(".");
+    auto mesh3 = cache2.LoadWavefrontMesh(objfile, false, false);
+    if (cache2.GetNumHits() != 1 || !SameMesh(*mesh3, reference)) {
+        std::cout << "Entry not found by a new cache object" << std::endl;
+        passed = false;
+    }
+
+    // Changing the file content invalidates the entry.
+    WriteBox(objfile, 2.0);
+    uint64_t key2 = ChGeometryCache::GetWavefrontMeshKey(objfile, false, false);
+    if (key2 == key) {
+        std::cout << "Entry key did not change" << std::endl;
+        passed = false;
+    }
+    cache2.Remove(key2);
+    auto mesh4 = cache2.LoadWavefrontMesh(objfile, false, false);
+    if (cache2.GetNumMisses() != 1 || mesh4->m_vertices.empty() || mesh4->m_vertices[0].x() != -2.0) {
+        std::cout << "Modified file not reloaded" << std::endl;
+        passed = false;
+    }
+
+    // Generic entries.
+    std::vector<char> data;
+    const char text[] = "cached data";
+    cache.Write(12345, text, sizeof(text));
+    if (!cache.Read(12345, data) || data.size() != sizeof(text) || std::string(data.data()) != text) {
+        std::cout << "Generic entry not read back" << std::endl;
+        passed = false;
+    }
+    cache.Remove(12345);
+    if (cache.Read(12345, data)) {
+        std::cout << "Generic entry not removed" << std::endl;
+        passed = false;
+    }
+
+    // Concurrent writers of the same entry never expose a partially written entry.
+    std::vector<char> payload(1 << 16);
+    for (size_t i = 0; i < payload.size(); i++)
+        payload[i] = static_cast<char>(i * 7);
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 8; t++)
+        writers.emplace_back([&cache, &payload]() {
+            for (int k = 0; k < 10; k++)
+                cache.Write(777, payload.data(), payload.size());
+        });
+    for (auto& writer : writers)
+        writer.join();
+    if (!cache.Read(777, data) || data != payload) {
+        std::cout << "Entry written concurrently is not valid" << std::endl;
+        passed = false;
+    }
+    cache.Remove(777);
+
+    cache.Remove(key);
+    cache.Remove(key2);
+    std::remove(objfile.c_str());
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
@@ -0,0 +1,137 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the asynchronous output pipeline.
+//
+// =============================================================================
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChOutputPipeline.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+// Ordered task recording the sequence of written frames, slower than the simulation.
+class RecordTask : public ChOutputTask {
+  public:
+    virtual void Capture(ChSystem& system, ChOutputFrame& frame) override {
+        frame.reals.assign(1, system.Get_bodylist()->at(0)->GetPos().z());
+    }
+    virtual void Write(const ChOutputFrame& frame) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        frames.push_back(frame.frame);
+        heights.push_back(frame.reals[0]);
+    }
+    std::vector<unsigned int> frames;
+    std::vector<double> heights;
+};
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    auto ball = std::make_shared<ChBodyEasySphere>(0.1, 1000);
+    system.AddBody(ball);
+
+    // Ordered task, several writer threads, blocking queue.
+    {
+        auto record = std::make_shared<RecordTask>();
+        auto bodies = std::make_shared<ChOutputTaskBodies>("utest_output_pipeline", false, true);
+        ChOutputPipeline output(3, 2);
+        output.AddTask(record);
+        output.AddTask(bodies);
+        output.SetOutputStep(0.01);
+
+        std::vector<double> heights;
+        while (system.GetChTime() < 0.5) {
+            system.DoStepDynamics(0.001);
+            if (output.Update(system))
+                heights.push_back(ball->GetPos().z());
+        }
+        output.Flush();
+
+        std::cout << "submitted: " << output.GetNumSubmitted() << "  blocked: " << output.GetNumBlocked()
+                  << "  max queue: " << output.GetMaxQueueLength() << std::endl;
+
+        if (output.GetNumSubmitted() != heights.size() || record->frames.size() != heights.size() ||
+            heights.size() < 45 || heights.size() > 55) {
+            std::cout << "Unexpected number of frames: " << record->frames.size() << std::endl;
+            passed = false;
+        }
+        for (size_t i = 0; i < record->frames.size(); i++) {
+            if (record->frames[i] != i || record->heights[i] != heights[i]) {
+                std::cout << "Frame " << i << " out of order or corrupted" << std::endl;
+                passed = false;
+                break;
+            }
+        }
+        if (output.GetNumBlocked() == 0 || output.GetMaxQueueLength() > 2) {
+            std::cout << "Back-pressure not applied" << std::endl;
+            passed = false;
+        }
+
+        // Check one of the CSV files and clean up.
+        std::ifstream csv("utest_output_pipeline_00001.csv");
+        double z;
+        char delim;
+        csv >> z >> delim >> z >> delim >> z;
+        if (!csv.good() || std::abs(z - heights[1]) > 1e-4) {
+            std::cout << "CSV output mismatch" << std::endl;
+            passed = false;
+        }
+        csv.close();
+        char name[64];
+        for (size_t i = 0; i < heights.size(); i++) {
+            sprintf(name, "utest_output_pipeline_%05u.csv", (unsigned int)i);
+            std::remove(name);
+        }
+    }
+
+    // Dropping policy: frames are skipped rather than slowing down the simulation.
+    {
+        auto record = std::make_shared<RecordTask>();
+        ChOutputPipeline output(1, 1, ChOutputPipeline::DROP);
+        output.AddTask(record);
+        for (int i = 0; i < 100; i++) {
+            system.DoStepDynamics(0.001);
+            output.Submit(system);
+        }
+        output.Flush();
+
+        std::cout << "submitted: " << output.GetNumSubmitted() << "  dropped: " << output.GetNumDropped()
+                  << std::endl;
+        if (output.GetNumDropped() == 0 || record->frames.size() + output.GetNumDropped() != 100 ||
+            output.GetNumBlocked() != 0) {
+            std::cout << "Unexpected drop statistics" << std::endl;
+            passed = false;
+        }
+        for (size_t i = 0; i < record->frames.size(); i++) {
+            if (record->frames[i] != i) {
+                std::cout << "Frames not numbered consecutively" << std::endl;
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
@@ -0,0 +1,107 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the data reduction probes.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChProbeReduction.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+
+static bool check(bool condition, const char* message) {
+    if (!condition)
+        std::cout << "Failed: " << message << std::endl;
+    return condition;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    // Free fall of a body: z = -g t^2 / 2, recorded by probes attached to the system.
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -10));
+    auto ball = std::make_shared<ChBodyEasySphere>(0.1, 1000);
+    system.AddBody(ball);
+
+    auto speed = [&]() { return ball->GetPos_dt().z(); };
+    auto stats = std::make_shared<ChProbeStatistics>(speed);
+    auto history = std::make_shared<ChProbeDecimator>(speed, 64);
+    auto histogram = std::make_shared<ChProbeHistogram>(speed, -10, 0, 10);
+    auto recent = std::make_shared<ChProbeCircularBuffer>(speed, 16);
+    system.AddProbe(stats);
+    system.AddProbe(history);
+    system.AddProbe(histogram);
+    system.AddProbe(recent);
+
+    int num_steps = 1000;
+    for (int i = 0; i < num_steps; i++)
+        system.DoStepDynamics(0.001);
+
+    // Speed decreases linearly from -0.01 to -10.
+    passed &= check(stats->GetCount() == num_steps, "statistics count");
+    passed &= check(std::abs(stats->GetMax() + 0.01) < 1e-6 && std::abs(stats->GetTimeMax() - 0.001) < 1e-9,
+                    "statistics max");
+    passed &= check(std::abs(stats->GetMin() + 10) < 1e-6 && std::abs(stats->GetTimeMin() - 1) < 1e-9,
+                    "statistics min");
+    passed &= check(std::abs(stats->GetMean() + 5.005) < 1e-6, "statistics mean");
+    passed &= check(std::abs(stats->GetRMS() - std::sqrt(100.0 / 3)) < 0.02, "statistics RMS");
+    passed &= check(std::abs(stats->GetStdDev() - 10 / std::sqrt(12.0)) < 0.01, "statistics standard deviation");
+
+    // The decimated history spans the whole run with at most 64 points, equally spaced.
+    passed &= check(history->GetNumPoints() <= 64 && history->GetNumPoints() > 32, "decimator size");
+    passed &= check(history->GetDecimation() == 16, "decimator factor");
+    auto& times = history->GetTimes();
+    for (size_t i = 0; i < times.size(); i++)
+        passed &= check(std::abs(times[i] - 0.001 * (1 + 16 * i)) < 1e-9, "decimator sample times");
+    passed &= check(std::abs(history->GetValue(0.5) + 5) < 1e-6, "decimator interpolation");
+
+    uint64_t total = histogram->GetUnderflow() + histogram->GetOverflow();
+    for (auto count : histogram->GetCounts()) {
+        passed &= check(count >= 99 && count <= 101, "histogram bins");
+        total += count;
+    }
+    passed &= check(total == num_steps, "histogram total");
+
+    // NaN values are counted separately; an empty range is rejected.
+    ChProbeHistogram bins(0, 1, 4);
+    bins.Process(0, std::nan(""));
+    bins.Process(0, -1);
+    bins.Process(0, 0.3);
+    bins.Process(0, 2);
+    passed &= check(bins.GetNumNaN() == 1 && bins.GetUnderflow() == 1 && bins.GetCounts()[1] == 1 &&
+                        bins.GetOverflow() == 1,
+                    "histogram NaN");
+    bool rejected = false;
+    try {
+        ChProbeHistogram empty(1, 1, 4);
+    } catch (const ChException&) {
+        rejected = true;
+    }
+    passed &= check(rejected, "histogram range");
+
+    passed &= check(recent->GetNumPoints() == 16, "circular buffer size");
+    passed &= check(std::abs(recent->GetTime(15) - 1) < 1e-9 && std::abs(recent->GetTime(0) - 0.985) < 1e-9,
+                    "circular buffer order");
+
+    system.ResetAllProbes();
+    passed &= check(stats->GetCount() == 0 && history->GetNumPoints() == 0 && recent->GetNumPoints() == 0,
+                    "reset");
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
@@ -0,0 +1,332 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the binary simulation output writer and reader.
+//
+// =============================================================================
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "chrono/core/ChLog.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChSimulationOutput.h"
+#include "chrono/utils/ChSimulationOutputReader.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+// Trivial codec which only copies the payload (exercises the compressed code path).
+class CopyCodec : public ChSimulationOutputCodec {
+  public:
+    virtual uint32_t GetId() const override { return 42; }
+    virtual void Compress(const char* src, size_t src_size, std::vector<char>& dst) override {
+        dst.assign(src, src + src_size);
+    }
+    virtual void Decompress(const char* src, size_t src_size, char* dst, size_t dst_size) override {
+        std::memcpy(dst, src, dst_size);
+        num_full++;
+    }
+    virtual void DecompressPrefix(const char* src, size_t src_size, char* dst, size_t dst_size, size_t raw_size)
+        override {
+        std::memcpy(dst, src, dst_size);
+        num_prefix++;
+    }
+
+    int num_full = 0;    // number of full decompressions
+    int num_prefix = 0;  // number of partial decompressions
+};
+
+// Write a file with the given number of frames of a system with 5 bodies.
+static void WriteTestFile(const std::string& filename, int num_frames, bool compressed) {
+    ChSystemNSC system;
+    for (int i = 0; i < 5; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetIdentifier(100 + i);
+        body->SetPos(ChVector<>(i, 0, 0));
+        system.AddBody(body);
+    }
+
+    ChSimulationOutputWriter writer(filename, OUTPUT_ALL, 2);
+    if (compressed)
+        writer.SetCodec(std::make_shared<CopyCodec>());
+    for (int frame = 0; frame < num_frames; frame++) {
+        system.DoStepDynamics(1e-2);
+        writer.WriteFrame(&system);
+    }
+    writer.Close();
+}
+
+static std::vector<char> ReadFile(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void WriteFile(const std::string& filename, const std::vector<char>& data) {
+    std::ofstream out(filename, std::ios::binary);
+    out.write(data.data(), data.size());
+}
+
+struct Record {
+    double time;
+    std::vector<ChVector<>> pos;
+    std::vector<ChQuaternion<>> rot;
+    std::vector<ChVector<>> vel;
+};
+
+bool test_output(bool compressed) {
+    GetLog() << "\nSimulation output test (compressed: " << compressed << ")\n";
+
+    std::string filename = compressed ? "simulation_output_c.bin" : "simulation_output.bin";
+
+    ChSystemNSC system;
+    for (int i = 0; i < 5; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetIdentifier(100 + i);
+        body->SetPos(ChVector<>(i, 0, 0));
+        body->SetWvel_par(ChVector<>(0, 0, 0.1 * i));
+        system.AddBody(body);
+    }
+
+    std::vector<Record> records;
+    {
+        ChSimulationOutputWriter writer(filename, OUTPUT_ALL, 2);
+        if (compressed)
+            writer.SetCodec(std::make_shared<CopyCodec>());
+
+        for (int frame = 0; frame < 20; frame++) {
+            system.DoStepDynamics(1e-2);
+            writer.WriteFrame(&system);
+
+            Record rec;
+            rec.time = system.GetChTime();
+            for (auto body : *system.Get_bodylist()) {
+                rec.pos.push_back(body->GetPos());
+                rec.rot.push_back(body->GetRot());
+                rec.vel.push_back(body->GetPos_dt());
+            }
+            records.push_back(rec);
+        }
+        writer.Close();
+    }
+
+    ChSimulationOutputReader reader(filename);
+    if (compressed)
+        reader.AddCodec(std::make_shared<CopyCodec>());
+
+    if (reader.GetNumFrames() != records.size()) {
+        GetLog() << "  wrong number of frames: " << (int)reader.GetNumFrames() << "\n";
+        return false;
+    }
+
+    // Check frame views
+    for (size_t f = 0; f < records.size(); f++) {
+        auto frame = reader.GetFrame(f);
+        if (frame.GetTime() != records[f].time || frame.GetNumBodies() != 5)
+            return false;
+        for (size_t i = 0; i < 5; i++) {
+            if (frame.GetBodyIdentifiers()[i] != 100 + (int)i)
+                return false;
+            if (!frame.GetBodyPos(i).Equals(records[f].pos[i]) || !(frame.GetBodyRot(i) == records[f].rot[i]))
+                return false;
+        }
+    }
+
+    // Check body histories
+    auto ids = reader.GetBodyIdentifiers();
+    if (ids.size() != 5 || ids[0] != 100 || ids[4] != 104)
+        return false;
+    for (size_t i = 0; i < 5; i++) {
+        auto history = reader.GetBodyHistory(ids[i]);
+        if (history.GetNumSamples() != records.size())
+            return false;
+        for (size_t f = 0; f < records.size(); f++) {
+            if (history.GetTime(f) != records[f].time || !history.GetPos(f).Equals(records[f].pos[i]) ||
+                !history.GetLinVel(f).Equals(records[f].vel[i]))
+                return false;
+        }
+    }
+
+    if (reader.GetBodyHistory(7).GetNumSamples() != 0)
+        return false;
+
+    std::remove(filename.c_str());
+    GetLog() << "  OK\n";
+    return true;
+}
+
+// Check that the body index is built from partially decompressed frames, and that the cache of
+// decompressed frames is bounded.
+bool test_cache() {
+    GetLog() << "\nSimulation output cache test\n";
+
+    std::string filename = "simulation_output_cache.bin";
+    WriteTestFile(filename, 30, true);
+
+    ChSimulationOutputReader reader(filename);
+    auto codec = std::make_shared<CopyCodec>();
+    reader.AddCodec(codec);
+    reader.SetCacheSize(4);
+
+    auto ids = reader.GetBodyIdentifiers();
+    if (ids.size() != 5 || codec->num_full != 0 || codec->num_prefix != 30 || reader.GetNumCachedFrames() != 0) {
+        GetLog() << "  body index decompressed full frames\n";
+        return false;
+    }
+
+    // Sweep all frames twice; only the 4 most recent frames are kept.
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t f = 0; f < reader.GetNumFrames(); f++) {
+            auto frame = reader.GetFrame(f);
+            if (frame.GetNumBodies() != 5 || frame.GetBodyIdentifiers()[4] != 104)
+                return false;
+            if (reader.GetNumCachedFrames() > 4)
+                return false;
+        }
+    }
+    if (codec->num_full != 60)
+        return false;
+
+    // Repeated access to a cached frame does not decompress it again.
+    auto history = reader.GetBodyHistory(102);
+    for (size_t f = 26; f < 30; f++) {
+        if (!history.GetPos(f).Equals(reader.GetFrame(f).GetBodyPos(size_t(2))))
+            return false;
+    }
+    if (codec->num_full != 60)
+        return false;
+
+    reader.SetCacheSize(1);
+    if (reader.GetNumCachedFrames() != 1)
+        return false;
+
+    std::remove(filename.c_str());
+    GetLog() << "  OK\n";
+    return true;
+}
+
+// Check that a corrupt or missing frame index is detected and the frames are recovered by walking the headers.
+bool test_corrupt_index() {
+    GetLog() << "\nSimulation output corrupt index test\n";
+
+    std::string filename = "simulation_output_corrupt.bin";
+    WriteTestFile(filename, 10, false);
+    std::vector<char> data = ReadFile(filename);
+
+    ChSimulationOutputTrailer trailer;
+    std::memcpy(&trailer, data.data() + data.size() - sizeof(trailer), sizeof(trailer));
+    size_t offsets = trailer.index_offset + sizeof(ChSimulationOutputIndexHeader);
+
+    // Offset pointing past the end of the file.
+    std::vector<char> bad = data;
+    uint64_t past_end = data.size() - 8;
+    std::memcpy(bad.data() + offsets + 3 * sizeof(uint64_t), &past_end, sizeof(uint64_t));
+    WriteFile(filename, bad);
+    if (ChSimulationOutputReader(filename).GetNumFrames() != 10)
+        return false;
+
+    // Offset pointing inside a frame payload.
+    bad = data;
+    uint64_t inside = sizeof(ChSimulationOutputFileHeader) + 8;
+    std::memcpy(bad.data() + offsets + 5 * sizeof(uint64_t), &inside, sizeof(uint64_t));
+    WriteFile(filename, bad);
+    if (ChSimulationOutputReader(filename).GetNumFrames() != 10)
+        return false;
+
+    // Number of frames exceeding the size of the index.
+    bad = data;
+    uint64_t num_frames = 1ull << 60;
+    std::memcpy(bad.data() + trailer.index_offset + 8, &num_frames, sizeof(uint64_t));
+    WriteFile(filename, bad);
+    if (ChSimulationOutputReader(filename).GetNumFrames() != 10)
+        return false;
+
+    // Truncated file: only complete frames are recovered.
+    bad.assign(data.begin(), data.begin() + trailer.index_offset - 16);
+    WriteFile(filename, bad);
+    if (ChSimulationOutputReader(filename).GetNumFrames() != 9)
+        return false;
+
+    // Compressed frame with an uncompressed size inconsistent with its layout: the frame is rejected, and only
+    // the frames before it are recovered (no buffer of the stated size is allocated).
+    WriteTestFile(filename, 10, true);
+    data = ReadFile(filename);
+    std::memcpy(&trailer, data.data() + data.size() - sizeof(trailer), sizeof(trailer));
+    offsets = trailer.index_offset + sizeof(ChSimulationOutputIndexHeader);
+    uint64_t frame_offset;
+    std::memcpy(&frame_offset, data.data() + offsets + 3 * sizeof(uint64_t), sizeof(uint64_t));
+    bad = data;
+    uint64_t raw_size = 1ull << 50;
+    std::memcpy(bad.data() + frame_offset + offsetof(ChSimulationOutputFrameHeader, raw_size), &raw_size,
+                sizeof(uint64_t));
+    WriteFile(filename, bad);
+    {
+        ChSimulationOutputReader reader(filename);
+        reader.AddCodec(std::make_shared<CopyCodec>());
+        if (reader.GetNumFrames() != 3 || reader.GetFrame(2).GetNumBodies() != 5)
+            return false;
+    }
+
+    std::remove(filename.c_str());
+    GetLog() << "  OK\n";
+    return true;
+}
+
+// Check that write errors are reported (the device /dev/full fails every write with ENOSPC).
+bool test_write_error() {
+#ifdef __linux__
+    GetLog() << "\nSimulation output write error test\n";
+
+    ChSystemNSC system;
+    auto body = std::make_shared<ChBody>();
+    system.AddBody(body);
+
+    ChSimulationOutputWriter writer("/dev/full", OUTPUT_ALL, 2);
+    bool reported = false;
+    try {
+        for (int frame = 0; frame < 10; frame++)
+            writer.WriteFrame(&system);
+        writer.Flush();
+    } catch (const ChException&) {
+        reported = true;
+    }
+    if (!reported || !writer.HasFailed())
+        return false;
+
+    try {
+        writer.Close();
+        return false;
+    } catch (const ChException&) {
+    }
+
+    GetLog() << "  OK\n";
+#endif
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= test_output(false);
+    passed &= test_output(true);
+    passed &= test_cache();
+    passed &= test_corrupt_index();
+    passed &= test_write_error();
+
+    // Return 0 if all tests passed.
+    std::cout << "\n\n" << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
@@ -0,0 +1,118 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the cache of the shape trees of the items exported to POV-Ray.
+//
+// The tree of shapes of a body is declared as a macro in the assets file, and
+// declared again (with a new version) only when the assets of the body change,
+// including changes nested in asset levels.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chrono/assets/ChAssetLevel.h"
+#include "chrono/assets/ChBoxShape.h"
+#include "chrono/assets/ChSphereShape.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono_postprocess/ChPovRay.h"
+
+using namespace chrono;
+using namespace chrono::postprocess;
+
+static std::string ReadFile(const std::string& filename) {
+    std::ifstream in(filename);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+static int Count(const std::string& text, const std::string& pattern) {
+    int n = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+        n++;
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC system;
+
+    auto body = std::make_shared<ChBody>();
+    system.AddBody(body);
+    auto sphere = std::make_shared<ChSphereShape>();
+    body->AddAsset(sphere);
+    auto level = std::make_shared<ChAssetLevel>();
+    level->AddAsset(std::make_shared<ChBoxShape>());
+    body->AddAsset(level);
+
+    ChPovRay pov(&system);
+    pov.SetTemplateFile("");
+    pov.SetOutputScriptFile("utest_povray.pov");
+    pov.AddAll();
+    pov.ExportScript();
+
+    std::string item = "ob_" + std::to_string((size_t)body.get()) + "_";
+    std::vector<std::string> files;
+    auto export_frame = [&]() {
+        std::string name = "utest_povray_state" + std::to_string(files.size());
+        pov.ExportData(name);
+        files.push_back(name);
+        return ReadFile(name + ".pov");
+    };
+
+    bool passed = true;
+    auto check = [&passed](bool condition, const char* message) {
+        if (!condition) {
+            std::cout << "Failed: " << message << std::endl;
+            passed = false;
+        }
+    };
+
+    // First export declares the tree; moving the body does not change it.
+    check(Count(export_frame(), item + "1()") == 1, "first frame");
+    body->SetPos(ChVector<>(1, 2, 3));
+    check(Count(export_frame(), item + "1()") == 1, "moved body");
+
+    // A shape added in a nested asset level changes the tree.
+    auto nested = std::make_shared<ChSphereShape>();
+    level->AddAsset(nested);
+    check(Count(export_frame(), item + "2()") == 1, "nested shape");
+
+    // So does a change of the frame of the asset level.
+    level->GetFrame().SetPos(ChVector<>(0, 1, 0));
+    check(Count(export_frame(), item + "3()") == 1, "level frame");
+    check(Count(export_frame(), item + "3()") == 1, "unchanged tree");
+
+    // Each version of the tree is declared once; the last one includes the nested shape.
+    std::string assets = ReadFile("utest_povray.pov.assets");
+    check(Count(assets, "#macro " + item) == 3, "number of declared trees");
+    size_t last = assets.find("#macro " + item + "3()");
+    check(last != std::string::npos &&
+              assets.find("sh_" + std::to_string((size_t)nested.get()), last) != std::string::npos,
+          "content of the last tree");
+
+    for (auto& name : files) {
+        std::remove((name + ".pov").c_str());
+        std::remove((name + ".dat").c_str());
+    }
+    std::remove("utest_povray.pov");
+    std::remove("utest_povray.pov.assets");
+    std::remove("utest_povray.pov.ini");
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
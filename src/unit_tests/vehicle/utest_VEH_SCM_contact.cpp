@@ -0,0 +1,90 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the contact loads of the SCM deformable terrain.
+//
+// A wheel sinks into the soil and is then lifted off it. Once the wheel left
+// the soil, the terrain must not apply any force on it (the loads of the
+// previous steps were removed from the load container).
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLoadContainer.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Return the number of loads applied by the terrain.
+size_t NumLoads(ChSystem& system) {
+    for (auto& item : *system.Get_otherphysicslist()) {
+        if (auto container = std::dynamic_pointer_cast<ChLoadContainer>(item))
+            return container->GetLoadList().size();
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    SCMDeformableTerrain terrain(&system);
+    terrain.SetPlane(ChCoordsys<>(VNULL, Q_from_AngX(CH_C_PI_2)));
+    terrain.SetSoilParametersSCM(2e6, 0, 1.1, 0, 30, 0.01, 4e7, 3e4);
+    terrain.Initialize(0, 2, 2, 40, 40);
+
+    auto wheel = std::make_shared<ChBodyEasyCylinder>(0.3, 0.2, 500, true, false);
+    wheel->SetPos(ChVector<>(0, 0, 0.29));
+    system.AddBody(wheel);
+
+    double step = 2e-3;
+    bool passed = true;
+
+    // The wheel sinks into the soil.
+    size_t max_loads = 0;
+    for (int i = 0; i < 50; i++) {
+        system.DoStepDynamics(step);
+        max_loads = std::max(max_loads, NumLoads(system));
+    }
+    std::cout << "Wheel on the soil: " << max_loads << " loads, height " << wheel->GetPos().z() << std::endl;
+    if (max_loads == 0 || wheel->GetPos().z() > 0.3) {
+        std::cout << "No contact with the soil" << std::endl;
+        passed = false;
+    }
+
+    // Lift the wheel off the soil; only gravity acts on it afterwards.
+    wheel->SetPos(ChVector<>(0, 0, 1));
+    wheel->SetPos_dt(VNULL);
+    wheel->SetWvel_par(VNULL);
+    for (int i = 0; i < 10; i++) {
+        system.DoStepDynamics(step);
+        if (NumLoads(system) != 0) {
+            std::cout << "Loads left after the wheel left the soil" << std::endl;
+            passed = false;
+        }
+    }
+    double vz = wheel->GetPos_dt().z();
+    std::cout << "Wheel off the soil: vertical velocity " << vz << std::endl;
+    if (std::abs(vz + 9.81 * 10 * step) > 1e-10 || wheel->GetPos_dt().x() != 0 || wheel->GetPos_dt().y() != 0) {
+        std::cout << "Soil forces applied to the wheel after it left the soil" << std::endl;
+        passed = false;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
@@ -0,0 +1,121 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the moving patches of the SCM deformable terrain.
+//
+// A wheel rolls on the soil, with bulldozing, without and with mesh
+// refinement. When a patch covers the wheel, the simulation must give exactly
+// the same wheel motion and the same soil mesh as without patches.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLoadContainer.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+struct Result {
+    ChVector<> pos;
+    ChQuaternion<> rot;
+    ChVector<> vel;
+    std::vector<ChVector<>> vertices;
+};
+
+// Return the soil mesh of the terrain.
+static geometry::ChTriangleMeshConnected* GetSoilMesh(ChSystem& system) {
+    for (auto& item : *system.Get_otherphysicslist()) {
+        if (!std::dynamic_pointer_cast<ChLoadContainer>(item))
+            continue;
+        for (auto& asset : item->GetAssets()) {
+            if (auto shape = std::dynamic_pointer_cast<ChTriangleMeshShape>(asset))
+                return &shape->GetMesh();
+        }
+    }
+    return nullptr;
+}
+
+static Result RollWheel(bool use_patch, bool refinement) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    SCMDeformableTerrain terrain(&system);
+    terrain.SetPlane(ChCoordsys<>(VNULL, Q_from_AngX(CH_C_PI_2)));
+    terrain.SetSoilParametersSCM(2e6, 0, 1.1, 0, 30, 0.01, 4e7, 3e4);
+    terrain.SetBulldozingFlow(true);
+    terrain.SetBulldozingParameters(55, 1, 3, 5);
+    terrain.SetAutomaticRefinement(refinement);
+    terrain.SetAutomaticRefinementResolution(0.04);
+    terrain.Initialize(0, 2, 2, 25, 25);
+
+    auto wheel = std::make_shared<ChBodyEasyCylinder>(0.3, 0.2, 500, true, false);
+    wheel->SetPos(ChVector<>(-0.4, 0, 0.29));
+    wheel->SetPos_dt(ChVector<>(1, 0, 0));
+    wheel->SetWvel_par(ChVector<>(0, 3, 0));
+    system.AddBody(wheel);
+
+    if (use_patch)
+        terrain.AddMovingPatch(wheel, VNULL, 0.9, 0.5);
+
+    for (int i = 0; i < 200; i++)
+        system.DoStepDynamics(2e-3);
+
+    Result result;
+    result.pos = wheel->GetPos();
+    result.rot = wheel->GetRot();
+    result.vel = wheel->GetPos_dt();
+    result.vertices = GetSoilMesh(system)->getCoordsVertices();
+    return result;
+}
+
+static bool Compare(bool refinement, const char* name) {
+    Result all = RollWheel(false, refinement);
+    Result patch = RollWheel(true, refinement);
+
+    double rut_depth = 0;
+    for (auto& v : all.vertices)
+        rut_depth = std::max(rut_depth, -v.z());
+    std::cout << name << ": wheel at " << all.pos.x() << ", " << all.pos.z() << ", rut depth " << rut_depth << ", "
+              << all.vertices.size() << " soil vertices" << std::endl;
+    if (rut_depth < 1e-3 || all.pos.x() < -0.3) {
+        std::cout << name << ": the wheel did not roll on the soil" << std::endl;
+        return false;
+    }
+    if (patch.pos != all.pos || patch.rot != all.rot || patch.vel != all.vel) {
+        std::cout << name << ": different wheel motion with a patch, position error "
+                  << (patch.pos - all.pos).Length() << std::endl;
+        return false;
+    }
+    if (patch.vertices != all.vertices) {
+        std::cout << name << ": different soil mesh with a patch" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= Compare(false, "Bulldozing");
+    passed &= Compare(true, "Bulldozing and refinement");
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
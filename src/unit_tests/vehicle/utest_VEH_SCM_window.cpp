@@ -0,0 +1,159 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the moving window of the SCM deformable terrain.
+//
+// A wheel makes a rut and is lifted off the soil. The window is then moved far
+// away (to negative tile indices) and back, so that the deformed vertices are
+// stored and restored. The soil mesh must be restored, and the wheel put back
+// in the rut must move exactly as in a simulation where the window did not
+// move. The preconditions of the moving window are also checked.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLoadContainer.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Return the soil mesh of the terrain.
+static geometry::ChTriangleMeshConnected* GetSoilMesh(ChSystem& system) {
+    for (auto& item : *system.Get_otherphysicslist()) {
+        if (!std::dynamic_pointer_cast<ChLoadContainer>(item))
+            continue;
+        for (auto& asset : item->GetAssets()) {
+            if (auto shape = std::dynamic_pointer_cast<ChTriangleMeshShape>(asset))
+                return &shape->GetMesh();
+        }
+    }
+    return nullptr;
+}
+
+// Make a rut, lift the wheel, optionally move the window away and back, then put the wheel back in the rut.
+// Return the final wheel position.
+static ChVector<> Simulate(bool move_window, bool& passed) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    double step = 2e-3;
+
+    SCMDeformableTerrain terrain(&system);
+    terrain.SetPlane(ChCoordsys<>(VNULL, Q_from_AngX(CH_C_PI_2)));
+    terrain.SetSoilParametersSCM(2e6, 0, 1.1, 0, 30, 0.01, 4e7, 3e4);
+    terrain.Initialize(0, 2, 2, 40, 40);
+
+    auto window_body = std::make_shared<ChBody>();
+    window_body->SetBodyFixed(true);
+    system.AddBody(window_body);
+    terrain.EnableMovingWindow(window_body, 5);
+
+    auto wheel = std::make_shared<ChBodyEasyCylinder>(0.3, 0.2, 500, true, false);
+    wheel->SetPos(ChVector<>(0.1, 0, 0.29));
+    system.AddBody(wheel);
+
+    for (int i = 0; i < 50; i++)
+        system.DoStepDynamics(step);
+    ChCoordsys<> rut_csys = wheel->GetCoord();
+
+    // Lift the wheel off the soil.
+    wheel->SetBodyFixed(true);
+    wheel->SetPos(ChVector<>(0.1, 0, 2));
+    system.DoStepDynamics(step);
+    std::vector<ChVector<>> rut = GetSoilMesh(system)->getCoordsVertices();
+
+    if (move_window) {
+        window_body->SetPos(ChVector<>(-5, 3, 0));
+        system.DoStepDynamics(step);
+        size_t stored = terrain.GetNumStoredVertices();
+        std::cout << "Window moved away: " << stored << " stored vertices" << std::endl;
+        if (stored == 0) {
+            std::cout << "Deformed vertices not stored" << std::endl;
+            passed = false;
+        }
+
+        window_body->SetPos(VNULL);
+        system.DoStepDynamics(step);
+        const std::vector<ChVector<>>& restored = GetSoilMesh(system)->getCoordsVertices();
+        double error = 0;
+        for (size_t i = 0; i < rut.size() && i < restored.size(); i++)
+            error = std::max(error, (restored[i] - rut[i]).Length());
+        std::cout << "Window moved back: " << terrain.GetNumStoredVertices() << " stored vertices, error " << error
+                  << std::endl;
+        if (terrain.GetNumStoredVertices() != 0 || restored.size() != rut.size() || error > 1e-12) {
+            std::cout << "Deformed vertices not restored" << std::endl;
+            passed = false;
+        }
+    } else {
+        system.DoStepDynamics(step);
+        system.DoStepDynamics(step);
+    }
+
+    // Put the wheel back in the rut.
+    wheel->SetCoord(rut_csys);
+    wheel->SetPos_dt(VNULL);
+    wheel->SetWvel_par(VNULL);
+    wheel->SetBodyFixed(false);
+    for (int i = 0; i < 50; i++)
+        system.DoStepDynamics(step);
+    return wheel->GetPos();
+}
+
+// Check that the function throws a ChException.
+template <typename Function>
+static bool Throws(Function f) {
+    try {
+        f();
+    } catch (ChException&) {
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    ChVector<> pos_ref = Simulate(false, passed);
+    ChVector<> pos = Simulate(true, passed);
+    std::cout << "Wheel back in the rut: height " << pos.z() << ", difference " << (pos - pos_ref).Length()
+              << std::endl;
+    if ((pos - pos_ref).Length() > 1e-10) {
+        std::cout << "Soil state not restored" << std::endl;
+        passed = false;
+    }
+
+    // Preconditions, checked when the window is enabled.
+    ChSystemNSC system;
+    auto body = std::make_shared<ChBody>();
+    SCMDeformableTerrain refined(&system);
+    refined.SetAutomaticRefinement(true);
+    SCMDeformableTerrain windowed(&system);
+    windowed.EnableMovingWindow(body);
+    if (!Throws([&]() { refined.EnableMovingWindow(body); }) ||
+        !Throws([&]() { windowed.SetAutomaticRefinement(true); }) ||
+        !Throws([&]() { windowed.Initialize("no_file.obj"); }) ||
+        !Throws([&]() { windowed.EnableMovingWindow(body, 0); })) {
+        std::cout << "Invalid moving window not rejected" << std::endl;
+        passed = false;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
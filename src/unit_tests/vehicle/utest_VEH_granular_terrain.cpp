@@ -0,0 +1,123 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the moving patch of the granular terrain.
+//
+// The particles are scattered along the patch, then the monitored body is
+// moved forward so that the patch is moved several times. The relocated
+// particles, their order and their new locations must be those given by a
+// serial search over the system body list, using the same Poisson Disk
+// samples; the other particles must not move.
+//
+// =============================================================================
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/utils/ChUtilsSamplers.h"
+
+#include "chrono_vehicle/terrain/GranularTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Parameters of the relocation volume, as used by GranularTerrain.
+static const double safety_factor = 1.001;
+static const double offset_factor = 3;
+
+int main(int argc, char* argv[]) {
+    const double radius = 0.02;
+    const double buffer_distance = 0.2;
+    const double shift_distance = 0.25;
+    const ChVector<> init_vel(0, 0, -0.1);
+    const int start_id = 1000000;
+
+    ChSystemSMC system;
+
+    auto body = std::make_shared<ChBody>(ChMaterialSurface::SMC);
+    system.AddBody(body);
+
+    GranularTerrain terrain(&system);
+    terrain.EnableMovingPatch(body, buffer_distance, shift_distance, init_vel);
+    terrain.Initialize(ChVector<>(0, 0, 0), 1.0, 0.4, 300, radius, 2500);
+
+    // Scatter the particles along the patch, so that the ones to relocate are not contiguous in the pool.
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(terrain.GetPatchRear(), terrain.GetPatchFront());
+    for (auto& particle : terrain.GetParticles())
+        particle->SetPos(ChVector<>(dist(rng), particle->GetPos().y(), particle->GetPos().z()));
+
+    bool passed = true;
+    for (int step = 0; step < 3; step++) {
+        double rear = terrain.GetPatchRear() + shift_distance;
+        double front = terrain.GetPatchFront();
+        body->SetPos(ChVector<>(front - buffer_distance / 2, 0, 0));
+
+        // Serial search of the particles to relocate, in the order of the system body list.
+        std::vector<std::shared_ptr<ChBody>> expected;
+        std::vector<ChVector<>> positions;
+        for (auto b : *system.Get_bodylist()) {
+            positions.push_back(b->GetPos());
+            if (b->GetIdentifier() > start_id && b->GetPos().x() - radius < rear)
+                expected.push_back(b);
+        }
+
+        // The terrain draws the new locations from the random engine of the samplers: replay the same samples.
+        auto engine = utils::rengine();
+        terrain.Synchronize(0);
+        auto engine_after = utils::rengine();
+        utils::rengine() = engine;
+
+        std::vector<ChVector<>> new_points;
+        double r = safety_factor * radius;
+        utils::PDSampler<> sampler(2 * r);
+        ChVector<> layer_hdims(shift_distance / 2 - r, (terrain.GetPatchLeft() - terrain.GetPatchRight()) / 2 - r, 0);
+        ChVector<> layer_center(front + shift_distance / 2, (terrain.GetPatchLeft() + terrain.GetPatchRight()) / 2,
+                                terrain.GetPatchBottom() + offset_factor * r);
+        while (new_points.size() < expected.size()) {
+            auto points = sampler.SampleBox(layer_center, layer_hdims);
+            new_points.insert(new_points.end(), points.begin(), points.end());
+            layer_center.z() += 2 * r;
+        }
+        utils::rengine() = engine_after;
+
+        if (!terrain.PatchMoved() || terrain.GetPatchFront() != front + shift_distance || expected.empty()) {
+            std::cout << "Patch not moved at step " << step << std::endl;
+            passed = false;
+            break;
+        }
+
+        size_t ip = 0;
+        size_t ib = 0;
+        for (auto b : *system.Get_bodylist()) {
+            if (ip < expected.size() && b == expected[ip]) {
+                if (!(b->GetPos() == new_points[ip]) || !(b->GetPos_dt() == init_vel)) {
+                    std::cout << "Particle " << b->GetIdentifier() << " not relocated at the expected location"
+                              << std::endl;
+                    passed = false;
+                }
+                ip++;
+            } else if (b != terrain.GetGroundBody() && !(b->GetPos() == positions[ib])) {
+                std::cout << "Particle " << b->GetIdentifier() << " moved, but it is not behind the patch"
+                          << std::endl;
+                passed = false;
+            }
+            ib++;
+        }
+        std::cout << "Move " << step << ": relocated " << expected.size() << " particles" << std::endl;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
@@ -0,0 +1,111 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for a terrain mesh shared by several rigid terrains.
+//
+// Two systems use rigid terrains initialized from the same RigidTerrainMesh,
+// with balls dropped on them. The systems are simulated one after the other,
+// then again concurrently on two threads: both runs must give exactly the same
+// results, with the balls on the terrain surface.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+static const double radius = 0.5;
+
+// A system with a terrain on the shared mesh and a few balls above it.
+class Scenario {
+  public:
+    Scenario(std::shared_ptr<RigidTerrainMesh> mesh, double offset) : terrain(&system) {
+        system.Set_G_acc(ChVector<>(0, 0, -9.81));
+        terrain.Initialize(mesh);
+        for (int i = 0; i < 4; i++) {
+            double x = -10 + 6.0 * i + offset;
+            double y = 5 - 3.0 * i - offset;
+            auto ball = std::make_shared<ChBodyEasySphere>(radius, 1000, true, false);
+            ball->SetPos(ChVector<>(x, y, terrain.GetHeight(x, y) + radius + 0.2));
+            system.AddBody(ball);
+            balls.push_back(ball);
+        }
+    }
+
+    void Simulate() {
+        for (int i = 0; i < 500; i++)
+            system.DoStepDynamics(2e-3);
+    }
+
+    ChSystemNSC system;
+    RigidTerrain terrain;
+    std::vector<std::shared_ptr<ChBody>> balls;
+};
+
+int main(int argc, char* argv[]) {
+    SetDataPath(GetChronoDataPath() + "vehicle/");
+    CHOMPfunctions::SetNumThreads(1);
+    bool passed = true;
+
+    auto mesh = std::make_shared<RigidTerrainMesh>(GetDataFile("terrain/height_maps/test64.bmp"), "test_map", 64,
+                                                   64, 0, 4);
+
+    // Reference: the systems simulated one after the other.
+    Scenario serial1(mesh, 0);
+    Scenario serial2(mesh, 1.5);
+    serial1.Simulate();
+    serial2.Simulate();
+
+    // The same systems simulated concurrently.
+    Scenario concurrent1(mesh, 0);
+    Scenario concurrent2(mesh, 1.5);
+    std::thread thread1([&]() { concurrent1.Simulate(); });
+    std::thread thread2([&]() { concurrent2.Simulate(); });
+    thread1.join();
+    thread2.join();
+
+    Scenario* serial[2] = {&serial1, &serial2};
+    Scenario* concurrent[2] = {&concurrent1, &concurrent2};
+    for (int is = 0; is < 2; is++) {
+        for (size_t ib = 0; ib < serial[is]->balls.size(); ib++) {
+            auto& ball = serial[is]->balls[ib];
+            ChVector<> pos = ball->GetPos();
+            double gap = pos.z() - radius - serial[is]->terrain.GetHeight(pos.x(), pos.y());
+            std::cout << "System " << is << ", ball " << ib << ": gap " << gap << std::endl;
+            // On a slope, the center of a ball resting on the terrain is higher than a radius above the terrain
+            // (the balls may roll down the slopes).
+            if (gap < -0.05 || gap > 0.5 * radius) {
+                std::cout << "Ball not on the terrain" << std::endl;
+                passed = false;
+            }
+            auto& other = concurrent[is]->balls[ib];
+            if (other->GetPos() != pos || other->GetRot() != ball->GetRot()) {
+                std::cout << "Different results on concurrent threads" << std::endl;
+                passed = false;
+            }
+        }
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
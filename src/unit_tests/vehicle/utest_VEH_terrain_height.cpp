@@ -0,0 +1,160 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the height queries of the rigid terrain.
+//
+// The heights and normals of an OBJ mesh terrain and of a height map terrain
+// are compared with a brute-force search over all triangles of the terrain
+// mesh, at random points, at the vertexes and on the edges shared by two
+// triangles, and at points outside the terrain. The batched queries must give
+// the same results as the single ones.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Lowest triangle of the mesh at (x,y), by brute force. Return the number of triangles found, counting only the
+// ones which contain the point with some margin in 'strict'.
+static int BruteForce(const geometry::ChTriangleMeshConnected& trimesh,
+                      double x,
+                      double y,
+                      double& height,
+                      ChVector<>& normal,
+                      int& strict) {
+    const auto& vertices = trimesh.m_vertices;
+    int found = 0;
+    strict = 0;
+    for (auto& face : trimesh.m_face_v_indices) {
+        const ChVector<>& p0 = vertices[face[0]];
+        ChVector<> e1 = vertices[face[1]] - p0;
+        ChVector<> e2 = vertices[face[2]] - p0;
+        double det = e1.x() * e2.y() - e2.x() * e1.y();
+        if (std::abs(det) <= 1e-12 * (e1.Length2() + e2.Length2()))
+            continue;
+        double s = ((x - p0.x()) * e2.y() - (y - p0.y()) * e2.x()) / det;
+        double r = ((y - p0.y()) * e1.x() - (x - p0.x()) * e1.y()) / det;
+        if (s < -1e-9 || r < -1e-9 || s + r > 1 + 1e-9)
+            continue;
+        if (s > 1e-6 && r > 1e-6 && s + r < 1 - 1e-6)
+            strict++;
+        double z = p0.z() + s * e1.z() + r * e2.z();
+        if (found == 0 || z < height) {
+            height = z;
+            normal = Vcross(e1, e2).GetNormalized();
+            if (normal.z() < 0)
+                normal = -normal;
+        }
+        found++;
+    }
+    return found;
+}
+
+static bool CheckTerrain(const RigidTerrain& terrain, const char* name) {
+    const auto& trimesh = terrain.GetMesh()->GetTriangleMesh();
+    const auto& vertices = trimesh.m_vertices;
+
+    ChVector<> pmin(1e300, 1e300, 0);
+    ChVector<> pmax(-1e300, -1e300, 0);
+    for (auto& v : vertices) {
+        pmin = ChVector<>(std::min(pmin.x(), v.x()), std::min(pmin.y(), v.y()), 0);
+        pmax = ChVector<>(std::max(pmax.x(), v.x()), std::max(pmax.y(), v.y()), 0);
+    }
+    double size = std::max(pmax.x() - pmin.x(), pmax.y() - pmin.y());
+
+    // Query points: random points (also some outside), vertexes, and points on triangle edges.
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::vector<ChVector<>> loc;
+    for (int i = 0; i < 200; i++)
+        loc.push_back(ChVector<>(pmin.x() - 0.1 * size + 1.2 * size * uniform(rng),
+                                 pmin.y() - 0.1 * size + 1.2 * size * uniform(rng), 0));
+    const auto& faces = trimesh.m_face_v_indices;
+    for (int i = 0; i < 100; i++) {
+        const ChVector<int>& face = faces[(size_t)(uniform(rng) * faces.size())];
+        const ChVector<>& a = vertices[face[i % 3]];
+        const ChVector<>& b = vertices[face[(i + 1) % 3]];
+        loc.push_back(a);
+        loc.push_back(a + uniform(rng) * (b - a));
+    }
+    loc.push_back(pmin);
+    loc.push_back(pmax);
+    loc.push_back(ChVector<>(pmin.x() - 1e-3 * size, 0.5 * (pmin.y() + pmax.y()), 0));
+    loc.push_back(ChVector<>(0.5 * (pmin.x() + pmax.x()), pmax.y() + 1e-3 * size, 0));
+
+    std::vector<double> heights;
+    std::vector<ChVector<>> normals;
+    terrain.GetHeightsAndNormals(loc, heights, normals);
+
+    int num_inside = 0;
+    int num_outside = 0;
+    for (size_t i = 0; i < loc.size(); i++) {
+        double x = loc[i].x();
+        double y = loc[i].y();
+        double height = terrain.GetHeight(x, y);
+        ChVector<> normal = terrain.GetNormal(x, y);
+        if (height != heights[i] || normal != normals[i]) {
+            std::cout << name << ": batched query differs at (" << x << ", " << y << ")" << std::endl;
+            return false;
+        }
+
+        double height_ref = 0;
+        ChVector<> normal_ref(0, 0, 1);
+        int strict;
+        int found = BruteForce(trimesh, x, y, height_ref, normal_ref, strict);
+        if (found)
+            num_inside++;
+        else
+            num_outside++;
+        bool ok = std::abs(height - height_ref) <= 1e-9 * (1 + std::abs(height_ref));
+        // On edges and vertexes, the normal is the one of any of the triangles sharing them.
+        if (found == 0 || (found == 1 && strict == 1))
+            ok = ok && (normal - normal_ref).Length() <= 1e-9;
+        if (!ok) {
+            std::cout << name << ": wrong result at (" << x << ", " << y << "): height " << height
+                      << ", expected " << height_ref << ", normal error " << (normal - normal_ref).Length()
+                      << std::endl;
+            return false;
+        }
+    }
+    std::cout << name << ": " << num_inside << " points inside, " << num_outside << " outside" << std::endl;
+    return num_inside > 0 && num_outside > 0;
+}
+
+int main(int argc, char* argv[]) {
+    SetDataPath(GetChronoDataPath() + "vehicle/");
+    bool passed = true;
+
+    ChSystemNSC system;
+
+    RigidTerrain mesh_terrain(&system);
+    mesh_terrain.Initialize(GetDataFile("terrain/meshes/test.obj"), "test_mesh");
+    passed &= CheckTerrain(mesh_terrain, "OBJ mesh");
+
+    RigidTerrain map_terrain(&system);
+    map_terrain.Initialize(GetDataFile("terrain/height_maps/test64.bmp"), "test_map", 64, 48, 0, 5);
+    passed &= CheckTerrain(map_terrain, "Height map");
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}